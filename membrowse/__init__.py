@@ -104,27 +104,57 @@ parse_linker_scripts(ld_scripts, elf_file=None)
     Parse GNU LD linker scripts to extract memory regions.
 """
 
-from importlib.metadata import version, PackageNotFoundError
-
-from .core.generator import ReportGenerator
-from .core.analyzer import ELFAnalyzer
-from .core.models import (
-    Symbol,
-    MemoryRegion,
-    MemorySection,
-    ELFMetadata,
-    # TypedDict types for type hints
-    MemoryReport,
-    SymbolDict,
-    MemoryRegionDict,
-    ProgramHeaderDict,
-)
-from .linker.parser import parse_linker_scripts
-
-try:
-    __version__ = version('membrowse')
-except PackageNotFoundError:
-    __version__ = "0.0.0"  # Package not installed
+from typing import TYPE_CHECKING
+
+from .utils.lazy import lazy_exports
+
+if TYPE_CHECKING:
+    from .core.generator import ReportGenerator
+    from .core.analyzer import ELFAnalyzer
+    from .core.models import (
+        Symbol,
+        MemoryRegion,
+        MemorySection,
+        ELFMetadata,
+        # TypedDict types for type hints
+        MemoryReport,
+        SymbolDict,
+        MemoryRegionDict,
+        ProgramHeaderDict,
+    )
+    from .linker.parser import parse_linker_scripts
+
+# The public API is imported on first use so that ``import membrowse`` (and
+# every subcommand that does not analyze an ELF) stays cheap
+_getattr, __dir__ = lazy_exports(__name__, {
+    'ReportGenerator': '.core.generator',
+    'ELFAnalyzer': '.core.analyzer',
+    'Symbol': '.core.models',
+    'MemoryRegion': '.core.models',
+    'MemorySection': '.core.models',
+    'ELFMetadata': '.core.models',
+    'MemoryReport': '.core.models',
+    'SymbolDict': '.core.models',
+    'MemoryRegionDict': '.core.models',
+    'ProgramHeaderDict': '.core.models',
+    'parse_linker_scripts': '.linker.parser',
+})
+
+
+def __getattr__(name):
+    """Resolve ``__version__`` and the lazily imported public API."""
+    if name != '__version__':
+        return _getattr(name)
+    # importlib.metadata alone takes tens of milliseconds to import
+    # pylint: disable-next=import-outside-toplevel
+    from importlib.metadata import version, PackageNotFoundError
+    try:
+        value = version('membrowse')
+    except PackageNotFoundError:
+        value = "0.0.0"  # Package not installed
+    globals()['__version__'] = value
+    return value
+
 
 __all__ = [
     # Classes
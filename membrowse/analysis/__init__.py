@@ -6,23 +6,23 @@ This package contains specialized analyzers for extracting information
 from ELF files including DWARF debug info, symbols, sections, and source files.
 """
 
-from .dwarf import DWARFProcessor
-from .symbols import SymbolExtractor
-from .sections import (
-    SectionAnalyzer,
-    SECTION_TYPE_CODE,
-    SECTION_TYPE_DATA,
-    SECTION_TYPE_RODATA,
-    SECTION_TYPE_UNKNOWN,
-)
-from .sources import SourceFileResolver
-from .mapper import MemoryMapper
-from .defaults import (
-    create_default_memory_regions,
-    map_sections_to_default_regions,
-    DEFAULT_CODE_REGION,
-    DEFAULT_DATA_REGION,
-)
+from ..utils.lazy import lazy_exports
+
+__getattr__, __dir__ = lazy_exports(__name__, {
+    'DWARFProcessor': '.dwarf',
+    'SymbolExtractor': '.symbols',
+    'SectionAnalyzer': '.sections',
+    'SECTION_TYPE_CODE': '.sections',
+    'SECTION_TYPE_DATA': '.sections',
+    'SECTION_TYPE_RODATA': '.sections',
+    'SECTION_TYPE_UNKNOWN': '.sections',
+    'SourceFileResolver': '.sources',
+    'MemoryMapper': '.mapper',
+    'create_default_memory_regions': '.defaults',
+    'map_sections_to_default_regions': '.defaults',
+    'DEFAULT_CODE_REGION': '.defaults',
+    'DEFAULT_DATA_REGION': '.defaults',
+})
 
 __all__ = [
     'DWARFProcessor',
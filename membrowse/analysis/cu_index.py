@@ -0,0 +1,180 @@
+#!/usr/bin/env python3
+"""
+Address index of compilation units.
+
+Maps addresses to the CUs whose code covers them, so that only CUs holding
+symbols we need are decoded. CU ranges come from ``.debug_aranges`` when
+the producer emitted it (no DIE is parsed), otherwise from the CU's top
+DIE: ``DW_AT_low_pc`` / ``DW_AT_high_pc`` or the full ``DW_AT_ranges`` list
+(``.debug_ranges`` in DWARF 4, ``.debug_rnglists`` in DWARF 5) as used by
+``-ffunction-sections`` and LTO ``<artificial>`` CUs.
+"""
+
+import bisect
+import logging
+from typing import Any, Callable, Dict, Iterable, Iterator, List, Optional, Sequence, Tuple
+
+logger = logging.getLogger(__name__)
+
+AddressRanges = List[Tuple[int, int]]
+
+
+def read_aranges(dwarfinfo) -> Dict[int, AddressRanges]:
+    """Address ranges per CU offset from ``.debug_aranges``.
+
+    Returns:
+        Mapping of CU offset to its (start, end) ranges; empty when the
+        section is missing or unreadable
+    """
+    try:
+        aranges = dwarfinfo.get_aranges()
+        if aranges is None:
+            return {}
+        ranges: Dict[int, AddressRanges] = {}
+        for entry in aranges.entries:
+            if entry.length:
+                ranges.setdefault(entry.info_offset, []).append(
+                    (entry.begin_addr, entry.begin_addr + entry.length))
+        return ranges
+    except Exception as e:  # pylint: disable=broad-exception-caught
+        logger.debug("Cannot read .debug_aranges (%s), using CU DIEs", e)
+        return {}
+
+
+def _rnglistx_offset(cu, top_die, index: int, rnglists: bytes,
+                     little_endian: bool) -> int:
+    """Resolve a ``DW_FORM_rnglistx`` index through the CU's offset table."""
+    base = top_die.attributes['DW_AT_rnglists_base'].value
+    offset_size = 8 if cu.dwarf_format() == 64 else 4
+    entry = base + index * offset_size
+    relative = int.from_bytes(rnglists[entry:entry + offset_size],
+                              'little' if little_endian else 'big')
+    return base + relative
+
+
+def read_die_ranges(dwarfinfo, cu, top_die, rnglists: bytes) -> Optional[AddressRanges]:
+    """Address ranges of a CU from its top DIE's ``DW_AT_ranges``.
+
+    Args:
+        dwarfinfo: DWARF debug information object
+        cu: Compilation unit
+        top_die: The CU's top DIE
+        rnglists: ``.debug_rnglists`` bytes (for ``DW_FORM_rnglistx``)
+
+    Returns:
+        The ranges, or None if the CU has no usable range list
+    """
+    attr = top_die.attributes.get('DW_AT_ranges')
+    if attr is None:
+        return None
+    try:
+        range_lists = dwarfinfo.range_lists()
+        if range_lists is None:
+            return None
+        offset = attr.value
+        if attr.form == 'DW_FORM_rnglistx':
+            offset = _rnglistx_offset(cu, top_die, offset, rnglists,
+                                      dwarfinfo.config.little_endian)
+        low_pc = top_die.attributes.get('DW_AT_low_pc')
+        base = low_pc.value if low_pc is not None else 0
+        ranges = []
+        for entry in range_lists.get_range_list_at_offset(offset, cu=cu):
+            if hasattr(entry, 'base_address'):
+                base = entry.base_address
+                continue
+            begin, end = entry.begin_offset, entry.end_offset
+            if not getattr(entry, 'is_absolute', False):
+                begin += base
+                end += base
+            if end > begin:
+                ranges.append((begin, end))
+        return ranges
+    except Exception as e:  # pylint: disable=broad-exception-caught
+        logger.debug("Cannot read DW_AT_ranges of CU at offset %d: %s",
+                     cu.cu_offset, e)
+        return None
+
+
+class CUAddressIndex:
+    """Address intervals of all CUs, with multi-range coverage.
+
+    CUs without any known range (e.g. data-only or assembly CUs) may hold
+    any symbol and are always reported relevant; they no longer disable
+    pruning of the CUs that do have ranges.
+
+    Lookups use a table of elementary segments: the range boundaries split
+    the address space into segments, and each segment stores the CUs that
+    cover all of it. An address is looked up with one bisect, however wide
+    or nested the ranges are.
+    """
+
+    def __init__(self, cu_ranges: Iterable[Tuple[Any, Sequence[Tuple[int, int]]]]):
+        """
+        Args:
+            cu_ranges: (cu, ranges) pairs in ``.debug_info`` order; an empty
+                range list marks a CU without known ranges
+        """
+        entries = list(cu_ranges)
+        # Processing order: by lowest address, range-less CUs first
+        entries.sort(key=lambda entry: min(start for start, _ in entry[1])
+                     if entry[1] else 0)
+        self._cus = [cu for cu, _ in entries]
+        self._rangeless = [pos for pos, (_, ranges) in enumerate(entries) if not ranges]
+
+        # Range ends are inclusive, like the previous single-range index, so
+        # a symbol at a CU's end address still selects it: a range covers
+        # [start, end + 1). Each boundary opens or closes ranges.
+        events: Dict[int, List[Tuple[int, int]]] = {}
+        for pos, (_, ranges) in enumerate(entries):
+            for start, end in ranges:
+                events.setdefault(start, []).append((pos, 1))
+                events.setdefault(end + 1, []).append((pos, -1))
+
+        self._bounds = sorted(events)
+        # Covering CU positions of the segment [bounds[i], bounds[i + 1])
+        self._segments: List[Tuple[int, ...]] = []
+        active: Dict[int, int] = {}
+        for bound in self._bounds:
+            for pos, delta in events[bound]:
+                depth = active.get(pos, 0) + delta
+                if depth:
+                    active[pos] = depth
+                else:
+                    del active[pos]
+            self._segments.append(tuple(active))
+
+    def __len__(self) -> int:
+        return len(self._cus)
+
+    def __iter__(self) -> Iterator[Any]:
+        """All CUs in index order."""
+        return iter(self._cus)
+
+    @property
+    def rangeless_count(self) -> int:
+        """Number of CUs without known address ranges."""
+        return len(self._rangeless)
+
+    def _positions_at(self, address: int) -> Tuple[int, ...]:
+        """Index positions of CUs with a range containing ``address``."""
+        i = bisect.bisect_right(self._bounds, address) - 1
+        return self._segments[i] if i >= 0 else ()
+
+    def relevant_cus(self, addresses: Iterable[int],
+                     include: Optional[Callable[[Any], bool]] = None) -> List[Any]:
+        """CUs covering any of ``addresses`` plus all range-less CUs.
+
+        Args:
+            addresses: Code addresses to look up
+            include: Selects further CUs regardless of their ranges
+
+        Returns:
+            CUs in index order (lowest address first)
+        """
+        positions = set(self._rangeless)
+        for address in addresses:
+            positions.update(self._positions_at(address))
+        if include is not None:
+            positions.update(pos for pos, cu in enumerate(self._cus)
+                             if pos not in positions and include(cu))
+        return [self._cus[pos] for pos in sorted(positions)]
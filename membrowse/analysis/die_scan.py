@@ -0,0 +1,387 @@
+#!/usr/bin/env python3
+"""
+Abbreviation-driven DIE tree scanner.
+
+pyelftools decodes every attribute of every DIE it visits, but the DIE walk
+in :class:`~membrowse.analysis.dwarf.DWARFProcessor` only needs the few
+subprogram, variable, parameter and inlined entries. This scanner reads the
+raw ``.debug_info`` bytes of a CU using its abbreviation table: it computes
+each DIE's size from the attribute forms without decoding the values, and
+jumps over subtrees that cannot contain relevant entries (types, enums,
+template parameters, and aggregates in C) through ``DW_AT_sibling`` or a
+raw walk. Only the relevant DIEs are then decoded by pyelftools.
+"""
+
+from typing import Any, Callable, Dict, Iterable, List, NamedTuple, Optional, Tuple
+
+# DIE tags processed by the DWARF walk
+RELEVANT_TAGS = frozenset({
+    'DW_TAG_subprogram',
+    'DW_TAG_variable',
+    'DW_TAG_formal_parameter',
+    'DW_TAG_inlined_subroutine',
+})
+
+# Tags whose subtrees never contain a relevant DIE in any language.
+# (Subroutine types and GNU parameter packs hold formal parameters and are
+# walked.)
+_SKIPPED_TAGS = frozenset({
+    'DW_TAG_base_type',
+    'DW_TAG_pointer_type',
+    'DW_TAG_reference_type',
+    'DW_TAG_rvalue_reference_type',
+    'DW_TAG_ptr_to_member_type',
+    'DW_TAG_const_type',
+    'DW_TAG_volatile_type',
+    'DW_TAG_restrict_type',
+    'DW_TAG_atomic_type',
+    'DW_TAG_immutable_type',
+    'DW_TAG_typedef',
+    'DW_TAG_array_type',
+    'DW_TAG_subrange_type',
+    'DW_TAG_enumeration_type',
+    'DW_TAG_enumerator',
+    'DW_TAG_member',
+    'DW_TAG_inheritance',
+    'DW_TAG_unspecified_type',
+    'DW_TAG_string_type',
+    'DW_TAG_template_type_param',
+    'DW_TAG_template_value_param',
+    'DW_TAG_GNU_template_parameter_pack',
+    'DW_TAG_GNU_template_template_param',
+})
+
+# In C, aggregates only hold members (C++ classes also hold methods and
+# static data members, so they are walked)
+_C_AGGREGATE_TAGS = frozenset({
+    'DW_TAG_structure_type',
+    'DW_TAG_union_type',
+})
+
+# Raw codes read from .debug_abbrev by declares_located_variable
+_DW_TAG_VARIABLE = 0x34
+_DW_AT_LOCATION = 0x02
+_DW_FORM_IMPLICIT_CONST = 0x21
+
+# DW_AT_language values of C dialects
+_C_LANGUAGES = frozenset({0x1, 0x2, 0xc, 0x1d, 0x2c})
+
+_FIXED_FORM_SIZES = {
+    'DW_FORM_data1': 1, 'DW_FORM_ref1': 1, 'DW_FORM_flag': 1,
+    'DW_FORM_strx1': 1, 'DW_FORM_addrx1': 1,
+    'DW_FORM_data2': 2, 'DW_FORM_ref2': 2, 'DW_FORM_strx2': 2, 'DW_FORM_addrx2': 2,
+    'DW_FORM_strx3': 3, 'DW_FORM_addrx3': 3,
+    'DW_FORM_data4': 4, 'DW_FORM_ref4': 4, 'DW_FORM_strx4': 4,
+    'DW_FORM_addrx4': 4, 'DW_FORM_ref_sup4': 4,
+    'DW_FORM_data8': 8, 'DW_FORM_ref8': 8, 'DW_FORM_ref_sig8': 8,
+    'DW_FORM_ref_sup8': 8,
+    'DW_FORM_data16': 16,
+    'DW_FORM_flag_present': 0, 'DW_FORM_implicit_const': 0,
+}
+_OFFSET_FORMS = frozenset({
+    'DW_FORM_strp', 'DW_FORM_line_strp', 'DW_FORM_sec_offset',
+    'DW_FORM_strp_sup', 'DW_FORM_GNU_ref_alt', 'DW_FORM_GNU_strp_alt',
+})
+_LEB128_FORMS = frozenset({
+    'DW_FORM_sdata', 'DW_FORM_udata', 'DW_FORM_ref_udata', 'DW_FORM_strx',
+    'DW_FORM_addrx', 'DW_FORM_rnglistx', 'DW_FORM_loclistx',
+    'DW_FORM_GNU_addr_index', 'DW_FORM_GNU_str_index',
+})
+# Forms DW_AT_sibling may use (CU-relative references)
+_SIBLING_FORMS = {
+    'DW_FORM_ref1': 1, 'DW_FORM_ref2': 2, 'DW_FORM_ref4': 4, 'DW_FORM_ref8': 8,
+}
+
+# Attribute size operations
+_OP_LEB128 = -1
+_OP_STRING = -2
+_OP_BLOCK1 = -3
+_OP_BLOCK2 = -4
+_OP_BLOCK4 = -5
+_OP_BLOCK_LEB = -6
+
+
+class ScanError(Exception):
+    """The CU uses something the scanner does not handle (fall back)."""
+
+
+class Abbrev(NamedTuple):
+    """Compiled abbreviation: how to step over a DIE without decoding it."""
+    tag: Any
+    has_children: bool
+    # Total attribute size when every form has a fixed size, else None
+    fixed_size: Optional[int]
+    # Per-attribute size (>= 0) or _OP_* code, in attribute order
+    ops: Tuple[int, ...]
+    # (attribute index, byte size or _OP_LEB128) of DW_AT_sibling, if any
+    sibling: Optional[Tuple[int, int]]
+
+
+def compile_abbrev(tag, has_children: bool, attr_specs: Iterable[Tuple[str, str]],
+                   address_size: int, offset_size: int, version: int) -> Abbrev:
+    """Compile an abbreviation declaration for :class:`DIEScanner`.
+
+    Args:
+        tag: DIE tag name
+        has_children: Whether DIEs with this abbreviation own children
+        attr_specs: ``(attribute name, form name)`` pairs in order
+        address_size: CU address size in bytes
+        offset_size: 4 for 32-bit DWARF, 8 for 64-bit DWARF
+        version: CU DWARF version
+
+    Raises:
+        ScanError: For forms whose size cannot be determined up front
+            (``DW_FORM_indirect``, unknown vendor forms)
+    """
+    ops = []
+    sibling = None
+    for name, form in attr_specs:
+        if form in _FIXED_FORM_SIZES:
+            op = _FIXED_FORM_SIZES[form]
+        elif form == 'DW_FORM_addr':
+            op = address_size
+        elif form in _OFFSET_FORMS:
+            op = offset_size
+        elif form == 'DW_FORM_ref_addr':
+            op = offset_size if version >= 3 else address_size
+        elif form in _LEB128_FORMS:
+            op = _OP_LEB128
+        elif form == 'DW_FORM_string':
+            op = _OP_STRING
+        elif form == 'DW_FORM_block1':
+            op = _OP_BLOCK1
+        elif form == 'DW_FORM_block2':
+            op = _OP_BLOCK2
+        elif form == 'DW_FORM_block4':
+            op = _OP_BLOCK4
+        elif form in ('DW_FORM_block', 'DW_FORM_exprloc'):
+            op = _OP_BLOCK_LEB
+        else:
+            raise ScanError(f"unsupported form {form}")
+        if name == 'DW_AT_sibling':
+            if form in _SIBLING_FORMS:
+                sibling = (len(ops), _SIBLING_FORMS[form])
+            elif form == 'DW_FORM_ref_udata':
+                sibling = (len(ops), _OP_LEB128)
+        ops.append(op)
+    fixed_size = sum(ops) if all(op >= 0 for op in ops) else None
+    return Abbrev(tag, bool(has_children), fixed_size, tuple(ops), sibling)
+
+
+def _read_uleb(data: bytes, pos: int) -> Tuple[int, int]:
+    """Decode a ULEB128 at ``pos``; returns (value, next position)."""
+    byte = data[pos]
+    if byte < 0x80:
+        return byte, pos + 1
+    value = byte & 0x7f
+    shift = 7
+    while True:
+        pos += 1
+        byte = data[pos]
+        value |= (byte & 0x7f) << shift
+        if byte < 0x80:
+            return value, pos + 1
+        shift += 7
+
+
+class ScannedTree(NamedTuple):
+    """Result of scanning a CU."""
+    tags: Dict[int, Any]
+    children: Dict[int, List[int]]
+    skipped: int
+
+
+class DIEScanner:  # pylint: disable=too-few-public-methods
+    """Scans the DIE tree of one CU from raw ``.debug_info`` bytes."""
+
+    def __init__(self, data: bytes, get_abbrev: Callable[[int], Abbrev],
+                 little_endian: bool = True, skip_c_aggregates: bool = False):
+        """
+        Args:
+            data: ``.debug_info`` section bytes
+            get_abbrev: Returns the compiled :class:`Abbrev` for a code
+                (raising KeyError for unknown codes)
+            little_endian: Byte order of the section
+            skip_c_aggregates: Also skip struct/union subtrees (C CUs)
+        """
+        self._data = data
+        self._get_abbrev = get_abbrev
+        self._byteorder = 'little' if little_endian else 'big'
+        self._skipped_tags = (_SKIPPED_TAGS | _C_AGGREGATE_TAGS
+                              if skip_c_aggregates else _SKIPPED_TAGS)
+
+    def _skip_attributes(self, abbrev: Abbrev, pos: int) -> Tuple[int, Optional[int]]:
+        """Step over a DIE's attributes.
+
+        Returns:
+            (position after the DIE, CU-relative DW_AT_sibling value or None)
+        """
+        if abbrev.fixed_size is not None and abbrev.sibling is None:
+            return pos + abbrev.fixed_size, None
+        data = self._data
+        sibling = None
+        sibling_index = abbrev.sibling[0] if abbrev.sibling else -1
+        for index, op in enumerate(abbrev.ops):
+            start = pos
+            if op >= 0:
+                pos += op
+            elif op == _OP_LEB128:
+                _, pos = _read_uleb(data, pos)
+            elif op == _OP_STRING:
+                pos = data.index(b'\0', pos) + 1
+            elif op == _OP_BLOCK_LEB:
+                length, pos = _read_uleb(data, pos)
+                pos += length
+            else:
+                width = {_OP_BLOCK1: 1, _OP_BLOCK2: 2, _OP_BLOCK4: 4}[op]
+                pos += width + int.from_bytes(data[pos:pos + width], self._byteorder)
+            if index == sibling_index:
+                if abbrev.sibling[1] == _OP_LEB128:
+                    sibling, _ = _read_uleb(data, start)
+                else:
+                    sibling = int.from_bytes(data[start:pos], self._byteorder)
+        return pos, sibling
+
+    def _skip_subtree_children(self, pos: int, end: int) -> Tuple[int, int]:
+        """Walk past the children of a DIE without recording them.
+
+        Returns:
+            (position after the terminating null entry, DIEs stepped over)
+        """
+        depth = 1
+        stepped = 0
+        data = self._data
+        while depth:
+            if pos >= end:
+                raise ScanError("subtree runs past the end of the CU")
+            code, pos = _read_uleb(data, pos)
+            if code == 0:
+                depth -= 1
+                continue
+            abbrev = self._get_abbrev(code)
+            pos, _ = self._skip_attributes(abbrev, pos)
+            stepped += 1
+            if abbrev.has_children:
+                depth += 1
+        return pos, stepped
+
+    def scan(self, cu_offset: int, first_die: int, end: int) -> ScannedTree:
+        """Scan the DIE tree of a CU.
+
+        Args:
+            cu_offset: Offset of the CU header (base of CU-relative references)
+            first_die: Offset of the CU's top DIE
+            end: Offset just past the CU
+
+        Returns:
+            :class:`ScannedTree` with the tag of every kept DIE and the child
+            offsets of each kept DIE with children, in document order
+
+        Raises:
+            ScanError: If the bytes do not form a well-nested tree
+        """
+        data = self._data
+        tags: Dict[int, Any] = {}
+        children: Dict[int, List[int]] = {}
+        skipped = 0
+        # Child lists of the open DIEs; the top DIE's parent is a sentinel
+        parents: List[List[int]] = [[]]
+        pos = first_die
+        try:
+            while pos < end:
+                offset = pos
+                code, pos = _read_uleb(data, pos)
+                if code == 0:
+                    parents.pop()
+                    if len(parents) == 1:
+                        # Top DIE closed; only padding may follow
+                        break
+                    continue
+                abbrev = self._get_abbrev(code)
+                pos, sibling = self._skip_attributes(abbrev, pos)
+
+                if len(parents) > 1 and abbrev.tag in self._skipped_tags:
+                    skipped += 1
+                    if abbrev.has_children:
+                        if sibling is not None and cu_offset + sibling > pos:
+                            pos = cu_offset + sibling
+                        else:
+                            pos, stepped = self._skip_subtree_children(pos, end)
+                            skipped += stepped
+                    continue
+
+                tags[offset] = abbrev.tag
+                parents[-1].append(offset)
+                if abbrev.has_children:
+                    child_list = children[offset] = []
+                    parents.append(child_list)
+                if len(parents) == 1:
+                    break
+        except (KeyError, IndexError, ValueError) as e:
+            raise ScanError(f"malformed DIE data near offset {pos}: {e}") from e
+        if pos > end or len(parents) > 1:
+            raise ScanError("DIE tree runs past the end of the CU")
+        return ScannedTree(tags, children, skipped)
+
+
+def relevant_die_order(tree: ScannedTree, top_offset: int) -> Tuple[List[int], int]:
+    """Offsets of relevant DIEs in the order the DWARF walk processes them.
+
+    The walk pops a DIE from a stack, pushes its children in document order
+    and then processes it, so DIEs come out depth first, last child first.
+
+    Returns:
+        (relevant DIE offsets in processing order, number of DIEs visited)
+    """
+    order = []
+    visited = 0
+    stack = [top_offset]
+    tags = tree.tags
+    children = tree.children
+    while stack:
+        offset = stack.pop()
+        visited += 1
+        stack.extend(children.get(offset, ()))
+        if tags[offset] in RELEVANT_TAGS:
+            order.append(offset)
+    return order, visited
+
+
+def is_c_language(language: Optional[int]) -> bool:
+    """Whether a ``DW_AT_language`` value denotes a C dialect."""
+    return language in _C_LANGUAGES
+
+
+def declares_located_variable(data: bytes, offset: int) -> bool:
+    """Whether an abbreviation table declares a variable with a location.
+
+    Reads the raw ``.debug_abbrev`` bytes, so no DIE is decoded. A CU whose
+    table has no such declaration cannot define a variable at an address.
+
+    Args:
+        data: ``.debug_abbrev`` section bytes
+        offset: Start of the CU's abbreviation table
+
+    Returns:
+        True also when the table is malformed (the CU cannot be ruled out)
+    """
+    pos = offset
+    try:
+        while True:
+            code, pos = _read_uleb(data, pos)
+            if code == 0:
+                return False
+            tag, pos = _read_uleb(data, pos)
+            pos += 1  # DW_CHILDREN_*
+            while True:
+                name, pos = _read_uleb(data, pos)
+                form, pos = _read_uleb(data, pos)
+                if name == 0 and form == 0:
+                    break
+                if form == _DW_FORM_IMPLICIT_CONST:
+                    # The SLEB128 constant has the length of a ULEB128
+                    _, pos = _read_uleb(data, pos)
+                if tag == _DW_TAG_VARIABLE and name == _DW_AT_LOCATION:
+                    return True
+    except IndexError:
+        return True
@@ -6,13 +6,26 @@ This module handles the parsing and processing of DWARF debug information
 to map symbols to their source files with intelligent optimizations.
 """
 
+import os
 import posixpath
 import logging
 import bisect
-from typing import Dict, List, Optional, Any, Tuple
+from concurrent.futures import ProcessPoolExecutor
+from concurrent.futures.process import BrokenProcessPool
+from contextlib import nullcontext
+from typing import Dict, Iterable, List, Optional, Any, Tuple
 from collections import deque
 from elftools.common.exceptions import ELFError
+from elftools.dwarf.die import DIE
+from elftools.elf.elffile import ELFFile
 from ..core.exceptions import DWARFParsingError, DWARFCUProcessingError, DWARFAttributeError
+from ..utils.cache import ContentCache
+from ..utils.timing import active_recorder, count, merge_recording, recording, stage
+from .cu_index import CUAddressIndex, read_aranges, read_die_ranges
+from .die_scan import (
+    RELEVANT_TAGS, DIEScanner, ScanError, compile_abbrev, declares_located_variable,
+    is_c_language, relevant_die_order)
+from .line_table import LineTable, LineTableBuilder
 
 # Configure logger
 logger = logging.getLogger(__name__)
@@ -27,6 +40,31 @@ ARM_MACHINES = {
     40,            # EM_ARM numeric value
 }
 
+# Below this many relevant CUs a process pool costs more than it saves
+MIN_CUS_PER_WORKER = 4
+
+# dwarf_data tables whose ARM tolerance aliases and address-0 fallbacks are
+# written with setdefault semantics (first writer wins, exact entries override)
+_DEFAULTED_TABLES = ('symbol_to_file', 'address_to_cu_file')
+
+# Bump when the cached per-CU record layout or the DIE processing rules change
+DWARF_CACHE_VERSION = b'membrowse-dwarf-cu-1'
+
+# String forms whose bytes live outside the CU and must be verified on a hit
+_STRING_TABLE_FORMS = {
+    'DW_FORM_strp': 'debug_str_sec',
+    'DW_FORM_line_strp': 'debug_line_str_sec',
+}
+
+
+def resolve_jobs(jobs: Optional[int]) -> int:
+    """Normalize a ``--jobs`` value: ``0`` or negative means one per CPU."""
+    if jobs is None:
+        return 1
+    if jobs <= 0:
+        return os.cpu_count() or 1
+    return jobs
+
 
 class DWARFProcessor:  # pylint: disable=too-many-instance-attributes,too-few-public-methods
     """Handles DWARF debug information processing for source file mapping.
@@ -40,12 +78,19 @@ class DWARFProcessor:  # pylint: disable=too-many-instance-attributes,too-few-pu
     that contain symbols we actually need to map.
     """
 
-    def __init__(
+    def __init__(  # pylint: disable=too-many-arguments
             self,
             elffile,
             symbol_addresses: set,
             skip_line_program: bool = False,
-            machine: str = None):
+            machine: str = None,
+            *,
+            jobs: int = 1,
+            elf_path: Optional[str] = None,
+            cache_dir: Optional[str] = None,
+            fast_die_scan: bool = True,
+            lazy_line_program: bool = False,
+            function_addresses: Optional[set] = None):
         """Initialize DWARF processor with ELF file and target addresses.
 
         Args:
@@ -54,11 +99,55 @@ class DWARFProcessor:  # pylint: disable=too-many-instance-attributes,too-few-pu
             skip_line_program: Skip line program processing for faster analysis
             machine: ELF machine type (e.g., 'EM_ARM', 'EM_XTENSA')
                      for architecture-specific handling
+            jobs: Number of worker processes for per-CU processing
+                  (``0`` = one per CPU). Requires ``elf_path``.
+            elf_path: Path of the ELF behind ``elffile``; workers reopen it
+            cache_dir: Enables the on-disk per-CU cache under this directory;
+                without one, the cache is kept in memory while
+                :meth:`ContentCache.keep_in_memory` is active
+            fast_die_scan: Find relevant DIEs with the raw abbreviation-driven
+                scanner (see :mod:`.die_scan`) instead of decoding every DIE
+            lazy_line_program: Run the DIE pass without line programs and
+                decode them later, only for the CUs :meth:`decode_line_programs`
+                is asked about
+            function_addresses: The FUNC symbols among ``symbol_addresses``.
+                CUs are selected by whether their code covers one of them;
+                CUs that may define a variable are processed whenever other
+                symbols are left. ``None`` treats every address as both.
         """
         self.elffile = elffile
         self.symbol_addresses = symbol_addresses
-        self.skip_line_program = skip_line_program
+        self.function_addresses = (symbol_addresses if function_addresses is None
+                                   else function_addresses)
+        self._has_data_symbols = (function_addresses is None
+                                  or bool(symbol_addresses - function_addresses))
+        self.lazy_line_program = lazy_line_program and not skip_line_program
+        self.skip_line_program = skip_line_program or self.lazy_line_program
         self.machine = machine
+        self.jobs = resolve_jobs(jobs)
+        self.elf_path = elf_path
+        # Per-table sets of keys written only via setdefault; populated in
+        # parallel workers so chunk merges preserve serial precedence
+        self.defaulted_keys: Optional[Dict[str, set]] = None
+
+        # Content-addressed per-CU cache. While a CU is decoded on a cache
+        # miss, _recording collects its symbol-set-independent output.
+        self.cache_dir = cache_dir
+        self.cache = (ContentCache(cache_dir, 'dwarf')
+                      if ContentCache.enabled(cache_dir) else None)
+        self._recording: Optional[Dict[str, Any]] = None
+        self.cache_hits = 0
+        self.cache_misses = 0
+        self._section_bytes_cache: Dict[str, bytes] = {}
+        self._abbrev_ends: Optional[Dict[int, int]] = None
+        self.fast_die_scan = fast_die_scan
+        # Compiled abbreviations per (abbrev offset, address size, offset
+        # size, version), filled lazily as the scanner meets codes
+        self._compiled_abbrevs: Dict[Tuple[int, int, int, int], Dict[int, Any]] = {}
+        # CU index of the DIE pass, reused by decode_line_programs
+        self._cu_index: Optional[CUAddressIndex] = None
+        # Abbreviation table offset -> declares a variable with a location
+        self._variable_abbrevs: Dict[int, bool] = {}
 
         # Determine if we need address tolerance based on architecture
         # ARM Thumb mode requires ±2 byte tolerance, other architectures use
@@ -76,12 +165,16 @@ class DWARFProcessor:  # pylint: disable=too-many-instance-attributes,too-few-pu
         self.target_symbol_count = len(symbol_addresses)
         # Precompute sorted symbol addresses for fast tolerance checking
         self.sorted_symbol_addresses = sorted(symbol_addresses)
+        # Line program rows are collected here and sorted into a LineTable
+        # once all CUs are processed (see build_line_table)
+        self._line_rows = LineTableBuilder()
+        line_table = LineTable()
         # Only keep actively used data structures
         self.dwarf_data = {
-            # address -> filename (from line programs)
-            'address_to_file': {},
-            # address -> line number (from line programs)
-            'address_to_line': {},
+            # address -> filename (from line programs, a LineTable)
+            'address_to_file': line_table,
+            # address -> line number (from line programs, a LineTable view)
+            'address_to_line': line_table.lines,
             # (symbol_name, address) -> filename
             'symbol_to_file': {},
             'address_to_cu_file': {},       # address -> cu_filename
@@ -125,33 +218,35 @@ class DWARFProcessor:  # pylint: disable=too-many-instance-attributes,too-few-pu
         try:
             dwarfinfo = self.elffile.get_dwarf_info()
 
-            # Build CU address range index
-            cu_address_index = self._build_cu_address_index(dwarfinfo)
-            logger.debug(
-                "Built CU index with %d compilation units",
-                len(cu_address_index))
-
-            # Only process CUs that contain relevant addresses for performance optimization
-            # This avoids processing all CUs when we only need specific symbols
-            relevant_cus = self._find_relevant_cus(cu_address_index)
+            with stage('dwarf_cu_index'):
+                # Build CU address range index
+                cu_address_index = self._build_cu_address_index(dwarfinfo)
+                logger.debug(
+                    "Built CU index with %d compilation units",
+                    len(cu_address_index))
+
+                # Only process CUs that contain relevant addresses for performance
+                # optimization. This avoids processing all CUs when we only need
+                # specific symbols
+                relevant_cus = self._find_relevant_cus(cu_address_index, dwarfinfo)
+                self._cu_index = cu_address_index
             logger.debug(
                 "Found %d relevant CUs out of %d total",
                 len(relevant_cus), len(cu_address_index))
+            count('dwarf_cus_processed', len(relevant_cus))
+            count('dwarf_cus_skipped', len(cu_address_index) - len(relevant_cus))
 
-            for cu in relevant_cus:
-                try:
-                    self._process_cu(cu, dwarfinfo)
-                    # Early termination disabled for correctness - other
-                    # optimizations provide sufficient speedup
-                    # if len(self.found_symbols) >= min(self.target_symbol_count * 2, 1000):
-                    #     logger.debug("Early termination: found %d symbols (target: %d)",
-                    #                  len(self.found_symbols), self.target_symbol_count)
-                    #     break
-                except Exception as e:
-                    logger.error(
-                        "Failed to process CU at offset %d: %s", cu.cu_offset, e)
-                    raise DWARFCUProcessingError(
-                        f"Failed to process CU at offset {cu.cu_offset}: {e}") from e
+            workers = self._worker_count(len(relevant_cus))
+            if not (workers > 1 and self._process_cus_parallel(relevant_cus, workers)):
+                for cu in relevant_cus:
+                    self.process_cu_guarded(cu, dwarfinfo)
+            self.build_line_table()
+
+            if self.cache is not None:
+                logger.debug("DWARF cache: %d CU hits, %d misses",
+                             self.cache_hits, self.cache_misses)
+                count('dwarf_cache_hits', self.cache_hits)
+                count('dwarf_cache_misses', self.cache_misses)
 
         except (IOError, OSError) as e:
             logger.error("Failed to read ELF file for DWARF parsing: %s", e)
@@ -167,6 +262,136 @@ class DWARFProcessor:  # pylint: disable=too-many-instance-attributes,too-few-pu
 
         return self.dwarf_data
 
+    def decode_line_programs(self, addresses: Iterable[int]) -> int:
+        """Decode the line programs of the CUs covering ``addresses``.
+
+        Second pass of ``lazy_line_program``: once the DIE pass has run,
+        only symbols it could not attribute need line program rows, so
+        only the CUs whose address ranges contain them (and CUs without
+        ranges) are decoded. The rows are added to ``dwarf_data``.
+
+        Args:
+            addresses: Symbol addresses still lacking a source file
+
+        Returns:
+            Number of CUs whose line program was decoded
+        """
+        addresses = set(addresses)
+        if not self.lazy_line_program or not addresses or self._cu_index is None:
+            return 0
+        dwarfinfo = self.elffile.get_dwarf_info()
+        cus = self._cu_index.relevant_cus(addresses)
+        logger.debug("Decoding line programs of %d CUs for %d unresolved symbols",
+                     len(cus), len(addresses))
+
+        self._line_rows.extend(self.dwarf_data['address_to_file'])
+        rows_before = len(self._line_rows)
+        with stage('line_programs'):
+            for cu in cus:
+                self._extract_line_program_data(cu, dwarfinfo)
+        count('line_program_rows', len(self._line_rows) - rows_before)
+        count('dwarf_lazy_line_program_cus', len(cus))
+        self.build_line_table()
+        if 'coverage_metrics' in self.dwarf_data:
+            self.dwarf_data['coverage_metrics']['line_program_skipped'] = False
+        return len(cus)
+
+    def process_cu_guarded(self, cu, dwarfinfo) -> None:
+        """Process one CU, wrapping any failure in DWARFCUProcessingError."""
+        try:
+            self._process_cu(cu, dwarfinfo)
+        except Exception as e:
+            logger.error(
+                "Failed to process CU at offset %d: %s", cu.cu_offset, e)
+            raise DWARFCUProcessingError(
+                f"Failed to process CU at offset {cu.cu_offset}: {e}") from e
+
+    def build_line_table(self) -> None:
+        """Sort the collected line program rows into ``dwarf_data``."""
+        table = self._line_rows.build()
+        self._line_rows = LineTableBuilder()
+        self.dwarf_data['address_to_file'] = table
+        self.dwarf_data['address_to_line'] = table.lines
+        if 'coverage_metrics' in self.dwarf_data:
+            self.dwarf_data['coverage_metrics']['line_program_addresses'] = len(table)
+
+    def track_defaulted_keys(self) -> None:
+        """Record keys written with setdefault semantics (used by workers)."""
+        self.defaulted_keys = {table: set() for table in _DEFAULTED_TABLES}
+
+    def _worker_count(self, cu_count: int) -> int:
+        """Number of worker processes worth starting for ``cu_count`` CUs."""
+        if self.jobs <= 1 or not self.elf_path:
+            return 1
+        return max(1, min(self.jobs, cu_count // MIN_CUS_PER_WORKER))
+
+    def _process_cus_parallel(self, relevant_cus: List[Any], workers: int) -> bool:
+        """Process CUs across worker processes and merge their results.
+
+        CUs are split into contiguous chunks in serial processing order and
+        merged back chunk by chunk, so the result is identical to a serial
+        run regardless of which worker finishes first.
+
+        Returns:
+            True on success, False if a process pool could not be used (the
+            caller then falls back to serial processing).
+
+        Raises:
+            DWARFCUProcessingError: If a worker fails to process a CU
+        """
+        offsets = [cu.cu_offset for cu in relevant_cus]
+        chunk_size = -(-len(offsets) // workers)
+        chunks = [offsets[i:i + chunk_size]
+                  for i in range(0, len(offsets), chunk_size)]
+        logger.debug(
+            "Processing %d CUs in %d worker processes", len(offsets), len(chunks))
+
+        try:
+            with ProcessPoolExecutor(max_workers=len(chunks)) as pool:
+                futures = [
+                    pool.submit(_process_cu_chunk, self.elf_path, chunk,
+                                self.symbol_addresses, self.skip_line_program,
+                                self.machine, self.cache_dir, self.fast_die_scan,
+                                active_recorder() is not None)
+                    for chunk in chunks]
+                partials = [future.result() for future in futures]
+        except (OSError, NotImplementedError, BrokenProcessPool) as e:
+            logger.warning(
+                "Parallel DWARF processing unavailable (%s), "
+                "falling back to serial", e)
+            return False
+
+        for partial in partials:
+            self._merge_partial(partial)
+
+        self.dwarf_data['coverage_metrics'] = {
+            'die_symbols': len(self.dwarf_data['symbol_to_file']),
+            'line_program_addresses': len(self._line_rows),
+            'cus_processed': len(self.dwarf_data['processed_cus']),
+            'line_program_skipped': self.skip_line_program
+        }
+        return True
+
+    def _merge_partial(self, partial: Dict[str, Any]) -> None:
+        """Merge one worker's ``dwarf_data`` into ours, in chunk order."""
+        data = self.dwarf_data
+        self._line_rows.extend(partial['address_to_file'])
+        data['static_symbol_mappings'].extend(partial['static_symbol_mappings'])
+        data['processed_cus'].update(partial['processed_cus'])
+        self.found_symbols.update(partial['found_symbols'])
+        self.cache_hits += partial['cache_hits']
+        self.cache_misses += partial['cache_misses']
+        merge_recording(partial['profile'])
+
+        for table in _DEFAULTED_TABLES:
+            merged = data[table]
+            defaulted = partial['defaulted_keys'][table]
+            for key, value in partial[table].items():
+                if key in defaulted:
+                    merged.setdefault(key, value)
+                else:
+                    merged[key] = value
+
     def _is_address_in_symbol_set_with_tolerance(
             self, die_address: int) -> bool:
         """Check if die_address is in symbol set or within tolerance using binary search.
@@ -252,72 +477,82 @@ class DWARFProcessor:  # pylint: disable=too-many-instance-attributes,too-few-pu
             raise DWARFAttributeError(
                 f"Failed to extract address range from CU: {e}") from e
 
-    def _build_cu_address_index(self, dwarfinfo) -> List[Tuple[int, int, Any]]:
+    def _build_cu_address_index(self, dwarfinfo) -> CUAddressIndex:
         """Build an index of compilation unit address ranges for fast lookup.
 
+        Ranges come from ``.debug_aranges`` where available, so most CUs are
+        indexed without parsing their top DIE. Other CUs use their
+        ``DW_AT_low_pc`` / ``DW_AT_high_pc`` pair or, for CUs with
+        discontiguous code (``-ffunction-sections``, LTO ``<artificial>``
+        units), every entry of their ``DW_AT_ranges`` list.
+
         Args:
             dwarfinfo: DWARF debug information object
 
         Returns:
-            Sorted list of (low_pc, high_pc, cu) tuples for binary search
+            Interval index over all CUs
         """
-        cu_index = []
-
+        aranges = read_aranges(dwarfinfo)
+        cu_ranges = []
         for cu in dwarfinfo.iter_CUs():
-            low_pc, high_pc = self._extract_cu_address_range(cu)
-            cu_index.append((low_pc, high_pc, cu))
-
-        cu_index.sort(key=lambda x: x[0])
-        return cu_index
-
-    def _find_relevant_cus(
-            self, cu_index: List[Tuple[int, int, Any]]) -> List[Any]:
+            ranges = aranges.get(cu.cu_offset)
+            if ranges is None:
+                ranges = self._cu_ranges_from_die(cu, dwarfinfo)
+            cu_ranges.append((cu, ranges))
+
+        index = CUAddressIndex(cu_ranges)
+        logger.debug(
+            "CU index: %d CUs with ranges from .debug_aranges, %d without ranges",
+            sum(1 for cu, _ in cu_ranges if cu.cu_offset in aranges),
+            index.rangeless_count)
+        return index
+
+    def _cu_ranges_from_die(self, cu, dwarfinfo) -> List[Tuple[int, int]]:
+        """Address ranges of a CU from its top DIE (empty if unknown)."""
+        low_pc, high_pc = self._extract_cu_address_range(cu)
+        if (low_pc, high_pc) != (0, MAX_ADDRESS):
+            return [(low_pc, high_pc)]
+        ranges = read_die_ranges(
+            dwarfinfo, cu, cu.get_top_DIE(),
+            self._section_bytes(dwarfinfo, 'debug_rnglists_sec'))
+        return ranges or []
+
+    def _find_relevant_cus(self, cu_index: CUAddressIndex, dwarfinfo) -> List[Any]:
         """Find compilation units that contain any of our target symbol addresses.
 
         This optimization is crucial for performance - we only process CUs that
         contain symbols we actually need to map, avoiding unnecessary processing
-        of unrelated compilation units.
-
-        Uses binary search for O(log n) lookups when CUs have specific ranges,
-        falls back to processing all CUs when most have full ranges.
+        of unrelated compilation units. CU ranges only describe code, so they
+        are matched against function addresses. CUs that may define a variable
+        are included as long as there are data symbols: their code may have
+        been garbage-collected while their data was kept. CUs without known
+        ranges can contain any symbol and are always included.
 
         Args:
-            cu_index: Sorted list of CU address ranges
+            cu_index: Interval index of CU address ranges
+            dwarfinfo: DWARF debug information object
 
         Returns:
-            List of CUs that contain at least one target symbol address
+            List of CUs that may contain at least one target symbol address
         """
-
-        # Check if any CUs have full address range (no specific ranges)
-        # Full-range CUs can contain any symbol, so binary search optimization
-        # doesn't work reliably when they exist (e.g., C++ <artificial> CUs)
-        has_full_range = any(
-            start == 0 and end == MAX_ADDRESS
-            for start, end, _ in cu_index
-        )
-
-        if has_full_range:
-            logger.debug("Found full-range CUs, processing all %d CUs", len(cu_index))
-            return [cu for _, _, cu in cu_index]
-
-        # Use binary search optimization only when all CUs have specific ranges
-        logger.debug("Using binary search optimization for %d CUs", len(cu_index))
-
-        relevant_cus = []
-        relevant_cu_set = set()
-        start_addresses = [start for start, _, _ in cu_index]
-
-        for symbol_addr in self.symbol_addresses:
-            pos = bisect.bisect_right(start_addresses, symbol_addr) - 1
-            if pos >= 0:
-                start_addr, end_addr, cu = cu_index[pos]
-                if start_addr <= symbol_addr <= end_addr and cu not in relevant_cu_set:
-                    relevant_cus.append(cu)
-                    relevant_cu_set.add(cu)
-
+        include = ((lambda cu: self._defines_variables(cu, dwarfinfo))
+                   if self._has_data_symbols else None)
+        relevant_cus = cu_index.relevant_cus(self.function_addresses, include)
+        if cu_index.rangeless_count:
+            logger.debug("Including %d CUs without address ranges",
+                         cu_index.rangeless_count)
         return relevant_cus
 
-    def _process_cu(self, cu, dwarfinfo):  # pylint: disable=too-many-locals
+    def _defines_variables(self, cu, dwarfinfo) -> bool:
+        """Whether the CU's abbreviations allow a variable with a location."""
+        offset = cu['debug_abbrev_offset']
+        defines = self._variable_abbrevs.get(offset)
+        if defines is None:
+            defines = self._variable_abbrevs[offset] = declares_located_variable(
+                self._section_bytes(dwarfinfo, 'debug_abbrev_sec'), offset)
+        return defines
+
+    def _process_cu(self, cu, dwarfinfo):
         """Process a single compilation unit to extract source mappings.
 
         Args:
@@ -331,6 +566,36 @@ class DWARFProcessor:  # pylint: disable=too-many-instance-attributes,too-few-pu
 
         # Get CU address range using the shared extraction method
         cu_low_pc, cu_high_pc = self._extract_cu_address_range(cu)
+
+        cache_key = self._cu_cache_key(cu, dwarfinfo) if self.cache else None
+        if cache_key is not None:
+            if self._replay_cached_cu(cache_key, dwarfinfo):
+                self._update_coverage_metrics()
+                return
+            self._recording = {
+                'cu_start': cu_offset,
+                'cu_end': cu_offset + cu.size,
+                'cacheable': True,
+                'strings': [],
+                'lines': [],
+                'dies': [],
+            }
+
+        try:
+            self._decode_cu(cu, dwarfinfo, cu_low_pc, cu_high_pc)
+            if cache_key is not None and self._recording['cacheable']:
+                self.cache.put(cache_key, {
+                    'strings': self._recording['strings'],
+                    'lines': self._recording['lines'],
+                    'dies': self._recording['dies'],
+                })
+        finally:
+            self._recording = None
+
+        self._update_coverage_metrics()
+
+    def _decode_cu(self, cu, dwarfinfo, cu_low_pc, cu_high_pc) -> None:
+        """Decode a CU's line program and DIE tree into ``dwarf_data``."""
         top_die = cu.get_top_DIE()
 
         # Get CU basic info
@@ -341,10 +606,12 @@ class DWARFProcessor:  # pylint: disable=too-many-instance-attributes,too-few-pu
         if top_die.attributes:
             name_attr = top_die.attributes.get('DW_AT_name')
             if name_attr:
+                self._note_string_attr(name_attr, top_die)
                 cu_name = self._extract_string_value(name_attr.value)
 
             comp_dir_attr = top_die.attributes.get('DW_AT_comp_dir')
             if comp_dir_attr:
+                self._note_string_attr(comp_dir_attr, top_die)
                 comp_dir = self._extract_string_value(comp_dir_attr.value)
 
         if cu_name:
@@ -364,13 +631,20 @@ class DWARFProcessor:  # pylint: disable=too-many-instance-attributes,too-few-pu
         # Skip line program processing if requested (20-30% performance
         # improvement)
         if not self.skip_line_program:
-            self._extract_line_program_data(cu, dwarfinfo)
-
-        self._extract_die_symbol_data_optimized(
-            cu, dwarfinfo, cu_source_file, cu_low_pc, cu_high_pc)
-
-        # Track coverage after line program processing
-        total_addresses = len(self.dwarf_data['address_to_file'])
+            rows_before = len(self._line_rows)
+            with stage('line_programs'):
+                self._extract_line_program_data(cu, dwarfinfo)
+            count('line_program_rows', len(self._line_rows) - rows_before)
+
+        with stage('die_walk'):
+            self._extract_die_symbol_data_optimized(
+                cu, dwarfinfo, cu_source_file, cu_low_pc, cu_high_pc)
+
+    def _update_coverage_metrics(self) -> None:
+        """Refresh coverage metrics after a CU has been processed."""
+        # Track coverage after line program processing (rows so far; replaced
+        # by the de-duplicated address count in build_line_table)
+        total_addresses = len(self._line_rows)
         die_coverage_after = len(self.dwarf_data['symbol_to_file'])
         line_program_addresses = total_addresses
 
@@ -387,6 +661,135 @@ class DWARFProcessor:  # pylint: disable=too-many-instance-attributes,too-few-pu
         self.dwarf_data['coverage_metrics']['line_program_addresses'] = line_program_addresses
         self.dwarf_data['coverage_metrics']['cus_processed'] += 1
 
+    def _section_bytes(self, dwarfinfo, attr_name: str) -> bytes:
+        """Return (and memoize) the decompressed bytes of a DWARF section."""
+        if attr_name not in self._section_bytes_cache:
+            desc = getattr(dwarfinfo, attr_name, None)
+            data = b''
+            if desc is not None:
+                stream = desc.stream
+                if hasattr(stream, 'getvalue'):
+                    data = stream.getvalue()
+                else:
+                    position = stream.tell()
+                    stream.seek(0)
+                    data = stream.read(desc.size)
+                    stream.seek(position)
+            self._section_bytes_cache[attr_name] = data
+        return self._section_bytes_cache[attr_name]
+
+    def _abbrev_table_end(self, dwarfinfo, abbrev_offset: int) -> int:
+        """End offset of the abbreviation table starting at ``abbrev_offset``.
+
+        Tables are bounded by the next table start used by any CU (or the
+        section end); computed once per ELF from the CU headers.
+        """
+        if self._abbrev_ends is None:
+            starts = sorted({cu['debug_abbrev_offset']
+                             for cu in dwarfinfo.iter_CUs()})
+            section_end = len(self._section_bytes(dwarfinfo, 'debug_abbrev_sec'))
+            self._abbrev_ends = dict(zip(starts, starts[1:] + [section_end]))
+        return self._abbrev_ends.get(
+            abbrev_offset,
+            len(self._section_bytes(dwarfinfo, 'debug_abbrev_sec')))
+
+    def _cu_cache_key(self, cu, dwarfinfo) -> Optional[str]:
+        """Content hash of everything a CU's cached output depends on.
+
+        Covers the CU's ``.debug_info`` bytes, its abbreviation table and its
+        ``.debug_line`` program. Strings referenced through ``.debug_str`` /
+        ``.debug_line_str`` offsets are verified against the recorded values
+        on each hit instead (see :meth:`_replay_cached_cu`). DWARF 5 line
+        program headers name their directories and files via
+        ``.debug_line_str``; the names this CU's header resolves to are
+        hashed rather than the whole section, so a file added elsewhere in
+        the image leaves the key unchanged.
+
+        Returns:
+            Cache key, or None if the CU cannot be keyed
+        """
+        try:
+            info = self._section_bytes(dwarfinfo, 'debug_info_sec')
+            abbrev = self._section_bytes(dwarfinfo, 'debug_abbrev_sec')
+            abbrev_offset = cu['debug_abbrev_offset']
+            parts = [
+                DWARF_CACHE_VERSION,
+                b'1' if self.skip_line_program else b'0',
+                b'le' if dwarfinfo.config.little_endian else b'be',
+                info[cu.cu_offset:cu.cu_offset + cu.size],
+                abbrev[abbrev_offset:self._abbrev_table_end(dwarfinfo, abbrev_offset)],
+            ]
+            line_program = dwarfinfo.line_program_for_CU(cu)
+            if line_program is not None:
+                stmt_list = cu.get_top_DIE().attributes['DW_AT_stmt_list'].value
+                line = self._section_bytes(dwarfinfo, 'debug_line_sec')
+                parts.append(line[stmt_list:line_program.program_end_offset])
+                if line_program['version'] >= 5:
+                    parts.append(_line_header_strings(line_program.header))
+            return ContentCache.make_key(*parts)
+        except (KeyError, AttributeError, TypeError, ValueError) as e:
+            logger.debug("CU at offset %d not cacheable: %s", cu.cu_offset, e)
+            return None
+
+    def _replay_cached_cu(self, cache_key: str, dwarfinfo) -> bool:
+        """Apply a cached CU record to ``dwarf_data``.
+
+        Returns:
+            True if a valid entry was found and applied
+        """
+        entry = self.cache.get(cache_key)
+        if entry is None:
+            self.cache_misses += 1
+            return False
+
+        # A string table change at an unchanged offset leaves the CU bytes
+        # identical; re-check every string the record depends on.
+        for section_attr, offset, text in entry['strings']:
+            expected = text.encode('latin-1') + b'\0'
+            data = self._section_bytes(dwarfinfo, section_attr)
+            if data[offset:offset + len(expected)] != expected:
+                self.cache_misses += 1
+                return False
+        self.cache_hits += 1
+
+        for address, filename, line_number in entry['lines']:
+            self._line_rows.add(address, filename, line_number)
+
+        for die_name, die_address, cu_source_file, best_source_file in entry['dies']:
+            if die_address and not self._is_address_in_symbol_set_with_tolerance(
+                    die_address):
+                continue
+            self._store_die_mapping(
+                die_name, die_address, cu_source_file, best_source_file)
+        return True
+
+    def _note_referenced_die(self, die) -> None:
+        """Mark the recorded CU uncacheable if ``die`` lives in another CU."""
+        recording = self._recording
+        if recording is not None and not (
+                recording['cu_start'] <= die.offset < recording['cu_end']):
+            recording['cacheable'] = False
+
+    def _note_string_attr(self, attr, owner_die) -> None:
+        """Record where a string attribute's value came from.
+
+        Inline strings are covered by the CU bytes in the cache key; string
+        table references are recorded and re-verified on every cache hit.
+        Other forms (e.g. DWARF 5 ``strx``) make the CU uncacheable.
+        """
+        recording = self._recording
+        if recording is None:
+            return
+        self._note_referenced_die(owner_die)
+        if attr.form == 'DW_FORM_string':
+            return
+        section_attr = _STRING_TABLE_FORMS.get(attr.form)
+        if section_attr is None or not isinstance(attr.value, bytes):
+            recording['cacheable'] = False
+            return
+        recording['strings'].append(
+            (section_attr, attr.raw_value, attr.value.decode('latin-1')))
+
     def _extract_string_value(self, value) -> Optional[str]:
         """Extract string value from DWARF attribute.
 
@@ -426,6 +829,7 @@ class DWARFProcessor:  # pylint: disable=too-many-instance-attributes,too-few-pu
         # Try direct name first
         name_attr = die.attributes.get('DW_AT_name')
         if name_attr and hasattr(name_attr, 'value'):
+            self._note_string_attr(name_attr, die)
             return self._extract_string_value(name_attr.value), None
 
         # Follow abstract_origin (C++ template instantiations, inlined functions)
@@ -434,8 +838,10 @@ class DWARFProcessor:  # pylint: disable=too-many-instance-attributes,too-few-pu
         if 'DW_AT_abstract_origin' in die.attributes:
             abstract_die = die.get_DIE_from_attribute('DW_AT_abstract_origin')
             if abstract_die and abstract_die.attributes:
+                self._note_referenced_die(abstract_die)
                 name_attr = abstract_die.attributes.get('DW_AT_name')
                 if name_attr and hasattr(name_attr, 'value'):
+                    self._note_string_attr(name_attr, abstract_die)
                     return self._extract_string_value(name_attr.value), abstract_die
                 ref_die = abstract_die
                 spec_die = abstract_die
@@ -444,8 +850,10 @@ class DWARFProcessor:  # pylint: disable=too-many-instance-attributes,too-few-pu
         if 'DW_AT_specification' in ref_die.attributes:
             spec_die = ref_die.get_DIE_from_attribute('DW_AT_specification')
             if spec_die and spec_die.attributes:
+                self._note_referenced_die(spec_die)
                 name_attr = spec_die.attributes.get('DW_AT_name')
                 if name_attr and hasattr(name_attr, 'value'):
+                    self._note_string_attr(name_attr, spec_die)
                     return self._extract_string_value(name_attr.value), spec_die
 
         return None, spec_die
@@ -568,10 +976,10 @@ class DWARFProcessor:  # pylint: disable=too-many-instance-attributes,too-few-pu
                                 filename = self._extract_string_value(
                                     file_entry.name)
                                 if filename:
-                                    # Store in dictionary
-                                    self.dwarf_data['address_to_file'][address] = filename
-                                    if line_number:
-                                        self.dwarf_data['address_to_line'][address] = line_number
+                                    self._line_rows.add(address, filename, line_number)
+                                    if self._recording is not None:
+                                        self._recording['lines'].append(
+                                            (address, filename, line_number))
 
                     except (IndexError, AttributeError) as e:
                         logger.error(
@@ -629,13 +1037,21 @@ class DWARFProcessor:  # pylint: disable=too-many-instance-attributes,too-few-pu
 
             # Process DIEs with early filtering
             top_die = cu.get_top_DIE()
-            self._process_die_tree(
-                top_die,
-                file_entries,
-                cu_source_file,
-                0,
-                cu_low_pc,
-                cu_high_pc)
+            offsets = self._scan_relevant_dies(cu, dwarfinfo, top_die)
+            if offsets is None:
+                self._process_die_tree(
+                    top_die,
+                    file_entries,
+                    cu_source_file,
+                    0,
+                    cu_low_pc,
+                    cu_high_pc)
+            else:
+                stream = dwarfinfo.debug_info_sec.stream
+                for offset in offsets:
+                    self._process_die_for_dictionaries_optimized(
+                        DIE(cu=cu, stream=stream, offset=offset),
+                        file_entries, cu_source_file, cu_low_pc, cu_high_pc)
 
         except Exception as e:
             logger.error(
@@ -644,6 +1060,53 @@ class DWARFProcessor:  # pylint: disable=too-many-instance-attributes,too-few-pu
             raise DWARFCUProcessingError(
                 f"Failed to extract DIE symbol data for CU at offset {cu.cu_offset}: {e}") from e
 
+    def _abbrev_lookup(self, cu):
+        """Return a code -> compiled abbreviation lookup for ``cu``."""
+        address_size = cu['address_size']
+        offset_size = 8 if cu.dwarf_format() == 64 else 4
+        version = cu['version']
+        key = (cu['debug_abbrev_offset'], address_size, offset_size, version)
+        compiled = self._compiled_abbrevs.setdefault(key, {})
+        table = cu.get_abbrev_table()
+
+        def get_abbrev(code):
+            abbrev = compiled.get(code)
+            if abbrev is None:
+                decl = table.get_abbrev(code)
+                abbrev = compiled[code] = compile_abbrev(
+                    decl['tag'], decl.has_children(), decl.iter_attr_specs(),
+                    address_size, offset_size, version)
+            return abbrev
+        return get_abbrev
+
+    def _scan_relevant_dies(self, cu, dwarfinfo, top_die) -> Optional[List[int]]:
+        """Offsets of the CU's relevant DIEs, in :meth:`_process_die_tree` order.
+
+        Uses the raw scanner, which skips type subtrees without decoding them.
+
+        Returns:
+            DIE offsets, or None when the fast scan is disabled or cannot
+            handle the CU (the caller then walks the tree with pyelftools)
+        """
+        if not self.fast_die_scan:
+            return None
+        language = top_die.attributes.get('DW_AT_language')
+        scanner = DIEScanner(
+            self._section_bytes(dwarfinfo, 'debug_info_sec'),
+            self._abbrev_lookup(cu),
+            little_endian=dwarfinfo.config.little_endian,
+            skip_c_aggregates=is_c_language(language.value if language else None))
+        try:
+            tree = scanner.scan(cu.cu_offset, top_die.offset, cu.cu_offset + cu.size)
+        except ScanError as e:
+            logger.debug("Fast DIE scan failed for CU at offset %d (%s), "
+                         "walking all DIEs", cu.cu_offset, e)
+            return None
+        offsets, visited = relevant_die_order(tree, top_die.offset)
+        count('dies_visited', visited)
+        count('dies_skipped', tree.skipped)
+        return offsets
+
     def _process_die_tree(self,  # pylint: disable=too-many-arguments,too-many-positional-arguments
                           die,
                           file_entries: Dict[int,
@@ -663,25 +1126,23 @@ class DWARFProcessor:  # pylint: disable=too-many-instance-attributes,too-few-pu
             cu_high_pc: CU ending address
         """
         stack = deque([die])
+        visited = 0
 
         while stack:
             current_die = stack.pop()
-
-            relevant_tags = {
-                'DW_TAG_subprogram',
-                'DW_TAG_variable',
-                'DW_TAG_formal_parameter',
-                'DW_TAG_inlined_subroutine'}
+            visited += 1
 
             for child_die in current_die.iter_children():
                 stack.append(child_die)
 
             if hasattr(current_die, 'tag') and current_die.tag:
-                if current_die.tag not in relevant_tags:
+                if current_die.tag not in RELEVANT_TAGS:
                     continue
                 self._process_die_for_dictionaries_optimized(
                     current_die, file_entries, cu_source_file, cu_low_pc, cu_high_pc)
 
+        count('dies_visited', visited)
+
     def _process_die_for_dictionaries_optimized(  # pylint: disable=too-many-branches,too-many-statements,too-many-nested-blocks,too-many-arguments,too-many-positional-arguments,too-many-locals
             self,
             die,
@@ -723,8 +1184,16 @@ class DWARFProcessor:  # pylint: disable=too-many-instance-attributes,too-few-pu
                 if location_attr and hasattr(location_attr, 'value'):
                     die_address = self._parse_location_expression(location_attr.value)
 
-            # Only process if this address is in our symbol table
-            if die_address and not self._is_address_in_symbol_set_with_tolerance(
+            # Only process if this address is in our symbol table. While
+            # recording for the cache every named DIE is kept, because the
+            # symbol table may differ when the record is replayed.
+            recording = self._recording
+            if recording is not None:
+                if low_pc_attr and ('addrx' in low_pc_attr.form
+                                    or 'addr_index' in low_pc_attr.form):
+                    # Resolved through .debug_addr, outside the CU bytes
+                    recording['cacheable'] = False
+            elif die_address and not self._is_address_in_symbol_set_with_tolerance(
                     die_address):
                 return
 
@@ -763,54 +1232,14 @@ class DWARFProcessor:  # pylint: disable=too-many-instance-attributes,too-few-pu
                 best_source_file = decl_file if decl_file else cu_source_file
 
             if best_source_file:
-                # Store symbol mappings
-                if die_address:
-                    # For symbols with addresses, store with exact address
-                    symbol_key = (die_name, die_address)
-                    self.dwarf_data['symbol_to_file'][symbol_key] = best_source_file
-                    self.dwarf_data['address_to_cu_file'][die_address] = best_source_file
-
-                    # For ARM architectures, also store with tolerance-adjusted addresses
-                    # ARM Thumb: LSB of function address indicates mode (0=ARM, 1=Thumb)
-                    # DIEs store actual instruction addresses, ELF symbols
-                    # include mode bit
-                    if self.address_tolerance > 0:
-                        symbol_to_file = self.dwarf_data['symbol_to_file']
-                        address_to_cu = self.dwarf_data['address_to_cu_file']
-                        for offset in range(-self.address_tolerance,
-                                            self.address_tolerance + 1):
-                            if offset != 0:  # Already stored exact address above
-                                adjusted_addr = die_address + offset
-                                adjusted_key = (die_name, adjusted_addr)
-                                # Use setdefault for single lookup instead of
-                                # check + set
-                                symbol_to_file.setdefault(
-                                    adjusted_key, best_source_file)
-                                address_to_cu.setdefault(
-                                    adjusted_addr, best_source_file)
-
-                    # Track found symbols for early termination after
-                    # successful mapping
-                    if die_address in self.symbol_addresses:
-                        self.found_symbols.add(die_address)
-                    # For ARM, also check tolerance-adjusted addresses
-                    elif self.address_tolerance > 0:
-                        for offset in range(-self.address_tolerance,
-                                            self.address_tolerance + 1):
-                            if die_address + offset in self.symbol_addresses:
-                                self.found_symbols.add(die_address + offset)
-                                break
-                else:
-                    # For symbols without DIE addresses (like static variables)
-                    # Store in our static symbol mappings list for special
-                    # handling
-                    self.dwarf_data['static_symbol_mappings'].append(
-                        (die_name, cu_source_file, best_source_file))
-
-                    # Also store with address 0 as fallback
-                    symbol_key = (die_name, 0)
-                    if symbol_key not in self.dwarf_data['symbol_to_file']:
-                        self.dwarf_data['symbol_to_file'][symbol_key] = best_source_file
+                if recording is not None:
+                    recording['dies'].append(
+                        (die_name, die_address, cu_source_file, best_source_file))
+                    if die_address and not self._is_address_in_symbol_set_with_tolerance(
+                            die_address):
+                        return
+                self._store_die_mapping(
+                    die_name, die_address, cu_source_file, best_source_file)
 
         except Exception as e:
             symbol_label = die_name if 'die_name' in locals() else 'unknown'
@@ -818,3 +1247,134 @@ class DWARFProcessor:  # pylint: disable=too-many-instance-attributes,too-few-pu
                 "Error processing DIE for symbol '%s': %s", symbol_label, e)
             raise DWARFAttributeError(
                 f"Error processing DIE for symbol: {e}") from e
+
+
+    def _store_die_mapping(self, die_name: str, die_address: Optional[int],
+                           cu_source_file: Optional[str],
+                           best_source_file: str) -> None:
+        """Write one resolved DIE mapping into ``dwarf_data``.
+
+        Args:
+            die_name: Symbol name from the DIE
+            die_address: DIE address (None/0 for DIEs without one)
+            cu_source_file: Source file of the owning compilation unit
+            best_source_file: Source file selected for the symbol
+        """
+        if die_address:
+            # For symbols with addresses, store with exact address
+            symbol_key = (die_name, die_address)
+            self.dwarf_data['symbol_to_file'][symbol_key] = best_source_file
+            self.dwarf_data['address_to_cu_file'][die_address] = best_source_file
+            defaulted = self.defaulted_keys
+            if defaulted is not None:
+                defaulted['symbol_to_file'].discard(symbol_key)
+                defaulted['address_to_cu_file'].discard(die_address)
+
+            # For ARM architectures, also store with tolerance-adjusted addresses
+            # ARM Thumb: LSB of function address indicates mode (0=ARM, 1=Thumb)
+            # DIEs store actual instruction addresses, ELF symbols
+            # include mode bit
+            if self.address_tolerance > 0:
+                symbol_to_file = self.dwarf_data['symbol_to_file']
+                address_to_cu = self.dwarf_data['address_to_cu_file']
+                for offset in range(-self.address_tolerance,
+                                    self.address_tolerance + 1):
+                    if offset != 0:  # Already stored exact address above
+                        adjusted_addr = die_address + offset
+                        adjusted_key = (die_name, adjusted_addr)
+                        if defaulted is not None:
+                            if adjusted_key not in symbol_to_file:
+                                defaulted['symbol_to_file'].add(adjusted_key)
+                            if adjusted_addr not in address_to_cu:
+                                defaulted['address_to_cu_file'].add(
+                                    adjusted_addr)
+                        # Use setdefault for single lookup instead of
+                        # check + set
+                        symbol_to_file.setdefault(
+                            adjusted_key, best_source_file)
+                        address_to_cu.setdefault(
+                            adjusted_addr, best_source_file)
+
+            # Track found symbols for early termination after
+            # successful mapping
+            if die_address in self.symbol_addresses:
+                self.found_symbols.add(die_address)
+            # For ARM, also check tolerance-adjusted addresses
+            elif self.address_tolerance > 0:
+                for offset in range(-self.address_tolerance,
+                                    self.address_tolerance + 1):
+                    if die_address + offset in self.symbol_addresses:
+                        self.found_symbols.add(die_address + offset)
+                        break
+        else:
+            # For symbols without DIE addresses (like static variables)
+            # Store in our static symbol mappings list for special
+            # handling
+            self.dwarf_data['static_symbol_mappings'].append(
+                (die_name, cu_source_file, best_source_file))
+
+            # Also store with address 0 as fallback
+            symbol_key = (die_name, 0)
+            if symbol_key not in self.dwarf_data['symbol_to_file']:
+                self.dwarf_data['symbol_to_file'][symbol_key] = best_source_file
+                if self.defaulted_keys is not None:
+                    self.defaulted_keys['symbol_to_file'].add(symbol_key)
+
+
+def _line_header_strings(header) -> bytes:
+    """Directory and file names of a (DWARF 5) line program header.
+
+    pyelftools resolves ``DW_FORM_line_strp`` names to their strings while
+    parsing the header, so these are the ``.debug_line_str`` contents the
+    CU's line rows and ``DW_AT_decl_file`` lookups depend on.
+    """
+    def encode(value) -> bytes:
+        if isinstance(value, bytes):
+            return value
+        return str(value).encode('utf-8')
+
+    names = [encode(directory) for directory in header.get('include_directory') or ()]
+    names.append(b'')  # Separates directories from files
+    for entry in header.get('file_entry') or ():
+        names.append(encode(entry.get('name', b'')))
+        names.append(str(entry.get('dir_index', 0)).encode('ascii'))
+    return b'\0'.join(names)
+
+
+def _process_cu_chunk(  # pylint: disable=too-many-arguments,too-many-positional-arguments
+        elf_path: str,
+        cu_offsets: List[int],
+        symbol_addresses: set,
+        skip_line_program: bool,
+        machine,
+        cache_dir: Optional[str] = None,
+        fast_die_scan: bool = True,
+        profile: bool = False) -> Dict[str, Any]:
+    """Worker entry point: process a contiguous chunk of CUs in its own process.
+
+    Each worker opens its own ELF handle (pyelftools objects cannot be shared
+    across processes) and returns the partial ``dwarf_data`` for its CUs plus
+    the set of keys that were only written with setdefault semantics, so the
+    parent can merge chunks with exactly the precedence of a serial run.
+    With ``profile``, the chunk's stages and counters are recorded and
+    returned too, for the parent's profile.
+    """
+    with recording() if profile else nullcontext() as recorder, \
+            open(elf_path, 'rb') as f:
+        processor = DWARFProcessor(
+            ELFFile(f), symbol_addresses,
+            skip_line_program=skip_line_program, machine=machine,
+            cache_dir=cache_dir, fast_die_scan=fast_die_scan)
+        processor.track_defaulted_keys()
+        dwarfinfo = processor.elffile.get_dwarf_info()
+        for offset in cu_offsets:
+            processor.process_cu_guarded(dwarfinfo.get_CU_at(offset), dwarfinfo)
+        processor.build_line_table()
+        result = processor.dwarf_data
+        result['profile'] = recorder.export() if recorder is not None else None
+        result.pop('coverage_metrics', None)
+        result['defaulted_keys'] = processor.defaulted_keys
+        result['found_symbols'] = processor.found_symbols
+        result['cache_hits'] = processor.cache_hits
+        result['cache_misses'] = processor.cache_misses
+        return result
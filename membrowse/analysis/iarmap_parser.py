@@ -6,7 +6,7 @@ Parses map files generated by the IAR ELF Linker (EWARM).
 """
 
 import re
-from typing import Dict, List, Tuple
+from typing import Dict, Iterable, Iterator, List, Tuple
 
 
 # Match IAR PLACEMENT SUMMARY contribution lines. Two layouts seen in the wild:
@@ -67,57 +67,45 @@ class IARMapFileParser:  # pylint: disable=too-few-public-methods
             ``start``. ``archive`` is the library name (e.g. "dl7M_tlf.a")
             or "" for object files from the project directory.
         """
-        group_to_library = self._parse_module_summary(content)
-        return self._parse_placement_summary(content, group_to_library)
+        ranges = list(self.iter_ranges(content.splitlines()))
+        ranges.sort(key=lambda r: r[0])
+        return ranges
 
-    def _parse_module_summary(self, content: str) -> Dict[str, str]:
-        """Extract group index -> library/path mapping from MODULE SUMMARY.
+    def iter_ranges(self, lines: Iterable[str]) -> Iterator[Tuple[int, int, str, str]]:
+        """Yield ``(start, end, archive, object_file)`` ranges in map order.
 
-        Returns:
-            Dict mapping group index string to library name.
-            Project directories (paths ending without .a) map to "".
+        Streaming form of :meth:`parse` reading both summaries in one pass.
+        The MODULE SUMMARY follows the PLACEMENT SUMMARY, so placements are
+        held until the library names are known, and reading stops once both
+        summaries have ended (the ENTRY LIST is not needed).
+
+        Args:
+            lines: Map file lines without line terminators.
         """
         group_map: Dict[str, str] = {}
-        in_module_summary = False
-
-        for line in content.splitlines():
-            if '*** MODULE SUMMARY' in line:
-                in_module_summary = True
+        placements: List[Tuple[int, int, str, str]] = []
+        seen_starts = set()
+        section = None
+        finished = set()
+
+        for line in lines:
+            if '*** PLACEMENT SUMMARY' in line or '*** MODULE SUMMARY' in line:
+                if section is not None:
+                    finished.add(section)
+                name = 'placement' if 'PLACEMENT' in line else 'module'
+                section = name if name not in finished else None
                 continue
-            if in_module_summary and line.startswith('*****'):
-                break
-
-            if not in_module_summary:
+            if section is None:
                 continue
-
-            match = _IAR_MODULE_GROUP_RE.match(line)
-            if match:
-                name = match.group(1).strip()
-                index = match.group(2)
-                # Library archives end with .a, project dirs don't
-                if name.endswith('.a'):
-                    group_map[index] = name
-                else:
-                    group_map[index] = ''
-
-        return group_map
-
-    def _parse_placement_summary(
-        self, content: str, group_to_library: Dict[str, str]
-    ) -> List[Tuple[int, int, str, str]]:
-        """Extract per-section contribution ranges from PLACEMENT SUMMARY."""
-        ranges: List[Tuple[int, int, str, str]] = []
-        seen_starts = set()
-        in_placement = False
-
-        for line in content.splitlines():
-            if '*** PLACEMENT SUMMARY' in line:
-                in_placement = True
+            if line.startswith('*****'):
+                finished.add(section)
+                section = None
+                if len(finished) == 2:
+                    break
                 continue
-            if in_placement and line.startswith('*****'):
-                break
 
-            if not in_placement:
+            if section == 'module':
+                self._add_module_group(line, group_map)
                 continue
 
             match = _IAR_PLACEMENT_RE.match(line)
@@ -133,11 +121,42 @@ class IARMapFileParser:  # pylint: disable=too-few-public-methods
             if address in seen_starts:
                 continue
             seen_starts.add(address)
+            placements.append((address, address + size, match.group(5), match.group(4)))
 
-            obj = match.group(4)
-            group_idx = match.group(5)
-            archive = group_to_library.get(group_idx, '')
-            ranges.append((address, address + size, archive, obj))
+        for address, end, group_idx, obj in placements:
+            yield (address, end, group_map.get(group_idx, ''), obj)
 
-        ranges.sort(key=lambda r: r[0])
-        return ranges
+    def _parse_module_summary(self, content: str) -> Dict[str, str]:
+        """Extract group index -> library/path mapping from MODULE SUMMARY.
+
+        Returns:
+            Dict mapping group index string to library name.
+            Project directories (paths ending without .a) map to "".
+        """
+        group_map: Dict[str, str] = {}
+        in_module_summary = False
+
+        for line in content.splitlines():
+            if '*** MODULE SUMMARY' in line:
+                in_module_summary = True
+                continue
+            if in_module_summary and line.startswith('*****'):
+                break
+
+            if in_module_summary:
+                self._add_module_group(line, group_map)
+
+        return group_map
+
+    @staticmethod
+    def _add_module_group(line: str, group_map: Dict[str, str]) -> None:
+        """Record the library of a MODULE SUMMARY group header line."""
+        match = _IAR_MODULE_GROUP_RE.match(line)
+        if match:
+            name = match.group(1).strip()
+            index = match.group(2)
+            # Library archives end with .a, project dirs don't
+            if name.endswith('.a'):
+                group_map[index] = name
+            else:
+                group_map[index] = ''
@@ -6,7 +6,7 @@ Parses map files generated via ``-Wl,-Map=output.map`` (GCC, Clang, Rust).
 """
 
 import re
-from typing import List, Tuple
+from typing import Iterable, Iterator, List, Optional, Tuple
 
 
 # Match input section contribution lines (indented):
@@ -40,6 +40,12 @@ _CONTINUATION_RE = re.compile(
 # CMake builds (especially on Windows hosts) emit objects with a .obj suffix.
 _ARCHIVE_RE = re.compile(r'^(.+\.a)\((.+\.(?:o|obj))\)$')
 
+# Top-level map headings whose blocks never carry attributable input
+# sections. Discarded sections all sit at address 0, and the ``--cref``
+# table is always the last block and often larger than the memory map.
+_DISCARDED_HEADING = 'Discarded input sections'
+_CREF_HEADING = 'Cross Reference Table'
+
 
 class MapFileParser:  # pylint: disable=too-few-public-methods
     """Parse GNU LD map file content to extract address-to-object mappings."""
@@ -71,30 +77,45 @@ class MapFileParser:  # pylint: disable=too-few-public-methods
             ``start``. ``archive`` is "" for bare .o files. Zero-size and
             zero-address entries are skipped.
         """
-        ranges: List[Tuple[int, int, str, str]] = []
+        ranges = list(self.iter_ranges(content.splitlines()))
+        ranges.sort(key=lambda r: r[0])
+        return ranges
+
+    def iter_ranges(self, lines: Iterable[str]) -> Iterator[Tuple[int, int, str, str]]:
+        """Yield ``(start, end, archive, object_file)`` ranges in map order.
+
+        Streaming form of :meth:`parse` for callers that read the map line
+        by line. The discarded input sections are skipped and reading stops
+        at the cross reference table.
+
+        Args:
+            lines: Map file lines without line terminators.
+        """
         seen_starts = set()
         pending_section = None
+        skipping = False
+
+        for line in lines:
+            if line[:1] not in ('', ' ', '\t'):
+                # Unindented lines are headings, output sections or
+                # LOAD/OUTPUT commands; none of them is an input section.
+                if line.startswith(_CREF_HEADING):
+                    return
+                skipping = line.startswith(_DISCARDED_HEADING)
+                pending_section = None
+                continue
+            if skipping:
+                continue
 
-        def emit(address: int, size: int, file_field: str) -> None:
-            if address == 0 or size == 0:
-                return
-            if address in seen_starts:
-                # First occurrence wins (GNU LD lists in link order).
-                return
-            archive, obj = self._parse_file_field(file_field.strip())
-            if not obj:
-                return
-            seen_starts.add(address)
-            ranges.append((address, address + size, archive, obj))
-
-        for line in content.splitlines():
             # Try single-line format first (section + address + size + file)
             match = _SECTION_CONTRIB_RE.match(line)
             if match:
                 pending_section = None
-                emit(int(match.group(2), 16),
-                     int(match.group(3), 16),
-                     match.group(4))
+                entry = self._entry(int(match.group(2), 16),
+                                    int(match.group(3), 16),
+                                    match.group(4), seen_starts)
+                if entry:
+                    yield entry
                 continue
 
             # Check for continuation line (address + size + file) for an
@@ -103,9 +124,11 @@ class MapFileParser:  # pylint: disable=too-few-public-methods
                 cont_match = _CONTINUATION_RE.match(line)
                 if cont_match:
                     pending_section = None
-                    emit(int(cont_match.group(1), 16),
-                         int(cont_match.group(2), 16),
-                         cont_match.group(3))
+                    entry = self._entry(int(cont_match.group(1), 16),
+                                        int(cont_match.group(2), 16),
+                                        cont_match.group(3), seen_starts)
+                    if entry:
+                        yield entry
                     continue
                 # Line didn't continue the pending section. Fall through so
                 # the current line still gets a chance to be recognized as
@@ -118,8 +141,19 @@ class MapFileParser:  # pylint: disable=too-few-public-methods
                 pending_section = name_match.group(1)
                 continue
 
-        ranges.sort(key=lambda r: r[0])
-        return ranges
+    def _entry(self, address: int, size: int, file_field: str,
+               seen_starts: set) -> Optional[Tuple[int, int, str, str]]:
+        """Range for one contribution, or None if it is skipped."""
+        if address == 0 or size == 0:
+            return None
+        if address in seen_starts:
+            # First occurrence wins (GNU LD lists in link order).
+            return None
+        archive, obj = self._parse_file_field(file_field.strip())
+        if not obj:
+            return None
+        seen_starts.add(address)
+        return (address, address + size, archive, obj)
 
     @staticmethod
     def _parse_file_field(field: str) -> Tuple[str, str]:
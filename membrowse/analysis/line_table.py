@@ -0,0 +1,274 @@
+#!/usr/bin/env python3
+"""
+Compact address-ordered table of DWARF line program rows.
+
+A line program emits one row per instruction boundary, so storing each row
+as a dict entry costs well over 100 bytes per address on large firmware.
+:class:`LineTable` keeps the rows as parallel ``array`` columns sorted by
+address, with file names interned, so both exact and nearest-address lookups
+are a bisect over a few bytes per row.
+"""
+
+import bisect
+import heapq
+from array import array
+from collections.abc import Mapping
+from typing import Dict, Iterator, List, Optional, Sequence, Tuple
+
+_UINT32_LIMIT = 1 << 32
+
+
+class LineTable(Mapping):
+    """Read-only ``address -> filename`` mapping over sorted line rows.
+
+    Line numbers are exposed through :attr:`lines` as a separate
+    ``address -> line`` mapping that, like the dict it replaces, omits rows
+    without a line number.
+    """
+
+    __slots__ = ('_addresses', '_file_ids', '_line_numbers', '_files',
+                 '_line_count', '_lines_view')
+
+    def __init__(self, addresses: Optional[array] = None,
+                 file_ids: Optional[array] = None,
+                 line_numbers: Optional[array] = None,
+                 files: Optional[List[str]] = None):
+        """
+        Args:
+            addresses: Strictly increasing row addresses
+            file_ids: Index into ``files`` for each row
+            line_numbers: Line number for each row (0 when unknown)
+            files: Interned file names
+        """
+        self._addresses = addresses if addresses is not None else array('I')
+        self._file_ids = file_ids if file_ids is not None else array('I')
+        self._line_numbers = line_numbers if line_numbers is not None else array('I')
+        self._files = files if files is not None else []
+        self._line_count = len(self._line_numbers) - self._line_numbers.count(0)
+        self._lines_view = None
+
+    @classmethod
+    def from_mappings(cls, address_to_file: Mapping,
+                      address_to_line: Optional[Mapping] = None) -> 'LineTable':
+        """Build a table from plain ``address -> file`` / ``address -> line`` dicts."""
+        builder = LineTableBuilder()
+        address_to_line = address_to_line or {}
+        for address, filename in address_to_file.items():
+            builder.add(address, filename, address_to_line.get(address, 0))
+        return builder.build()
+
+    def _index(self, address: int) -> int:
+        """Row index of ``address``, or -1 if it has no row."""
+        idx = bisect.bisect_left(self._addresses, address)
+        if idx < len(self._addresses) and self._addresses[idx] == address:
+            return idx
+        return -1
+
+    def __getitem__(self, address: int) -> str:
+        idx = self._index(address)
+        if idx < 0:
+            raise KeyError(address)
+        return self._files[self._file_ids[idx]]
+
+    def __contains__(self, address) -> bool:
+        return isinstance(address, int) and self._index(address) >= 0
+
+    def __iter__(self) -> Iterator[int]:
+        return iter(self._addresses)
+
+    def __len__(self) -> int:
+        return len(self._addresses)
+
+    def get(self, address, default=None):
+        """Return the file for ``address``, or ``default`` if it has no row."""
+        idx = self._index(address) if isinstance(address, int) else -1
+        return self._files[self._file_ids[idx]] if idx >= 0 else default
+
+    @property
+    def line_count(self) -> int:
+        """Number of rows that carry a line number."""
+        return self._line_count
+
+    @property
+    def lines(self) -> 'LineNumbers':
+        """``address -> line number`` view sharing this table's storage."""
+        if self._lines_view is None:
+            self._lines_view = LineNumbers(self)
+        return self._lines_view
+
+    def line_at(self, address: int) -> int:
+        """Line number recorded for ``address``, or 0."""
+        idx = self._index(address)
+        return self._line_numbers[idx] if idx >= 0 else 0
+
+    def rows(self) -> Iterator[Tuple[int, str, int]]:
+        """Iterate ``(address, filename, line)`` rows in address order."""
+        files = self._files
+        for address, file_id, line in zip(
+                self._addresses, self._file_ids, self._line_numbers):
+            yield address, files[file_id], line
+
+    def row(self, idx: int) -> Tuple[int, str, int]:
+        """``(address, filename, line)`` of the row at index ``idx``."""
+        return (self._addresses[idx], self._files[self._file_ids[idx]],
+                self._line_numbers[idx])
+
+    def nearest(self, address: int, max_distance: int) -> Optional[int]:
+        """Return the row address closest to ``address`` within ``max_distance``.
+
+        On a tie the lower address wins.
+        """
+        idx = self._nearest_index(
+            bisect.bisect_left(self._addresses, address), address, max_distance)
+        return self._addresses[idx] if idx >= 0 else None
+
+    def sweep(self, addresses: Sequence[int],
+              max_distance: int) -> Iterator[Tuple[int, int]]:
+        """Row indices for ascending ``addresses``, in one forward pass.
+
+        Yields ``(exact, near)`` for each address: the index of its own row
+        and of the row :meth:`nearest` returns, each -1 if there is none.
+        The search window only moves forward, so each step bisects the
+        rows between the previous address and this one.
+        """
+        rows = self._addresses
+        idx = 0
+        for address in addresses:
+            idx = bisect.bisect_left(rows, address, idx)
+            exact = idx if idx < len(rows) and rows[idx] == address else -1
+            yield exact, self._nearest_index(idx, address, max_distance)
+
+    def _nearest_index(self, idx: int, address: int, max_distance: int) -> int:
+        """Index of the nearest row given ``idx = bisect_left(address)``, or -1."""
+        addresses = self._addresses
+        best = -1
+        # Check the row before first so it wins ties
+        if idx > 0 and address - addresses[idx - 1] <= max_distance:
+            best = idx - 1
+        if idx < len(addresses):
+            distance = addresses[idx] - address
+            if distance <= max_distance and (best < 0 or distance < address - addresses[best]):
+                best = idx
+        return best
+
+
+class LineNumbers(Mapping):
+    """``address -> line`` view of a :class:`LineTable` (rows with a line only)."""
+
+    __slots__ = ('_table',)
+
+    def __init__(self, table: LineTable):
+        self._table = table
+
+    def __getitem__(self, address: int) -> int:
+        line = self._table.line_at(address) if isinstance(address, int) else 0
+        if not line:
+            raise KeyError(address)
+        return line
+
+    def __iter__(self) -> Iterator[int]:
+        for address, _, line in self._table.rows():
+            if line:
+                yield address
+
+    def __len__(self) -> int:
+        return self._table.line_count
+
+
+class LineTableBuilder:
+    """Accumulates line rows in arrival order and builds a :class:`LineTable`.
+
+    Later rows for an address override earlier ones, except that a row without
+    a line number keeps the previously recorded line, matching the dict
+    semantics the table replaces.
+    """
+
+    def __init__(self):
+        self._addresses = array('Q')
+        self._file_ids = array('I')
+        self._line_numbers = array('I')
+        self._files: List[str] = []
+        self._file_index: Dict[str, int] = {}
+
+    def __len__(self) -> int:
+        return len(self._addresses)
+
+    def _intern(self, filename: str) -> int:
+        file_id = self._file_index.get(filename)
+        if file_id is None:
+            file_id = self._file_index[filename] = len(self._files)
+            self._files.append(filename)
+        return file_id
+
+    def add(self, address: int, filename: str, line: int = 0) -> None:
+        """Append one line program row."""
+        self._addresses.append(address)
+        self._file_ids.append(self._intern(filename))
+        self._line_numbers.append(line or 0)
+
+    def extend(self, table: LineTable) -> None:
+        """Append all rows of an already built table, in address order."""
+        for address, filename, line in table.rows():
+            self.add(address, filename, line)
+
+    def build(self) -> LineTable:
+        """Sort and de-duplicate the collected rows (the builder is not reusable)."""
+        addresses = self._addresses
+        count = len(addresses)
+        in_order = all(addresses[i] < addresses[i + 1] for i in range(count - 1))
+        if in_order:
+            out_addresses = addresses
+            out_file_ids = self._file_ids
+            out_lines = self._line_numbers
+        else:
+            out_addresses, out_file_ids, out_lines = self._sorted_unique()
+
+        if out_addresses and out_addresses[-1] < _UINT32_LIMIT:
+            out_addresses = array('I', out_addresses)
+        elif not out_addresses:
+            out_addresses = array('I')
+        return LineTable(out_addresses, out_file_ids, out_lines, self._files)
+
+    def _sorted_unique(self) -> Tuple[array, array, array]:
+        """Stable-sort rows by address, merging rows that share an address."""
+        addresses = self._addresses
+        file_ids = self._file_ids
+        line_numbers = self._line_numbers
+        out_addresses = array('Q')
+        out_file_ids = array('I')
+        out_lines = array('I')
+        previous = None
+        # The order is stable, so rows for one address stay in arrival order
+        for i in sorted_indices(addresses):
+            address = addresses[i]
+            if address == previous:
+                out_file_ids[-1] = file_ids[i]
+                if line_numbers[i]:
+                    out_lines[-1] = line_numbers[i]
+                continue
+            out_addresses.append(address)
+            out_file_ids.append(file_ids[i])
+            out_lines.append(line_numbers[i])
+            previous = address
+        return out_addresses, out_file_ids, out_lines
+
+
+def _indexed_run(keys: Sequence[int], start: int, end: int) -> Iterator[Tuple[int, int]]:
+    for i in range(start, end):
+        yield keys[i], i
+
+
+def sorted_indices(keys: Sequence[int]) -> Iterator[int]:
+    """Indices of ``keys`` in stable ascending key order.
+
+    Rows are collected as ascending runs (a line program sequence, an output
+    section of a map file), so the runs are merged with :func:`heapq.merge`
+    instead of sorting a list of every index with a key per index; memory
+    grows with the number of runs only.
+    """
+    bounds = [0]
+    bounds.extend(i for i in range(1, len(keys)) if keys[i] < keys[i - 1])
+    bounds.append(len(keys))
+    runs = [_indexed_run(keys, start, end) for start, end in zip(bounds, bounds[1:])]
+    for _, i in heapq.merge(*runs):
+        yield i
@@ -7,7 +7,7 @@ Parses map files generated via ``-Wl,-Map=output.map`` with ld.lld
 """
 
 import re
-from typing import List, Tuple
+from typing import Iterable, Iterator, List, Tuple
 
 
 # LLD map file row:
@@ -58,10 +58,26 @@ class LLDMapFileParser:  # pylint: disable=too-few-public-methods
             List of ``(start, end, archive, object_file)`` tuples sorted by
             ``start``. ``archive`` is "" for bare .o files.
         """
-        ranges: List[Tuple[int, int, str, str]] = []
+        ranges = list(self.iter_ranges(content.splitlines()))
+        ranges.sort(key=lambda r: r[0])
+        return ranges
+
+    def iter_ranges(self, lines: Iterable[str]) -> Iterator[Tuple[int, int, str, str]]:
+        """Yield ``(start, end, archive, object_file)`` ranges in map order.
+
+        Streaming form of :meth:`parse` for callers that read the map line
+        by line.
+
+        Args:
+            lines: Map file lines without line terminators.
+        """
         seen_starts = set()
 
-        for line in content.splitlines():
+        for line in lines:
+            # Symbol rows make up most of a large map; only input-section
+            # rows contain the ":(" delimiter, so skip the rest unmatched.
+            if ':(' not in line:
+                continue
             match = _LLD_ROW_RE.match(line)
             if not match:
                 continue
@@ -87,10 +103,7 @@ class LLDMapFileParser:  # pylint: disable=too-few-public-methods
             if not obj:
                 continue
             seen_starts.add(address)
-            ranges.append((address, address + size, archive, obj))
-
-        ranges.sort(key=lambda r: r[0])
-        return ranges
+            yield (address, address + size, archive, obj)
 
     @staticmethod
     def _parse_file_field(field: str) -> Tuple[str, str]:
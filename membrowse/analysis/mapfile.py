@@ -13,9 +13,14 @@ The format is auto-detected by :meth:`MapFileResolver.from_file`.
 
 import bisect
 import logging
-from typing import Dict, List, Optional, Tuple
+import mmap
+import os
+import re
+from array import array
+from typing import Dict, Iterable, Iterator, List, Optional, Tuple
 
 from ..core.exceptions import MapFileParseError
+from .line_table import sorted_indices
 from .ldmap_parser import MapFileParser
 from .iarmap_parser import IARMapFileParser
 from .lldmap_parser import LLDMapFileParser
@@ -30,6 +35,22 @@ __all__ = [
     'MapFileResolver',
 ]
 
+_IAR_MARKERS = ('*** PLACEMENT SUMMARY', 'IAR ELF Linker')
+# LLD emits a unique column header absent from GNU LD output.
+_LLD_MARKER = 'Size Align Out     In      Symbol'
+
+_NON_SPACE_RE = re.compile(rb'\S')
+
+# Format markers sit in the banner (IAR) or the first line (LLD), so only
+# the head of a memory-mapped file is searched.
+_DETECT_BYTES = 64 * 1024
+
+_PARSERS = {
+    'iar': (IARMapFileParser, 'IAR'),
+    'lld': (LLDMapFileParser, 'LLD'),
+    'gnu_ld': (MapFileParser, 'GNU LD'),
+}
+
 
 def _detect_map_format(content: str) -> str:
     """Detect whether a map file is GNU LD, LLD, or IAR format.
@@ -40,32 +61,98 @@ def _detect_map_format(content: str) -> str:
     Returns:
         "iar", "lld", or "gnu_ld".
     """
-    if '*** PLACEMENT SUMMARY' in content or 'IAR ELF Linker' in content:
+    if any(marker in content for marker in _IAR_MARKERS):
         return 'iar'
-    # LLD emits a unique column header absent from GNU LD output.
-    if 'Size Align Out     In      Symbol' in content:
+    if _LLD_MARKER in content:
         return 'lld'
     return 'gnu_ld'
 
 
+def _iter_lines(mapped: mmap.mmap) -> Iterator[str]:
+    """Decode a memory-mapped map file one line at a time."""
+    for raw in iter(mapped.readline, b''):
+        yield raw.decode('utf-8', 'replace').rstrip('\r\n')
+
+
+class _RangeTable:  # pylint: disable=too-few-public-methods
+    """Sorted half-open ranges stored as parallel arrays.
+
+    A large map has hundreds of thousands of input sections. As arrays
+    each range takes 24 bytes instead of a tuple of four objects, and each
+    archive and object path is stored once and referenced by index.
+    """
+
+    __slots__ = ('starts', 'ends', 'archive_ids', 'object_ids', 'names')
+
+    def __init__(self, ranges: Iterable[Tuple[int, int, str, str]]):
+        self.starts = array('Q')
+        self.ends = array('Q')
+        self.archive_ids = array('I')
+        self.object_ids = array('I')
+        ids: Dict[str, int] = {'': 0}
+        in_order = True
+        for start, end, archive, obj in ranges:
+            if self.starts and start < self.starts[-1]:
+                in_order = False
+            self.starts.append(start)
+            self.ends.append(end)
+            self.archive_ids.append(ids.setdefault(archive, len(ids)))
+            self.object_ids.append(ids.setdefault(obj, len(ids)))
+        # Ids were assigned in insertion order
+        self.names: List[str] = list(ids)
+        if not in_order:
+            self._sort()
+
+    def _sort(self) -> None:
+        # A packed index array: 4 bytes per range instead of an int and a key
+        order = array('I', sorted_indices(self.starts))
+        for name in ('starts', 'ends', 'archive_ids', 'object_ids'):
+            column = getattr(self, name)
+            setattr(self, name, array(column.typecode, (column[i] for i in order)))
+
+    def __len__(self) -> int:
+        return len(self.starts)
+
+    def lookup(self, address: int) -> Tuple[str, str]:
+        """(archive, object_file) of the range containing ``address``."""
+        # bisect_right gives the index past the last range whose start <=
+        # address; the candidate containing range is at idx-1.
+        return self._at(bisect.bisect_right(self.starts, address), address)
+
+    def sweep(self, addresses: Iterable[int]) -> Iterator[Tuple[str, str]]:
+        """:meth:`lookup` for ascending ``addresses`` with a forward-only search."""
+        idx = 0
+        for address in addresses:
+            idx = bisect.bisect_right(self.starts, address, idx)
+            yield self._at(idx, address)
+
+    def _at(self, idx: int, address: int) -> Tuple[str, str]:
+        """Result for ``address`` given ``idx = bisect_right(starts, address)``."""
+        if idx == 0 or address >= self.ends[idx - 1]:
+            return ('', '')
+        return (self.names[self.archive_ids[idx - 1]],
+                self.names[self.object_ids[idx - 1]])
+
+
 class MapFileResolver:
     """Resolve symbol addresses to their originating archive/object files.
 
     Two storage backends:
 
-    - ``address_map`` (GNU LD, LLD): exact-address dict. Each linker
-      input-section entry corresponds 1:1 to an ELF symbol address.
-    - ``ranges`` (IAR): sorted list of half-open ``[start, end)`` ranges.
-      IAR's PLACEMENT SUMMARY emits one entry per object's contribution
-      to a section, which can span thousands of bytes containing many
-      ELF symbols. Range lookup attributes every interior symbol.
+    - ``address_map``: exact-address dict. Each entry corresponds 1:1 to
+      an ELF symbol address.
+    - ``ranges`` (all parsed map files): sorted half-open ``[start, end)``
+      ranges, one per linker input section (GNU LD, LLD) or per object's
+      contribution to a section (IAR). A range can span thousands of bytes
+      containing many ELF symbols; range lookup attributes every interior
+      symbol.
     """
 
     def __init__(
         self,
         address_map: Optional[Dict[int, Tuple[str, str]]] = None,
         *,
-        ranges: Optional[List[Tuple[int, int, str, str]]] = None,
+        ranges: Optional[Iterable[Tuple[int, int, str, str]]] = None,
     ):
         """Initialize with pre-parsed mapping.
 
@@ -74,23 +161,24 @@ class MapFileResolver:
 
         Args:
             address_map: Dict mapping exact addresses to
-                (archive, object_file) tuples. Used by GNU LD / LLD.
-            ranges: Sorted list of (start, end, archive, object_file)
-                tuples with half-open intervals. Used by IAR.
+                (archive, object_file) tuples.
+            ranges: (start, end, archive, object_file) tuples with
+                half-open intervals, sorted by start (unsorted input is
+                sorted).
         """
         if address_map is not None and ranges is not None:
             raise ValueError(
                 "MapFileResolver: pass address_map OR ranges, not both")
         self._address_map = address_map if ranges is None else None
-        self._ranges = ranges
-        self._range_starts = (
-            [r[0] for r in ranges] if ranges else None)
+        self._ranges = _RangeTable(ranges) if ranges is not None else None
 
     @classmethod
     def from_file(cls, map_path: str) -> 'MapFileResolver':
         """Create a resolver by parsing a map file (GNU LD, LLD, or IAR).
 
-        The format is auto-detected from the file content.
+        The format is auto-detected from the head of the file, which is
+        memory-mapped and parsed line by line, so even maps of hundreds of
+        megabytes (GNU LD ``--cref``) are never held in memory as text.
 
         Args:
             map_path: Path to the .map file.
@@ -102,26 +190,23 @@ class MapFileResolver:
             MapFileParseError: If the file cannot be read.
         """
         try:
-            with open(map_path, 'r', encoding='utf-8', errors='replace') as f:
-                content = f.read()
+            with open(map_path, 'rb') as f:
+                if os.fstat(f.fileno()).st_size == 0:
+                    logger.debug("Map file is empty: %s", map_path)
+                    return cls.null()
+                with mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ) as mapped:
+                    fmt = _detect_map_format(
+                        mapped[:_DETECT_BYTES].decode('utf-8', 'replace'))
+                    parser_class, format_name = _PARSERS[fmt]
+                    logger.debug("Detected %s map file format: %s", format_name, map_path)
+                    resolver = cls(ranges=parser_class().iter_ranges(_iter_lines(mapped)))
+                    has_text = _NON_SPACE_RE.search(mapped) is not None
         except OSError as e:
             raise MapFileParseError(
                 f"Cannot read map file {map_path}: {e}") from e
 
-        fmt = _detect_map_format(content)
-        if fmt == 'iar':
-            ranges = IARMapFileParser().parse(content)
-            logger.debug("Detected IAR map file format: %s", map_path)
-        elif fmt == 'lld':
-            ranges = LLDMapFileParser().parse(content)
-            logger.debug("Detected LLD map file format: %s", map_path)
-        else:
-            ranges = MapFileParser().parse(content)
-            logger.debug("Detected GNU LD map file format: %s", map_path)
-        count = len(ranges)
-        resolver = cls(ranges=ranges)
-
-        if count == 0 and content.strip():
+        count = len(resolver._ranges)
+        if count == 0 and has_text:
             logger.warning(
                 "Map file %s produced no entries - "
                 "check that the format is correct", map_path)
@@ -156,16 +241,15 @@ class MapFileResolver:
             # use the real (even) load address. Try with bit 0 cleared.
             return self._address_map.get(address & ~1, ('', ''))
         if self._ranges:
-            return self._lookup_range(address)
+            return self._ranges.lookup(address)
         return ('', '')
 
-    def _lookup_range(self, address: int) -> Tuple[str, str]:
-        # bisect_right gives the index past the last range whose start <=
-        # address; the candidate containing range is at idx-1.
-        idx = bisect.bisect_right(self._range_starts, address)
-        if idx == 0:
-            return ('', '')
-        _start, end, archive, obj = self._ranges[idx - 1]
-        if address < end:
-            return (archive, obj)
-        return ('', '')
+    def resolve_sorted(self, addresses: Iterable[int]) -> Iterator[Tuple[str, str]]:
+        """Yield :meth:`resolve` results for ascending ``addresses``.
+
+        Range lookups share one forward search over the sorted ranges
+        instead of a full bisect per address.
+        """
+        if self._address_map is None and self._ranges:
+            return self._ranges.sweep(addresses)
+        return map(self.resolve, addresses)
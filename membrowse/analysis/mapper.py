@@ -7,8 +7,10 @@ addresses and types, with optimized binary search algorithms for performance.
 """
 
 import logging
-from typing import Dict, List, Optional
-from ..core.models import MemoryRegion, MemorySection
+from typing import Dict, Iterable, List, Optional, Union
+from ..core.models import MemoryRegion, MemorySection, Symbol
+from ..core.symbol_table import SymbolTable
+from ..utils.region_index import RegionIndex
 
 logger = logging.getLogger(__name__)
 
@@ -17,14 +19,16 @@ class MemoryMapper:
     """Maps ELF sections to memory regions with optimized address lookups"""
 
     def __init__(self, memory_regions: Dict[str, MemoryRegion]):
-        """Initialize with sorted region list for efficient address lookups."""
+        """Index the regions once for efficient address lookups."""
         self.regions = memory_regions
-        # Create sorted list of regions by start address for binary search
-        self._sorted_regions = []
-        for region in memory_regions.values():
-            self._sorted_regions.append(
-                (region.address, region.address + region.limit_size, region))
-        self._sorted_regions.sort(key=lambda x: x[0])  # Sort by start address
+        self._index = RegionIndex(
+            (name, region.address, region.address + region.limit_size)
+            for name, region in memory_regions.items())
+
+    @property
+    def parent_to_children(self) -> Dict[str, List[str]]:
+        """Region names mapped to the names of all regions nested in them."""
+        return self._index.parent_to_children
 
     @staticmethod
     def map_sections_to_regions(sections: List[MemorySection],
@@ -85,11 +89,12 @@ class MemoryMapper:
 
     def _find_region_containing(self, address: int) -> Optional[MemoryRegion]:
         """Return the smallest declared region containing the given address."""
-        matches = [region for start, end, region in self._sorted_regions
-                   if start <= address < end]
-        if not matches:
-            return None
-        return min(matches, key=lambda r: r.limit_size)
+        name = self._index.smallest_containing(address)
+        return None if name is None else self.regions[name]
+
+    def find_region_name(self, address: int) -> Optional[str]:
+        """Name of the smallest declared region containing ``address``."""
+        return self._index.smallest_containing(address)
 
     def find_region_by_address(
             self,
@@ -109,6 +114,39 @@ class MemoryMapper:
         """
         return self._find_region_containing(section.address)
 
+    @staticmethod
+    def section_lma_offsets(sections: Iterable[MemorySection]) -> Dict[str, int]:
+        """LMA minus VMA per section name, for sections with a distinct LMA.
+
+        Take this before :meth:`map_sections_to_regions`, which consumes
+        ``section.lma``.
+        """
+        return {section.name: section.lma - section.address
+                for section in sections if section.lma is not None}
+
+    @staticmethod
+    def attribute_symbols_to_regions(symbols: Union[SymbolTable, Iterable[Symbol]],
+                                     lma_offsets: Dict[str, int],
+                                     memory_regions: Dict[str, MemoryRegion]
+                                     ) -> None:
+        """Set each region's ``symbol_used_size`` from symbol addresses.
+
+        Symbols in sections with a distinct LMA are also credited to the
+        region holding their load image, at the same offset into the
+        section.
+
+        Args:
+            symbols: Symbols to attribute (zero-size symbols are ignored)
+            lma_offsets: Result of :meth:`section_lma_offsets`
+            memory_regions: Regions to attribute to
+        """
+        if not isinstance(symbols, SymbolTable):
+            symbols = SymbolTable.from_symbols(symbols)
+        mapper = MemoryMapper(memory_regions)
+        used = symbols.group_sizes_by_address(mapper.find_region_name, lma_offsets)
+        for name, region in memory_regions.items():
+            region.symbol_used_size = used.get(name, 0)
+
     @staticmethod
     def _find_region_by_type(section: MemorySection,
                              memory_regions: Dict[str,
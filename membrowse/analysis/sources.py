@@ -8,15 +8,18 @@ using DWARF debug information, with optimizations for performance and accuracy.
 
 import os
 import re
-import bisect
-from typing import Any, Dict, Optional
+from typing import Any, Dict, Iterable, List, Optional, Sequence, Tuple
 
 from .symbols import strip_compiler_suffix
+from .line_table import LineTable
 
 # Rust Codegen Unit hash filenames (e.g. "defmt_rtt.2465299265768a95-cgu.0")
 # These are compiler internals, not real source files.
 _CGU_HASH_PATTERN = re.compile(r'^.+\.[0-9a-f]+-cgu\.\d+$')
 
+# How far a symbol may sit from a line program row and still take its file
+_NEARBY_DISTANCE = 100
+
 
 class SourceFileResolver:  # pylint: disable=too-few-public-methods
     """Handles source file resolution logic for symbols using DWARF debug information"""
@@ -31,7 +34,8 @@ class SourceFileResolver:  # pylint: disable=too-few-public-methods
         # Pre-build static symbol mappings lookup for O(1) access
         self._static_symbol_lookup = {}
         self._basename_cache = {}  # Cache basename computations
-        self._sorted_addresses = None  # Lazy initialization for address lookup
+        self._line_table = None  # Lazy initialization for address lookup
+        self._swept_rows = None  # address -> (exact, nearest) line table rows
         if 'static_symbol_mappings' in dwarf_data:
             for mapping in dwarf_data['static_symbol_mappings']:
                 symbol_name = mapping[0]
@@ -50,6 +54,48 @@ class SourceFileResolver:  # pylint: disable=too-few-public-methods
             self._basename_cache[source_file] = os.path.basename(source_file)
         return self._basename_cache[source_file]
 
+    def unresolved_function_addresses(
+            self, functions: Iterable[Tuple[str, int]]) -> List[int]:
+        """Addresses of functions the DIE mappings cannot attribute.
+
+        Their source file can only come from the line program (the
+        address-based fallback of :meth:`extract_source_file`).
+
+        Args:
+            functions: ``(demangled name, address)`` of FUNC symbols
+
+        Returns:
+            Sorted unique addresses
+        """
+        symbol_to_file = self.dwarf_data.get('symbol_to_file', {}) if self.dwarf_data else {}
+        missing = set()
+        for name, address in functions:
+            if not address or (name, address) in symbol_to_file:
+                continue
+            stripped = strip_compiler_suffix(name)
+            if stripped == name or (stripped, address) not in symbol_to_file:
+                missing.add(address)
+        return sorted(missing)
+
+    def resolve_addresses(self, addresses: Sequence[int]) -> None:
+        """Find the line table rows of many symbol addresses in one pass.
+
+        ``addresses`` must be ascending. One forward sweep over the line
+        table finds the exact and nearest row of every address; later
+        :meth:`extract_source_file` and :meth:`extract_source_line` calls
+        for those addresses reuse them instead of searching per symbol.
+        Applies to the ``LineTable`` built by ``DWARFProcessor``; hand-built
+        dict tables keep the per-symbol lookups.
+        """
+        if not self.dwarf_data:
+            return
+        table = self.dwarf_data.get('address_to_file')
+        if (not isinstance(table, LineTable)
+                or self.dwarf_data.get('address_to_line') is not table.lines):
+            return
+        self._line_table = table
+        self._swept_rows = dict(zip(addresses, table.sweep(addresses, _NEARBY_DISTANCE)))
+
     def extract_source_file(
             self,
             symbol_name: str,
@@ -83,6 +129,13 @@ class SourceFileResolver:  # pylint: disable=too-few-public-methods
         """
         if not self.dwarf_data or not symbol_address:
             return 0
+        rows = self._swept_rows.get(symbol_address) if self._swept_rows else None
+        if rows is not None:
+            exact, near = rows
+            line = self._line_table.row(exact)[2] if exact >= 0 else 0
+            if not line and near >= 0:
+                line = self._line_table.row(near)[2]
+            return line
         addr_to_line = self.dwarf_data.get('address_to_line')
         if not addr_to_line:
             return 0
@@ -195,37 +248,37 @@ class SourceFileResolver:  # pylint: disable=too-few-public-methods
 
     def _resolve_by_address(self, symbol_address: int) -> str:
         """Resolve source file by symbol address."""
+        rows = self._swept_rows.get(symbol_address) if self._swept_rows else None
+        if rows is not None:
+            # Exact row first, then the nearest one
+            idx = rows[0] if rows[0] >= 0 else rows[1]
+            if idx < 0:
+                return ""
+            address, source_file, _line = self._line_table.row(idx)
+            return self._prefer_cu_source(address, self._get_basename(source_file))
+
         # Exact address lookup
         if symbol_address in self.dwarf_data['address_to_file']:
             source_file = self.dwarf_data['address_to_file'][symbol_address]
-            source_file_basename = self._get_basename(source_file)
-
-            # Prefer .c files over .h files when available
-            if (source_file_basename.endswith('.h')
-                    and symbol_address in self.dwarf_data['address_to_cu_file']):
-                cu_source_file = self.dwarf_data['address_to_cu_file'][symbol_address]
-                if cu_source_file and cu_source_file.endswith('.c'):
-                    return self._get_basename(cu_source_file)
-
-            return source_file_basename
+            return self._prefer_cu_source(symbol_address, self._get_basename(source_file))
 
         # Proximity search using optimized algorithm
         nearby_addr = self._find_nearby_address(symbol_address)
         if nearby_addr is not None:
             source_file = self.dwarf_data['address_to_file'][nearby_addr]
-            source_file_basename = self._get_basename(source_file)
-
-            # Apply .h/.c preference logic
-            if (source_file_basename.endswith('.h')
-                    and nearby_addr in self.dwarf_data['address_to_cu_file']):
-                cu_source_file = self.dwarf_data['address_to_cu_file'][nearby_addr]
-                if cu_source_file and cu_source_file.endswith('.c'):
-                    return self._get_basename(cu_source_file)
-
-            return source_file_basename
+            return self._prefer_cu_source(nearby_addr, self._get_basename(source_file))
 
         return ""
 
+    def _prefer_cu_source(self, address: int, source_file_basename: str) -> str:
+        """Prefer the CU's .c file over a .h file from the line program."""
+        if (source_file_basename.endswith('.h')
+                and address in self.dwarf_data['address_to_cu_file']):
+            cu_source_file = self.dwarf_data['address_to_cu_file'][address]
+            if cu_source_file and cu_source_file.endswith('.c'):
+                return self._get_basename(cu_source_file)
+        return source_file_basename
+
     def _resolve_fallback(self, symbol_name: str, symbol_address: int) -> str:
         """Fallback resolution methods for edge cases."""
         # Try address-based CU mapping
@@ -250,38 +303,18 @@ class SourceFileResolver:  # pylint: disable=too-few-public-methods
     def _find_nearby_address(
             self,
             target_address: int,
-            max_distance: int = 100) -> Optional[int]:
-        """Find nearby address using dictionary-based search."""
-        if not self.dwarf_data['address_to_file']:
+            max_distance: int = _NEARBY_DISTANCE) -> Optional[int]:
+        """Find the closest line program address within ``max_distance``."""
+        address_to_file = self.dwarf_data['address_to_file']
+        if not address_to_file:
             return None
 
-        # Create sorted list from dictionary keys for efficient search
-        if self._sorted_addresses is None:
-            addresses = self.dwarf_data['address_to_file'].keys()
-            self._sorted_addresses = sorted(addresses)
-
-        # Binary search to find closest address
-        idx = bisect.bisect_left(self._sorted_addresses, target_address)
-
-        candidates = []
-
-        # Check address at or after target
-        if idx < len(self._sorted_addresses):
-            addr = self._sorted_addresses[idx]
-            distance = abs(addr - target_address)
-            if distance <= max_distance:
-                candidates.append((distance, addr))
-
-        # Check address before target
-        if idx > 0:
-            addr = self._sorted_addresses[idx - 1]
-            distance = abs(addr - target_address)
-            if distance <= max_distance:
-                candidates.append((distance, addr))
-
-        # Return closest address
-        if candidates:
-            candidates.sort()  # Sort by distance
-            return candidates[0][1]  # Return address with minimum distance
+        # DWARFProcessor already produces a sorted LineTable; plain dicts
+        # (hand-built dwarf_data) are converted once on first use
+        if self._line_table is None:
+            if isinstance(address_to_file, LineTable):
+                self._line_table = address_to_file
+            else:
+                self._line_table = LineTable.from_mappings(address_to_file)
 
-        return None
+        return self._line_table.nearest(target_address, max_distance)
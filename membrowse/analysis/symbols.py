@@ -8,13 +8,34 @@ including symbol filtering, type mapping, and source file resolution.
 """
 
 import re
-from typing import Dict, List, Tuple
-from itanium_demangler import parse as cpp_demangle
-from rust_demangler import demangle as rust_demangle
+import logging
+import threading
+from collections import OrderedDict
+from typing import Dict, Iterable, List, Optional, Tuple
 from elftools.common.exceptions import ELFError
 from ..core.models import Symbol
 from ..core.exceptions import SymbolExtractionError
-from . import _cpp_demangle  # pylint: disable=unused-import  # import installs the missing-production patch for itanium_demangler
+from ..utils.timing import count, stage, timed_methods
+from ._native_demangle import demangle_batch, find_native_demangler
+
+logger = logging.getLogger(__name__)
+
+
+# The pure-Python demanglers are imported on the first name that needs
+# them, so C-only firmware and commands that never demangle skip loading
+# them (and patching itanium_demangler).
+def cpp_demangle(name: str):
+    """``itanium_demangler.parse`` with the ``_cpp_demangle`` extensions."""
+    # pylint: disable=import-outside-toplevel,unused-import
+    from . import _cpp_demangle  # import installs the missing-production patch
+    from itanium_demangler import parse
+    return parse(name)
+
+
+def rust_demangle(name: str):
+    """``rust_demangler.demangle``."""
+    from rust_demangler import demangle  # pylint: disable=import-outside-toplevel
+    return demangle(name)
 
 
 # GCC/LLVM compiler-generated suffixes appended to mangled symbol names.
@@ -45,6 +66,26 @@ _RUST_LEGACY_HASH_RE = re.compile(r'17h[0-9a-f]{16}E')
 _RLIB_NAME_RE = re.compile(
     r'(?:^|[\\/])lib([A-Za-z_][A-Za-z0-9_]*)-[0-9a-f]+\.rlib$')
 
+# Memoized ``name -> (demangled, kind)`` results, shared by every
+# SymbolExtractor in the process so that repeated analyses (one per commit
+# in ``onboard``) only demangle names they have not seen before. Keyed by
+# the native demangler in use (None = built-in only), since its formatting
+# differs slightly from itanium_demangler's (e.g. ``> >`` vs ``>>``).
+# Each cache keeps the most recently used MAX_DEMANGLE_CACHE_ENTRIES names,
+# so a long-running ``membrowse serve`` does not grow with every build.
+# ``batch --workers`` analyzes on threads, so every lookup, insert and
+# eviction holds _DEMANGLE_CACHE_LOCK; demangling itself runs outside it.
+_DEMANGLE_CACHES: Dict[Optional[str], 'OrderedDict[str, Tuple[str, str]]'] = {}
+_DEMANGLE_CACHE_LOCK = threading.Lock()
+MAX_DEMANGLE_CACHE_ENTRIES = 200_000
+
+
+def clear_demangle_caches() -> None:
+    """Forget memoized demangling results (e.g. between benchmark runs)."""
+    with _DEMANGLE_CACHE_LOCK:
+        for cache in _DEMANGLE_CACHES.values():
+            cache.clear()
+
 
 def _crate_from_rlib_path(path: str) -> str:
     """Return the crate name encoded in a ``lib<crate>-<hash>.rlib`` archive.
@@ -59,6 +100,14 @@ def _crate_from_rlib_path(path: str) -> str:
     return match.group(1) if match else ''
 
 
+def _split_compiler_suffix(name: str) -> Tuple[str, str]:
+    """Split ``name`` into its base and any compiler-generated suffix."""
+    suffix_match = _COMPILER_SUFFIX_RE.search(name)
+    if suffix_match:
+        return name[:suffix_match.start()], suffix_match.group()
+    return name, ''
+
+
 def strip_compiler_suffix(name: str) -> str:
     """Strip GCC/LLVM compiler-generated suffixes from a symbol name.
 
@@ -151,9 +200,26 @@ def _extract_rust_crate(demangled: str) -> str:  # pylint: disable=too-many-retu
 class SymbolExtractor:  # pylint: disable=too-few-public-methods
     """Handles symbol extraction and analysis from ELF files"""
 
-    def __init__(self, elffile):
-        """Initialize with ELF file handle."""
+    def __init__(self, elffile, native_demangler: bool = False):
+        """Initialize with ELF file handle.
+
+        Args:
+            elffile: pyelftools ELFFile (or ELFContext)
+            native_demangler: Demangle C++ names with ``c++filt`` /
+                ``llvm-cxxfilt`` from PATH in one batch, using the built-in
+                demangler only for names the tool rejects
+        """
         self.elffile = elffile
+        self._native_tool = find_native_demangler() if native_demangler else None
+        if native_demangler and not self._native_tool:
+            logger.warning(
+                "No native demangler (c++filt, llvm-cxxfilt) found on PATH; "
+                "using built-in demangler")
+        with _DEMANGLE_CACHE_LOCK:
+            self._demangle_cache = _DEMANGLE_CACHES.setdefault(
+                self._native_tool, OrderedDict())
+        # mangled C++ base name -> native demangler output
+        self._native_cpp: Dict[str, str] = {}
 
     def _demangle_symbol_name(self, name: str) -> str:
         """Demangle a C++ or Rust symbol name. See :meth:`_demangle_with_kind`.
@@ -165,8 +231,31 @@ class SymbolExtractor:  # pylint: disable=too-few-public-methods
         demangled, _ = self._demangle_with_kind(name)
         return demangled
 
-    def _demangle_with_kind(  # pylint: disable=too-many-return-statements
-            self, name: str) -> Tuple[str, str]:
+    def demangle_batch(self, names: Iterable[str]) -> None:
+        """Demangle ``names`` up front into the shared cache.
+
+        With a native demangler, every C++ candidate not cached yet goes
+        through it in a single subprocess call.
+        """
+        unique_names = dict.fromkeys(names)
+        with _DEMANGLE_CACHE_LOCK:
+            pending = [name for name in unique_names
+                       if name and name not in self._demangle_cache]
+        count('symbols_demangled', len(pending))
+        count('demangle_cache_hits', len(unique_names) - len(pending))
+        if self._native_tool:
+            cpp_names = []
+            for name in pending:
+                base_name = _split_compiler_suffix(name)[0]
+                if (base_name.startswith('_Z')
+                        and not _RUST_LEGACY_HASH_RE.search(base_name)):
+                    cpp_names.append(base_name)
+            self._native_cpp.update(
+                demangle_batch(self._native_tool, list(dict.fromkeys(cpp_names))))
+        for name in pending:
+            self._demangle_with_kind(name)
+
+    def _demangle_with_kind(self, name: str) -> Tuple[str, str]:
         """Demangle and also report which demangler handled the name.
 
         Supports:
@@ -184,19 +273,32 @@ class SymbolExtractor:  # pylint: disable=too-few-public-methods
             whether to run Rust-specific crate extraction — a C++ namespace
             like ``std::vector<int>::push_back`` would otherwise be
             mis-extracted as crate "std".
+
+            The most recently used results are memoized per process (see
+            ``_DEMANGLE_CACHES``).
         """
+        cache = self._demangle_cache
+        with _DEMANGLE_CACHE_LOCK:
+            result = cache.get(name)
+            if result is not None:
+                cache.move_to_end(name)
+                return result
+        result = self._demangle_uncached(name)
+        with _DEMANGLE_CACHE_LOCK:
+            cache[name] = result
+            if len(cache) > MAX_DEMANGLE_CACHE_ENTRIES:
+                cache.popitem(last=False)
+        return result
+
+    def _demangle_uncached(  # pylint: disable=too-many-return-statements
+            self, name: str) -> Tuple[str, str]:
+        """Implementation of :meth:`_demangle_with_kind` without the cache."""
         if not name:
             return name, 'none'
 
         # Strip compiler-generated suffixes (e.g. .part.0, .constprop.1)
         # before demangling, then re-append to the result.
-        suffix_match = _COMPILER_SUFFIX_RE.search(name)
-        if suffix_match:
-            base_name = name[:suffix_match.start()]
-            suffix = suffix_match.group()
-        else:
-            base_name = name
-            suffix = ''
+        base_name, suffix = _split_compiler_suffix(name)
 
         # Rust v0 mangling (starts with _R).
         if base_name.startswith('_R'):
@@ -238,19 +340,47 @@ class SymbolExtractor:  # pylint: disable=too-few-public-methods
             return name
 
     def _demangle_cpp(self, name: str) -> str:
-        """Demangle C++ symbol names using itanium_demangler (pure Python)."""
+        """Demangle C++ symbol names using the native demangler's batch
+        result if there is one, else itanium_demangler (pure Python)."""
+        native = self._native_cpp.get(name)
+        if native:
+            return native
         try:
             result = cpp_demangle(name)
             return str(result) if result is not None else name
         except Exception:  # pylint: disable=broad-exception-caught
             return name
 
-    def extract_symbols(  # pylint: disable=too-many-locals,too-many-branches
+    def function_symbols(self) -> List[Tuple[str, int]]:
+        """Demangled ``(name, address)`` of every FUNC symbol to extract.
+
+        All symbol names are demangled in one batch into the shared cache,
+        so :meth:`extract_symbols` does not demangle them again.
+        """
+        symbol_table_section = self.elffile.get_section_by_name('.symtab')
+        if not symbol_table_section:
+            return []
+        valid_symbols = [symbol for symbol in symbol_table_section.iter_symbols()
+                         if self._is_valid_symbol(symbol)]
+        self.demangle_batch(symbol.name for symbol in valid_symbols)
+        return [(self._demangle_with_kind(symbol.name)[0], symbol['st_value'])
+                for symbol in valid_symbols
+                if symbol['st_info']['type'] == 'STT_FUNC']
+
+    def extract_symbols(self, source_resolver, map_resolver=None) -> List[Symbol]:
+        """Extract symbol information from ELF file with source file mapping."""
+        with stage('symbol_extraction'):
+            symbols = self._collect_symbols(source_resolver, map_resolver)
+        count('symbols_extracted', len(symbols))
+        return symbols
+
+    def _collect_symbols(  # pylint: disable=too-many-locals,too-many-branches
         self, source_resolver, map_resolver=None
     ) -> List[Symbol]:
-        """Extract symbol information from ELF file with source file mapping."""
         symbols = []
-
+        source_resolver = timed_methods(
+            source_resolver, 'source_resolution', 'resolve_addresses',
+            'extract_source_file', 'extract_source_line')
         try:
             symbol_table_section = self.elffile.get_section_by_name('.symtab')
             if not symbol_table_section:
@@ -259,10 +389,21 @@ class SymbolExtractor:  # pylint: disable=too-few-public-methods
             # Build section name mapping for efficiency
             section_names = self._build_section_name_mapping()
 
-            for symbol in symbol_table_section.iter_symbols():
-                if not self._is_valid_symbol(symbol):
-                    continue
-
+            valid_symbols = [symbol for symbol in symbol_table_section.iter_symbols()
+                             if self._is_valid_symbol(symbol)]
+            self.demangle_batch(symbol.name for symbol in valid_symbols)
+
+            # Address lookups are done for all symbols at once, in address
+            # order, so each sweeps its sorted table forward instead of
+            # searching it per symbol
+            addresses = sorted({symbol['st_value'] for symbol in valid_symbols})
+            source_resolver.resolve_addresses(addresses)
+            if map_resolver is not None:
+                map_entries = dict(zip(addresses, map_resolver.resolve_sorted(addresses)))
+            else:
+                map_entries = {}
+
+            for symbol in valid_symbols:
                 symbol_name, demangle_kind = self._demangle_with_kind(
                     symbol.name)
                 symbol_type = self._get_symbol_type(symbol['st_info']['type'])
@@ -293,11 +434,7 @@ class SymbolExtractor:  # pylint: disable=too-few-public-methods
                     pass
 
                 # Get archive/object file from map file resolver
-                if map_resolver is not None:
-                    archive, object_file = map_resolver.resolve(
-                        symbol_address)
-                else:
-                    archive, object_file = '', ''
+                archive, object_file = map_entries.get(symbol_address, ('', ''))
 
                 # Attribute by crate for Rust projects. The demangled name is
                 # the best source for Rust-mangled symbols (covers monomorph-
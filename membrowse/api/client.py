@@ -5,23 +5,104 @@ Provides MemBrowseClient class for interacting with the MemBrowse API:
 uploading memory analysis reports and retrieving summaries.
 """
 
-import copy
-import json
 import logging
 import os
 import random
+import threading
 import time
+import zlib
+from datetime import datetime, timezone
+from email.utils import parsedate_to_datetime
 from importlib.metadata import version
-from typing import Dict, Any
+from typing import Dict, Any, Iterator, Optional
 
 import requests
+from requests.adapters import HTTPAdapter
 
 from ..auth.strategy import AuthContext
+from ..utils.json_stream import iter_json
+from ..utils.timing import count, stage, timed
+
+try:
+    import zstandard
+except ImportError:  # optional dependency, only needed for zstd uploads
+    zstandard = None  # pylint: disable=invalid-name
 
 logger = logging.getLogger(__name__)
 
 PACKAGE_VERSION = version('membrowse')
 
+# Supported upload Content-Encodings, in fallback order
+CONTENT_ENCODINGS = ('zstd', 'gzip', 'identity')
+DEFAULT_CONTENT_ENCODING = 'gzip'
+
+# Retry schedule: exponential backoff with equal jitter, unless the server
+# sends Retry-After (honored up to MAX_RETRY_AFTER seconds). The five waits
+# add up to 172-345s, enough to ride out an API deploy's 502/503/504s.
+MAX_ATTEMPTS = 6
+RETRY_BASE_DELAY = 15.0
+MAX_RETRY_DELAY = 120.0
+MAX_RETRY_AFTER = 300.0
+RETRYABLE_STATUS_CODES = (429, 502, 503, 504)
+
+# Pooled keep-alive connections per host and thread
+POOL_CONNECTIONS = 8
+
+_thread_sessions = threading.local()
+
+
+def _get_session() -> requests.Session:
+    """Keep-alive session shared by every client in the calling thread.
+
+    Clients send their own headers with each request, so one connection
+    pool (and its TLS sessions) serves uploads and summaries of all
+    targets and commits. ``requests.Session`` is not thread-safe, so the
+    upload threads of ``report --manifest`` and ``onboard`` each get their
+    own.
+    """
+    session = getattr(_thread_sessions, 'session', None)
+    if session is None:
+        session = requests.Session()
+        adapter = HTTPAdapter(pool_connections=POOL_CONNECTIONS,
+                              pool_maxsize=POOL_CONNECTIONS)
+        session.mount('https://', adapter)
+        session.mount('http://', adapter)
+        _thread_sessions.session = session
+    return session
+
+
+def retry_delay(attempt: int, response: Optional[requests.Response] = None) -> float:
+    """Seconds to wait before retrying after failed ``attempt`` (1-based).
+
+    A ``Retry-After`` header (seconds or an HTTP date) on a 429/503
+    response wins. Otherwise the delay is drawn uniformly from the upper
+    half of ``min(MAX_RETRY_DELAY, RETRY_BASE_DELAY * 2 ** (attempt - 1))``:
+    the jitter keeps many clients from retrying in lockstep and the lower
+    bound keeps the total wait from collapsing.
+    """
+    if response is not None and response.status_code in (429, 503):
+        retry_after = _parse_retry_after(response.headers.get('Retry-After'))
+        if retry_after is not None:
+            return min(retry_after, MAX_RETRY_AFTER)
+    bound = min(MAX_RETRY_DELAY, RETRY_BASE_DELAY * 2 ** (attempt - 1))
+    return random.uniform(bound / 2, bound)
+
+
+def _parse_retry_after(value: Optional[str]) -> Optional[float]:
+    """Seconds from a ``Retry-After`` header value, or None if unusable."""
+    if not value:
+        return None
+    value = value.strip()
+    if value.isdigit():
+        return float(value)
+    try:
+        when = parsedate_to_datetime(value)
+    except (TypeError, ValueError):
+        return None
+    if when.tzinfo is None:
+        when = when.replace(tzinfo=timezone.utc)
+    return max(0.0, (when - datetime.now(timezone.utc)).total_seconds())
+
 
 def _detect_ci_platform() -> str:
     """Detect the CI platform from environment variables."""
@@ -32,27 +113,107 @@ def _detect_ci_platform() -> str:
     return 'CLI'
 
 
+class _IdentityCompressor:
+    """Pass-through with the compressobj interface."""
+
+    @staticmethod
+    def compress(data: bytes) -> bytes:
+        """Return ``data`` unchanged."""
+        return data
+
+    @staticmethod
+    def flush() -> bytes:
+        """Nothing is buffered."""
+        return b''
+
+
+def _make_compressor(encoding: str):
+    """Return a fresh ``compress()``/``flush()`` object for ``encoding``."""
+    if encoding == 'gzip':
+        # wbits 16 + MAX_WBITS selects the gzip container
+        return zlib.compressobj(6, zlib.DEFLATED, 16 + zlib.MAX_WBITS)
+    if encoding == 'zstd':
+        return zstandard.ZstdCompressor(level=3).compressobj()
+    return _IdentityCompressor()
+
+
+class JSONBody:  # pylint: disable=too-few-public-methods
+    """Streaming, optionally compressed JSON request body.
+
+    Passed as ``data=`` to requests, which sends it with chunked transfer
+    encoding. The JSON is encoded and compressed while it is sent, so the
+    full payload never exists in memory. Each iteration starts over, so a
+    retried request sends the complete body again.
+    """
+
+    def __init__(self, obj: Any, encoding: str = DEFAULT_CONTENT_ENCODING):
+        """
+        Args:
+            obj: JSON-serializable payload
+            encoding: One of :data:`CONTENT_ENCODINGS`
+        """
+        self.obj = obj
+        self.encoding = encoding
+
+    def __iter__(self) -> Iterator[bytes]:
+        compressor = _make_compressor(self.encoding)
+        raw_size = 0
+        sent_size = 0
+        for piece in iter_json(self.obj):
+            data = piece.encode('utf-8')
+            raw_size += len(data)
+            chunk = compressor.compress(data)
+            if chunk:
+                sent_size += len(chunk)
+                yield chunk
+        chunk = compressor.flush()
+        sent_size += len(chunk)
+        yield chunk
+        count('upload_raw_bytes', raw_size)
+        count('upload_bytes', sent_size)
+        logger.debug("Uploaded payload: %d bytes (%d bytes %s)",
+                     raw_size, sent_size, self.encoding)
+
+
 class MemBrowseClient:
     """Handles API requests to MemBrowse (upload reports, get summaries)."""
 
-    def __init__(self, auth_context: AuthContext, api_base_url: str):
+    def __init__(self, auth_context: AuthContext, api_base_url: str,
+                 content_encoding: str = DEFAULT_CONTENT_ENCODING):
         """
         Initialize client with authentication context.
 
         Args:
             auth_context: Authentication context with strategy and credentials
             api_base_url: API base URL (e.g., 'https://api.membrowse.com')
+            content_encoding: Upload body encoding, one of
+                :data:`CONTENT_ENCODINGS`. If the server answers 415 the
+                client falls back to the next encoding for this and all
+                later uploads; on 411 it stops using chunked bodies.
         """
+        if content_encoding not in CONTENT_ENCODINGS:
+            raise ValueError(f"Unsupported content encoding: {content_encoding}")
+        if content_encoding == 'zstd' and zstandard is None:
+            logger.warning("zstd upload compression needs the 'zstandard' "
+                           "package; using gzip")
+            content_encoding = 'gzip'
         self.auth_context = auth_context
         self.api_base_url = api_base_url.rstrip('/')
-        self.session = requests.Session()
+        self.content_encoding = content_encoding
+        self.chunked_upload = True
 
-        # Build headers based on auth strategy
-        headers = auth_context.build_headers()
+        # Build headers based on auth strategy; sent with every request
+        # because the session is shared
+        self.headers = auth_context.build_headers()
         ci_platform = _detect_ci_platform()
-        headers['User-Agent'] = f'MemBrowse-Client/{PACKAGE_VERSION} ({ci_platform})'
-        self.session.headers.update(headers)
+        self.headers['User-Agent'] = f'MemBrowse-Client/{PACKAGE_VERSION} ({ci_platform})'
+
+    @property
+    def session(self) -> requests.Session:
+        """Keep-alive session of the calling thread."""
+        return _get_session()
 
+    @timed('upload')
     def upload_report(self, report_data: Dict[str, Any]) -> Dict[str, Any]:
         """
         Upload report to MemBrowse API.
@@ -69,29 +230,99 @@ class MemBrowseClient:
             requests.exceptions.RequestException: For other request errors
             json.JSONDecodeError: If response cannot be parsed as JSON
         """
-        # Create a copy to avoid mutating the input
-        report_to_send = copy.deepcopy(report_data)
+        # Shallow copies are enough to avoid mutating the input: only the
+        # top-level metadata dict is modified (the symbol list is shared)
+        report_to_send = dict(report_data)
 
         # Add auth-specific metadata (e.g., github_context for tokenless uploads)
         metadata_additions = self.auth_context.get_metadata_additions()
         if metadata_additions:
-            if 'metadata' not in report_to_send:
-                report_to_send['metadata'] = {}
+            report_to_send['metadata'] = dict(report_to_send.get('metadata', {}))
             report_to_send['metadata'].update(metadata_additions)
 
         url = f"{self.api_base_url}/upload"
         commit_hash = report_to_send.get('metadata', {}).get('git', {}).get('commit_hash', '')
 
-        json_bytes = json.dumps(report_to_send).encode('utf-8')
-        logger.debug("Uploading payload: %d bytes", len(json_bytes))
+        while True:
+            try:
+                return self._send_report(report_to_send, url, commit_hash)
+            except requests.exceptions.HTTPError as e:
+                if self._downgrade_upload(e):
+                    continue
+                if not self._may_reject_body(e):
+                    raise
+                return self._retry_with_plain_body(report_to_send, url, commit_hash, e)
+
+    def _send_report(self, report: Dict[str, Any], url: str,
+                     commit_hash: str) -> Dict[str, Any]:
+        """POST ``report`` with the current encoding and chunking."""
+        body = JSONBody(report, self.content_encoding)
+        headers = {'Content-Type': 'application/json'}
+        if self.content_encoding != 'identity':
+            headers['Content-Encoding'] = self.content_encoding
         return self._request_with_retry(
             'POST', url, log_context=commit_hash,
-            data=json_bytes,
-            headers={
-                'Content-Type': 'application/json',
-            },
+            # A bytes body is sent with Content-Length instead
+            data=body if self.chunked_upload else b''.join(body),
+            headers=headers,
         )
 
+    def _may_reject_body(self, error: requests.exceptions.HTTPError) -> bool:
+        """True for a 400 that may be about a compressed or chunked body.
+
+        Proxies and servers that cannot read such a body often answer a plain
+        400 instead of 415 or 411.
+        """
+        status_code = error.response.status_code if error.response is not None else None
+        return status_code == 400 and (self.content_encoding != 'identity'
+                                       or self.chunked_upload)
+
+    def _retry_with_plain_body(self, report: Dict[str, Any], url: str, commit_hash: str,
+                               error: requests.exceptions.HTTPError) -> Dict[str, Any]:
+        """Resend once uncompressed with Content-Length after ``error`` (a 400).
+
+        The plain body is kept for later uploads only if the server accepts
+        it. Otherwise the report itself was rejected: the previous settings
+        are restored and ``error`` is raised.
+        """
+        previous = (self.content_encoding, self.chunked_upload)
+        logger.warning("Server rejected %s%s upload (HTTP 400), retrying uncompressed "
+                       "with Content-Length", self.content_encoding,
+                       ', chunked' if self.chunked_upload else '')
+        self.content_encoding, self.chunked_upload = 'identity', False
+        try:
+            response = self._send_report(report, url, commit_hash)
+        except requests.exceptions.HTTPError:
+            self.content_encoding, self.chunked_upload = previous
+            raise error from None
+        except Exception:
+            self.content_encoding, self.chunked_upload = previous
+            raise
+        count('upload_fallbacks')
+        return response
+
+    def _downgrade_upload(self, error: requests.exceptions.HTTPError) -> bool:
+        """Switch to a more widely supported upload body after a rejection.
+
+        Returns:
+            True if the upload should be retried with the new settings
+        """
+        status_code = error.response.status_code if error.response is not None else None
+        if status_code == 415 and self.content_encoding != 'identity':
+            fallback = CONTENT_ENCODINGS[CONTENT_ENCODINGS.index(self.content_encoding) + 1]
+            logger.warning("Server rejected %s-encoded upload (HTTP 415), retrying with %s",
+                           self.content_encoding, fallback)
+            self.content_encoding = fallback
+            count('upload_fallbacks')
+            return True
+        if status_code == 411 and self.chunked_upload:
+            logger.warning("Server rejected chunked upload (HTTP 411), "
+                           "retrying with Content-Length")
+            self.chunked_upload = False
+            count('upload_fallbacks')
+            return True
+        return False
+
     def get_summary(self, commit_sha: str) -> Dict[str, Any]:
         """
         Get memory footprint summary for a commit from MemBrowse API.
@@ -120,6 +351,10 @@ class MemBrowseClient:
         """
         Make HTTP request with retry logic.
 
+        Timeouts, connection errors and HTTP 429/502/503/504 are retried
+        after :func:`retry_delay` (exponential backoff with jitter, or the
+        server's ``Retry-After``).
+
         Args:
             method: HTTP method ('GET' or 'POST')
             url: Request URL
@@ -129,12 +364,10 @@ class MemBrowseClient:
         Returns:
             Parsed JSON response
         """
-        max_attempts = 5
-        retry_delays = [10, 30, 60, 120]  # seconds between attempts
-
-        prefix = f"({log_context}) " if log_context else ""
-
+        max_attempts = MAX_ATTEMPTS
         prefix = f"({log_context}) " if log_context else ""
+        headers = dict(self.headers)
+        headers.update(kwargs.pop('headers', None) or {})
 
         for attempt in range(1, max_attempts + 1):
             try:
@@ -142,9 +375,12 @@ class MemBrowseClient:
                     "%s%s %s (attempt %d of %d)...",
                     prefix, method, url, attempt, max_attempts
                 )
-                response = self.session.request(
-                    method, url, timeout=120, **kwargs
-                )
+                count('http_requests')
+                with stage('http_request', {'method': method, 'attempt': attempt}):
+                    response = self.session.request(
+                        method, url, timeout=120, headers=headers, **kwargs
+                    )
+                    count('http_response_bytes', len(response.content))
                 response.raise_for_status()
 
                 # Parse and return JSON response
@@ -157,12 +393,12 @@ class MemBrowseClient:
 
             except (requests.exceptions.Timeout, requests.exceptions.ConnectionError) as e:
                 if attempt < max_attempts:
-                    delay = retry_delays[attempt - 1] * random.uniform(1, 1.5)
+                    delay = retry_delay(attempt)
                     logger.warning(
                         "%sRequest failed: %s. Retrying in %.1f seconds...",
                         prefix, str(e), delay
                     )
-                    time.sleep(delay)
+                    _wait_before_retry(delay)
                     continue
                 logger.error(
                     "%sRequest failed after %d attempts: %s", prefix, max_attempts, str(e)
@@ -175,13 +411,13 @@ class MemBrowseClient:
                 status_code = e.response.status_code if e.response is not None else None
                 # Retry on 429 Too Many Requests, 503 Service Unavailable,
                 # and gateway errors (502, 504)
-                if status_code in (429, 502, 503, 504) and attempt < max_attempts:
-                    delay = retry_delays[attempt - 1] * random.uniform(1, 1.5)
+                if status_code in RETRYABLE_STATUS_CODES and attempt < max_attempts:
+                    delay = retry_delay(attempt, e.response)
                     logger.warning(
                         "%sRequest failed with HTTP %d: %s. Retrying in %.1f seconds...",
                         prefix, status_code, str(e), delay
                     )
-                    time.sleep(delay)
+                    _wait_before_retry(delay)
                     continue
                 # Include error field from response in error message
                 error_detail = ""
@@ -207,5 +443,12 @@ class MemBrowseClient:
         )
 
 
+def _wait_before_retry(delay: float) -> None:
+    """Sleep ``delay`` seconds, counting the retry and the wait."""
+    count('http_retries')
+    count('http_retry_wait_ms', int(delay * 1000))
+    time.sleep(delay)
+
+
 # Backward compatibility alias
 MemBrowseUploader = MemBrowseClient
@@ -8,10 +8,33 @@ Provides a unified command-line interface with subcommands for memory analysis.
 import sys
 import logging
 import argparse
-
-from .commands.report import add_report_parser, run_report
-from .commands.onboard import add_onboard_parser, run_onboard
-from .commands.summary import add_summary_parser, run_summary
+from importlib import import_module
+from typing import List, NamedTuple, Optional
+
+
+class Subcommand(NamedTuple):
+    """A subcommand and the module defining ``add_<name>_parser`` and ``run_<name>``."""
+    module: str
+    help: str
+
+
+# Subcommand modules are imported only when their subcommand runs: the
+# report and onboard modules pull in pyelftools, the demanglers and every
+# linker parser, which `membrowse summary` never needs.
+SUBCOMMANDS = {
+    'report': Subcommand(
+        '.commands.report', 'Generate memory footprint report from ELF and linker scripts'),
+    'onboard': Subcommand(
+        '.commands.onboard', 'Analyze memory footprints across historical commits for onboarding'),
+    'summary': Subcommand(
+        '.commands.summary', 'Retrieve memory footprint summary for a commit'),
+    'diff': Subcommand(
+        '.commands.diff', 'Compare the memory footprint of two builds locally'),
+    'bench': Subcommand(
+        '.commands.bench', 'Benchmark report generation stages on the test fixtures'),
+    'serve': Subcommand(
+        '.commands.serve', 'Run a daemon that keeps caches warm for repeated reports'),
+}
 
 LOG_LEVELS = {
     "INFO": logging.INFO,
@@ -19,10 +42,39 @@ LOG_LEVELS = {
     "DEBUG": logging.DEBUG,
 }
 
-def create_parser() -> argparse.ArgumentParser:
+def _command_module(name: str):
+    return import_module(SUBCOMMANDS[name].module, __package__)
+
+
+# Global options that take a separate value (``-v DEBUG``)
+_GLOBAL_VALUE_OPTIONS = ('-v', '--verbose')
+
+
+def selected_subcommand(argv: List[str]) -> Optional[str]:
+    """The subcommand named on the command line, if any.
+
+    That is the first token after the global options, as argparse sees it,
+    so an argument that happens to equal a subcommand name is not mistaken
+    for one.
+    """
+    args = iter(argv)
+    for arg in args:
+        if arg in _GLOBAL_VALUE_OPTIONS:
+            next(args, None)
+        elif not arg.startswith('-'):
+            return arg if arg in SUBCOMMANDS else None
+    return None
+
+
+def create_parser(argv: Optional[List[str]] = None) -> argparse.ArgumentParser:
     """
     Create the main argument parser with subcommands.
 
+    Args:
+        argv: Command line about to be parsed. Only the subcommand it
+            selects gets its full parser (the others are listed but their
+            modules are not imported). None builds every subcommand.
+
     Returns:
         Configured ArgumentParser
     """
@@ -35,6 +87,9 @@ subcommands:
   report    Generate memory footprint report (local or upload mode)
   onboard   Analyze and upload memory footprints across historical commits
   summary   Retrieve memory footprint summary for a commit
+  diff      Compare the memory footprint of two builds locally
+  bench     Benchmark report generation stages on the test fixtures
+  serve     Keep caches warm in a daemon that `report` uses automatically
 
 examples:
   # Local mode - human-readable output (default)
@@ -58,10 +113,22 @@ examples:
   # Summary - get memory footprint summary for a commit
   membrowse summary abc123 --api-key "$API_KEY"
 
+  # Diff - what grew between two builds, without uploading
+  membrowse diff base/firmware.elf build/firmware.elf "linker.ld"
+
+  # Bench - time report stages on the test fixtures (from a source checkout)
+  membrowse bench --output bench.json
+
+  # Serve - later `membrowse report` runs are answered by the warm daemon
+  membrowse serve &
+
 For more help on a subcommand:
   membrowse report --help
   membrowse onboard --help
   membrowse summary --help
+  membrowse diff --help
+  membrowse bench --help
+  membrowse serve --help
         """
     )
 
@@ -82,9 +149,12 @@ For more help on a subcommand:
     )
 
     # Add subcommand parsers
-    add_report_parser(subparsers)
-    add_onboard_parser(subparsers)
-    add_summary_parser(subparsers)
+    selected = None if argv is None else selected_subcommand(argv)
+    for name, subcommand in SUBCOMMANDS.items():
+        if argv is None or name == selected:
+            getattr(_command_module(name), f'add_{name}_parser')(subparsers)
+        else:
+            subparsers.add_parser(name, help=subcommand.help)
 
     return parser
 
@@ -96,8 +166,9 @@ def main() -> int:
     Returns:
         Exit code (0 for success, non-zero for error)
     """
-    parser = create_parser()
-    args = parser.parse_args()
+    argv = sys.argv[1:]
+    parser = create_parser(argv)
+    args = parser.parse_args(argv)
 
     logging.basicConfig(
         level=LOG_LEVELS[args.verbose],
@@ -106,12 +177,8 @@ def main() -> int:
     )
 
     # Route to appropriate subcommand
-    if args.subcommand == 'report':
-        return run_report(args)
-    if args.subcommand == 'onboard':
-        return run_onboard(args)
-    if args.subcommand == 'summary':
-        return run_summary(args)
+    if args.subcommand in SUBCOMMANDS:
+        return getattr(_command_module(args.subcommand), f'run_{args.subcommand}')(args)
     parser.print_help()
     return 1
 
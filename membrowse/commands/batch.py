@@ -0,0 +1,290 @@
+"""Manifest mode of the report subcommand - many targets in one run.
+
+Projects building dozens of board targets would otherwise start one
+``membrowse report`` process per target, each paying for Python startup
+and imports and re-parsing the same linker scripts. With ``--manifest``
+the targets are analyzed in a pool of long-lived worker processes (which
+keep their demangle and linker-parse caches between targets), uploads run
+concurrently while later targets are still being analyzed, and the
+combined result list for the PR comment action is written at the end.
+"""
+
+import argparse
+import json
+import logging
+import os
+import sys
+from concurrent.futures import ProcessPoolExecutor, ThreadPoolExecutor, as_completed
+from concurrent.futures.process import BrokenProcessPool
+from typing import Any, Dict, Iterator, List, NamedTuple, Optional, Tuple
+
+from elftools.common.exceptions import ELFError
+
+from ..analysis.dwarf import resolve_jobs
+from ..utils.cache import cache_dir_from_args
+from ..utils.formatter import format_report_human_readable
+from ..utils.timing import active_recorder, merge_recording, recording
+from .report import (
+    generate_report, _build_commit_info, _parse_linker_definitions,
+    _upload_and_check_alerts, _validate_file_paths, _validate_limits_input,
+    _validate_profile_path, _validate_upload_arguments,
+)
+
+logger = logging.getLogger(__name__)
+
+# Concurrent uploads; uploads are network bound, analysis is CPU bound
+UPLOAD_THREADS = 4
+
+_TARGET_FIELDS = frozenset((
+    'target_name', 'elf_path', 'ld_scripts', 'map_file', 'limits',
+    'skip_sections', 'defs'))
+_PATH_FIELDS = ('elf_path', 'map_file', 'limits')
+
+
+class ManifestTarget(NamedTuple):
+    """One target of a manifest, with paths resolved."""
+    target_name: str
+    elf_path: str
+    ld_scripts: Optional[str]
+    map_file: Optional[str]
+    limits: Optional[str]
+    skip_sections: Optional[List[str]]
+    linker_variables: Optional[Dict[str, str]]
+
+
+def load_manifest(path: str,
+                  linker_variables: Optional[Dict[str, str]] = None
+                  ) -> List[ManifestTarget]:
+    """Read and validate a targets manifest.
+
+    The manifest is a JSON list of target objects, or an object holding it
+    under ``targets``. Each target has ``target_name`` and ``elf_path``
+    and optionally ``ld_scripts`` (a list, or a space-separated string),
+    ``map_file``, ``limits``, ``skip_sections`` and ``defs`` (linker
+    variables, overriding the ``--def`` values). Relative paths are
+    relative to the manifest.
+
+    Args:
+        path: Manifest file
+        linker_variables: ``--def`` variables applied to every target
+
+    Returns:
+        Targets in manifest order
+
+    Raises:
+        ValueError: If the manifest is unreadable or a target is invalid
+    """
+    try:
+        with open(path, 'r', encoding='utf-8') as f:
+            data = json.load(f)
+    except (OSError, ValueError) as e:
+        raise ValueError(f"Cannot read manifest {path}: {e}") from e
+
+    entries = data.get('targets') if isinstance(data, dict) else data
+    if not isinstance(entries, list) or not entries:
+        raise ValueError(f"Manifest {path} lists no targets")
+
+    base_dir = os.path.dirname(os.path.abspath(path))
+    targets = []
+    for index, entry in enumerate(entries):
+        target = _parse_target(entry, base_dir, linker_variables)
+        if not target.target_name:
+            raise ValueError(f"Manifest target #{index + 1} has no target_name")
+        targets.append(target)
+
+    names = [target.target_name for target in targets]
+    duplicates = sorted({name for name in names if names.count(name) > 1})
+    if duplicates:
+        raise ValueError(f"Duplicate target_name in manifest: {', '.join(duplicates)}")
+    return targets
+
+
+def _parse_target(entry: Any, base_dir: str,
+                  linker_variables: Optional[Dict[str, str]]) -> ManifestTarget:
+    if not isinstance(entry, dict):
+        raise ValueError(f"Manifest targets must be objects, got {entry!r}")
+    unknown = sorted(set(entry) - _TARGET_FIELDS)
+    if unknown:
+        raise ValueError(f"Unknown manifest field(s): {', '.join(unknown)}")
+    name = str(entry.get('target_name') or '')
+    if not entry.get('elf_path'):
+        raise ValueError(f"Manifest target '{name}' has no elf_path")
+
+    paths = {field: os.path.join(base_dir, entry[field])
+             for field in _PATH_FIELDS if entry.get(field)}
+    scripts = entry.get('ld_scripts') or []
+    if isinstance(scripts, str):
+        scripts = scripts.split()
+    scripts = [os.path.join(base_dir, script) for script in scripts]
+
+    error = (_validate_file_paths(paths['elf_path'], scripts)[1]
+             or _validate_limits_input(paths.get('limits'), scripts))
+    if error:
+        raise ValueError(f"{name}: {error}")
+
+    variables = dict(linker_variables or {})
+    variables.update({key: str(value) for key, value in (entry.get('defs') or {}).items()})
+    return ManifestTarget(
+        target_name=name,
+        elf_path=paths['elf_path'],
+        ld_scripts=' '.join(scripts) or None,
+        map_file=paths.get('map_file'),
+        limits=paths.get('limits'),
+        skip_sections=list(entry.get('skip_sections') or []) or None,
+        linker_variables=variables or None,
+    )
+
+
+def validate_manifest_args(args: argparse.Namespace) -> Optional[str]:
+    """Validate ``--manifest`` arguments, returning an error message or None."""
+    if not os.path.isfile(args.manifest):
+        return f"Manifest not found: {args.manifest}"
+    if args.elf_path or args.ld_scripts:
+        return "--manifest replaces the elf_path and ld_scripts arguments"
+    if getattr(args, 'identical', False):
+        return "--identical cannot be used with --manifest"
+    if getattr(args, 'target_name', None):
+        return "--target-name cannot be used with --manifest (set target_name per target)"
+    if getattr(args, 'upload', False):
+        # Any name: every manifest target has one
+        is_valid, error_message = _validate_upload_arguments(
+            getattr(args, 'api_key', None), 'manifest',
+            is_github_mode=getattr(args, 'github', False))
+        if not is_valid:
+            return error_message
+    return _validate_profile_path(getattr(args, 'profile', None))
+
+
+def _analyze_target(target: ManifestTarget,
+                    options: Dict[str, Any]) -> Tuple[Optional[dict], Optional[str]]:
+    """Generate the report of one target (runs in a worker process).
+
+    Errors are returned rather than raised, so that one unreadable target
+    is not mistaken by :func:`_iter_reports` for a broken worker pool.
+
+    Returns:
+        Tuple of (report, None), or (None, error message) on failure
+    """
+    try:
+        return generate_report(
+            elf_path=target.elf_path,
+            ld_scripts=target.ld_scripts,
+            linker_variables=target.linker_variables,
+            map_file=target.map_file,
+            limits_ld=target.limits,
+            skip_sections=target.skip_sections,
+            **options,
+        ), None
+    except (ValueError, OSError, ELFError) as e:
+        return None, str(e)
+
+
+def _analyze_target_profiled(target: ManifestTarget, options: Dict[str, Any]):
+    """:func:`_analyze_target` in a worker process, with its recording for ``--profile``."""
+    with recording() as recorder:
+        result = _analyze_target(target, options)
+    return result, recorder.export()
+
+
+def _iter_reports(targets: List[ManifestTarget], options: Dict[str, Any],
+                  workers: int) -> Iterator[Tuple[ManifestTarget, Optional[dict], Optional[str]]]:
+    """Yield (target, report, error) for every target as its analysis completes."""
+    pending = list(targets)
+    if workers > 1:
+        profile = active_recorder() is not None
+        analyze = _analyze_target_profiled if profile else _analyze_target
+        try:
+            with ProcessPoolExecutor(max_workers=workers) as pool:
+                futures = {pool.submit(analyze, target, options): target
+                           for target in targets}
+                for future in as_completed(futures):
+                    result = future.result()
+                    if profile:
+                        result, worker = result
+                        merge_recording(worker)
+                    pending.remove(futures[future])
+                    yield (futures[future],) + result
+        # Pool start-up failures only; target errors come back as results
+        except (OSError, NotImplementedError, BrokenProcessPool) as e:
+            logger.warning(
+                "Worker processes unavailable (%s), analyzing the %d remaining "
+                "targets serially", e, len(pending))
+    for target in pending:
+        yield (target,) + _analyze_target(target, options)
+
+
+def run_manifest(args: argparse.Namespace) -> int:
+    """Analyze (and optionally upload) every target of ``--manifest``.
+
+    Returns:
+        Exit code: 1 if any target failed or exceeded a budget (unless
+        ``--dont-fail-on-alerts``), else 0
+    """
+    try:
+        targets = load_manifest(
+            args.manifest, _parse_linker_definitions(getattr(args, 'linker_defs', None)))
+    except ValueError as e:
+        logger.error("%s", e)
+        return 1
+
+    workers = min(resolve_jobs(getattr(args, 'jobs', 1)), len(targets))
+    options = {
+        'skip_line_program': getattr(args, 'skip_line_program', False),
+        'lazy_line_program': getattr(args, 'lazy_line_program', False),
+        # Parallelism is across targets; nested DWARF pools would oversubscribe
+        'jobs': 1 if workers > 1 else getattr(args, 'jobs', 1),
+        'cache_dir': cache_dir_from_args(args),
+        'native_demangler': getattr(args, 'native_demangler', False),
+    }
+    upload_mode = getattr(args, 'upload', False)
+    commit_info = _build_commit_info(args) if upload_mode else None
+    logger.info("Analyzing %d targets in %d worker process(es)", len(targets), workers)
+
+    exit_code = 0
+    reports: Dict[str, dict] = {}
+    results: List[dict] = []
+    with ThreadPoolExecutor(max_workers=UPLOAD_THREADS) as uploader:
+        uploads = {}
+        for target, report, error in _iter_reports(targets, options, workers):
+            if error:
+                logger.error("%s: Failed to generate report: %s", target.target_name, error)
+                exit_code = 1
+            elif upload_mode:
+                uploads[uploader.submit(_upload_and_check_alerts, report, args,
+                                        commit_info, target.target_name)] = target
+            else:
+                reports[target.target_name] = report
+        for future in as_completed(uploads):
+            try:
+                alert_code, raw_response = future.result()
+            except (ValueError, RuntimeError) as e:
+                logger.error("%s: Failed to upload report: %s", uploads[future].target_name, e)
+                exit_code = 1
+                continue
+            exit_code = max(exit_code, alert_code)
+            results.append(raw_response)
+
+    if upload_mode:
+        if getattr(args, 'output_raw_response', False):
+            results.sort(key=lambda result: result['target_name'])
+            json.dump(results, sys.stdout, indent=2)
+            sys.stdout.write('\n')
+        elif exit_code:
+            logger.error("One or more targets failed or exceeded a budget")
+    else:
+        _print_reports(args, [(target.target_name, reports[target.target_name])
+                              for target in targets if target.target_name in reports])
+    return exit_code
+
+
+def _print_reports(args: argparse.Namespace, reports: List[Tuple[str, dict]]) -> None:
+    """Write local-mode reports in manifest order."""
+    if getattr(args, 'json', False):
+        json.dump([{'target_name': name, 'report': report} for name, report in reports],
+                  sys.stdout, indent=2)
+        sys.stdout.write('\n')
+        return
+    show_all_symbols = getattr(args, 'all_symbols', False)
+    for name, report in reports:
+        print(f"==== {name} ====")
+        print(format_report_human_readable(report, show_all_symbols=show_all_symbols))
@@ -0,0 +1,373 @@
+"""Bench subcommand - times the report pipeline stages on the test fixtures."""
+
+import argparse
+import functools
+import json
+import logging
+import platform
+import statistics
+import subprocess
+import sys
+import time
+from importlib.metadata import version, PackageNotFoundError
+from pathlib import Path
+from typing import Any, Dict, List, NamedTuple, Optional, Tuple
+
+from ..analysis.symbols import clear_demangle_caches
+from ..linker.parser import parse_linker_scripts
+from ..utils.json_stream import iter_json
+from ..utils.timing import STAGES, recording, stage
+from .report import generate_report
+
+logger = logging.getLogger(__name__)
+
+DEFAULT_FIXTURES_DIR = 'tests'
+DEFAULT_REPEAT = 3
+DEFAULT_MAX_REGRESSION = 20.0
+
+# Stage medians below this are too noisy to compare against a baseline
+MIN_COMPARED_SECONDS = 0.005
+
+BENCH_FORMAT_VERSION = 1
+
+DEFAULT_STARTUP_REPEAT = 10
+
+_ESP32_LD = 'fixtures/micropython/esp32/linker'
+
+
+class BenchCase(NamedTuple):
+    """A fixture to benchmark; paths are relative to the fixtures directory."""
+    name: str
+    elf: Optional[str]
+    ld_scripts: Tuple[str, ...]
+
+
+BENCH_CASES = (
+    BenchCase('micropython-stm32', 'fixtures/micropython/stm32/firmware.elf',
+              ('fixtures/micropython/stm32/linker/stm32f405.ld',)),
+    BenchCase('micropython-esp32', 'fixtures/micropython/esp32/micropython.elf', (
+        f'{_ESP32_LD}/esp-idf/esp_system/ld/memory.ld',
+        f'{_ESP32_LD}/esp-idf/esp_system/ld/sections.ld',
+        f'{_ESP32_LD}/soc/esp32/ld/esp32.peripherals.ld',
+    ) + tuple(f'{_ESP32_LD}/esp_rom/esp32/ld/esp32.rom{suffix}.ld' for suffix in (
+        '', '.api', '.libgcc', '.newlib-data', '.syscalls', '.newlib-funcs',
+        '.newlib-time', '.newlib-nano', '.newlib-locale', '.eco3', '.redefined',
+        '.spiflash_legacy'))),
+    BenchCase('iar-stm32f407', None, ('linker_scripts/stm32f407xx_flash.icf',)),
+    BenchCase('ti-linker-cmd', None, ('fixtures/linkers/linker.cmd',)),
+    BenchCase('gnu-ternary', None, ('fixtures/linkers/linker_ternary.ld',)),
+)
+
+
+# Short command lines timed by --startup (Python interpreter arguments).
+# None of them should import pyelftools, the demanglers or the linker parsers.
+STARTUP_COMMANDS = (
+    ('python', ('-c', 'pass')),
+    ('import', ('-c', 'import membrowse')),
+    ('help', ('-m', 'membrowse', '--help')),
+    ('summary-help', ('-m', 'membrowse', 'summary', '--help')),
+    ('comment-help', ('-m', 'membrowse.utils.github_comment', '--help')),
+)
+
+
+def add_bench_parser(subparsers) -> argparse.ArgumentParser:
+    """Add 'bench' subcommand parser."""
+    parser = subparsers.add_parser(
+        'bench',
+        help='Benchmark report generation stages on the test fixtures',
+        description=(
+            'Time each report stage (linker parse, ELF open, DWARF CU index,\n'
+            'line programs, DIE walk, symbol extraction, source resolution,\n'
+            'region mapping, serialization) on the bundled fixtures and print\n'
+            'the results as JSON.\n\n'
+            'Runs serially and without caches so that results are comparable.\n'
+            'Run from a source checkout or pass --fixtures-dir.'
+        ),
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+    )
+    parser.add_argument(
+        '--fixtures-dir',
+        default=DEFAULT_FIXTURES_DIR,
+        metavar='DIR',
+        help=f'Directory holding the fixtures (default: {DEFAULT_FIXTURES_DIR})',
+    )
+    parser.add_argument(
+        '--case',
+        action='append',
+        dest='cases',
+        choices=[case.name for case in BENCH_CASES],
+        help='Only run this case (repeatable; default: all)',
+    )
+    parser.add_argument(
+        '--repeat',
+        type=int,
+        metavar='N',
+        help=f'Runs per case; medians are reported (default: {DEFAULT_REPEAT})',
+    )
+    parser.add_argument(
+        '--startup',
+        action='store_true',
+        help=('Time the startup of short commands (`import membrowse`, '
+              '`membrowse summary --help`, ...) in fresh interpreters instead of the '
+              f'fixtures; --repeat defaults to {DEFAULT_STARTUP_REPEAT}'),
+    )
+    parser.add_argument(
+        '--max-startup',
+        type=float,
+        metavar='MS',
+        help='With --startup, exit 1 if a median startup time exceeds MS milliseconds',
+    )
+    parser.add_argument(
+        '--output',
+        metavar='FILE',
+        help='Write the JSON results to FILE instead of stdout',
+    )
+    parser.add_argument(
+        '--baseline',
+        metavar='FILE',
+        help='Compare against earlier results and exit 1 on a regression',
+    )
+    parser.add_argument(
+        '--max-regression',
+        type=float,
+        default=DEFAULT_MAX_REGRESSION,
+        metavar='PCT',
+        help=('Allowed slowdown of a case or stage median against --baseline, '
+              f'in percent (default: {DEFAULT_MAX_REGRESSION:g})'),
+    )
+    return parser
+
+
+def _is_elf(path: Path) -> bool:
+    """Whether ``path`` is an ELF (and not e.g. a Git LFS pointer)."""
+    try:
+        with open(path, 'rb') as f:
+            return f.read(4) == b'\x7fELF'
+    except OSError:
+        return False
+
+
+def _missing_inputs(case: BenchCase, root: Path) -> Optional[str]:
+    """Reason the case cannot run, or None."""
+    for script in case.ld_scripts:
+        if not (root / script).exists():
+            return f"linker script not found: {root / script}"
+    if case.elf is not None and not _is_elf(root / case.elf):
+        return f"not an ELF file (run 'git lfs pull'?): {root / case.elf}"
+    return None
+
+
+def _run_once(case: BenchCase, root: Path) -> Tuple[float, Dict[str, float], int]:
+    """Run a case once.
+
+    Returns:
+        (wall seconds, self seconds per stage, symbol count)
+    """
+    ld_scripts = [str(root / script) for script in case.ld_scripts]
+    clear_demangle_caches()
+    with recording(keep_events=False) as recorder:
+        start = time.perf_counter()
+        if case.elf is None:
+            with stage('linker_parse'):
+                parse_linker_scripts(ld_scripts)
+            symbol_count = 0
+        else:
+            report = generate_report(str(root / case.elf), ' '.join(ld_scripts))
+            with stage('serialization'):
+                for _ in iter_json(report):
+                    pass
+            symbol_count = len(report.get('symbols', []))
+        wall = time.perf_counter() - start
+    return wall, dict(recorder.self_times), symbol_count
+
+
+def run_case(case: BenchCase, root: Path, repeat: int) -> Dict[str, Any]:
+    """Benchmark one case ``repeat`` times.
+
+    Returns:
+        Result dict with wall time and per-stage self time medians, or a
+        ``skipped`` status when the fixture is not available
+    """
+    reason = _missing_inputs(case, root)
+    if reason:
+        logger.warning("Skipping %s: %s", case.name, reason)
+        return {'name': case.name, 'status': 'skipped', 'reason': reason}
+
+    walls = []
+    stage_runs: Dict[str, List[float]] = {name: [] for name in STAGES}
+    symbol_count = 0
+    for _ in range(repeat):
+        wall, self_times, symbol_count = _run_once(case, root)
+        walls.append(wall)
+        for name, seconds in stage_runs.items():
+            seconds.append(self_times.get(name, 0.0))
+
+    wall_median = statistics.median(walls)
+    stages = {name: statistics.median(runs) for name, runs in stage_runs.items()
+              if any(runs)}
+    logger.info("%s: %.3fs median over %d run(s)", case.name, wall_median, repeat)
+    return {
+        'name': case.name,
+        'status': 'ok',
+        'runs': repeat,
+        'symbols': symbol_count,
+        'wall_seconds': {'median': wall_median, 'min': min(walls)},
+        'stage_seconds': stages,
+        # Time outside any stage (report assembly, DWARF bookkeeping)
+        'other_seconds': max(0.0, wall_median - sum(stages.values())),
+    }
+
+
+def run_startup_case(name: str, argv: Tuple[str, ...], repeat: int) -> Dict[str, Any]:
+    """Time ``python <argv>`` in a fresh interpreter ``repeat`` times.
+
+    Returns:
+        Result dict in the shape of :func:`run_case` (without stages)
+
+    Raises:
+        subprocess.CalledProcessError: If the command fails
+    """
+    command = [sys.executable, *argv]
+    walls = []
+    for _ in range(repeat):
+        start = time.perf_counter()
+        subprocess.run(command, check=True, stdin=subprocess.DEVNULL,
+                       stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+        walls.append(time.perf_counter() - start)
+
+    wall_median = statistics.median(walls)
+    logger.info("startup-%s: %.1fms median over %d run(s)", name, wall_median * 1000, repeat)
+    return {
+        'name': f'startup-{name}',
+        'status': 'ok',
+        'runs': repeat,
+        'command': ' '.join(['python', *argv]),
+        'wall_seconds': {'median': wall_median, 'min': min(walls)},
+        'stage_seconds': {},
+    }
+
+
+def find_slow_startups(results: Dict[str, Any], max_startup_ms: float) -> List[str]:
+    """Describe every startup case whose median exceeds ``max_startup_ms``."""
+    return [f"{case['command']}: {case['wall_seconds']['median'] * 1000:.1f}ms "
+            f"(limit {max_startup_ms:g}ms)"
+            for case in results['cases']
+            if case['status'] == 'ok' and 'command' in case
+            and case['wall_seconds']['median'] * 1000 > max_startup_ms]
+
+
+def _package_version() -> str:
+    try:
+        return version('membrowse')
+    except PackageNotFoundError:
+        return 'unknown'
+
+
+def find_regressions(results: Dict[str, Any], baseline: Dict[str, Any],
+                     max_regression: float) -> List[str]:
+    """Describe every case or stage median more than ``max_regression``
+    percent slower than in ``baseline``."""
+    limit = 1 + max_regression / 100
+    previous = {case['name']: case for case in baseline.get('cases', [])
+                if case.get('status') == 'ok'}
+    regressions = []
+    for case in results['cases']:
+        old = previous.get(case['name'])
+        if case['status'] != 'ok' or old is None:
+            continue
+        timings = [('wall', case['wall_seconds']['median'],
+                    old['wall_seconds']['median'])]
+        timings += [(name, seconds, old.get('stage_seconds', {}).get(name))
+                    for name, seconds in case['stage_seconds'].items()]
+        for name, seconds, old_seconds in timings:
+            if old_seconds is None or max(seconds, old_seconds) < MIN_COMPARED_SECONDS:
+                continue
+            if seconds > old_seconds * limit:
+                regressions.append(
+                    f"{case['name']} {name}: {old_seconds:.3f}s -> {seconds:.3f}s "
+                    f"(+{(seconds / old_seconds - 1) * 100:.0f}%)")
+    return regressions
+
+
+def run_bench(args: argparse.Namespace) -> int:
+    """
+    Execute the bench subcommand.
+
+    Args:
+        args: Parsed command-line arguments
+
+    Returns:
+        Exit code (0 for success, 1 for errors or regressions)
+    """
+    startup = getattr(args, 'startup', False)
+    repeat = args.repeat
+    if repeat is None:
+        repeat = DEFAULT_STARTUP_REPEAT if startup else DEFAULT_REPEAT
+    if repeat < 1:
+        logger.error("--repeat must be at least 1")
+        return 1
+
+    root = Path(args.fixtures_dir)
+    if not startup and not root.is_dir():
+        logger.error("Fixtures directory not found: %s", root)
+        return 1
+
+    baseline = None
+    if args.baseline:
+        try:
+            with open(args.baseline, 'r', encoding='utf-8') as f:
+                baseline = json.load(f)
+        except (OSError, ValueError) as e:
+            logger.error("Cannot read baseline %s: %s", args.baseline, e)
+            return 1
+
+    if startup:
+        runs = [functools.partial(run_startup_case, name, argv, repeat)
+                for name, argv in STARTUP_COMMANDS]
+        names = [f'startup-{name}' for name, _ in STARTUP_COMMANDS]
+    else:
+        selected = [case for case in BENCH_CASES
+                    if not args.cases or case.name in args.cases]
+        runs = [functools.partial(run_case, case, root, repeat) for case in selected]
+        names = [case.name for case in selected]
+    results = {
+        'format_version': BENCH_FORMAT_VERSION,
+        'membrowse_version': _package_version(),
+        'python': platform.python_version(),
+        'platform': platform.platform(),
+        'cases': [],
+    }
+    for name, run in zip(names, runs):
+        try:
+            results['cases'].append(run())
+        except Exception as e:  # pylint: disable=broad-exception-caught
+            logger.error("Benchmark %s failed: %s", name, e)
+            results['cases'].append(
+                {'name': name, 'status': 'failed', 'reason': str(e)})
+
+    if args.output:
+        with open(args.output, 'w', encoding='utf-8') as f:
+            json.dump(results, f, indent=2)
+            f.write('\n')
+    else:
+        json.dump(results, sys.stdout, indent=2)
+        sys.stdout.write('\n')
+
+    failed = [case['name'] for case in results['cases'] if case['status'] == 'failed']
+    if failed:
+        return 1
+
+    status = 0
+    max_startup = getattr(args, 'max_startup', None)
+    if startup and max_startup is not None:
+        for slow in find_slow_startups(results, max_startup):
+            logger.error("Slow startup: %s", slow)
+            status = 1
+
+    if baseline is not None:
+        regressions = find_regressions(results, baseline, args.max_regression)
+        for regression in regressions:
+            logger.error("Regression: %s", regression)
+        if regressions:
+            status = 1
+    return status
@@ -0,0 +1,239 @@
+"""Diff subcommand - compares the memory footprint of two builds locally."""
+
+import argparse
+import json
+import logging
+from pathlib import Path
+from typing import Any, Dict, Optional
+
+from ..core.diff import as_summary_response, diff_reports
+from ..utils.cache import cache_dir_from_args
+from ..utils.daemon import request_report
+from ..utils.formatter import format_diff_human_readable
+from ..utils.summary_formatter import build_summary_template_context, render_jinja2_template
+from .report import generate_report, _parse_linker_definitions
+from .summary import DEFAULT_TEMPLATE
+
+logger = logging.getLogger(__name__)
+
+
+def add_diff_parser(subparsers) -> argparse.ArgumentParser:
+    """Add 'diff' subcommand parser."""
+    parser = subparsers.add_parser(
+        'diff',
+        help='Compare the memory footprint of two builds locally',
+        description=(
+            'Compare two builds without uploading them: region, section,\n'
+            'archive and symbol size changes from base to head.\n\n'
+            'Each build is an ELF file, analyzed like `membrowse report`\n'
+            '(by a running `membrowse serve` daemon if there is one), or a\n'
+            'saved `membrowse report --json` output. With --cache both ELFs\n'
+            'share the on-disk cache, so the compilation units head has in\n'
+            'common with base are not decoded twice.\n\n'
+            'Symbols are matched by demangled name, section and source file,\n'
+            'ignoring compiler clone suffixes such as .constprop.0 and .part.1;\n'
+            'unambiguous renames and moves to another source file are\n'
+            'reported as moved.'
+        ),
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+        epilog="""
+examples:
+  # What grew between two builds
+  membrowse diff base/firmware.elf build/firmware.elf "linker.ld"
+
+  # Diff against a report saved earlier, as JSON
+  membrowse report base/firmware.elf "linker.ld" --json > base.json
+  membrowse diff base.json build/firmware.elf "linker.ld" --json
+
+  # Markdown for a PR comment, from the built-in comment template
+  membrowse diff base/firmware.elf build/firmware.elf "linker.ld" --markdown
+        """
+    )
+
+    parser.add_argument('base', help='Base build: ELF file or JSON report')
+    parser.add_argument('head', help='Head build: ELF file or JSON report')
+    parser.add_argument(
+        'ld_scripts',
+        nargs='?',
+        default=None,
+        help='Space-separated linker script paths used for both ELFs (optional - '
+             'if omitted, uses default Code/Data regions)')
+
+    analysis_group = parser.add_argument_group('analysis options')
+    analysis_group.add_argument(
+        '--map-file',
+        dest='map_files',
+        nargs=2,
+        default=None,
+        metavar=('BASE_MAP', 'HEAD_MAP'),
+        help='Linker map files of the two builds for archive/object file attribution'
+    )
+    analysis_group.add_argument(
+        '--def',
+        dest='linker_defs',
+        action='append',
+        metavar='VAR=VALUE',
+        help='Define linker script variable (can be specified multiple times)'
+    )
+    analysis_group.add_argument(
+        '--skip-section',
+        dest='skip_sections',
+        action='append',
+        metavar='NAME',
+        help='Exclude an ELF section by exact name (can be specified multiple times)'
+    )
+    line_program_group = analysis_group.add_mutually_exclusive_group()
+    line_program_group.add_argument(
+        '--skip-line-program',
+        action='store_true',
+        help='Skip DWARF line program processing for faster analysis'
+    )
+    line_program_group.add_argument(
+        '--lazy-line-program',
+        action='store_true',
+        help='Decode DWARF line programs only for CUs whose functions the '
+             'debug info entries do not attribute to a source file'
+    )
+    analysis_group.add_argument(
+        '--jobs',
+        type=int,
+        default=1,
+        metavar='N',
+        help='Process DWARF compilation units in N worker processes '
+             '(0 = one per CPU, default: 1)'
+    )
+    analysis_group.add_argument(
+        '--cache',
+        action='store_true',
+        help='Cache per-compilation-unit DWARF results on disk under '
+             '$XDG_CACHE_HOME/membrowse, shared by both ELFs and by later '
+             'runs, so compilation units they have in common are decoded once'
+    )
+    analysis_group.add_argument(
+        '--cache-dir',
+        default=None,
+        metavar='DIR',
+        help='Like --cache, but store the cache under DIR'
+    )
+    analysis_group.add_argument(
+        '--no-daemon',
+        action='store_true',
+        help='Analyze in this process even when a `membrowse serve` daemon is running'
+    )
+    analysis_group.add_argument(
+        '--native-demangler',
+        action='store_true',
+        help='Demangle C++ symbol names with c++filt or llvm-cxxfilt from PATH'
+    )
+
+    output_group = parser.add_argument_group('output options')
+    format_group = output_group.add_mutually_exclusive_group()
+    format_group.add_argument(
+        '--json',
+        action='store_true',
+        help='Output the changes as JSON (the changes_summary shape of the API)'
+    )
+    format_group.add_argument(
+        '--markdown',
+        action='store_true',
+        help='Render the built-in PR comment template'
+    )
+    format_group.add_argument(
+        '--template',
+        metavar='PATH',
+        help='Render a custom Jinja2 template (same context as `membrowse summary`)'
+    )
+    output_group.add_argument(
+        '--target-name',
+        default=None,
+        help='Target name shown by templates (default: head file name)'
+    )
+    output_group.add_argument(
+        '--all-symbols',
+        action='store_true',
+        help='Display all symbol changes instead of the top 20 (text output only)'
+    )
+
+    return parser
+
+
+def _load_report(path: str, options: Dict[str, Any], use_daemon: bool) -> Dict[str, Any]:
+    """Report of one build: a saved JSON report, or the ELF analyzed now.
+
+    Raises:
+        ValueError: If the file cannot be read or analyzed
+    """
+    if path.endswith('.json'):
+        try:
+            with open(path, 'r', encoding='utf-8') as f:
+                report = json.load(f)
+        except (OSError, ValueError) as e:
+            raise ValueError(f"Cannot read report {path}: {e}") from e
+        if not isinstance(report, dict) or 'symbols' not in report:
+            raise ValueError(f"{path} is not a membrowse report")
+        return report
+
+    options = {**options, 'elf_path': path}
+    report = request_report(options) if use_daemon else None
+    if report is None:
+        report = generate_report(**options)
+    return report
+
+
+def _render(diff: Dict[str, Any], args: argparse.Namespace) -> Optional[str]:
+    """Output text for the selected format, or None after a template error."""
+    if getattr(args, 'json', False):
+        return json.dumps(diff, indent=2)
+
+    template_path = getattr(args, 'template', None)
+    if template_path is None and not getattr(args, 'markdown', False):
+        return format_diff_human_readable(
+            diff, show_all=getattr(args, 'all_symbols', False))
+
+    # jinja2 is only needed for the rendered output
+    from jinja2 import TemplateError  # pylint: disable=import-outside-toplevel
+    target_name = getattr(args, 'target_name', None) or Path(args.head).name
+    try:
+        context = build_summary_template_context(as_summary_response(diff, target_name))
+        return render_jinja2_template(template_path or str(DEFAULT_TEMPLATE), context)
+    except (FileNotFoundError, TemplateError) as e:
+        logger.error("Template error: %s", e)
+        return None
+
+
+def run_diff(args: argparse.Namespace) -> int:
+    """
+    Execute the diff subcommand.
+
+    Args:
+        args: Parsed command-line arguments
+
+    Returns:
+        Exit code (0 for success, 1 for errors)
+    """
+    options = {
+        'ld_scripts': getattr(args, 'ld_scripts', None),
+        'skip_line_program': getattr(args, 'skip_line_program', False),
+        'linker_variables': _parse_linker_definitions(getattr(args, 'linker_defs', None)),
+        'skip_sections': getattr(args, 'skip_sections', None),
+        'jobs': getattr(args, 'jobs', 1),
+        'cache_dir': cache_dir_from_args(args),
+        'native_demangler': getattr(args, 'native_demangler', False),
+        'lazy_line_program': getattr(args, 'lazy_line_program', False),
+    }
+    map_files = getattr(args, 'map_files', None) or (None, None)
+    use_daemon = not getattr(args, 'no_daemon', False)
+
+    reports = []
+    for path, map_file in zip((args.base, args.head), map_files):
+        try:
+            reports.append(_load_report(path, {**options, 'map_file': map_file}, use_daemon))
+        except ValueError as e:
+            logger.error("Failed to generate report for %s: %s", path, e)
+            return 1
+
+    output = _render(diff_reports(*reports), args)
+    if output is None:
+        return 1
+    print(output)
+    return 0
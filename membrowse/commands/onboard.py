@@ -2,18 +2,36 @@
 """Onboard subcommand - historical analysis across multiple commits."""
 
 import os
+import copy
+import gzip
+import json
+import hashlib
+import itertools
+import queue
+import functools
+import shutil
+import bisect
+import tempfile
+import threading
 import subprocess
 import argparse
 import logging
+from concurrent.futures import FIRST_COMPLETED, ThreadPoolExecutor, wait
 from datetime import datetime
 
 from ..utils.git import (
-    run_git_command, get_commit_metadata,
-    git_checkout, git_submodule_update, git_clean,
+    run_git_command, get_commit_metadata, CommitMetadataCache,
+    git_checkout, git_submodule_update, git_submodule_update_changed, git_clean,
+    git_worktree_add, git_worktree_remove,
 )
-from ..api.client import MemBrowseClient
+from ..api.client import MemBrowseClient, DEFAULT_CONTENT_ENCODING
 from ..auth.strategy import determine_auth_strategy
-from .report import generate_report, upload_report, DEFAULT_API_URL, _parse_linker_definitions
+from ..utils.cache import cache_dir_from_args
+from ..utils.timing import count as count_event, profiling, sample_counters, stage
+from .report import (
+    generate_report, upload_report, add_upload_format_arguments,
+    DEFAULT_API_URL, _parse_linker_definitions, _validate_profile_path,
+)
 
 # Set up logger
 logger = logging.getLogger(__name__)
@@ -21,6 +39,12 @@ logger = logging.getLogger(__name__)
 # Sentinel to distinguish "no override" from "override with None"
 _NO_OVERRIDE = object()
 
+# Uploads that may wait behind the one being sent while builds continue
+DEFAULT_UPLOAD_QUEUE = 4
+
+# With --incremental, every Nth build is checked against a clean build
+DEFAULT_VERIFY_EVERY = 20
+
 
 def _create_empty_report(elf_path: str) -> dict:
     """
@@ -199,6 +223,45 @@ examples:
              'compares memory fingerprints, and only builds midpoints where changes are '
              'detected. Mutually exclusive with --build-dirs.'
     )
+    parser.add_argument(
+        '--workers',
+        dest='workers',
+        type=int,
+        default=1,
+        metavar='N',
+        help='With --binary-search, build up to N commits at once, each in its '
+             'own git worktree (default: 1, builds in the current checkout). '
+             'The build command runs at the same relative directory inside each '
+             'worktree; paths given to onboard are mapped into it.'
+    )
+    parser.add_argument(
+        '--incremental',
+        dest='incremental',
+        action='store_true',
+        help='Build on top of the previous commit\'s build output instead of '
+             'running git clean -fdx before every build, and only update '
+             'submodules whose commit changed. With --workers, the worktrees '
+             'are kept between runs. Relies on the build system (make, ninja, '
+             'CMake, idf.py, west) to rebuild what changed.'
+    )
+    parser.add_argument(
+        '--clean-worktrees',
+        dest='clean_worktrees',
+        action='store_true',
+        help='With --incremental and --workers, remove the kept worktrees '
+             '(<git-common-dir>/membrowse-worktrees) and their build output '
+             'when the run ends instead of keeping them for the next run.'
+    )
+    parser.add_argument(
+        '--verify-every',
+        dest='verify_every',
+        type=int,
+        default=DEFAULT_VERIFY_EVERY,
+        metavar='N',
+        help='With --incremental, rebuild every Nth built commit from a clean '
+             'tree, warn if its ELF differs from the incremental build and '
+             f'report the clean build (default: {DEFAULT_VERIFY_EVERY}; 0 never verifies)'
+    )
     parser.add_argument(
         '--dry-run',
         dest='dry_run',
@@ -206,6 +269,17 @@ examples:
         help='Run the full onboard workflow (checkout, build, analyze) but skip '
              'uploading reports. Logs what would be uploaded for each commit.'
     )
+    parser.add_argument(
+        '--upload-queue',
+        dest='upload_queue',
+        type=int,
+        default=DEFAULT_UPLOAD_QUEUE,
+        metavar='N',
+        help='Upload reports on a background thread, in commit order, while '
+             'the next commits are checked out and built. Up to N finished '
+             f'reports wait for upload before builds pause (default: {DEFAULT_UPLOAD_QUEUE}; '
+             '0 uploads each report before the next build).'
+    )
     parser.add_argument(
         '--map-file',
         dest='map_file',
@@ -238,6 +312,53 @@ examples:
              'onboarding. Omit when the binary fits — --ld-scripts is already '
              'the real limit.'
     )
+    add_upload_format_arguments(parser)
+    parser.add_argument(
+        '--jobs',
+        dest='jobs',
+        type=int,
+        default=1,
+        metavar='N',
+        help='Process DWARF compilation units of each commit\'s ELF in N '
+             'worker processes (0 = one per CPU, default: 1)'
+    )
+    parser.add_argument(
+        '--cache',
+        dest='cache',
+        action='store_true',
+        help='Cache per-compilation-unit DWARF results on disk under '
+             '$XDG_CACHE_HOME/membrowse. CUs that are byte-identical between '
+             'commits (vendor HALs, libc, SDK components) are decoded once, '
+             'commits producing a byte-identical ELF reuse the whole report, '
+             'and parsed linker scripts are reused across runs.'
+    )
+    parser.add_argument(
+        '--cache-dir',
+        dest='cache_dir',
+        default=None,
+        metavar='DIR',
+        help='Like --cache, but store the cache under DIR. DIR must be '
+             'outside the repository: each commit is checked out with '
+             'git clean -fdx, which deletes untracked files.'
+    )
+    parser.add_argument(
+        '--native-demangler',
+        dest='native_demangler',
+        action='store_true',
+        help='Demangle C++ symbol names with c++filt or llvm-cxxfilt from '
+             'PATH in one batch per commit. Demangled names are also reused '
+             'across commits.'
+    )
+    parser.add_argument(
+        '--profile',
+        dest='profile',
+        default=None,
+        metavar='FILE',
+        help='Write a Chrome trace-event profile of the whole run to FILE, '
+             'with one span per commit (checkout, build, analysis) and '
+             'uploads. Counters are sampled after every commit. Place FILE '
+             'outside the repository.'
+    )
 
     return parser
 
@@ -369,18 +490,24 @@ def _commit_has_changes_in_dirs(commit: str, build_dirs: list[str]) -> bool:
     Returns:
         True if commit has changes in any of the build_dirs, False otherwise
     """
-    # Get parent commit (handle first commit case)
-    parent = run_git_command(['rev-parse', f'{commit}^'])
-    if not parent:
-        # First commit - always consider as having changes
-        return True
-
-    # Get list of changed files between parent and commit
-    changed_files = run_git_command(['diff', '--name-only', parent, commit])
-    if not changed_files:
-        return False
+    metadata = CommitMetadataCache.get(commit)
+    if metadata is not None:
+        if not metadata['parent_sha']:
+            return True
+        changed_list = CommitMetadataCache.changed_paths(commit)
+    else:
+        # Get parent commit (handle first commit case)
+        parent = run_git_command(['rev-parse', f'{commit}^'])
+        if not parent:
+            # First commit - always consider as having changes
+            return True
+
+        # Get list of changed files between parent and commit
+        changed_files = run_git_command(['diff', '--name-only', parent, commit])
+        if not changed_files:
+            return False
 
-    changed_list = [f.strip() for f in changed_files.split('\n') if f.strip()]
+        changed_list = [f.strip() for f in changed_files.split('\n') if f.strip()]
 
     # Check if any changed file is in one of the build directories
     for changed_file in changed_list:
@@ -471,7 +598,77 @@ def _extract_fingerprint(report: dict) -> tuple:
     )
 
 
-def _build_and_generate_report(commit, args, linker_variables):
+def _build_and_generate_report(commit, args, linker_variables, cwd=None):
+    """
+    Checkout, build, and generate a memory report for a single commit.
+
+    Recorded as one ``commit`` span in a ``--profile``; see
+    :func:`_checkout_build_and_analyze` for arguments and results.
+    """
+    with stage('commit', {'commit': commit}):
+        result = _checkout_build_and_analyze(commit, args, linker_variables, cwd)
+    sample_counters()
+    return result
+
+
+class _CleanBuildSchedule:  # pylint: disable=too-few-public-methods
+    """Picks the incremental builds that are verified against a clean build."""
+
+    def __init__(self, every):
+        self._every = every
+        self._builds = itertools.count(1)
+
+    def due(self):
+        """Count one build; True if it is to be verified."""
+        return self._every > 0 and next(self._builds) % self._every == 0
+
+
+def _file_digest(path):
+    """SHA-256 of a file's contents."""
+    digest = hashlib.sha256()
+    with open(path, 'rb') as f:
+        for block in iter(lambda: f.read(1 << 20), b''):
+            digest.update(block)
+    return digest.hexdigest()
+
+
+def _run_build_script(args, log_prefix, cwd=None):
+    """Run the build script; returns the CompletedProcess."""
+    logger.debug("%s: Building firmware with: %s", log_prefix, args.build_script)
+    with stage('build'):
+        return subprocess.run(
+            args.build_script,
+            capture_output=True,
+            text=True,
+            check=False,
+            shell=True,
+            cwd=cwd
+        )
+
+
+def _verify_incremental_build(args, log_prefix, cwd=None):
+    """Rebuild from a clean tree and compare its ELF with the incremental one.
+
+    Returns:
+        CompletedProcess of the clean build, whose output is then reported
+    """
+    incremental_digest = _file_digest(args.elf_path)
+    logger.debug("%s: Verifying incremental build against a clean build...", log_prefix)
+    with stage('checkout'):
+        git_submodule_update(cwd=cwd)
+        git_clean(cwd=cwd)
+    result = _run_build_script(args, log_prefix, cwd)
+    if result.returncode == 0 and os.path.exists(args.elf_path):
+        if _file_digest(args.elf_path) != incremental_digest:
+            count_event('incremental_build_mismatches')
+            logger.warning(
+                "%s: ELF of the incremental build differs from a clean build "
+                "(stale build output or a non-reproducible build); reporting "
+                "the clean build", log_prefix)
+    return result
+
+
+def _checkout_build_and_analyze(commit, args, linker_variables, cwd=None):
     """
     Checkout, build, and generate a memory report for a single commit.
 
@@ -479,6 +676,8 @@ def _build_and_generate_report(commit, args, linker_variables):
         commit: Commit hash
         args: Parsed CLI arguments (build_script, elf_path, ld_scripts)
         linker_variables: Parsed linker variable definitions
+        cwd: Directory to check out and build in (a worktree), or None for
+             the current checkout. Paths in ``args`` must already point into it.
 
     Returns:
         Tuple of (report, build_failed) where report is the report dict
@@ -489,27 +688,31 @@ def _build_and_generate_report(commit, args, linker_variables):
         ValueError: If report generation fails with a configuration error
     """
     log_prefix = f"({commit})"
+    incremental = getattr(args, 'incremental', False)
 
-    # Checkout the commit
-    logger.debug("%s: Checking out commit...", log_prefix)
-    git_checkout(commit)
+    with stage('checkout'):
+        # Checkout the commit
+        logger.debug("%s: Checking out commit...", log_prefix)
+        git_checkout(commit, cwd=cwd)
 
-    # Update submodules to match the checked-out commit
-    git_submodule_update()
+        if incremental:
+            # Keep build output; only move submodules whose gitlink changed
+            git_submodule_update_changed(cwd=cwd)
+        else:
+            # Update submodules to match the checked-out commit
+            git_submodule_update(cwd=cwd)
 
-    # Clean previous build artifacts
-    logger.debug("Cleaning previous build artifacts...")
-    git_clean()
+            # Clean previous build artifacts
+            logger.debug("Cleaning previous build artifacts...")
+            git_clean(cwd=cwd)
 
     # Build the firmware
-    logger.debug("%s: Building firmware with: %s", log_prefix, args.build_script)
-    result = subprocess.run(
-        args.build_script,
-        capture_output=True,
-        text=True,
-        check=False,
-        shell=True
-    )
+    result = _run_build_script(args, log_prefix, cwd)
+
+    schedule = getattr(args, 'clean_build_schedule', None)
+    if (incremental and result.returncode == 0 and os.path.exists(args.elf_path)
+            and schedule is not None and schedule.due()):
+        result = _verify_incremental_build(args, log_prefix, cwd)
 
     # Case 1: Build failed (non-zero exit code)
     if result.returncode != 0:
@@ -533,6 +736,9 @@ def _build_and_generate_report(commit, args, linker_variables):
         map_file=getattr(args, 'map_file', None),
         limits_ld=getattr(args, 'limits', None),
         skip_sections=getattr(args, 'skip_sections', None),
+        jobs=getattr(args, 'jobs', 1),
+        cache_dir=cache_dir_from_args(args),
+        native_demangler=getattr(args, 'native_demangler', False),
     )
 
     # Case 3b: Build succeeded but report has empty memory_layout
@@ -584,7 +790,9 @@ def _create_client(args, api_url=None):
     """Create a reusable MemBrowseClient from onboard args."""
     resolved_api_url = api_url if api_url is not None else args.api_url
     auth_context = determine_auth_strategy(api_key=args.api_key)
-    return MemBrowseClient(auth_context, resolved_api_url)
+    return MemBrowseClient(
+        auth_context, resolved_api_url,
+        content_encoding=getattr(args, 'upload_encoding', DEFAULT_CONTENT_ENCODING))
 
 
 def _upload_commit(  # pylint: disable=too-many-arguments,too-many-positional-arguments,too-many-locals
@@ -638,7 +846,8 @@ def _upload_commit(  # pylint: disable=too-many-arguments,too-many-positional-ar
             api_url=resolved_api_url,
             build_failed=build_failed,
             identical=identical,
-            client=client
+            client=client,
+            compact_format=getattr(args, 'compact_format', False)
         )
         return True
     except (ValueError, RuntimeError) as e:
@@ -646,6 +855,150 @@ def _upload_commit(  # pylint: disable=too-many-arguments,too-many-positional-ar
         return False
 
 
+class _UploadQueue:
+    """Runs uploads in submission order on one background thread.
+
+    The next checkout and build proceed while a report is sent (and while
+    the client backs off after a transient API error). At most
+    ``max_pending`` uploads wait behind the one in progress; :meth:`submit`
+    blocks when the queue is full, so a slow API throttles the builds. After
+    the first failed upload the remaining ones are dropped and
+    :attr:`failed` tells the producer to stop. With ``max_pending`` 0 each
+    upload runs synchronously in :meth:`submit`.
+    """
+
+    def __init__(self, max_pending=DEFAULT_UPLOAD_QUEUE):
+        self.successful = 0
+        self.failures = 0
+        self._failed = threading.Event()
+        self._queue = None
+        self._thread = None
+        if max_pending > 0:
+            self._queue = queue.Queue(maxsize=max_pending)
+            self._thread = threading.Thread(
+                target=self._run, name='membrowse-upload', daemon=True)
+            self._thread.start()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc_info):
+        self.close()
+
+    @property
+    def failed(self):
+        """True once an upload has failed."""
+        return self._failed.is_set()
+
+    def submit(self, upload):
+        """Queue ``upload``, a callable returning True on success.
+
+        Returns:
+            False if an upload has failed so far, True otherwise
+        """
+        if self.failed:
+            return False
+        if self._queue is None:
+            self._send(upload)
+        else:
+            self._queue.put(upload)
+        return not self.failed
+
+    def close(self):
+        """Wait for every queued upload to finish."""
+        if self._thread is not None:
+            self._queue.put(None)
+            self._thread.join()
+            self._thread = None
+
+    def _run(self):
+        while True:
+            upload = self._queue.get()
+            if upload is None:
+                return
+            if not self.failed:
+                self._send(upload)
+
+    def _send(self, upload):
+        try:
+            succeeded = upload()
+        except Exception:  # pylint: disable=broad-exception-caught
+            logger.exception("Upload failed")
+            succeeded = False
+        if succeeded:
+            self.successful += 1
+        else:
+            self.failures += 1
+            self._failed.set()
+
+
+class _SpilledResults:
+    """Built commits waiting for their in-order upload, kept on disk.
+
+    Maps index -> (report, build_failed, identical) like a dict, but
+    reports with symbols are written gzip-compressed to a temporary
+    directory and read back when popped. Out-of-order binary search paths
+    can leave hundreds of built commits waiting for an earlier one;
+    memory then only holds their flags. Metadata-only and empty reports
+    are small and stay in memory.
+    """
+
+    def __init__(self):
+        self._entries = {}  # index -> (in-memory report or None, build_failed, identical)
+        self._dir = None
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc_info):
+        self.close()
+
+    def __contains__(self, index):
+        return index in self._entries
+
+    def __len__(self):
+        return len(self._entries)
+
+    def __setitem__(self, index, result):
+        report, build_failed, identical = result
+        self._discard(index)
+        if report.get('symbols'):
+            with gzip.open(self._path(index), 'wt', encoding='utf-8', compresslevel=1) as f:
+                json.dump(report, f, separators=(',', ':'))
+            report = None
+        self._entries[index] = (report, build_failed, identical)
+
+    def __getitem__(self, index):
+        report, build_failed, identical = self._entries[index]
+        if report is None:
+            with gzip.open(self._path(index), 'rt', encoding='utf-8') as f:
+                report = json.load(f)
+        return report, build_failed, identical
+
+    def pop(self, index):
+        """Remove and return the result for ``index``."""
+        result = self[index]
+        self._discard(index)
+        return result
+
+    def close(self):
+        """Delete the spill directory."""
+        self._entries.clear()
+        if self._dir is not None:
+            shutil.rmtree(self._dir, ignore_errors=True)
+            self._dir = None
+
+    def _path(self, index):
+        if self._dir is None:
+            self._dir = tempfile.mkdtemp(prefix='membrowse-onboard-')
+        return os.path.join(self._dir, f'{index}.json.gz')
+
+    def _discard(self, index):
+        entry = self._entries.pop(index, None)
+        if entry is not None and entry[0] is None:
+            os.remove(self._path(index))
+
+
 def _mark_identical_range(  # pylint: disable=too-many-arguments,too-many-positional-arguments
     commits, left_idx, right_idx, left_fingerprint,
     built_indices, commit_results, elf_path
@@ -684,7 +1037,7 @@ def _mark_identical_range(  # pylint: disable=too-many-arguments,too-many-positi
 def _binary_search_range(  # pylint: disable=too-many-arguments,too-many-positional-arguments,too-many-locals,too-many-return-statements
     commits, left_idx, right_idx,
     left_fingerprint, right_fingerprint,
-    built_indices, failed_indices, reports_cache, commit_results,
+    built_indices, failed_indices, fingerprints, commit_results,
     args, linker_variables, flush_fn
 ):
     """
@@ -706,7 +1059,8 @@ def _binary_search_range(  # pylint: disable=too-many-arguments,too-many-positio
                            or None if the build failed
         built_indices: Set of indices that have been built
         failed_indices: Set of indices where builds failed
-        reports_cache: Dict mapping index -> report (for built commits)
+        fingerprints: Dict mapping index -> fingerprint (None for failed
+                      builds) of built commits
         commit_results: Dict mapping index -> (report, build_failed, identical)
                         populated by this function for later upload
         args: CLI args
@@ -731,9 +1085,8 @@ def _binary_search_range(  # pylint: disable=too-many-arguments,too-many-positio
     mid_idx = (left_idx + right_idx) // 2
 
     if mid_idx in built_indices:
-        # Already built (shouldn't normally happen), use cached report
-        mid_report = reports_cache[mid_idx]
-        mid_fingerprint = None if mid_idx in failed_indices else _extract_fingerprint(mid_report)
+        # Already built (shouldn't normally happen), use its fingerprint
+        mid_fingerprint = None if mid_idx in failed_indices else fingerprints[mid_idx]
     else:
         # Build the midpoint
         commit = commits[mid_idx]
@@ -751,30 +1104,28 @@ def _binary_search_range(  # pylint: disable=too-many-arguments,too-many-positio
                          commit[:8], e)
             return False
 
+        mid_fingerprint = None if build_failed else _extract_fingerprint(mid_report)
         commit_results[mid_idx] = (mid_report, build_failed, False)
+        del mid_report
         built_indices.add(mid_idx)
-        reports_cache[mid_idx] = mid_report
-        if not flush_fn():
-            return False
-
+        fingerprints[mid_idx] = mid_fingerprint
         if build_failed:
             failed_indices.add(mid_idx)
-            mid_fingerprint = None
-        else:
-            mid_fingerprint = _extract_fingerprint(mid_report)
+        if not flush_fn():
+            return False
 
     # Recurse on both halves
     if not _binary_search_range(
             commits, left_idx, mid_idx,
             left_fingerprint, mid_fingerprint,
-            built_indices, failed_indices, reports_cache, commit_results,
+            built_indices, failed_indices, fingerprints, commit_results,
             args, linker_variables, flush_fn):
         return False
 
     return _binary_search_range(
         commits, mid_idx, right_idx,
         mid_fingerprint, right_fingerprint,
-        built_indices, failed_indices, reports_cache, commit_results,
+        built_indices, failed_indices, fingerprints, commit_results,
         args, linker_variables, flush_fn)
 
 
@@ -791,6 +1142,290 @@ def _build_endpoint_safe(commit, args, linker_variables, label=""):
         return None
 
 
+class _WorktreePool:
+    """A fixed set of git worktrees handed out to one build at a time.
+
+    Worktrees are created detached at HEAD under a temporary directory and
+    removed again on exit, so the user's checkout is never touched.
+    Persistent pools (``--incremental``) live under
+    ``<git-common-dir>/membrowse-worktrees`` instead and are kept, with
+    their build output, for the next run unless ``clean`` is set
+    (``--clean-worktrees``). Worktrees left by a run with more workers are
+    removed.
+    """
+
+    def __init__(self, count, persistent=False, clean=False):
+        self._count = count
+        self._persistent = persistent
+        self._clean = clean
+        self._root = None
+        self._paths = []
+        self._free = queue.Queue()
+        self._repo_root = run_git_command(['rev-parse', '--show-toplevel'])
+        # Sub-directory of the repository onboard was started from
+        self._prefix = run_git_command(['rev-parse', '--show-prefix']) or ''
+        if not self._repo_root:
+            raise RuntimeError("Not in a git repository")
+
+    def __enter__(self):
+        if self._persistent:
+            common_dir = run_git_command(['rev-parse', '--git-common-dir'])
+            self._root = os.path.join(os.path.abspath(common_dir), 'membrowse-worktrees')
+            os.makedirs(self._root, exist_ok=True)
+            self._remove_surplus()
+        else:
+            self._root = tempfile.mkdtemp(prefix='membrowse-worktrees-')
+        try:
+            for i in range(self._count):
+                path = os.path.join(self._root, f'worker{i}')
+                if not (self._persistent and self._reusable(path)):
+                    git_worktree_add(path)
+                self._paths.append(path)
+                self._free.put(path)
+        except RuntimeError:
+            self.close()
+            raise
+        logger.debug("Using %d worktrees under %s", self._count, self._root)
+        return self
+
+    def __exit__(self, *exc_info):
+        self.close()
+
+    @staticmethod
+    def _reusable(path):
+        """True if ``path`` is a worktree kept by an earlier run."""
+        if os.path.isdir(path):
+            if run_git_command(['-C', path, 'rev-parse', '--is-inside-work-tree']) == 'true':
+                return True
+            shutil.rmtree(path, ignore_errors=True)
+        run_git_command(['worktree', 'prune'])
+        return False
+
+    def _remove_surplus(self):
+        """Remove kept worktrees beyond ``count`` (from runs with more workers)."""
+        surplus = [name for name in os.listdir(self._root)
+                   if name.startswith('worker') and name[6:].isdigit()
+                   and int(name[6:]) >= self._count]
+        for name in surplus:
+            path = os.path.join(self._root, name)
+            git_worktree_remove(path)
+            shutil.rmtree(path, ignore_errors=True)
+        if surplus:
+            logger.info("Removed %d surplus worktrees under %s", len(surplus), self._root)
+            run_git_command(['worktree', 'prune'])
+
+    def close(self):
+        """Remove all worktrees and their directory (unless kept for the next run)."""
+        if self._persistent and not self._clean:
+            if self._paths:
+                logger.info("Keeping %d worktrees under %s for the next run "
+                            "(--clean-worktrees removes them)", len(self._paths), self._root)
+            self._paths = []
+            self._root = None
+            return
+        for path in self._paths:
+            git_worktree_remove(path)
+        self._paths = []
+        if self._root:
+            shutil.rmtree(self._root, ignore_errors=True)
+            self._root = None
+        run_git_command(['worktree', 'prune'])
+
+    def acquire(self):
+        """Take a free worktree (blocks until one is released)."""
+        return self._free.get()
+
+    def release(self, path):
+        """Return a worktree taken with acquire()."""
+        self._free.put(path)
+
+    def build_dir(self, worktree):
+        """Directory inside ``worktree`` matching the current directory."""
+        return os.path.join(worktree, self._prefix)
+
+    def map_path(self, path, worktree):
+        """Map a path in the main checkout to the same path in ``worktree``.
+
+        Relative paths are taken relative to the current directory, as in a
+        serial run. Absolute paths outside the repository are left alone.
+        """
+        if not path:
+            return path
+        if not os.path.isabs(path):
+            return os.path.join(self.build_dir(worktree), path)
+        relative = os.path.relpath(path, self._repo_root)
+        if relative == os.pardir or relative.startswith(os.pardir + os.sep):
+            return path
+        return os.path.join(worktree, relative)
+
+    def worktree_args(self, args, worktree):
+        """Copy of ``args`` with every input path mapped into ``worktree``."""
+        mapped = copy.copy(args)
+        mapped.elf_path = self.map_path(args.elf_path, worktree)
+        if args.ld_scripts:
+            mapped.ld_scripts = ' '.join(
+                self.map_path(script, worktree) for script in args.ld_scripts.split())
+        for name in ('map_file', 'limits'):
+            if getattr(args, name, None):
+                setattr(mapped, name, self.map_path(getattr(args, name), worktree))
+        return mapped
+
+
+def _build_in_worktree(pool, commit, args, linker_variables):
+    """Build one commit in a free worktree of ``pool`` (runs in a worker thread).
+
+    Reports keep ``args.elf_path`` as their file path so they are identical to
+    reports from a serial run.
+    """
+    worktree = pool.acquire()
+    try:
+        report, build_failed = _build_and_generate_report(
+            commit, pool.worktree_args(args, worktree), linker_variables,
+            cwd=pool.build_dir(worktree))
+    except OSError as e:
+        # e.g. the build directory does not exist at this commit
+        raise RuntimeError(f"Cannot build in {worktree}: {e}") from e
+    finally:
+        pool.release(worktree)
+    report['file_path'] = args.elf_path
+    return report, build_failed
+
+
+def _split_points(left_idx, right_idx, count):
+    """Return up to ``count`` evenly spaced indices strictly inside a range.
+
+    With ``count == 1`` this is the binary search midpoint.
+    """
+    count = min(count, right_idx - left_idx - 1)
+    return sorted({left_idx + (right_idx - left_idx) * i // (count + 1)
+                   for i in range(1, count + 1)})
+
+
+class _ParallelBinarySearch:  # pylint: disable=too-many-instance-attributes
+    """Binary search onboard that keeps up to N builds running at once.
+
+    Commits that have been built (or are being built) split the commit list
+    into segments. Once both ends of a segment are known it is either marked
+    identical, exactly as in the serial search, or queued for splitting. Idle
+    workers are spread over the queued segments, so a lone segment is split
+    at several points at once instead of only at its midpoint. Results go
+    through the same ``commit_results``/``flush_fn`` path as the serial
+    search, so uploads stay in chronological order.
+    """
+
+    def __init__(self, commits, args, linker_variables, state, flush_fn):  # pylint: disable=too-many-arguments,too-many-positional-arguments
+        self.commits = commits
+        self.args = args
+        self.linker_variables = linker_variables
+        self.state = state
+        self.flush_fn = flush_fn
+        self.workers = args.workers
+        self.fingerprints = state['fingerprints']  # index -> fingerprint (None if failed)
+        self.boundaries = []  # sorted indices that are built or being built
+        self.pending_segments = []  # (left_idx, right_idx) with differing ends
+
+    def run(self, pool):
+        """Build endpoints and search between them. Returns False if aborted."""
+        last = len(self.commits) - 1
+        in_flight = {}
+        with ThreadPoolExecutor(max_workers=self.workers) as executor:
+            def submit(index):
+                bisect.insort(self.boundaries, index)
+                logger.debug("Building commit %d/%d: %s",
+                             index + 1, len(self.commits), self.commits[index][:8])
+                future = executor.submit(
+                    _build_in_worktree, pool, self.commits[index], self.args,
+                    self.linker_variables)
+                in_flight[future] = index
+
+            for index in sorted({0, last}):
+                submit(index)
+
+            while in_flight:
+                done, _ = wait(in_flight, return_when=FIRST_COMPLETED)
+                for future in sorted(done, key=in_flight.get):
+                    index = in_flight.pop(future)
+                    if not self._record(index, future, index in (0, last)):
+                        for other in in_flight:
+                            other.cancel()
+                        return False
+                self._schedule(submit, len(in_flight))
+        return self.flush_fn()
+
+    def _record(self, index, future, is_endpoint):
+        """Register a finished build and classify its neighbouring segments."""
+        commit = self.commits[index]
+        try:
+            report, build_failed = future.result()
+        except RuntimeError as e:
+            if is_endpoint:
+                logger.error("Failed to build endpoint commit %s: %s", commit[:8], e)
+                self.state['counters']['failed'] += 1
+                return False
+            logger.error("Checkout failed at midpoint %s: %s", commit[:8], e)
+            report, build_failed = _create_empty_report(self.args.elf_path), True
+        except ValueError as e:
+            logger.error("Report generation failed at %s: %s", commit[:8], e)
+            if is_endpoint:
+                self.state['counters']['failed'] += 1
+            return False
+
+        _register_endpoint(self.state, index, report, build_failed)
+        del report
+        if not self.flush_fn():
+            return False
+
+        position = bisect.bisect_left(self.boundaries, index)
+        if position > 0 and not self._classify(self.boundaries[position - 1], index):
+            return False
+        if (position + 1 < len(self.boundaries)
+                and not self._classify(index, self.boundaries[position + 1])):
+            return False
+        return True
+
+    def _classify(self, left_idx, right_idx):
+        """Mark a segment identical or queue it once both ends are built."""
+        if (right_idx - left_idx <= 1 or left_idx not in self.fingerprints
+                or right_idx not in self.fingerprints):
+            return True
+        left_fp = self.fingerprints[left_idx]
+        if left_fp == self.fingerprints[right_idx]:
+            _mark_identical_range(
+                self.commits, left_idx, right_idx, left_fp,
+                self.state['built_indices'], self.state['commit_results'],
+                self.args.elf_path)
+            return self.flush_fn()
+        self.pending_segments.append((left_idx, right_idx))
+        return True
+
+    def _schedule(self, submit, running):
+        """Hand idle workers to queued segments, oldest segment first."""
+        idle = self.workers - running
+        while idle > 0 and self.pending_segments:
+            left_idx, right_idx = self.pending_segments.pop(0)
+            share = max(1, idle // (len(self.pending_segments) + 1))
+            for index in _split_points(left_idx, right_idx, share):
+                submit(index)
+                idle -= 1
+
+
+def _run_parallel_binary_search(commits, args, linker_variables, state, flush_fn):
+    """Run the binary search with ``args.workers`` builds in separate worktrees."""
+    logger.info("Building with %d parallel workers", args.workers)
+    pool_options = {}
+    if getattr(args, 'incremental', False):
+        pool_options = {'persistent': True,
+                        'clean': getattr(args, 'clean_worktrees', False)}
+    try:
+        with _WorktreePool(args.workers, **pool_options) as pool:
+            if not _ParallelBinarySearch(
+                    commits, args, linker_variables, state, flush_fn).run(pool):
+                logger.error("Binary search aborted")
+    except RuntimeError as e:
+        logger.error("Cannot set up parallel workers: %s", e)
+        state['counters']['failed'] += 1
+
+
 def _run_binary_search_onboard(  # pylint: disable=too-many-locals,too-many-statements
     args, commits, current_branch, repo_name, linker_variables
 ):
@@ -814,21 +1449,22 @@ def _run_binary_search_onboard(  # pylint: disable=too-many-locals,too-many-stat
     counters = {'successful': 0, 'failed': 0}
     built_indices = set()
     failed_indices = set()
-    reports_cache = {}
-    commit_results = {}  # index -> (report, build_failed, identical)
+    fingerprints = {}  # index -> fingerprint of built commits (None if failed)
+    commit_results = _SpilledResults()  # index -> (report, build_failed, identical)
     total = len(commits)
 
     # Create a single client to reuse across all uploads
     client = _create_client(args) if not getattr(args, 'dry_run', False) else None
+    uploads = _UploadQueue(getattr(args, 'upload_queue', DEFAULT_UPLOAD_QUEUE))
 
     # Flush state: upload consecutive ready commits in chronological order
     flush_state = {'next_to_upload': 0, 'prev_fingerprint': None, 'prev_build_failed': False}
 
     def flush_fn():
-        """Upload consecutive ready commits starting from next_to_upload.
+        """Queue uploads of consecutive ready commits starting from next_to_upload.
 
         Returns:
-            True if all uploads succeeded, False if any upload failed.
+            True if all uploads so far succeeded, False if any upload failed.
         """
         while flush_state['next_to_upload'] in commit_results:
             idx = flush_state['next_to_upload']
@@ -847,12 +1483,10 @@ def _run_binary_search_onboard(  # pylint: disable=too-many-locals,too-many-stat
                 build_failed = True
                 report = _create_empty_report(args.elf_path)
 
-            if _upload_commit(report, commits[idx], args, current_branch,
-                              repo_name, build_failed=build_failed,
-                              identical=identical, client=client):
-                counters['successful'] += 1
-            else:
-                counters['failed'] += 1
+            if not uploads.submit(functools.partial(
+                    _upload_commit, report, commits[idx], args, current_branch,
+                    repo_name, build_failed=build_failed,
+                    identical=identical, client=client)):
                 flush_state['next_to_upload'] += 1
                 return False
 
@@ -878,12 +1512,16 @@ def _run_binary_search_onboard(  # pylint: disable=too-many-locals,too-many-stat
         'counters': counters,
         'built_indices': built_indices,
         'failed_indices': failed_indices,
-        'reports_cache': reports_cache,
+        'fingerprints': fingerprints,
         'commit_results': commit_results,
     }
-    _binary_search_build_and_flush(commits, args, linker_variables, state, flush_fn)
+    with uploads, commit_results:
+        if getattr(args, 'workers', 1) > 1:
+            _run_parallel_binary_search(commits, args, linker_variables, state, flush_fn)
+        else:
+            _binary_search_build_and_flush(commits, args, linker_variables, state, flush_fn)
 
-    return counters['successful'], counters['failed']
+    return uploads.successful, counters['failed'] + uploads.failures
 
 
 def _register_endpoint(state, index, report, build_failed):
@@ -892,7 +1530,7 @@ def _register_endpoint(state, index, report, build_failed):
     state['built_indices'].add(index)
     if build_failed:
         state['failed_indices'].add(index)
-    state['reports_cache'][index] = report
+    state['fingerprints'][index] = None if build_failed else _extract_fingerprint(report)
 
 
 def _binary_search_build_and_flush(commits, args, linker_variables, state, flush_fn):
@@ -919,8 +1557,7 @@ def _binary_search_build_and_flush(commits, args, linker_variables, state, flush
         counters['failed'] += 1
         return
 
-    first_report, first_failed = result
-    _register_endpoint(state, 0, first_report, first_failed)
+    _register_endpoint(state, 0, *result)
     if not flush_fn():
         return
 
@@ -932,20 +1569,17 @@ def _binary_search_build_and_flush(commits, args, linker_variables, state, flush
         counters['failed'] += 1
         return
 
-    last_report, last_failed = result
-    _register_endpoint(state, total - 1, last_report, last_failed)
+    _register_endpoint(state, total - 1, *result)
+    del result
 
     # Edge case: only two commits — just flush
     if total == 2:
         flush_fn()
         return
 
-    # Extract fingerprints (None for failed builds)
-    first_fp = None if first_failed else _extract_fingerprint(first_report)
-    last_fp = None if last_failed else _extract_fingerprint(last_report)
-
-    state['first_fp'] = first_fp
-    state['last_fp'] = last_fp
+    # Fingerprints are None for failed builds
+    state['first_fp'] = state['fingerprints'][0]
+    state['last_fp'] = state['fingerprints'][total - 1]
 
     _run_binary_search_between_endpoints(
         commits, args, linker_variables, state, flush_fn)
@@ -963,7 +1597,7 @@ def _run_binary_search_between_endpoints(commits, args, linker_variables, state,
             commits, 0, total - 1,
             first_fp, last_fp,
             state['built_indices'], state['failed_indices'],
-            state['reports_cache'], state['commit_results'],
+            state['fingerprints'], state['commit_results'],
             args, linker_variables, flush_fn):
         logger.error("Binary search aborted due to upload failure")
         return
@@ -987,7 +1621,7 @@ def _log_fingerprint_comparison(first_fp, last_fp, total):
         logger.debug("Endpoints differ - searching for changes via binary search")
 
 
-def run_onboard(args: argparse.Namespace) -> int:  # pylint: disable=too-many-locals,too-many-statements,too-many-branches,too-many-return-statements
+def run_onboard(args: argparse.Namespace) -> int:
     """
     Execute the onboard subcommand.
 
@@ -997,6 +1631,20 @@ def run_onboard(args: argparse.Namespace) -> int:  # pylint: disable=too-many-lo
     Returns:
         Exit code (0 for success, 1 for error)
     """
+    profile_path = getattr(args, 'profile', None)
+    profile_error = _validate_profile_path(profile_path)
+    if profile_error:
+        logger.error("%s", profile_error)
+        return 1
+    with profiling(profile_path):
+        exit_code = _run_onboard(args)
+    if profile_path:
+        logger.info("Profile written to %s", profile_path)
+    return exit_code
+
+
+def _run_onboard(args: argparse.Namespace) -> int:  # pylint: disable=too-many-locals,too-many-statements,too-many-branches,too-many-return-statements
+    """Body of :func:`run_onboard`."""
 
     commits_arg = getattr(args, 'commits', None)
     initial_commit = getattr(args, 'initial_commit', None)
@@ -1010,6 +1658,19 @@ def run_onboard(args: argparse.Namespace) -> int:  # pylint: disable=too-many-lo
     if getattr(args, 'binary_search', False) and getattr(args, 'build_dirs', None):
         logger.error("--binary-search and --build-dirs are mutually exclusive")
         return 1
+    workers = getattr(args, 'workers', 1)
+    if workers < 1:
+        logger.error("--workers must be at least 1")
+        return 1
+    if getattr(args, 'verify_every', DEFAULT_VERIFY_EVERY) < 0:
+        logger.error("--verify-every cannot be negative")
+        return 1
+    if getattr(args, 'upload_queue', DEFAULT_UPLOAD_QUEUE) < 0:
+        logger.error("--upload-queue cannot be negative")
+        return 1
+    if workers > 1 and not getattr(args, 'binary_search', False):
+        logger.error("--workers requires --binary-search")
+        return 1
     if use_explicit_commits and getattr(args, 'binary_search', False):
         logger.error("--binary-search and --commits are mutually exclusive")
         return 1
@@ -1031,6 +1692,12 @@ def run_onboard(args: argparse.Namespace) -> int:  # pylint: disable=too-many-lo
 
     if getattr(args, 'dry_run', False):
         logger.info("DRY-RUN MODE: will build and analyze but skip uploading")
+    if getattr(args, 'incremental', False):
+        verify_every = getattr(args, 'verify_every', DEFAULT_VERIFY_EVERY)
+        logger.info("Incremental builds (no git clean between commits)%s",
+                    f", checking every {verify_every} builds against a clean build"
+                    if verify_every else "")
+        args.clean_build_schedule = _CleanBuildSchedule(verify_every)
 
 
     logger.info("Starting historical memory analysis for %s", args.target_name)
@@ -1082,6 +1749,10 @@ def run_onboard(args: argparse.Namespace) -> int:  # pylint: disable=too-many-lo
 
     total_commits = len(commits)
 
+    # Read metadata (and --build-dirs changes) of the whole range up front
+    with stage('git_metadata'):
+        CommitMetadataCache.prefetch(commits)
+
     # Create a single client to reuse across all uploads
     client = _create_client(args, api_url) if not getattr(args, 'dry_run', False) else None
 
@@ -1089,10 +1760,19 @@ def run_onboard(args: argparse.Namespace) -> int:  # pylint: disable=too-many-lo
     successful_uploads = 0
     failed_uploads = 0
     start_time = datetime.now()
+    uploads = None
 
     # Helper function to restore HEAD and print summary on exit
     def finalize_and_return(exit_code: int) -> int:
-        """Restore original HEAD, print summary, and return exit code."""
+        """Flush uploads, restore original HEAD, print summary, and return exit code."""
+        nonlocal successful_uploads, failed_uploads
+        if uploads is not None:
+            uploads.close()
+            successful_uploads += uploads.successful
+            failed_uploads += uploads.failures
+            if uploads.failed:
+                exit_code = 1
+
         # Restore original HEAD
         logger.debug("")
         logger.debug("Restoring original HEAD...")
@@ -1124,9 +1804,29 @@ def run_onboard(args: argparse.Namespace) -> int:  # pylint: disable=too-many-lo
         )
         return finalize_and_return(0 if failed_uploads == 0 else 1)
 
+    # Uploads run in the background, in commit order, while the next commits build
+    uploads = _UploadQueue(getattr(args, 'upload_queue', DEFAULT_UPLOAD_QUEUE))
+
+    def upload(report, commit, commit_count, message, **options):
+        """Queue one upload; returns False once any upload has failed."""
+        def send():
+            log_prefix = f"({commit})"
+            if _upload_commit(report, commit, args, current_branch, repo_name,
+                              api_url=api_url, client=client, **options):
+                logger.debug("%s: %s (commit %d of %d)",
+                             log_prefix, message, commit_count, total_commits)
+                return True
+            logger.error(
+                "%s: Failed to upload memory report (commit %d of %d), stopping workflow...",
+                log_prefix, commit_count, total_commits)
+            return False
+        return uploads.submit(send)
+
     # Process each commit
     for commit_count, commit in enumerate(commits, 1):
         log_prefix = f"({commit})"
+        if uploads.failed:
+            return finalize_and_return(1)
 
         logger.debug("")
         logger.debug("Processing commit %d/%d: %s",
@@ -1143,13 +1843,8 @@ def run_onboard(args: argparse.Namespace) -> int:  # pylint: disable=too-many-lo
             logger.debug("%s: No changes in build directories, marking as identical", log_prefix)
 
             report = _create_metadata_only_report(args.elf_path)
-            if _upload_commit(report, commit, args, current_branch, repo_name,
-                              identical=True, api_url=api_url, client=client):
-                logger.debug("%s: Identical report uploaded (commit %d of %d)",
-                            log_prefix, commit_count, total_commits)
-                successful_uploads += 1
-            else:
-                failed_uploads += 1
+            if not upload(report, commit, commit_count, "Identical report uploaded",
+                          identical=True):
                 return finalize_and_return(1)
 
             continue  # Skip to next commit - no checkout/build needed
@@ -1177,27 +1872,10 @@ def run_onboard(args: argparse.Namespace) -> int:  # pylint: disable=too-many-lo
         else:
             faked_parent = _NO_OVERRIDE
 
-        if _upload_commit(report, commit, args, current_branch, repo_name,
-                          build_failed=build_failed, api_url=api_url,
-                          parent_sha_override=faked_parent, client=client):
-            if build_failed:
-                logger.debug(
-                    "%s: Empty report uploaded successfully for failed build (commit %d of %d)",
-                    log_prefix,
-                    commit_count,
-                    total_commits)
-            else:
-                logger.debug(
-                    "%s: Memory report uploaded successfully (commit %d of %d)",
-                    log_prefix,
-                    commit_count,
-                    total_commits)
-            successful_uploads += 1
-        else:
-            logger.error(
-                "%s: Failed to upload memory report (commit %d of %d), stopping workflow...",
-                log_prefix, commit_count, total_commits)
-            failed_uploads += 1
+        if not upload(report, commit, commit_count,
+                      "Empty report uploaded successfully for failed build" if build_failed
+                      else "Memory report uploaded successfully",
+                      build_failed=build_failed, parent_sha_override=faked_parent):
             return finalize_and_return(1)
 
     # Finalize with summary and restoration
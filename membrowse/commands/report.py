@@ -2,26 +2,40 @@
 """Report subcommand - generates memory footprint reports from ELF files."""
 
 import os
+import sys
 import json
 import argparse
 import logging
 from importlib.metadata import version
-from typing import Dict, Any, Optional
+from typing import Dict, Any, Optional, Tuple
+
+from elftools.common.exceptions import ELFError
 
 from ..utils.git import detect_git_metadata, detect_github_metadata
 from ..utils.budget_alerts import iter_budget_alerts
 from ..utils.formatter import format_report_human_readable
 from ..utils.github import is_pull_request_event
-from ..linker.parser import LinkerScriptParser
+from ..utils.cache import ContentCache, cache_dir_from_args
+from ..utils.daemon import request_report
+from ..utils.timing import count, profiling, stage, timed
+from ..linker.parser import LinkerScriptParser, ScriptSources
+from ..linker.elf_info import ELFContext
 from ..core.generator import ReportGenerator
+from ..core.region_cache import RegionCache, parsing_strategy
+from ..core.report_cache import ReportCache
+from ..core.compact import compact_report
 from ..core.models import MemoryRegion
-from ..api.client import MemBrowseClient
+from ..core.symbol_table import SymbolTable
+from ..api.client import (
+    MemBrowseClient, CONTENT_ENCODINGS, DEFAULT_CONTENT_ENCODING,
+)
 from ..auth.strategy import determine_auth_strategy
 from ..analysis.defaults import (
     create_default_memory_regions,
     map_sections_to_default_regions
 )
 from ..analysis.mapper import MemoryMapper
+from ..analysis._native_demangle import find_native_demangler
 
 # Set up logger
 logger = logging.getLogger(__name__)
@@ -309,6 +323,10 @@ examples:
   # GitHub Actions mode (auto-detects Git metadata from GitHub environment)
   membrowse report firmware.elf "linker.ld" --upload --github \\
       --target-name stm32f4 --api-key "$API_KEY"
+
+  # Many targets in one run, 8 at a time, results for the PR comment
+  membrowse report --manifest targets.json --jobs 8 --upload --github \\
+      --api-key "$API_KEY" --output-raw-response > results.json
         """
     )
 
@@ -342,6 +360,18 @@ examples:
         action='store_true',
         help='Use GitHub Actions environment for Git metadata detection (use with --upload)'
     )
+    mode_group.add_argument(
+        '--manifest',
+        default=None,
+        metavar='FILE',
+        help='Analyze every target listed in a JSON manifest in one run '
+             'instead of a single elf_path: a list of objects with '
+             'target_name, elf_path and optionally ld_scripts, map_file, '
+             'limits, skip_sections and defs (paths relative to the '
+             'manifest). Targets are analyzed in --jobs worker processes '
+             'and uploaded concurrently; --output-raw-response prints the '
+             'combined result list for the PR comment action'
+    )
 
     # Upload parameters (only relevant with --upload)
     upload_group = parser.add_argument_group(
@@ -364,6 +394,7 @@ examples:
         help='Mark this commit as having identical memory footprint to previous '
              '(metadata-only upload, no build analysis required)'
     )
+    add_upload_format_arguments(upload_group)
 
     # Optional Git metadata (overrides auto-detected values)
     git_group = parser.add_argument_group(
@@ -391,11 +422,70 @@ examples:
 
     # Performance options
     perf_group = parser.add_argument_group('performance options')
-    perf_group.add_argument(
+    line_program_group = perf_group.add_mutually_exclusive_group()
+    line_program_group.add_argument(
         '--skip-line-program',
         action='store_true',
         help='Skip DWARF line program processing for faster analysis'
     )
+    line_program_group.add_argument(
+        '--lazy-line-program',
+        action='store_true',
+        help='Decode DWARF line programs only for the compilation units of '
+             'functions the debug info entries do not attribute to a source '
+             'file: close to --skip-line-program speed with close to full '
+             'source file coverage'
+    )
+    perf_group.add_argument(
+        '--jobs',
+        type=int,
+        default=1,
+        metavar='N',
+        help='Process DWARF compilation units in N worker processes '
+             '(0 = one per CPU, default: 1). Output is identical to a '
+             'serial run. With --manifest, the number of targets analyzed '
+             'in parallel instead.'
+    )
+    perf_group.add_argument(
+        '--cache',
+        action='store_true',
+        help='Cache per-compilation-unit DWARF results on disk under '
+             '$XDG_CACHE_HOME/membrowse so unchanged CUs are not decoded '
+             'again on the next run. Complete reports and parsed linker '
+             'scripts are cached too, so a byte-identical ELF is not '
+             'analyzed again.'
+    )
+    perf_group.add_argument(
+        '--cache-dir',
+        default=None,
+        metavar='DIR',
+        help='Like --cache, but store the cache under DIR'
+    )
+    perf_group.add_argument(
+        '--no-daemon',
+        action='store_true',
+        help='Analyze in this process even when a `membrowse serve` daemon '
+             'is running (by default the daemon and its warm caches are used)'
+    )
+    perf_group.add_argument(
+        '--native-demangler',
+        action='store_true',
+        help='Demangle C++ symbol names with c++filt or llvm-cxxfilt from '
+             'PATH in one batch (much faster on large C++ firmware). Names '
+             'are formatted the way the tool prints them, which can differ '
+             'slightly from the built-in demangler, so use it consistently '
+             'for a target'
+    )
+    perf_group.add_argument(
+        '--profile',
+        default=None,
+        metavar='FILE',
+        help='Write a Chrome trace-event profile of the run to FILE (open in '
+             'Perfetto or chrome://tracing): nested timings of every stage '
+             'plus counters such as CUs processed, DIEs visited, line program '
+             'rows, demangled symbols, cache hits and upload bytes. Use '
+             'with --jobs 1, worker processes are not traced'
+    )
     perf_group.add_argument(
         '--def',
         dest='linker_defs',
@@ -476,7 +566,7 @@ def _apply_default_regions(generator: ReportGenerator, report: dict) -> None:
     sections = generator.elf_analyzer.get_sections()
     if generator.skip_sections:
         sections, _ = generator._apply_section_skips(  # pylint: disable=protected-access
-            sections, [])
+            sections, SymbolTable())
     default_regions_data = create_default_memory_regions(sections)
 
     if not default_regions_data:
@@ -498,8 +588,9 @@ def _apply_default_regions(generator: ReportGenerator, report: dict) -> None:
 
     # Map sections to default regions by type (not by address)
     # This is necessary because default regions have limit_size=0
-    map_sections_to_default_regions(sections, memory_regions)
-    MemoryMapper.calculate_utilization(memory_regions)
+    with stage('region_mapping'):
+        map_sections_to_default_regions(sections, memory_regions)
+        MemoryMapper.calculate_utilization(memory_regions)
 
     # Update report with default regions
     report['memory_layout'] = {
@@ -508,7 +599,8 @@ def _apply_default_regions(generator: ReportGenerator, report: dict) -> None:
     }
 
 
-def generate_report(  # pylint: disable=too-many-arguments,too-many-positional-arguments
+@timed('generate_report')
+def generate_report(  # pylint: disable=too-many-arguments,too-many-positional-arguments,too-many-locals
     elf_path: str,
     ld_scripts: Optional[str] = None,
     skip_line_program: bool = False,
@@ -516,6 +608,10 @@ def generate_report(  # pylint: disable=too-many-arguments,too-many-positional-a
     map_file: Optional[str] = None,
     limits_ld: Optional[str] = None,
     skip_sections: Optional[list] = None,
+    jobs: int = 1,
+    cache_dir: Optional[str] = None,
+    native_demangler: bool = False,
+    lazy_line_program: bool = False,
 ) -> dict:
     """
     Generate a memory footprint report from ELF and optionally linker scripts.
@@ -539,6 +635,11 @@ def generate_report(  # pylint: disable=too-many-arguments,too-many-positional-a
             ``.noinit``) to exclude from the report. Listed sections are
             removed before region mapping so they don't contribute to any
             region's ``used_size``; symbols inside them are also dropped.
+        jobs: Worker processes for DWARF processing (0 = one per CPU)
+        cache_dir: Optional directory for the on-disk DWARF and report caches
+        native_demangler: Demangle C++ names with c++filt / llvm-cxxfilt
+        lazy_line_program: Decode DWARF line programs only for the CUs of
+            functions the DIE pass could not attribute to a source file
 
     Returns:
         dict: Memory analysis report (JSON-serializable)
@@ -553,52 +654,148 @@ def generate_report(  # pylint: disable=too-many-arguments,too-many-positional-a
     logger.debug("Started Memory Report generation")
     logger.debug("ELF file: %s", elf_path)
 
-    # Handle optional linker scripts
-    memory_regions_data = _parse_linker_scripts_if_provided(
-        ld_scripts, elf_path, linker_variables
-    )
-
-    real_limits = _resolve_real_limits(
-        limits_ld, memory_regions_data, elf_path, linker_variables
-    )
-
-    # Generate JSON report
-    logger.debug("Generating memory report...")
+    # Open and decode the ELF once for the linker script parsers and the
+    # analyzer instead of once per component
+    with stage('elf_open'):
+        elf_context = _open_elf_context(elf_path)
     try:
-        generator = ReportGenerator(
-            elf_path,
-            memory_regions_data,
-            skip_line_program=skip_line_program,
-            map_file_path=map_file,
-            real_limits=real_limits,
-            skip_sections=skip_sections,
-        )
-        report = generator.generate_report()
-
-        # Fall back to default regions when no linker scripts were provided
-        # OR when parsing yielded none (e.g. SECTIONS-only script with no
-        # MEMORY block). Otherwise upload fails: "memory_layout is required".
-        if not memory_regions_data:
-            if memory_regions_data is not None:
-                logger.warning(
-                    "Linker scripts parsed but yielded no memory regions; "
-                    "falling back to default Code/Data regions from ELF sections"
-                )
-            _apply_default_regions(generator, report)
+        with stage('linker_parse'):
+            # Handle optional linker scripts
+            memory_regions_data, real_limits = _parse_linker_inputs(
+                ld_scripts, limits_ld, elf_path, linker_variables,
+                elf_context, cache_dir=cache_dir
+            )
 
-    except Exception as e:  # pylint: disable=broad-exception-caught
-        logger.error("Failed to generate memory report: %s", e)
-        raise ValueError(f"Failed to generate memory report: {e}") from e
+        # Reuse the full report of a byte-identical ELF built with the
+        # same inputs, skipping DWARF and symbol analysis entirely
+        report_cache = (ReportCache(cache_dir)
+                        if ContentCache.enabled(cache_dir) and elf_context else None)
+        cache_key = None
+        if report_cache is not None:
+            cache_key = report_cache.make_key(elf_context, {
+                'memory_regions': memory_regions_data,
+                'real_limits': real_limits,
+                'skip_line_program': skip_line_program,
+                'lazy_line_program': lazy_line_program,
+                'skip_sections': sorted(skip_sections or []),
+                'native_demangler': (find_native_demangler()
+                                     if native_demangler else None),
+            }, map_file)
+            cached = report_cache.get(cache_key) if cache_key else None
+            count('report_cache_hits' if cached is not None else 'report_cache_misses')
+            if cached is not None:
+                logger.info("ELF content unchanged, reusing cached report")
+                cached['file_path'] = elf_path
+                return cached
+
+        # Generate JSON report
+        logger.debug("Generating memory report...")
+        try:
+            generator = ReportGenerator(
+                elf_path,
+                memory_regions_data,
+                skip_line_program=skip_line_program,
+                map_file_path=map_file,
+                real_limits=real_limits,
+                skip_sections=skip_sections,
+                jobs=jobs,
+                cache_dir=cache_dir,
+                elf_context=elf_context,
+                native_demangler=native_demangler,
+                lazy_line_program=lazy_line_program,
+            )
+            report = generator.generate_report()
+
+            # Fall back to default regions when no linker scripts were provided
+            # OR when parsing yielded none (e.g. SECTIONS-only script with no
+            # MEMORY block). Otherwise upload fails: "memory_layout is required".
+            if not memory_regions_data:
+                if memory_regions_data is not None:
+                    logger.warning(
+                        "Linker scripts parsed but yielded no memory regions; "
+                        "falling back to default Code/Data regions from ELF sections"
+                    )
+                _apply_default_regions(generator, report)
+
+        except Exception as e:  # pylint: disable=broad-exception-caught
+            logger.error("Failed to generate memory report: %s", e)
+            raise ValueError(f"Failed to generate memory report: {e}") from e
+
+        if cache_key:
+            report_cache.put(cache_key, report)
+    finally:
+        if elf_context is not None:
+            elf_context.close()
 
     logger.debug("Memory report generated successfully")
     return report
 
 
-def _resolve_real_limits(
+def _open_elf_context(elf_path: str) -> Optional[ELFContext]:
+    """Open ``elf_path`` once for every component of a report run.
+
+    Returns None when the file cannot be opened as an ELF; each component
+    then opens it itself and reports the problem with its usual error.
+    """
+    try:
+        return ELFContext.open(elf_path)
+    except (OSError, ELFError, ValueError) as e:
+        logger.debug("Could not open shared ELF context for %s: %s", elf_path, e)
+        return None
+
+
+def _parse_linker_inputs(  # pylint: disable=too-many-arguments,too-many-positional-arguments
+    ld_scripts: Optional[str],
+    limits_ld: Optional[str],
+    elf_path: str,
+    linker_variables: Optional[Dict[str, Any]],
+    elf_context: Optional[ELFContext] = None,
+    cache_dir: Optional[str] = None
+) -> Tuple[Optional[Dict[str, Any]], Optional[Dict[str, int]]]:
+    """Parse the linker scripts and the ``--limits`` script.
+
+    Results are reused from the region cache when neither the scripts, the
+    files they include, the variables nor the ELF architecture changed.
+
+    Returns:
+        Tuple of (memory_regions_data, real_limits)
+    """
+    # INCLUDEs shared by the primary and --limits scripts are read and
+    # split once
+    script_sources = ScriptSources()
+    region_cache = cache_key = None
+    if ld_scripts and ld_scripts.strip():
+        region_cache = RegionCache(cache_dir)
+        cache_key = RegionCache.make_key(
+            ld_scripts.split(), limits_ld, linker_variables,
+            parsing_strategy(elf_path, elf_context), script_sources)
+        cached = region_cache.get(cache_key) if cache_key else None
+        count('region_cache_hits' if cached is not None else 'region_cache_misses')
+        if cached is not None:
+            logger.debug("Linker scripts unchanged, reusing parsed memory regions")
+            return cached['memory_regions'], cached['real_limits']
+
+    memory_regions_data = _parse_linker_scripts_if_provided(
+        ld_scripts, elf_path, linker_variables, elf_context,
+        script_sources=script_sources
+    )
+    real_limits = _resolve_real_limits(
+        limits_ld, memory_regions_data, elf_path, linker_variables,
+        elf_context, script_sources=script_sources
+    )
+    if cache_key:
+        region_cache.put(cache_key, {'memory_regions': memory_regions_data,
+                                     'real_limits': real_limits})
+    return memory_regions_data, real_limits
+
+
+def _resolve_real_limits(  # pylint: disable=too-many-arguments,too-many-positional-arguments
     limits_ld: Optional[str],
     attribution_regions: Optional[Dict[str, Any]],
     elf_path: str,
-    linker_variables: Optional[Dict[str, Any]]
+    linker_variables: Optional[Dict[str, Any]],
+    elf_context: Optional[ELFContext] = None,
+    script_sources: Optional[ScriptSources] = None
 ) -> Optional[Dict[str, int]]:
     """Parse the limits linker script and return a ``name -> real_limit_size``
     mapping for regions that appear in both scripts.
@@ -623,7 +820,8 @@ def _resolve_real_limits(
     logger.debug("Parsing limits linker script: %s", limits_ld)
     try:
         limits_parser = LinkerScriptParser(
-            [limits_ld], elf_file=elf_path, user_variables=linker_variables
+            [limits_ld], elf_file=elf_path, user_variables=linker_variables,
+            elf_context=elf_context, script_sources=script_sources
         )
         limits_regions = limits_parser.parse_memory_regions()
     except Exception as e:  # pylint: disable=broad-exception-caught
@@ -667,7 +865,9 @@ def _resolve_real_limits(
 def _parse_linker_scripts_if_provided(
     ld_scripts: Optional[str],
     elf_path: str,
-    linker_variables: Optional[Dict[str, Any]]
+    linker_variables: Optional[Dict[str, Any]],
+    elf_context: Optional[ELFContext] = None,
+    script_sources: Optional[ScriptSources] = None
 ) -> Optional[Dict[str, Any]]:
     """
     Parse linker scripts if provided, otherwise return None for default regions.
@@ -676,6 +876,8 @@ def _parse_linker_scripts_if_provided(
         ld_scripts: Space-separated linker script paths (or None/empty)
         elf_path: Path to ELF file for architecture detection
         linker_variables: Optional user-defined linker variables
+        elf_context: Optional shared ELF context for architecture detection
+        script_sources: Optional script cache shared with the --limits parse
 
     Returns:
         Parsed memory regions data, or None if no linker scripts provided
@@ -696,7 +898,8 @@ def _parse_linker_scripts_if_provided(
     logger.debug("Parsing memory regions from linker scripts...")
     try:
         parser = LinkerScriptParser(
-            ld_array, elf_file=elf_path, user_variables=linker_variables
+            ld_array, elf_file=elf_path, user_variables=linker_variables,
+            elf_context=elf_context, script_sources=script_sources
         )
         return parser.parse_memory_regions()
     except Exception as e:  # pylint: disable=broad-exception-caught
@@ -736,7 +939,9 @@ def upload_report(  # pylint: disable=too-many-arguments
     build_failed: bool = None,
     identical: bool = False,
     is_github_mode: bool = False,
-    client: Optional[MemBrowseClient] = None
+    client: Optional[MemBrowseClient] = None,
+    upload_encoding: str = DEFAULT_CONTENT_ENCODING,
+    compact_format: bool = False
 ) -> tuple[dict, str]:
     """
     Upload a memory footprint report to MemBrowse platform.
@@ -763,6 +968,9 @@ def upload_report(  # pylint: disable=too-many-arguments
         identical: Whether this commit has identical memory footprint to previous
                    (no changes in build directories, metadata-only report)
         is_github_mode: Whether --github flag is set (enables tokenless for fork PRs)
+        client: Optional client to reuse across uploads
+        upload_encoding: Upload body Content-Encoding when no client is given
+        compact_format: Upload the compact format (version 2) report
 
     Returns:
         tuple[dict, str]: (API response data, comparison URL if available)
@@ -785,13 +993,15 @@ def upload_report(  # pylint: disable=too-many-arguments
 
     # Build and enrich report
     enriched_report = _build_enriched_report(
-        report, commit_info, target_name, build_failed, identical
+        compact_report(report) if compact_format else report,
+        commit_info, target_name, build_failed, identical
     )
 
     # Upload to MemBrowse
     response_data = _perform_upload(
         enriched_report, api_key, api_url, log_prefix,
-        is_github_mode=is_github_mode, client=client
+        is_github_mode=is_github_mode, client=client,
+        upload_encoding=upload_encoding
     )
 
     # Always print upload response details (success or failure)
@@ -851,7 +1061,8 @@ def _perform_upload(  # pylint: disable=too-many-arguments,too-many-positional-a
     api_url: str,
     log_prefix: str,
     is_github_mode: bool = False,
-    client: Optional[MemBrowseClient] = None
+    client: Optional[MemBrowseClient] = None,
+    upload_encoding: str = DEFAULT_CONTENT_ENCODING
 ) -> dict:
     """Perform the actual upload to MemBrowse."""
     try:
@@ -861,13 +1072,35 @@ def _perform_upload(  # pylint: disable=too-many-arguments,too-many-positional-a
                 api_key=api_key,
                 auto_detect_fork=is_github_mode
             )
-            client = MemBrowseClient(auth_context, api_url)
+            client = MemBrowseClient(auth_context, api_url,
+                                     content_encoding=upload_encoding)
         return client.upload_report(enriched_report)
     except Exception as e:  # pylint: disable=broad-exception-caught
         logger.error("%s: Failed to upload report to %s: %s", log_prefix, api_url, e)
         raise RuntimeError(f"Failed to upload report to {api_url}: {e}") from e
 
 
+def add_upload_format_arguments(group) -> None:
+    """Add the upload encoding options shared by report and onboard."""
+    group.add_argument(
+        '--upload-encoding',
+        dest='upload_encoding',
+        choices=CONTENT_ENCODINGS,
+        default=DEFAULT_CONTENT_ENCODING,
+        help='Compression for the upload body (default: %(default)s; zstd '
+             'needs the zstandard package). Falls back to the next encoding '
+             'if the server rejects it.'
+    )
+    group.add_argument(
+        '--compact-format',
+        dest='compact_format',
+        action='store_true',
+        help='Upload report format version 2, which stores section, source '
+             'file and archive names once in string tables referenced by index. '
+             'Requires a MemBrowse server that supports it.'
+    )
+
+
 def _validate_upload_success(response_data: dict, log_prefix: str) -> None:
     """Validate that upload was successful."""
     if not response_data.get('success'):
@@ -923,6 +1156,59 @@ def _parse_linker_definitions(linker_defs: list) -> Optional[Dict[str, str]]:
     return linker_variables if linker_variables else None
 
 
+def _upload_and_check_alerts(
+    report: dict,
+    args: argparse.Namespace,
+    commit_info: dict,
+    target_name: Optional[str],
+) -> tuple[int, dict]:
+    """
+    Upload a report for one target and check its budget alerts.
+
+    Args:
+        report: The generated memory report
+        args: Parsed command-line arguments (upload options)
+        commit_info: Git commit metadata
+        target_name: Target the report belongs to
+
+    Returns:
+        Tuple of (exit_code, raw_response) where exit_code is 1 when budget
+        alerts should fail the run and raw_response is the
+        ``--output-raw-response`` document the PR comment action reads
+
+    Raises:
+        ValueError: If upload arguments are invalid
+        RuntimeError: If the upload fails
+    """
+    response_data, comparison_url = upload_report(
+        report=report,
+        commit_info=commit_info,
+        target_name=target_name,
+        api_key=getattr(args, 'api_key', None),
+        api_url=getattr(args, 'api_url', DEFAULT_API_URL),
+        identical=getattr(args, 'identical', False),
+        is_github_mode=getattr(args, 'github', False),
+        upload_encoding=getattr(args, 'upload_encoding', DEFAULT_CONTENT_ENCODING),
+        compact_format=getattr(args, 'compact_format', False),
+    )
+
+    exit_code = 0
+    if not getattr(args, 'dont_fail_on_alerts', False):
+        try:
+            _check_budget_alerts(response_data, commit_info)
+        except RuntimeError:
+            # Budget alerts detected - should fail CI
+            exit_code = 1
+
+    raw_response = {
+        'comparison_url': comparison_url or '',
+        'api_response': response_data or {},
+        'target_name': target_name,
+        'pr_number': commit_info.get('pr_number', '')
+    }
+    return exit_code, raw_response
+
+
 def _handle_upload_and_alerts(
     report: dict,
     args: argparse.Namespace,
@@ -935,40 +1221,17 @@ def _handle_upload_and_alerts(
         report: The generated memory report
         args: Parsed command-line arguments
         commit_info: Git commit metadata
-        verbose: Verbose logging flag
 
     Returns:
         Exit code (0 for success, 1 for error)
     """
     try:
-        response_data, comparison_url = upload_report(
-            report=report,
-            commit_info=commit_info,
-            target_name=getattr(args, 'target_name', None),
-            api_key=getattr(args, 'api_key', None),
-            api_url=getattr(args, 'api_url', DEFAULT_API_URL),
-            identical=getattr(args, 'identical', False),
-            is_github_mode=getattr(args, 'github', False),
-        )
-
-        # Check for budget alerts first to determine exit code
-        exit_code = 0
-        if not getattr(args, 'dont_fail_on_alerts', False):
-            try:
-                _check_budget_alerts(response_data, commit_info)
-            except RuntimeError:
-                # Budget alerts detected - should fail CI
-                exit_code = 1
+        exit_code, raw_response = _upload_and_check_alerts(
+            report, args, commit_info, getattr(args, 'target_name', ''))
 
         # Output raw API response to stdout if requested (for piping to PR comment script)
         if getattr(args, 'output_raw_response', False):
-            output_data = {
-                'comparison_url': comparison_url or '',
-                'api_response': response_data or {},
-                'target_name': getattr(args, 'target_name', ''),
-                'pr_number': commit_info.get('pr_number', '')
-            }
-            print(json.dumps(output_data, indent=2))
+            print(json.dumps(raw_response, indent=2))
             return exit_code
 
         # If we reach here and have alerts, re-raise to fail
@@ -1025,6 +1288,15 @@ def _validate_args(args: argparse.Namespace) -> Optional[str]:
         if limits_error:
             return limits_error
 
+    return _validate_profile_path(getattr(args, 'profile', None))
+
+
+def _validate_profile_path(profile_path: Optional[str]) -> Optional[str]:
+    """Check that a --profile file can be created, returning an error or None."""
+    if profile_path:
+        profile_dir = os.path.dirname(os.path.abspath(profile_path))
+        if not os.path.isdir(profile_dir):
+            return f"--profile directory does not exist: {profile_dir}"
     return None
 
 
@@ -1041,11 +1313,28 @@ def run_report(args: argparse.Namespace) -> int:
     Returns:
         Exit code (0 for success, 1 for error)
     """
-    error = _validate_args(args)
+    if getattr(args, 'manifest', None):
+        # Local import: batch builds on this module
+        from .batch import run_manifest, validate_manifest_args  # pylint: disable=import-outside-toplevel
+        validate, run = validate_manifest_args, run_manifest
+    else:
+        validate, run = _validate_args, _run_report
+
+    error = validate(args)
     if error:
         logger.error("%s", error)
         return 1
 
+    profile_path = getattr(args, 'profile', None)
+    with profiling(profile_path):
+        exit_code = run(args)
+    if profile_path:
+        logger.info("Profile written to %s", profile_path)
+    return exit_code
+
+
+def _run_report(args: argparse.Namespace) -> int:
+    """Body of :func:`run_report` after argument validation."""
     identical_mode = getattr(args, 'identical', False)
     upload_mode = getattr(args, 'upload', False)
 
@@ -1057,17 +1346,28 @@ def run_report(args: argparse.Namespace) -> int:
         # Parse linker variable definitions
         linker_variables = _parse_linker_definitions(getattr(args, 'linker_defs', None))
 
-        # Generate report
+        options = {
+            'elf_path': args.elf_path,
+            'ld_scripts': args.ld_scripts,
+            'skip_line_program': getattr(args, 'skip_line_program', False),
+            'linker_variables': linker_variables,
+            'map_file': getattr(args, 'map_file', None),
+            'limits_ld': getattr(args, 'limits', None),
+            'skip_sections': getattr(args, 'skip_sections', None),
+            'jobs': getattr(args, 'jobs', 1),
+            'cache_dir': cache_dir_from_args(args),
+            'native_demangler': getattr(args, 'native_demangler', False),
+            'lazy_line_program': getattr(args, 'lazy_line_program', False),
+        }
+
+        # Generate report, in a running `membrowse serve` if there is one.
+        # Profiles need the stages of this process, so they analyze locally.
         try:
-            report = generate_report(
-                elf_path=args.elf_path,
-                ld_scripts=args.ld_scripts,
-                skip_line_program=getattr(args, 'skip_line_program', False),
-                linker_variables=linker_variables,
-                map_file=getattr(args, 'map_file', None),
-                limits_ld=getattr(args, 'limits', None),
-                skip_sections=getattr(args, 'skip_sections', None),
-            )
+            report = None
+            if not getattr(args, 'no_daemon', False) and not getattr(args, 'profile', None):
+                report = request_report(options)
+            if report is None:
+                report = generate_report(**options)
         except ValueError as e:
             logger.error("Failed to generate report: %s", e)
             return 1
@@ -1075,12 +1375,23 @@ def run_report(args: argparse.Namespace) -> int:
     # If not uploading, output report to stdout
     if not upload_mode:
         if getattr(args, 'json', False):
-            print(json.dumps(report, indent=2))
+            # Written piece by piece rather than built as one string
+            json.dump(report, sys.stdout, indent=2)
+            sys.stdout.write('\n')
         else:
             show_all_symbols = getattr(args, 'all_symbols', False)
             print(format_report_human_readable(report, show_all_symbols=show_all_symbols))
         return 0
 
+    # Upload report and handle alerts
+    return _handle_upload_and_alerts(report, args, _build_commit_info(args))
+
+
+def _build_commit_info(args: argparse.Namespace) -> dict:
+    """Git metadata for an upload, in ``metadata['git']`` format.
+
+    Explicit command-line values win over auto-detected ones.
+    """
     # Build commit_info dict in metadata['git'] format
     arg_to_metadata_map = {
         'commit_sha': 'commit_hash',
@@ -1126,5 +1437,4 @@ def run_report(args: argparse.Namespace) -> int:
     if explicit_no_parent:
         commit_info['parent_commit_hash'] = None
 
-    # Upload report and handle alerts
-    return _handle_upload_and_alerts(report, args, commit_info)
+    return commit_info
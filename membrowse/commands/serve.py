@@ -0,0 +1,246 @@
+"""Serve subcommand - keeps analysis caches warm for repeated reports."""
+
+import argparse
+import json
+import logging
+import os
+import socketserver
+import threading
+from pathlib import Path
+from typing import Any, Dict, List, Optional
+
+from ..utils.cache import ContentCache
+from ..utils.daemon import (
+    DaemonUnavailable, daemon_supported, package_version, send_request, socket_path)
+from .report import generate_report
+
+logger = logging.getLogger(__name__)
+
+DEFAULT_MEMORY_MB = 1024
+
+# generate_report() options a client may pass
+REPORT_OPTIONS = frozenset((
+    'elf_path', 'ld_scripts', 'skip_line_program', 'linker_variables', 'map_file',
+    'limits_ld', 'skip_sections', 'jobs', 'cache_dir', 'native_demangler',
+    'lazy_line_program',
+))
+
+
+def add_serve_parser(subparsers) -> argparse.ArgumentParser:
+    """Add 'serve' subcommand parser."""
+    parser = subparsers.add_parser(
+        'serve',
+        help='Run a daemon that keeps caches warm for repeated reports',
+        description=(
+            'Listen on a Unix domain socket and generate reports for\n'
+            '`membrowse report`, which uses a running daemon automatically.\n\n'
+            'Per-CU DWARF results, complete reports, parsed linker scripts and\n'
+            'demangled names stay in memory between requests, so a rebuilt ELF\n'
+            'only decodes its changed compilation units and an unchanged one is\n'
+            'answered from memory. Only requests that ask for the on-disk cache\n'
+            '(`membrowse report --cache`) also read and write it.'
+        ),
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+    )
+    parser.add_argument(
+        '--socket',
+        metavar='PATH',
+        help=f'Socket to listen on (default: ${{MEMBROWSE_SOCKET}} or {socket_path()})',
+    )
+    parser.add_argument(
+        '--cache-dir',
+        default=None,
+        metavar='DIR',
+        help=('On-disk cache for requests that do not pass their own '
+              '(default: none, those are cached in memory only)'),
+    )
+    parser.add_argument(
+        '--memory-mb',
+        type=int,
+        default=DEFAULT_MEMORY_MB,
+        metavar='MB',
+        help=('Memory for cached DWARF results and reports '
+              f'(default: {DEFAULT_MEMORY_MB})'),
+    )
+    parser.add_argument(
+        '--idle-timeout',
+        type=float,
+        default=0,
+        metavar='SECONDS',
+        help='Exit after SECONDS without a request (default: 0, run until stopped)',
+    )
+    parser.add_argument(
+        '--stop',
+        action='store_true',
+        help='Stop the daemon listening on the socket and exit',
+    )
+    return parser
+
+
+class _LogCapture(logging.Handler):
+    """Collects the records of one request to send back to the client."""
+
+    def __init__(self, level: int):
+        super().__init__(level)
+        self.records: List[List[Any]] = []
+
+    def emit(self, record: logging.LogRecord) -> None:
+        self.records.append([record.name, record.levelno, record.getMessage()])
+
+
+class ReportDaemon:
+    """Answers daemon requests; caches live in the process between calls.
+
+    Requests are handled one at a time, each in the client's working
+    directory so that relative paths mean what they do for the client.
+    """
+
+    def __init__(self, cache_dir: Optional[str] = None):
+        # Only used for requests without their own; None keeps their
+        # entries in the memory layer of ContentCache
+        self.cache_dir = cache_dir
+        self.version = package_version()
+        self.requests = 0
+        self.stopped = False
+
+    def handle(self, request: Any) -> Dict[str, Any]:
+        """Response for one decoded request."""
+        if not isinstance(request, dict):
+            return {'ok': False, 'error': 'request must be a JSON object'}
+        command = request.get('command')
+        if command == 'ping':
+            return {'ok': True, 'version': self.version, 'pid': os.getpid(),
+                    'requests': self.requests}
+        if command == 'stop':
+            self.stopped = True
+            return {'ok': True}
+        if command != 'report':
+            return {'ok': False, 'error': f'unknown command: {command!r}'}
+        if request.get('version') != self.version:
+            return {'ok': False, 'incompatible': True,
+                    'error': (f"daemon runs membrowse {self.version}, "
+                              f"client is {request.get('version')}")}
+        return self._report(request)
+
+    def _report(self, request: Dict[str, Any]) -> Dict[str, Any]:
+        options = request.get('options') or {}
+        unknown = sorted(set(options) - REPORT_OPTIONS)
+        if unknown or 'elf_path' not in options:
+            return {'ok': False, 'incompatible': True,
+                    'error': f"unsupported report options: {', '.join(unknown) or 'elf_path'}"}
+        options = dict(options)
+        if self.cache_dir and not options.get('cache_dir'):
+            options['cache_dir'] = self.cache_dir
+
+        self.requests += 1
+        capture = _LogCapture(request.get('log_level', logging.INFO))
+        package_logger = logging.getLogger('membrowse')
+        previous_level = package_logger.level
+        package_logger.addHandler(capture)
+        package_logger.setLevel(capture.level)
+        previous_cwd = os.getcwd()
+        try:
+            os.chdir(request.get('cwd') or previous_cwd)
+            report = generate_report(**options)
+            response = {'ok': True, 'pid': os.getpid(), 'report': report}
+        except (OSError, ValueError) as e:
+            response = {'ok': False, 'error': str(e)}
+        except Exception as e:  # pylint: disable=broad-exception-caught
+            logger.exception("Report request failed")
+            response = {'ok': False, 'error': f"daemon error: {e}"}
+        finally:
+            os.chdir(previous_cwd)
+            package_logger.removeHandler(capture)
+            package_logger.setLevel(previous_level)
+        response['logs'] = capture.records
+        return response
+
+
+class _RequestHandler(socketserver.StreamRequestHandler):
+    """One JSON line in, one JSON line out."""
+
+    def handle(self) -> None:
+        line = self.rfile.readline()
+        try:
+            request = json.loads(line)
+        except ValueError as e:
+            response = {'ok': False, 'error': f'invalid request: {e}'}
+        else:
+            response = self.server.report_daemon.handle(request)
+        self.wfile.write(json.dumps(response, separators=(',', ':')).encode('utf-8') + b'\n')
+
+
+def _daemon_running(path) -> bool:
+    try:
+        send_request({'command': 'ping'}, path, timeout=5)
+    except DaemonUnavailable:
+        return False
+    return True
+
+
+def run_serve(args: argparse.Namespace) -> int:
+    """
+    Execute the serve subcommand.
+
+    Args:
+        args: Parsed command-line arguments
+
+    Returns:
+        Exit code (0 for success, 1 for errors)
+    """
+    if not daemon_supported():
+        logger.error("membrowse serve needs Unix domain sockets, which this platform lacks")
+        return 1
+    path = Path(args.socket) if getattr(args, 'socket', None) else socket_path()
+
+    if getattr(args, 'stop', False):
+        try:
+            send_request({'command': 'stop'}, path, timeout=5)
+        except DaemonUnavailable as e:
+            logger.error("No daemon to stop: %s", e)
+            return 1
+        return 0
+
+    memory_mb = getattr(args, 'memory_mb', DEFAULT_MEMORY_MB)
+    if memory_mb < 0:
+        logger.error("--memory-mb must not be negative")
+        return 1
+    if _daemon_running(path):
+        logger.error("A daemon is already listening on %s", path)
+        return 1
+
+    ContentCache.keep_in_memory(memory_mb * 1024 * 1024)
+    path.parent.mkdir(parents=True, exist_ok=True)
+    if path.exists():
+        path.unlink()  # Left behind by a daemon that did not shut down
+
+    daemon = ReportDaemon(getattr(args, 'cache_dir', None))
+    # Only the owner may connect: reports expose file contents
+    previous_umask = os.umask(0o177)
+    try:
+        server = socketserver.UnixStreamServer(  # pylint: disable=no-member
+            str(path), _RequestHandler)
+    finally:
+        os.umask(previous_umask)
+    server.report_daemon = daemon
+    server.timeout = getattr(args, 'idle_timeout', 0) or None
+    idle = threading.Event()
+    server.handle_timeout = idle.set
+
+    logger.info("membrowse serve %s listening on %s", daemon.version, path)
+    try:
+        with server:
+            while not daemon.stopped and not idle.is_set():
+                server.handle_request()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        try:
+            path.unlink()
+        except OSError:
+            pass
+        ContentCache.keep_in_memory(0)
+    if idle.is_set():
+        logger.info("No request for %gs, exiting", server.timeout)
+    logger.info("membrowse serve stopped after %d report(s)", daemon.requests)
+    return 0
@@ -6,9 +6,6 @@ import logging
 from pathlib import Path
 from typing import Dict, Any
 
-from jinja2 import TemplateError as Jinja2TemplateError
-
-from ..api.client import MemBrowseClient
 from ..auth.strategy import AuthContext, AuthType
 from ..utils.summary_formatter import build_summary_template_context, render_jinja2_template
 
@@ -76,6 +73,9 @@ def _fetch_summary(
     Raises:
         RuntimeError: If API request fails or returns an error
     """
+    # Keeps requests out of `membrowse summary --help`
+    from ..api.client import MemBrowseClient  # pylint: disable=import-outside-toplevel
+
     auth_context = AuthContext(
         auth_type=AuthType.API_KEY,
         api_key=api_key,
@@ -106,17 +106,20 @@ def run_summary(args) -> int:
 
         if args.json:
             print(json.dumps(response, indent=2))
-        else:
+            return 0
+
+        # jinja2 is only needed for the rendered (non --json) output
+        from jinja2 import TemplateError  # pylint: disable=import-outside-toplevel
+        try:
             context = build_summary_template_context(response)
             template_path = args.template or str(DEFAULT_TEMPLATE)
             output = render_jinja2_template(template_path, context)
-            print(output)
-
+        except (FileNotFoundError, TemplateError) as e:
+            logger.error("Template error: %s", e)
+            return 1
+        print(output)
         return 0
 
-    except (FileNotFoundError, Jinja2TemplateError) as e:
-        logger.error("Template error: %s", e)
-        return 1
     except RuntimeError as e:
         logger.error("%s", e)
         return 1
@@ -7,17 +7,23 @@ This package contains the main coordination logic for ELF analysis
 and memory report generation.
 """
 
-from .generator import ReportGenerator
-from .analyzer import ELFAnalyzer
-from .models import Symbol, MemoryRegion, MemorySection, ELFMetadata
-from .exceptions import (
-    ELFAnalysisError,
-    DWARFParsingError,
-    DWARFCUProcessingError,
-    DWARFAttributeError,
-    SymbolExtractionError,
-    SectionAnalysisError,
-)
+from ..utils.lazy import lazy_exports
+
+__getattr__, __dir__ = lazy_exports(__name__, {
+    'ReportGenerator': '.generator',
+    'ELFAnalyzer': '.analyzer',
+    'Symbol': '.models',
+    'MemoryRegion': '.models',
+    'MemorySection': '.models',
+    'ELFMetadata': '.models',
+    'ELFAnalysisError': '.exceptions',
+    'DWARFParsingError': '.exceptions',
+    'DWARFCUProcessingError': '.exceptions',
+    'DWARFAttributeError': '.exceptions',
+    'SymbolExtractionError': '.exceptions',
+    'SectionAnalysisError': '.exceptions',
+    'diff_reports': '.diff',
+})
 
 __all__ = [
     'ReportGenerator',
@@ -32,4 +38,5 @@ __all__ = [
     'DWARFAttributeError',
     'SymbolExtractionError',
     'SectionAnalysisError',
+    'diff_reports',
 ]
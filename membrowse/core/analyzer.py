@@ -9,7 +9,7 @@ of ELF files using specialized component classes for symbols, sections, and DWAR
 
 import os
 from pathlib import Path
-from typing import Dict, List, Any, Optional
+from typing import Dict, List, Any, Optional, Tuple
 from elftools.elf.elffile import ELFFile
 from elftools.common.exceptions import ELFError
 
@@ -20,7 +20,8 @@ from ..analysis.sources import SourceFileResolver
 from ..analysis.symbols import SymbolExtractor
 from ..analysis.sections import SectionAnalyzer
 from ..analysis.mapfile import MapFileResolver
-from ..linker.elf_info import ELFParser, Architecture
+from ..linker.elf_info import ELFParser, Architecture, ELFContext
+from ..utils.timing import stage
 
 
 class ELFAnalyzer:  # pylint: disable=too-many-instance-attributes
@@ -60,15 +61,21 @@ class ELFAnalyzer:  # pylint: disable=too-many-instance-attributes
     Note:
         The analyzer opens the ELF file on initialization and keeps it open
         for the lifetime of the object. The file is closed when the analyzer
-        is garbage collected.
+        is garbage collected. When an ``elf_context`` is passed instead, the
+        analyzer reuses it and leaves closing it to the caller.
 
     Attributes:
         elf_path: Path to the ELF file.
         elffile: The underlying pyelftools ELFFile object.
     """
 
-    def __init__(self, elf_path: str, skip_line_program: bool = False,
-                 map_file_path: Optional[str] = None):
+    def __init__(  # pylint: disable=too-many-arguments,too-many-positional-arguments
+                 self, elf_path: str, skip_line_program: bool = False,
+                 map_file_path: Optional[str] = None, jobs: int = 1,
+                 cache_dir: Optional[str] = None,
+                 elf_context: Optional[ELFContext] = None,
+                 native_demangler: bool = False,
+                 lazy_line_program: bool = False):
         """Initialize ELF analyzer with file path and component setup.
 
         Args:
@@ -78,6 +85,22 @@ class ELFAnalyzer:  # pylint: disable=too-many-instance-attributes
                 file mapping coverage from ~97% to ~88% (ARM) or ~76% to ~65% (ESP32).
             map_file_path: Optional path to a linker map file (GNU LD or IAR)
                 for archive/object file attribution on symbols.
+            jobs: Worker processes used for DWARF compilation-unit processing
+                (``0`` = one per CPU). The default of 1 processes CUs serially.
+            cache_dir: Optional directory for the on-disk per-CU DWARF cache.
+                Unchanged compilation units are replayed from the cache
+                instead of being decoded again.
+            elf_context: Optional already opened :class:`ELFContext` for
+                ``elf_path``, shared with other components (e.g. the linker
+                script parser) so the ELF is only opened and decoded once.
+            native_demangler: Demangle C++ symbol names with ``c++filt`` /
+                ``llvm-cxxfilt`` from PATH in one batch. Their formatting
+                differs slightly from the built-in demangler (e.g. ``> >``).
+            lazy_line_program: Run the DWARF DIE pass first and decode line
+                programs only for the CUs containing functions it could not
+                attribute to a source file. Close to ``skip_line_program``
+                speed with close to full source file coverage; source lines
+                are only filled in for symbols in those CUs.
 
         Raises:
             ELFAnalysisError: If the file doesn't exist or cannot be read.
@@ -86,43 +109,68 @@ class ELFAnalyzer:  # pylint: disable=too-many-instance-attributes
         self.skip_line_program = skip_line_program
         self._validate_elf_file()
 
-        # Open ELF file once and reuse throughout
-        # pylint: disable=consider-using-with
-        self._elf_file_handle = open(self.elf_path, 'rb')
+        # Open ELF file once and reuse throughout. A caller-supplied context
+        # is shared with other components and closed by the caller.
+        if elf_context is None:
+            # pylint: disable=consider-using-with
+            self._elf_file_handle = open(self.elf_path, 'rb')
         try:
-            self.elffile = ELFFile(self._elf_file_handle)
+            if elf_context is None:
+                # The context caches section headers, symbols and segments
+                # for all components below
+                with stage('elf_open'):
+                    elf_context = ELFContext(
+                        ELFFile(self._elf_file_handle), str(self.elf_path))
+            self._elf = elf_context
+            self.elffile = elf_context.elffile
 
             # Cache for expensive string operations and file paths
             self._system_header_cache = {}
 
             # Get symbol addresses we need to map
-            symbol_addresses = self._get_symbol_addresses_to_map(self.elffile)
+            symbol_addresses, function_addresses = self._get_symbol_addresses_to_map(
+                self._elf)
 
             # Detect architecture for address tolerance
-            machine = self.elffile.header['e_machine']
+            machine = self._elf.header['e_machine']
 
             # Process DWARF information
             dwarf_processor = DWARFProcessor(
-                self.elffile,
+                self._elf,
                 symbol_addresses,
                 skip_line_program=skip_line_program,
-                machine=machine
+                machine=machine,
+                jobs=jobs,
+                elf_path=str(self.elf_path),
+                cache_dir=cache_dir,
+                lazy_line_program=lazy_line_program,
+                function_addresses=function_addresses
             )
-            self._dwarf_data = dwarf_processor.process_dwarf_info()
+            with stage('dwarf'):
+                self._dwarf_data = dwarf_processor.process_dwarf_info()
 
             # Initialize specialized analyzers
             self._source_resolver = SourceFileResolver(
                 self._dwarf_data, self._system_header_cache)
-            self._symbol_extractor = SymbolExtractor(self.elffile)
-            self._section_analyzer = SectionAnalyzer(self.elffile)
+            self._symbol_extractor = SymbolExtractor(
+                self._elf, native_demangler=native_demangler)
+            self._section_analyzer = SectionAnalyzer(self._elf)
+
+            if dwarf_processor.lazy_line_program:
+                with stage('dwarf'):
+                    dwarf_processor.decode_line_programs(
+                        self._source_resolver.unresolved_function_addresses(
+                            self._symbol_extractor.function_symbols()))
 
             # Initialize map file resolver (optional)
             if map_file_path:
-                self._map_resolver = MapFileResolver.from_file(map_file_path)
+                with stage('map_file_parse'):
+                    self._map_resolver = MapFileResolver.from_file(map_file_path)
             else:
                 self._map_resolver = MapFileResolver.null()
         except Exception:
-            self._elf_file_handle.close()
+            if hasattr(self, '_elf_file_handle'):
+                self._elf_file_handle.close()
             raise
 
     def _validate_elf_file(self) -> None:
@@ -138,19 +186,26 @@ class ELFAnalyzer:  # pylint: disable=too-many-instance-attributes
         if hasattr(self, '_elf_file_handle'):
             self._elf_file_handle.close()
 
-    def _get_symbol_addresses_to_map(self, elffile) -> set:
-        """Get set of symbol addresses that we actually need to map."""
+    def _get_symbol_addresses_to_map(self, elffile) -> Tuple[set, set]:
+        """Get sets of symbol addresses that we actually need to map.
+
+        Returns:
+            (all symbol addresses, addresses of the FUNC symbols among them)
+        """
         symbol_addresses = set()
+        function_addresses = set()
 
         symbol_table_section = elffile.get_section_by_name('.symtab')
         if not symbol_table_section:
-            return symbol_addresses
+            return symbol_addresses, function_addresses
 
         for symbol in symbol_table_section.iter_symbols():
             if self._is_valid_symbol(symbol):
                 symbol_addresses.add(symbol['st_value'])
+                if symbol['st_info']['type'] == 'STT_FUNC':
+                    function_addresses.add(symbol['st_value'])
 
-        return symbol_addresses
+        return symbol_addresses, function_addresses
 
     def _is_valid_symbol(self, symbol) -> bool:
         """Check if symbol should be included in analysis."""
@@ -218,7 +273,7 @@ class ELFAnalyzer:  # pylint: disable=too-many-instance-attributes
         (e.g. ``--skip-section``) should use this so non-loaded sections
         aren't mistaken for missing.
         """
-        return {s.name for s in self.elffile.iter_sections() if s.name}
+        return {s.name for s in self._elf.iter_sections() if s.name}
 
     def get_symbols(self) -> List[Symbol]:
         """Extract symbols from the ELF file.
@@ -242,7 +297,7 @@ class ELFAnalyzer:  # pylint: disable=too-many-instance-attributes
         segments = []
 
         try:
-            for segment in self.elffile.iter_segments():
+            for segment in self._elf.iter_segments():
                 segments.append({
                     'type': segment['p_type'],
                     'offset': segment['p_offset'],
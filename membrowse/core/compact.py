@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+"""
+Compact report format with interned symbol strings.
+
+Most symbol entries repeat a handful of section names, source file basenames
+and archive/object paths. Format version 2 stores each distinct value once
+in ``string_tables`` and replaces it in every symbol by its index:
+
+.. code-block:: json
+
+    {
+      "format_version": 2,
+      "string_tables": {"section": [".text", ".bss"], "source_file": ["main.c"]},
+      "symbols": [{"name": "main", "section": 0, "source_file": 0}]
+    }
+
+Reports without ``format_version`` are version 1 (plain strings).
+"""
+
+from typing import Any, Dict, List
+
+COMPACT_FORMAT_VERSION = 2
+
+# Symbol fields whose values are replaced by string table indices
+INTERNED_SYMBOL_FIELDS = ('section', 'source_file', 'archive', 'object_file')
+
+
+def compact_report(report: Dict[str, Any]) -> Dict[str, Any]:
+    """Return a format version 2 copy of ``report`` (the input is unchanged)."""
+    tables: Dict[str, List[Any]] = {field: [] for field in INTERNED_SYMBOL_FIELDS}
+    indices: Dict[str, Dict[Any, int]] = {field: {} for field in INTERNED_SYMBOL_FIELDS}
+
+    symbols = []
+    for symbol in report.get('symbols', []):
+        entry = dict(symbol)
+        for field in INTERNED_SYMBOL_FIELDS:
+            if field not in entry:
+                continue
+            value = entry[field]
+            index = indices[field].get(value)
+            if index is None:
+                index = indices[field][value] = len(tables[field])
+                tables[field].append(value)
+            entry[field] = index
+        symbols.append(entry)
+
+    compact = dict(report)
+    compact['format_version'] = COMPACT_FORMAT_VERSION
+    compact['string_tables'] = tables
+    compact['symbols'] = symbols
+    return compact
+
+
+def expand_report(report: Dict[str, Any]) -> Dict[str, Any]:
+    """Return the plain (version 1) form of a report in either format."""
+    if report.get('format_version') != COMPACT_FORMAT_VERSION:
+        return report
+
+    tables = report['string_tables']
+    symbols = []
+    for symbol in report.get('symbols', []):
+        entry = dict(symbol)
+        for field, values in tables.items():
+            if field in entry:
+                entry[field] = values[entry[field]]
+        symbols.append(entry)
+
+    expanded = {key: value for key, value in report.items()
+                if key not in ('format_version', 'string_tables')}
+    expanded['symbols'] = symbols
+    return expanded
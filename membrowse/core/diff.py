@@ -0,0 +1,232 @@
+"""
+Local comparison of two memory reports.
+
+:func:`diff_reports` produces the ``changes`` object the MemBrowse server
+returns in its ``changes_summary``: per-category ``added`` / ``removed`` /
+``modified`` lists whose ``modified`` entries carry the head values and an
+``old`` dict with the base values. ``summary_formatter`` and the PR comment
+templates render it unchanged, and it adds the ``archives`` category and
+symbol-level deltas that do not need an upload.
+
+Symbols are hash-joined on ``(name, section, source file)``, with the name
+stripped of compiler clone suffixes (``.constprop.0``, ``.part.1``, ...) so
+that a function GCC clones differently in the two builds still matches.
+Symbols without a source file are joined on their object file instead.
+What remains unmatched is paired where the pairing is unambiguous: the same
+name in the same section under a different source file (a moved function),
+or a single symbol of identical size in the same section and file (a
+rename). Those pairs are reported as ``moved``.
+"""
+
+from collections import defaultdict
+from typing import Any, Callable, Dict, Iterable, List, Optional, Tuple
+
+from ..analysis.symbols import strip_compiler_suffix
+
+# Symbol fields copied into symbol deltas
+SYMBOL_DELTA_FIELDS = ('name', 'address', 'size', 'type', 'section', 'source_file',
+                       'archive', 'object_file')
+
+SymbolKey = Tuple[str, str, str]
+
+
+def base_name(name: str) -> str:
+    """``name`` without any (possibly stacked) compiler clone suffixes."""
+    while True:
+        stripped = strip_compiler_suffix(name)
+        if stripped == name:
+            return name
+        name = stripped
+
+
+def _symbol_key(symbol: Dict[str, Any]) -> SymbolKey:
+    return (base_name(symbol.get('name', '')), symbol.get('section', ''),
+            symbol.get('source_file') or symbol.get('object_file', ''))
+
+
+def _index_symbols(symbols: Iterable[Dict[str, Any]]) -> Dict[SymbolKey, Dict[str, Any]]:
+    """Join key -> symbol record; clones sharing a key are summed.
+
+    Zero-size symbols (labels, linker markers) occupy no memory and are left
+    out.
+    """
+    index: Dict[SymbolKey, Dict[str, Any]] = {}
+    for symbol in symbols:
+        if not symbol.get('size'):
+            continue
+        key = _symbol_key(symbol)
+        record = index.get(key)
+        if record is None:
+            index[key] = {field: symbol.get(field, '') for field in SYMBOL_DELTA_FIELDS}
+        else:
+            # Several clones of one function: report them under the base name
+            record['size'] += symbol['size']
+            record['name'] = key[0]
+            record['address'] = min(record['address'], symbol.get('address', 0))
+    return index
+
+
+def _delta_entry(head: Optional[Dict[str, Any]], base: Optional[Dict[str, Any]],
+                 fields: Iterable[str]) -> Dict[str, Any]:
+    """Change entry in the server's shape: head values plus ``old``."""
+    entry = dict(head if head is not None else base)
+    old_size = base['size'] if base is not None else 0
+    entry['delta'] = (head['size'] if head is not None else 0) - old_size
+    if head is not None and base is not None:
+        entry['old'] = {field: base[field] for field in fields}
+    return entry
+
+
+def _by_delta(entries: List[Dict[str, Any]]) -> List[Dict[str, Any]]:
+    return sorted(entries, key=lambda entry: (-abs(entry['delta']), entry['name']))
+
+
+def _pair_unique(removed: Dict[SymbolKey, Dict[str, Any]],
+                 added: Dict[SymbolKey, Dict[str, Any]],
+                 match_key: Callable[[SymbolKey, Dict[str, Any]], Any]
+                 ) -> List[Tuple[SymbolKey, SymbolKey]]:
+    """Pairs of unmatched keys that are the only ones sharing ``match_key``."""
+    groups: Dict[Any, Tuple[List[SymbolKey], List[SymbolKey]]] = defaultdict(
+        lambda: ([], []))
+    for key, record in removed.items():
+        groups[match_key(key, record)][0].append(key)
+    for key, record in added.items():
+        groups[match_key(key, record)][1].append(key)
+    return [(old_keys[0], new_keys[0]) for old_keys, new_keys in groups.values()
+            if len(old_keys) == 1 and len(new_keys) == 1]
+
+
+def _same_name(key: SymbolKey, _record: Dict[str, Any]) -> Any:
+    """Moved to another source file."""
+    return key[0], key[1]
+
+
+def _same_place_and_size(key: SymbolKey, record: Dict[str, Any]) -> Any:
+    """Renamed in place."""
+    return key[1], key[2], record['size']
+
+
+def diff_symbols(base_symbols: Iterable[Dict[str, Any]],
+                 head_symbols: Iterable[Dict[str, Any]]) -> Dict[str, List[Dict[str, Any]]]:
+    """Symbol deltas between two reports' ``symbols`` lists.
+
+    Returns:
+        ``added``, ``removed``, ``modified`` and ``moved`` lists, largest
+        change first. Every entry has ``delta`` (bytes); ``modified`` and
+        ``moved`` entries hold the base symbol's fields in ``old``.
+    """
+    base = _index_symbols(base_symbols)
+    head = _index_symbols(head_symbols)
+    old_fields = ('name', 'address', 'size', 'section', 'source_file')
+
+    modified = [_delta_entry(record, base[key], old_fields)
+                for key, record in head.items()
+                if key in base and record['size'] != base[key]['size']]
+
+    removed = {key: record for key, record in base.items() if key not in head}
+    added = {key: record for key, record in head.items() if key not in base}
+    moved = []
+    for match_key in (_same_name, _same_place_and_size):
+        for old_key, new_key in _pair_unique(removed, added, match_key):
+            moved.append(_delta_entry(added.pop(new_key), removed.pop(old_key),
+                                      old_fields))
+
+    return {
+        'added': _by_delta([_delta_entry(record, None, ()) for record in added.values()]),
+        'removed': _by_delta([_delta_entry(None, record, ()) for record in removed.values()]),
+        'modified': _by_delta(modified),
+        'moved': _by_delta(moved),
+    }
+
+
+def _diff_named(base: Dict[Any, Dict[str, Any]], head: Dict[Any, Dict[str, Any]],
+                size_field: str, changed: Callable[[Dict[str, Any], Dict[str, Any]], bool],
+                old_fields: Iterable[str]) -> Dict[str, List[Dict[str, Any]]]:
+    """``added`` / ``removed`` / ``modified`` for entries that carry a ``name``."""
+    modified = []
+    for key, values in head.items():
+        old = base.get(key)
+        if old is not None and changed(old, values):
+            modified.append({**values,
+                             'delta': values.get(size_field, 0) - old.get(size_field, 0),
+                             'old': {field: old.get(field) for field in old_fields}})
+    return {
+        'added': _by_delta([{**values, 'delta': values.get(size_field, 0)}
+                            for key, values in head.items() if key not in base]),
+        'removed': _by_delta([{**values, 'delta': -values.get(size_field, 0)}
+                              for key, values in base.items() if key not in head]),
+        'modified': _by_delta(modified),
+    }
+
+
+def _region_values(report: Dict[str, Any]) -> Dict[str, Dict[str, Any]]:
+    return {name: {'name': name, **{field: value for field, value in region.items()
+                                    if field != 'sections'}}
+            for name, region in (report.get('memory_layout') or {}).items()}
+
+
+def _section_values(report: Dict[str, Any]) -> Dict[Tuple[str, str], Dict[str, Any]]:
+    """(region, section) -> section entry; LMA copies appear in both regions."""
+    sections = {}
+    for region_name, region in (report.get('memory_layout') or {}).items():
+        for section in region.get('sections', []):
+            sections[(region_name, section['name'])] = {**section, 'region': region_name}
+    return sections
+
+
+def _archive_values(report: Dict[str, Any]) -> Dict[str, Dict[str, Any]]:
+    sizes: Dict[str, int] = defaultdict(int)
+    for symbol in report.get('symbols', []):
+        if symbol.get('archive'):
+            sizes[symbol['archive']] += symbol.get('size', 0)
+    return {name: {'name': name, 'size': size} for name, size in sizes.items()}
+
+
+def diff_reports(base: Dict[str, Any], head: Dict[str, Any]) -> Dict[str, Any]:
+    """Compare two reports from ``generate_report()``.
+
+    Args:
+        base: Report of the reference build
+        head: Report of the build being evaluated
+
+    Returns:
+        ``{'changes': {...}}`` with ``regions``, ``sections``, ``archives``
+        and ``symbols`` deltas in the server's ``changes_summary`` shape.
+        Regions are modified when their used size or limit changed, sections
+        and archives when their size changed.
+    """
+    regions = _diff_named(
+        _region_values(base), _region_values(head), 'used_size',
+        lambda old, new: (old.get('used_size'), old.get('limit_size'))
+        != (new.get('used_size'), new.get('limit_size')),
+        ('used_size', 'limit_size', 'free_size', 'utilization_percent'))
+
+    sections = _diff_named(
+        _section_values(base), _section_values(head), 'size',
+        lambda old, new: old.get('size') != new.get('size'), ('address', 'size'))
+
+    archives = _diff_named(_archive_values(base), _archive_values(head), 'size',
+                           lambda old, new: old['size'] != new['size'], ('size',))
+
+    return {
+        'base': base.get('file_path'),
+        'head': head.get('file_path'),
+        'changes': {
+            'regions': regions,
+            'sections': sections,
+            'archives': archives,
+            'symbols': diff_symbols(base.get('symbols', []), head.get('symbols', [])),
+        },
+    }
+
+
+def as_summary_response(diff: Dict[str, Any], target_name: str) -> Dict[str, Any]:
+    """Wrap a diff like a one-target summary API response.
+
+    The result can be passed to ``build_summary_template_context`` to render
+    the diff with the summary and PR comment templates.
+    """
+    return {'data': {'targets': [{
+        'target_name': target_name,
+        'changes_summary': {'changes': diff['changes']},
+    }]}}
@@ -11,7 +11,10 @@ import logging
 from typing import Dict, Any, List, Optional
 from .models import MemoryRegion, MemoryReport
 from .analyzer import ELFAnalyzer
+from .symbol_table import SymbolTable
+from ..linker.elf_info import ELFContext
 from ..analysis.mapper import MemoryMapper
+from ..utils.timing import stage
 from .exceptions import ELFAnalysisError
 
 # Set up logger
@@ -59,7 +62,12 @@ class ReportGenerator:  # pylint: disable=too-few-public-methods
                  skip_line_program: bool = False,
                  map_file_path: Optional[str] = None,
                  real_limits: Optional[Dict[str, int]] = None,
-                 skip_sections: Optional[List[str]] = None):
+                 skip_sections: Optional[List[str]] = None,
+                 jobs: int = 1,
+                 cache_dir: Optional[str] = None,
+                 elf_context: Optional[ELFContext] = None,
+                 native_demangler: bool = False,
+                 lazy_line_program: bool = False):
         """Initialize the report generator.
 
         Args:
@@ -82,10 +90,22 @@ class ReportGenerator:  # pylint: disable=too-few-public-methods
                 are removed before mapping, so they do not contribute to any
                 region's ``used_size``; symbols residing in those sections
                 are also dropped to keep the report consistent.
+            jobs: Worker processes used for DWARF processing (``0`` = one per
+                CPU). Output is identical to a serial run.
+            cache_dir: Optional directory for on-disk analysis caches (see
+                :class:`ELFAnalyzer`). Output is identical to an uncached run.
+            elf_context: Optional already opened :class:`ELFContext` for
+                ``elf_path`` to share with the analyzer. The caller closes it.
+            native_demangler: Demangle C++ symbol names with a native
+                ``c++filt`` / ``llvm-cxxfilt`` (see :class:`ELFAnalyzer`).
+            lazy_line_program: Decode DWARF line programs only for the CUs
+                of functions the DIE pass missed (see :class:`ELFAnalyzer`).
         """
         self.elf_analyzer = ELFAnalyzer(
             elf_path, skip_line_program=skip_line_program,
-            map_file_path=map_file_path)
+            map_file_path=map_file_path, jobs=jobs, cache_dir=cache_dir,
+            elf_context=elf_context, native_demangler=native_demangler,
+            lazy_line_program=lazy_line_program)
         self.memory_regions_data = memory_regions_data
         self.elf_path = elf_path
         self.skip_line_program = skip_line_program
@@ -111,7 +131,8 @@ class ReportGenerator:  # pylint: disable=too-few-public-methods
             - ``program_headers`` (list): ELF program headers/segments.
             - ``memory_layout`` (dict): Memory region utilization data (only if
               memory_regions_data was provided). Maps region names to dicts with:
-              address, limit_size, used_size, free_size, utilization_percent, sections.
+              address, limit_size, used_size, free_size, utilization_percent, sections,
+              symbol_used_size (bytes of the symbols located in the region).
 
         Raises:
             ELFAnalysisError: If ELF analysis fails.
@@ -133,7 +154,7 @@ class ReportGenerator:  # pylint: disable=too-few-public-methods
         try:
             # Extract ELF data
             metadata = self.elf_analyzer.get_metadata()
-            symbols = self.elf_analyzer.get_symbols()
+            symbols = SymbolTable.from_symbols(self.elf_analyzer.get_symbols())
             sections = self.elf_analyzer.get_sections()
             program_headers = self.elf_analyzer.get_program_headers()
 
@@ -142,49 +163,13 @@ class ReportGenerator:  # pylint: disable=too-few-public-methods
             if self.skip_sections:
                 sections, symbols = self._apply_section_skips(sections, symbols)
 
-            # Convert memory regions data to MemoryRegion objects (if provided)
-            memory_regions = {}
-            if self.memory_regions_data:
-                memory_regions = self._convert_to_memory_regions(
-                    self.memory_regions_data)
-
-                # Map sections to regions based on addresses and calculate
-                # utilization
-                unmapped = MemoryMapper.map_sections_to_regions(
-                    sections, memory_regions)
-
-                # If sections couldn't be mapped, try inferring regions from
-                # ELF LOAD segments (e.g. when linker script symbols are
-                # unresolved)
-                if unmapped:
-                    inferred = MemoryMapper.infer_regions_from_segments(
-                        program_headers, memory_regions)
-                    if inferred:
-                        memory_regions.update(inferred)
-                        # Re-map the previously unmapped sections
-                        still_unmapped = MemoryMapper.map_sections_to_regions(
-                            unmapped, memory_regions)
-                        if still_unmapped:
-                            logger.warning(
-                                "%d section(s) could not be mapped to any "
-                                "memory region: %s",
-                                len(still_unmapped),
-                                ', '.join(s.name for s in still_unmapped))
-
-                # Swap attribution limit_size for the real limit (from a
-                # separate limits linker script) before computing utilization.
-                # Attribution used the broader range to classify overflow
-                # sections; utilization math uses the real capacity.
-                for name, real_size in self.real_limits.items():
-                    region = memory_regions.get(name)
-                    if region is not None:
-                        region.limit_size = real_size
-
-                MemoryMapper.calculate_utilization(memory_regions)
+            with stage('region_mapping'):
+                memory_regions = self._map_memory_regions(
+                    sections, program_headers, symbols)
 
             # Calculate performance statistics
             total_time = time.time() - report_start_time
-            symbols_with_source = sum(1 for s in symbols if s.source_file)
+            symbols_with_source = symbols.count_nonempty('source_file')
 
             logger.debug("Performance Summary:")
             logger.debug("  Total time: %.2fs", total_time)
@@ -207,8 +192,7 @@ class ReportGenerator:  # pylint: disable=too-few-public-methods
                 'entry_point': metadata.entry_point,
                 'file_type': metadata.file_type,
                 'machine': metadata.machine,
-                'symbols': [
-                    symbol.__dict__ for symbol in symbols],
+                'symbols': symbols.to_dicts(),
                 'program_headers': program_headers,
                 'memory_layout': {
                     name: region.to_dict() for name,
@@ -220,7 +204,63 @@ class ReportGenerator:  # pylint: disable=too-few-public-methods
             raise ELFAnalysisError(
                 f"Failed to generate memory report: {e}") from e
 
-    def _apply_section_skips(self, sections, symbols):
+    def _map_memory_regions(self, sections, program_headers,
+                            symbols) -> Dict[str, MemoryRegion]:
+        """Map sections and symbols to the configured regions and compute
+        utilization.
+
+        Returns:
+            Dictionary mapping region names to MemoryRegion objects (empty
+            when no memory regions were provided)
+        """
+        # Convert memory regions data to MemoryRegion objects (if provided)
+        memory_regions = {}
+        if self.memory_regions_data:
+            memory_regions = self._convert_to_memory_regions(
+                self.memory_regions_data)
+
+            # Section mapping consumes the LMAs symbol attribution needs
+            lma_offsets = MemoryMapper.section_lma_offsets(sections)
+
+            # Map sections to regions based on addresses and calculate
+            # utilization
+            unmapped = MemoryMapper.map_sections_to_regions(
+                sections, memory_regions)
+
+            # If sections couldn't be mapped, try inferring regions from
+            # ELF LOAD segments (e.g. when linker script symbols are
+            # unresolved)
+            if unmapped:
+                inferred = MemoryMapper.infer_regions_from_segments(
+                    program_headers, memory_regions)
+                if inferred:
+                    memory_regions.update(inferred)
+                    # Re-map the previously unmapped sections
+                    still_unmapped = MemoryMapper.map_sections_to_regions(
+                        unmapped, memory_regions)
+                    if still_unmapped:
+                        logger.warning(
+                            "%d section(s) could not be mapped to any "
+                            "memory region: %s",
+                            len(still_unmapped),
+                            ', '.join(s.name for s in still_unmapped))
+
+            MemoryMapper.attribute_symbols_to_regions(
+                symbols, lma_offsets, memory_regions)
+
+            # Swap attribution limit_size for the real limit (from a
+            # separate limits linker script) before computing utilization.
+            # Attribution used the broader range to classify overflow
+            # sections; utilization math uses the real capacity.
+            for name, real_size in self.real_limits.items():
+                region = memory_regions.get(name)
+                if region is not None:
+                    region.limit_size = real_size
+
+            MemoryMapper.calculate_utilization(memory_regions)
+        return memory_regions
+
+    def _apply_section_skips(self, sections, symbols: SymbolTable):
         """Remove sections (and symbols inside them) whose names appear in
         ``self.skip_sections``. Names are matched exactly.
 
@@ -245,7 +285,7 @@ class ReportGenerator:  # pylint: disable=too-few-public-methods
                 ", ".join(sorted(missing)))
 
         kept_sections = [s for s in sections if s.name not in skip]
-        kept_symbols = [s for s in symbols if s.section not in skip]
+        kept_symbols = symbols.filter('section', skip, exclude=True)
         return kept_sections, kept_symbols
 
     def _convert_to_memory_regions(
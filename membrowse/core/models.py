@@ -24,6 +24,8 @@ class MemoryRegion:
     free_size: int = 0
     utilization_percent: float = 0.0
     sections: List[Dict[str, Any]] = None
+    # Bytes of the symbols located in this region (VMA and LMA copies)
+    symbol_used_size: int = 0
 
     def __post_init__(self):
         if self.sections is None:
@@ -41,7 +43,8 @@ class MemoryRegion:
             'used_size': self.used_size,
             'free_size': self.free_size,
             'utilization_percent': self.utilization_percent,
-            'sections': self.sections
+            'sections': self.sections,
+            'symbol_used_size': self.symbol_used_size,
         }
 
 
@@ -159,6 +162,7 @@ class MemoryRegionDict(TypedDict):
     free_size: int
     utilization_percent: float
     sections: List[Dict[str, Any]]
+    symbol_used_size: int
 
 
 class MemoryReport(TypedDict):
@@ -0,0 +1,143 @@
+#!/usr/bin/env python3
+"""
+Cache of parsed memory regions keyed by the content of the linker scripts.
+
+Linker scripts rarely change between commits, but every report re-parses
+them (and the ``--limits`` script). The parse result only depends on the
+text of the scripts and the files they include, the ``--def`` variables
+and the parsing strategy selected for the ELF architecture, so those are
+hashed into a key. Results are kept in memory for the life of the process
+(an onboard run or a server) and, when a cache directory is configured,
+on disk under ``<cache_dir>/regions``.
+"""
+
+import copy
+import json
+import logging
+import os
+import threading
+from collections import OrderedDict
+from typing import Any, Dict, List, Optional
+
+from ..linker.elf_info import (
+    ELFContext, ELFParser, get_architecture_info, get_linker_parsing_strategy)
+from ..linker.parser import ScriptSources
+from ..utils.cache import ContentCache
+from .report_cache import _package_version
+
+logger = logging.getLogger(__name__)
+
+# Bump when the parsed region structure changes without a package version bump
+REGION_CACHE_VERSION = b'membrowse-regions-1'
+
+# Distinct script sets kept in memory; onboard runs typically need one or two
+_MEMORY_ENTRIES = 32
+
+
+def _scripts_digest(scripts: List[str], sources: ScriptSources) -> bytes:
+    """Contents of each script and everything it includes, in order.
+
+    Included files are identified relative to their root script, so the
+    same tree checked out elsewhere (e.g. an onboard worktree) shares keys.
+    """
+    parts = []
+    for script in scripts:
+        base_dir = os.path.dirname(os.path.abspath(script))
+        for path in sources.dependencies(script):
+            parts.append(os.path.relpath(path, base_dir).encode())
+            parts.append(sources.read(path).encode('utf-8', 'surrogateescape'))
+    return ContentCache.make_key(*parts).encode()
+
+
+def parsing_strategy(elf_path: Optional[str],
+                     elf_context: Optional[ELFContext] = None) -> Dict[str, Any]:
+    """The architecture-specific strategy the linker parser will apply."""
+    if not elf_path:
+        return {}
+    if elf_context is not None:
+        elf_info = ELFParser.parse_elffile(elf_context, elf_path)
+    else:
+        elf_info = get_architecture_info(elf_path)
+    return get_linker_parsing_strategy(elf_info) if elf_info else {}
+
+
+class RegionCache:
+    """Parsed memory regions and ``--limits`` sizes keyed by script content."""
+
+    _memory: 'OrderedDict[str, Dict[str, Any]]' = OrderedDict()
+    _lock = threading.Lock()
+
+    def __init__(self, cache_dir: Optional[str] = None):
+        """
+        Args:
+            cache_dir: Optional cache root for entries shared across runs
+        """
+        self._disk = ContentCache(cache_dir, 'regions') if cache_dir else None
+
+    @staticmethod
+    def make_key(  # pylint: disable=too-many-arguments,too-many-positional-arguments
+            ld_scripts: List[str],
+            limits_ld: Optional[str],
+            linker_variables: Optional[Dict[str, Any]],
+            strategy: Dict[str, Any],
+            sources: ScriptSources) -> Optional[str]:
+        """Cache key for parsing ``ld_scripts`` (and ``limits_ld``).
+
+        Args:
+            ld_scripts: Primary linker script paths
+            limits_ld: Optional ``--limits`` script path
+            linker_variables: ``--def`` variables
+            strategy: Result of :func:`parsing_strategy`
+            sources: Script cache of the run, which the parse then reuses
+
+        Returns:
+            Cache key, or None if a script cannot be read
+        """
+        try:
+            return ContentCache.make_key(
+                REGION_CACHE_VERSION,
+                _package_version(),
+                _scripts_digest(ld_scripts, sources),
+                _scripts_digest([limits_ld] if limits_ld else [], sources),
+                json.dumps(linker_variables or {}, sort_keys=True, default=str).encode(),
+                json.dumps(strategy, sort_keys=True, default=str).encode(),
+            )
+        except (OSError, TypeError, ValueError) as e:
+            logger.debug("Memory regions not cacheable: %s", e)
+            return None
+
+    def get(self, key: str) -> Optional[Dict[str, Any]]:
+        """Return a copy of the entry for ``key``, or None on a miss.
+
+        Entries hold ``memory_regions`` and ``real_limits``.
+        """
+        with self._lock:
+            entry = self._memory.get(key)
+            if entry is not None:
+                self._memory.move_to_end(key)
+        if entry is None and self._disk is not None:
+            entry = self._disk.get(key)
+            if not isinstance(entry, dict):
+                return None
+            self._remember(key, entry)
+        return copy.deepcopy(entry) if entry is not None else None
+
+    def put(self, key: str, entry: Dict[str, Any]) -> None:
+        """Store ``entry`` under ``key`` in memory and on disk."""
+        entry = copy.deepcopy(entry)
+        self._remember(key, entry)
+        if self._disk is not None:
+            self._disk.put(key, entry)
+
+    def _remember(self, key: str, entry: Dict[str, Any]) -> None:
+        with self._lock:
+            self._memory[key] = entry
+            self._memory.move_to_end(key)
+            while len(self._memory) > _MEMORY_ENTRIES:
+                self._memory.popitem(last=False)
+
+    @classmethod
+    def clear_memory(cls) -> None:
+        """Drop the in-memory entries shared by all instances."""
+        with cls._lock:
+            cls._memory.clear()
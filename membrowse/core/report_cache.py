@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+"""
+Whole-report cache keyed by a content fingerprint of the ELF.
+
+Hashing the bytes a report is derived from is far cheaper than DWARF,
+symbol and region analysis, so byte-identical binaries (docs-only commits,
+CI retries, reproducible builds) reuse the previous report verbatim. The
+key also covers every option and input beyond the ELF that changes the
+report, so a cached report is always identical to a freshly generated one.
+"""
+
+import hashlib
+import json
+import logging
+from importlib.metadata import version, PackageNotFoundError
+from typing import Any, Dict, Optional
+
+from ..utils.cache import ContentCache
+
+logger = logging.getLogger(__name__)
+
+# Bump when the report structure changes without a package version bump
+REPORT_CACHE_VERSION = b'membrowse-report-1'
+
+_SHF_ALLOC = 0x2
+_SYMBOL_TABLE_TYPES = ('SHT_SYMTAB', 'SHT_DYNSYM')
+# Non-ALLOC sections the report reads: toolchain detection and DWARF source
+# attribution (debug-only edits such as moved lines change symbol sources)
+_METADATA_SECTIONS = ('.comment', '.shstrtab')
+
+
+def _package_version() -> bytes:
+    try:
+        return version('membrowse').encode()
+    except PackageNotFoundError:
+        return b'0.0.0'
+
+
+def _is_fingerprinted(section) -> bool:
+    """Whether a section's contents feed into the report."""
+    if section['sh_type'] == 'SHT_NOBITS':
+        return False
+    return bool(section['sh_flags'] & _SHF_ALLOC
+                or section['sh_type'] in _SYMBOL_TABLE_TYPES
+                or section.name in _METADATA_SECTIONS
+                or section.name.startswith('.debug_'))
+
+
+def elf_fingerprint(elf) -> bytes:
+    """SHA-256 over the parts of an ELF that a report is derived from.
+
+    Covers the ELF, section and program headers, the contents of ALLOC
+    sections, symbol tables and their string tables, ``.comment`` and the
+    DWARF sections.
+
+    Args:
+        elf: :class:`~membrowse.linker.elf_info.ELFContext` or ELFFile
+
+    Returns:
+        Raw SHA-256 digest
+    """
+    header = elf.header
+    stream = elf.elffile.stream if hasattr(elf, 'elffile') else elf.stream
+    digest = hashlib.sha256()
+
+    def add_range(offset, size):
+        stream.seek(offset)
+        data = stream.read(size)
+        digest.update(len(data).to_bytes(8, 'little'))
+        digest.update(data)
+
+    add_range(0, header['e_ehsize'])
+    add_range(header['e_shoff'], header['e_shentsize'] * header['e_shnum'])
+    add_range(header['e_phoff'], header['e_phentsize'] * header['e_phnum'])
+
+    sections = list(elf.iter_sections())
+    string_tables = {section['sh_link'] for section in sections
+                     if section['sh_type'] in _SYMBOL_TABLE_TYPES}
+    for index, section in enumerate(sections):
+        if _is_fingerprinted(section) or index in string_tables:
+            add_range(section['sh_offset'], section['sh_size'])
+    return digest.digest()
+
+
+def _file_digest(path: Optional[str]) -> bytes:
+    """SHA-256 of a file's contents, or empty bytes when there is no file."""
+    if not path:
+        return b''
+    digest = hashlib.sha256()
+    with open(path, 'rb') as f:
+        for chunk in iter(lambda: f.read(1 << 20), b''):
+            digest.update(chunk)
+    return digest.digest()
+
+
+class ReportCache:
+    """Stores complete reports under ``<cache_dir>/report`` (or only in memory)."""
+
+    def __init__(self, cache_dir: Optional[str]):
+        self._cache = ContentCache(cache_dir, 'report')
+
+    @staticmethod
+    def make_key(elf, options: Dict[str, Any],
+                 map_file: Optional[str] = None) -> Optional[str]:
+        """Cache key for a report of ``elf`` generated with ``options``.
+
+        Args:
+            elf: Opened ELF (see :func:`elf_fingerprint`)
+            options: JSON-serializable report inputs other than the ELF
+                (parsed memory regions, limits, flags)
+            map_file: Optional linker map file whose contents are included
+
+        Returns:
+            Cache key, or None if the inputs cannot be read
+        """
+        try:
+            return ContentCache.make_key(
+                REPORT_CACHE_VERSION,
+                _package_version(),
+                elf_fingerprint(elf),
+                json.dumps(options, sort_keys=True, default=str).encode(),
+                _file_digest(map_file),
+            )
+        except (OSError, TypeError, ValueError, KeyError) as e:
+            logger.debug("Report not cacheable: %s", e)
+            return None
+
+    def get(self, key: str) -> Optional[Dict[str, Any]]:
+        """Return the cached report for ``key``, or None on a miss."""
+        report = self._cache.get(key)
+        return report if isinstance(report, dict) else None
+
+    def put(self, key: str, report: Dict[str, Any]) -> None:
+        """Store ``report`` under ``key``."""
+        self._cache.put(key, report)
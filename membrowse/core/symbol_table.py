@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+"""
+Columnar storage for the symbols of one report.
+
+A firmware image has tens of thousands of symbols and every consumer
+(section skips, region attribution, source mapping statistics, the top-N
+table of the formatter) visits all of them. :class:`SymbolTable` keeps
+them as parallel arrays with every string stored once, so those passes
+run over compact columns, and only :meth:`SymbolTable.to_dicts` builds the
+``symbols`` list of the report.
+"""
+
+import heapq
+from array import array
+from typing import Any, Callable, Dict, Iterable, List, Optional, Sequence, Set, Tuple
+
+from .models import Symbol
+
+# Report field order (that of :class:`Symbol`)
+SYMBOL_FIELDS = ('name', 'address', 'size', 'type', 'binding', 'section',
+                 'source_file', 'source_line', 'visibility', 'archive', 'object_file')
+
+# Fields stored as indices into the shared string pool
+STRING_FIELDS = ('name', 'type', 'binding', 'section', 'source_file',
+                 'visibility', 'archive', 'object_file')
+
+# Fields stored as unsigned integers
+NUMERIC_FIELDS = {'address': 'Q', 'size': 'Q', 'source_line': 'I'}
+
+
+class SymbolTable:
+    """Symbols stored as parallel arrays.
+
+    Numeric fields are arrays of their own; string fields are arrays of
+    indices into ``strings``, which holds each distinct value once (the
+    empty string is always index 0). Filters and top-k selections return
+    row indices or new tables and never touch the strings themselves.
+    """
+
+    __slots__ = ('columns', 'strings', '_ids')
+
+    def __init__(self, strings: Optional[List[Any]] = None):
+        self.columns: Dict[str, array] = {
+            field: array(NUMERIC_FIELDS.get(field, 'I')) for field in SYMBOL_FIELDS}
+        self.strings: List[Any] = [''] if strings is None else strings
+        self._ids: Dict[Any, int] = {value: i for i, value in enumerate(self.strings)}
+
+    @classmethod
+    def from_symbols(cls, symbols: Iterable[Symbol]) -> 'SymbolTable':
+        """Build a table from :class:`Symbol` objects."""
+        table = cls()
+        for symbol in symbols:
+            table.append(symbol.__dict__)
+        return table
+
+    @classmethod
+    def from_dicts(cls, symbols: Iterable[Dict[str, Any]]) -> 'SymbolTable':
+        """Build a table from report symbol dicts (missing fields are empty)."""
+        table = cls()
+        for symbol in symbols:
+            table.append(symbol)
+        return table
+
+    def append(self, symbol: Dict[str, Any]) -> None:
+        """Add one row from a mapping of symbol fields."""
+        ids = self._ids
+        for field, column in self.columns.items():
+            if field in NUMERIC_FIELDS:
+                column.append(symbol.get(field) or 0)
+                continue
+            value = symbol.get(field, '')
+            index = ids.get(value)
+            if index is None:
+                index = ids[value] = len(self.strings)
+                self.strings.append(value)
+            column.append(index)
+
+    def __len__(self) -> int:
+        return len(self.columns['address'])
+
+    @property
+    def addresses(self) -> array:
+        """Address column."""
+        return self.columns['address']
+
+    @property
+    def sizes(self) -> array:
+        """Size column."""
+        return self.columns['size']
+
+    def values(self, field: str) -> List[Any]:
+        """The values of one field, row by row."""
+        column = self.columns[field]
+        if field in NUMERIC_FIELDS:
+            return list(column)
+        strings = self.strings
+        return [strings[index] for index in column]
+
+    def _string_ids(self, values: Iterable[Any]) -> set:
+        """Pool indices of those ``values`` that occur in the table."""
+        ids = self._ids
+        return {ids[value] for value in values if value in ids}
+
+    def rows_where(self, field: str, values: Iterable[Any],
+                   exclude: bool = False) -> List[int]:
+        """Rows whose string ``field`` is one of ``values`` (or none of them)."""
+        wanted = self._string_ids(values)
+        return [row for row, index in enumerate(self.columns[field])
+                if (index in wanted) != exclude]
+
+    def select(self, rows: Sequence[int]) -> 'SymbolTable':
+        """New table with the given rows, sharing this table's string pool."""
+        table = SymbolTable.__new__(SymbolTable)
+        table.strings = self.strings
+        table._ids = self._ids  # pylint: disable=protected-access
+        table.columns = {field: array(column.typecode, (column[row] for row in rows))
+                         for field, column in self.columns.items()}
+        return table
+
+    def filter(self, field: str, values: Iterable[Any], exclude: bool = False) -> 'SymbolTable':
+        """:meth:`select` the :meth:`rows_where` ``field`` is in ``values``."""
+        values = list(values)
+        if exclude and not self._string_ids(values):
+            return self
+        return self.select(self.rows_where(field, values, exclude))
+
+    def count_nonempty(self, field: str) -> int:
+        """Number of rows whose string ``field`` is not empty."""
+        return len(self.columns[field]) - self.columns[field].count(0)
+
+    def group_sizes(self, field: str) -> Dict[Any, int]:
+        """Total symbol size per value of a string field (e.g. section, archive)."""
+        totals: Dict[int, int] = {}
+        for index, size in zip(self.columns[field], self.sizes):
+            totals[index] = totals.get(index, 0) + size
+        strings = self.strings
+        return {strings[index]: total for index, total in totals.items()}
+
+    def group_sizes_by_address(self, lookup: Callable[[int], Optional[str]],
+                               section_offsets: Optional[Dict[str, int]] = None
+                               ) -> Dict[str, int]:
+        """Total symbol size per ``lookup(address)`` key (e.g. region name).
+
+        Zero-size symbols and rows for which ``lookup`` returns None are
+        skipped. Aliases (several names for one address and size, such as
+        ``memcpy`` and ``__aeabi_memcpy``) occupy memory once and are
+        counted once. Symbols in a section listed in ``section_offsets`` are
+        also counted at their address plus that offset (the load image of
+        an LMA-placed section).
+
+        Args:
+            lookup: Maps an address to its group, or None
+            section_offsets: Extra address offset per section name
+        """
+        offsets = {self._ids[name]: offset
+                   for name, offset in (section_offsets or {}).items() if name in self._ids}
+        totals: Dict[str, int] = {}
+        counted: Set[Tuple[int, int]] = set()
+        for address, size, section in zip(self.addresses, self.sizes,
+                                          self.columns['section']):
+            if size == 0 or (address, size) in counted:
+                continue
+            counted.add((address, size))
+            key = lookup(address)
+            if key is not None:
+                totals[key] = totals.get(key, 0) + size
+            offset = offsets.get(section)
+            if offset is not None:
+                key = lookup(address + offset)
+                if key is not None:
+                    totals[key] = totals.get(key, 0) + size
+        return totals
+
+    def top_k(self, k: Optional[int] = None, field: str = 'size') -> List[int]:
+        """Rows with the ``k`` largest values of a numeric field, largest first.
+
+        Ties keep table order, as a stable descending sort would. ``None``
+        orders every row.
+        """
+        column = self.columns[field]
+        if k is None or k >= len(column):
+            return sorted(range(len(column)), key=column.__getitem__, reverse=True)
+        return heapq.nlargest(k, range(len(column)), key=column.__getitem__)
+
+    def to_dicts(self, rows: Optional[Iterable[int]] = None) -> List[Dict[str, Any]]:
+        """Report symbol dicts (the shape of ``Symbol.__dict__``) for ``rows``,
+        or every row."""
+        strings = self.strings
+        columns = [(field, self.columns[field], field not in NUMERIC_FIELDS)
+                   for field in SYMBOL_FIELDS]
+        if rows is None:
+            rows = range(len(self))
+        return [{field: strings[column[row]] if interned else column[row]
+                 for field, column, interned in columns}
+                for row in rows]
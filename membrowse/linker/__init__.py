@@ -6,10 +6,16 @@ This package provides tools for parsing GNU LD and IAR EWARM (.icf)
 linker scripts and extracting memory region definitions.
 """
 
-from .parser import parse_linker_scripts, LinkerScriptParser
-from .elf_info import get_architecture_info, get_linker_parsing_strategy
-from .icf_parser import IARLinkerScriptParser
-from .base import LinkerFormatDetector
+from ..utils.lazy import lazy_exports
+
+__getattr__, __dir__ = lazy_exports(__name__, {
+    'parse_linker_scripts': '.parser',
+    'LinkerScriptParser': '.parser',
+    'get_architecture_info': '.elf_info',
+    'get_linker_parsing_strategy': '.elf_info',
+    'IARLinkerScriptParser': '.icf_parser',
+    'LinkerFormatDetector': '.base',
+})
 
 __all__ = [
     'parse_linker_scripts',
@@ -8,9 +8,10 @@ to intelligently handle different linker script syntaxes and parsing strategies.
 """
 
 import logging
+import mmap
 from enum import Enum
 from dataclasses import dataclass
-from typing import Optional, Dict, Any
+from typing import Optional, Dict, Any, List
 
 from elftools.elf.elffile import ELFFile
 from elftools.common.exceptions import ELFError
@@ -142,28 +143,7 @@ class ELFParser:  # pylint: disable=too-few-public-methods
         """
         try:
             with open(elf_path, 'rb') as f:
-                elffile = ELFFile(f)
-
-                # Get machine type using pyelftools
-                e_machine = elffile.header['e_machine']
-                architecture = cls.MACHINE_TYPES.get(
-                    e_machine, Architecture.UNKNOWN)
-
-                # Get bit width and endianness
-                bit_width = elffile.elfclass
-                endianness = elffile.little_endian
-
-                # Determine platform based on architecture and path hints
-                platform = cls._detect_platform(architecture, elf_path)
-
-                return ELFInfo(
-                    architecture=architecture,
-                    platform=platform,
-                    bit_width=bit_width,
-                    endianness="little" if endianness else "big",
-                    machine_type=elffile.header['e_machine'],
-                    is_embedded=cls._is_embedded_platform(platform)
-                )
+                return cls.parse_elffile(ELFFile(f), elf_path)
         except (IOError, OSError) as e:
             logger.error("Could not read ELF file %s: %s", elf_path, e)
             return None
@@ -171,6 +151,38 @@ class ELFParser:  # pylint: disable=too-few-public-methods
             logger.error("Error parsing ELF file %s: %s", elf_path, e)
             return None
 
+    @classmethod
+    def parse_elffile(cls, elffile, elf_path: str) -> ELFInfo:
+        """Extract architecture information from an already opened ELF
+
+        Args:
+            elffile: pyelftools ELFFile (or :class:`ELFContext`)
+            elf_path: Path of the ELF, used for platform hints
+
+        Returns:
+            ELFInfo object with architecture details
+        """
+        # Get machine type using pyelftools
+        e_machine = elffile.header['e_machine']
+        architecture = cls.MACHINE_TYPES.get(
+            e_machine, Architecture.UNKNOWN)
+
+        # Get bit width and endianness
+        bit_width = elffile.elfclass
+        endianness = elffile.little_endian
+
+        # Determine platform based on architecture and path hints
+        platform = cls._detect_platform(architecture, elf_path)
+
+        return ELFInfo(
+            architecture=architecture,
+            platform=platform,
+            bit_width=bit_width,
+            endianness="little" if endianness else "big",
+            machine_type=e_machine,
+            is_embedded=cls._is_embedded_platform(platform)
+        )
+
     @classmethod
     def _detect_platform(
             cls,
@@ -252,6 +264,170 @@ class ELFParser:  # pylint: disable=too-few-public-methods
         return platform in embedded_platforms
 
 
+class _CachedSymbolTable:
+    """Symbol table section proxy that decodes its symbols only once."""
+
+    def __init__(self, section):
+        self._section = section
+        self._symbols = None
+
+    def iter_symbols(self):
+        """Iterate the (cached) symbols of the wrapped section."""
+        if self._symbols is None:
+            self._symbols = list(self._section.iter_symbols())
+        return iter(self._symbols)
+
+    def num_symbols(self) -> int:
+        """Number of symbols in the wrapped section."""
+        return self._section.num_symbols()
+
+    def __getitem__(self, name):
+        return self._section[name]
+
+    def __getattr__(self, name):
+        return getattr(self._section, name)
+
+
+class ELFContext:
+    """One parsed ELF shared by every component of an analysis run.
+
+    pyelftools re-reads and re-decodes section headers, symbols and program
+    headers on every ``iter_sections()``/``iter_symbols()``/
+    ``iter_segments()`` call, and each component used to open the ELF on
+    its own. An ``ELFContext`` memory-maps the file once (see :meth:`open`)
+    and caches those tables. It implements the subset of the ``ELFFile``
+    interface membrowse uses, so it can be passed to the analysis components
+    in place of an ``ELFFile``; the wrapped file is :attr:`elffile`.
+
+    Example::
+
+        with ELFContext.open("firmware.elf") as elf:
+            parser = LinkerScriptParser(["linker.ld"], elf_file="firmware.elf",
+                                        elf_context=elf)
+            analyzer = ELFAnalyzer("firmware.elf", elf_context=elf)
+    """
+
+    def __init__(self, elffile, elf_path: Optional[str] = None, resources=()):
+        """Wrap an already opened ELF.
+
+        Args:
+            elffile: pyelftools ELFFile
+            elf_path: Path of the ELF file, if known
+            resources: Objects to close together with this context
+        """
+        self.elffile = elffile
+        self.elf_path = elf_path
+        self._resources = list(resources)
+        self._sections: Optional[List[Any]] = None
+        self._sections_by_name: Optional[Dict[str, Any]] = None
+        self._segments: Optional[List[Any]] = None
+        self._dwarf_info = None
+
+    @classmethod
+    def open(cls, elf_path: str) -> 'ELFContext':
+        """Open and memory-map ``elf_path``.
+
+        Falls back to regular file reads where the file cannot be mapped
+        (e.g. an empty file).
+
+        Raises:
+            OSError: If the file cannot be read
+            ELFError: If the file is not a valid ELF
+        """
+        f = open(elf_path, 'rb')  # pylint: disable=consider-using-with
+        resources = [f]
+        try:
+            try:
+                stream = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+                resources.insert(0, stream)
+            except (ValueError, OSError) as e:
+                logger.debug("Cannot mmap %s (%s), using file reads", elf_path, e)
+                stream = f
+            return cls(ELFFile(stream), str(elf_path), resources)
+        except Exception:
+            for resource in resources:
+                resource.close()
+            raise
+
+    def close(self) -> None:
+        """Release the mapping and file handle (for contexts from :meth:`open`)."""
+        for resource in self._resources:
+            # Section data handed out by pyelftools is copied, so once the
+            # tables are cached nothing references the mapping itself
+            try:
+                resource.close()
+            except BufferError:
+                logger.debug("ELF mapping still exported, leaving it open")
+        self._resources = []
+
+    def __enter__(self) -> 'ELFContext':
+        return self
+
+    def __exit__(self, *exc_info) -> None:
+        self.close()
+
+    @property
+    def header(self):
+        """ELF file header."""
+        return self.elffile.header
+
+    @property
+    def elfclass(self) -> int:
+        """32 or 64."""
+        return self.elffile.elfclass
+
+    @property
+    def little_endian(self) -> bool:
+        """True for little-endian ELFs."""
+        return self.elffile.little_endian
+
+    @property
+    def sections(self) -> List[Any]:
+        """All sections in header order (symbol tables decode symbols once)."""
+        if self._sections is None:
+            self._sections = [
+                _CachedSymbolTable(section) if hasattr(section, 'iter_symbols')
+                else section
+                for section in self.elffile.iter_sections()]
+        return self._sections
+
+    def iter_sections(self):
+        """Iterate the cached sections."""
+        return iter(self.sections)
+
+    def num_sections(self) -> int:
+        """Number of sections."""
+        return len(self.sections)
+
+    def get_section(self, index: int):
+        """Return the cached section at ``index``."""
+        return self.sections[index]
+
+    def get_section_by_name(self, name: str):
+        """Return the section called ``name``, or None."""
+        if self._sections_by_name is None:
+            # Later duplicates win, as in ELFFile.get_section_by_name
+            self._sections_by_name = {
+                section.name: section for section in self.sections}
+        return self._sections_by_name.get(name)
+
+    def iter_segments(self):
+        """Iterate the cached program headers."""
+        if self._segments is None:
+            self._segments = list(self.elffile.iter_segments())
+        return iter(self._segments)
+
+    def has_dwarf_info(self) -> bool:
+        """True if the ELF carries DWARF debug information."""
+        return self.elffile.has_dwarf_info()
+
+    def get_dwarf_info(self):
+        """Return the (cached) DWARFInfo of the ELF."""
+        if self._dwarf_info is None:
+            self._dwarf_info = self.elffile.get_dwarf_info()
+        return self._dwarf_info
+
+
 def get_architecture_info(elf_path: str) -> Optional[ELFInfo]:
     """Convenience function to get architecture info from ELF file
 
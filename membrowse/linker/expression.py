@@ -0,0 +1,440 @@
+#!/usr/bin/env python3
+"""
+Compiled linker script expressions.
+
+GNU LD scripts and IAR ICF files share C-like integer expressions: hex,
+octal and decimal literals with K/M/G size suffixes, arithmetic, bitwise,
+comparison and logical operators, ``?:`` and calls such as
+``ORIGIN(FLASH)`` or ``isdefinedsymbol(X)``. An expression is tokenized
+and parsed once into a tree of closures (cached per dialect) and then
+evaluated against an :class:`EvaluationContext`, which supplies symbol
+values and functions. Compiled expressions list the symbols they read, so
+a set of definitions can be resolved in dependency order with
+:func:`dependency_order`.
+"""
+
+import operator
+import re
+from functools import lru_cache
+from typing import (Callable, Dict, FrozenSet, Iterable, List, Mapping,
+                    NamedTuple, Optional, Set, Tuple)
+
+# Maximum nesting depth for ternary expressions (security limit)
+MAX_TERNARY_DEPTH = 50
+
+# Maximum parenthesis/unary nesting; each level costs the parser a dozen
+# stack frames
+MAX_NESTING_DEPTH = 32
+
+# Largest shift count; addresses are at most 64 bits wide
+MAX_SHIFT = 64
+
+SIZE_MULTIPLIERS = {
+    "K": 1 << 10, "KB": 1 << 10,
+    "M": 1 << 20, "MB": 1 << 20,
+    "G": 1 << 30, "GB": 1 << 30,
+}
+
+# Binary operator binding strength as in C (higher binds tighter)
+C_PRECEDENCE = {
+    '||': 1, '&&': 2, '|': 3, '^': 4, '&': 5,
+    '==': 6, '!=': 6, '<': 7, '<=': 7, '>': 7, '>=': 7,
+    '<<': 8, '>>': 8, '+': 9, '-': 9, '*': 10, '/': 10, '%': 10,
+}
+
+
+class ExpressionError(ValueError):
+    """Raised when an expression is malformed or cannot be computed."""
+
+
+class Dialect(NamedTuple):
+    """Syntax differences between linker script languages.
+
+    Attributes:
+        name_functions: Functions taking a bare name (region, section or
+            symbol) rather than a value, e.g. ``ORIGIN`` or ``isempty``
+        precedence: Binary operator binding strengths
+        octal: Whether a leading ``0`` marks an octal literal
+    """
+    name_functions: FrozenSet[str]
+    precedence: Tuple[Tuple[str, int], ...]
+    octal: bool
+
+
+Evaluate = Callable[['EvaluationContext'], int]
+
+
+class EvaluationContext:
+    """Supplies symbols and functions to compiled expressions.
+
+    The defaults know no symbols or functions; subclasses override the
+    hooks they support.
+    """
+
+    def lookup_symbol(self, name: str) -> int:
+        """Value of the symbol ``name``."""
+        raise ExpressionError(f"Undefined symbol '{name}'")
+
+    # pylint: disable-next=unused-argument
+    def call_function(self, name: str, args: Tuple[int, ...]) -> int:
+        """Value of ``name(args...)`` for functions taking values."""
+        raise ExpressionError(f"Unsupported function '{name}'")
+
+    def call_name_function(self, name: str, arg: str) -> int:  # pylint: disable=unused-argument
+        """Value of ``name(arg)`` for the dialect's name functions."""
+        raise ExpressionError(f"Unsupported function '{name}'")
+
+    def test_condition(self, condition: Evaluate) -> bool:
+        """Truth value of a ``?:`` condition."""
+        return bool(condition(self))
+
+
+class CompiledExpression:  # pylint: disable=too-few-public-methods
+    """A parsed expression, ready to evaluate against any context."""
+
+    __slots__ = ('text', 'symbols', '_evaluate')
+
+    def __init__(self, text: str, symbols: FrozenSet[str], evaluate: Evaluate):
+        self.text = text
+        self.symbols = symbols
+        self._evaluate = evaluate
+
+    def evaluate(self, context: EvaluationContext) -> int:
+        """Compute the expression's value in ``context``."""
+        return self._evaluate(context)
+
+
+def _divide(left: int, right: int) -> int:
+    if right == 0:
+        raise ExpressionError("Division by zero")
+    return left // right
+
+
+def _modulo(left: int, right: int) -> int:
+    if right == 0:
+        raise ExpressionError("Division by zero")
+    return left % right
+
+
+def _shift_count(count: int) -> int:
+    if not 0 <= count <= MAX_SHIFT:
+        raise ExpressionError(f"Shift count {count} out of range")
+    return count
+
+
+def _shift_left(left: int, right: int) -> int:
+    return left << _shift_count(right)
+
+
+def _shift_right(left: int, right: int) -> int:
+    return left >> _shift_count(right)
+
+
+def _compare(predicate: Callable[[int, int], bool]) -> Callable[[int, int], int]:
+    return lambda left, right: 1 if predicate(left, right) else 0
+
+
+_BINARY_OPERATORS: Dict[str, Callable[[int, int], int]] = {
+    '|': operator.or_, '^': operator.xor, '&': operator.and_,
+    '==': _compare(operator.eq), '!=': _compare(operator.ne),
+    '<': _compare(operator.lt), '<=': _compare(operator.le),
+    '>': _compare(operator.gt), '>=': _compare(operator.ge),
+    '<<': _shift_left, '>>': _shift_right,
+    '+': operator.add, '-': operator.sub,
+    '*': operator.mul, '/': _divide, '%': _modulo,
+}
+
+_UNARY_OPERATORS: Dict[str, Callable[[int], int]] = {
+    '-': operator.neg, '+': operator.pos, '~': operator.invert,
+    '!': lambda value: 0 if value else 1,
+}
+
+
+_LOGICAL_LEVELS = (frozenset({'&&'}), frozenset({'||'}))
+
+
+@lru_cache(maxsize=None)
+def _token_pattern(name_functions: FrozenSet[str]) -> 're.Pattern[str]':
+    name_call = ''
+    if name_functions:
+        names = '|'.join(sorted(name_functions, key=len, reverse=True))
+        name_call = rf'|(?P<name_call>{names})\s*\(\s*(?P<arg>[^()]*?)\s*\)'
+    return re.compile(
+        r'\s*(?:'
+        r'(?P<number>0[xX][0-9a-fA-F]+|[0-9]+)(?:\s*(?P<suffix>(?i:[KMG]B?))\b)?'
+        + name_call +
+        r'|(?P<name>[A-Za-z_][A-Za-z0-9_]*)'
+        r'|(?P<op><<|>>|<=|>=|==|!=|&&|\|\||[-+*/%&|^~!<>?:(),])'
+        r')')
+
+
+class _Token(NamedTuple):
+    kind: str
+    value: object
+    position: int
+
+
+def _tokenize(text: str, dialect: Dialect) -> List[_Token]:
+    pattern = _token_pattern(dialect.name_functions)
+    tokens = []
+    pos = 0
+    end = len(text.rstrip())
+    while pos < end:
+        match = pattern.match(text, pos)
+        start = len(text) - len(text[pos:].lstrip())
+        if match is None or match.end() == pos:
+            raise ExpressionError(
+                f"Unexpected character '{text[start]}' at position {start} in '{text}'")
+        if match.group('number') is not None:
+            tokens.append(_Token('number', _literal(match, dialect), start))
+        elif match.lastgroup == 'name':
+            tokens.append(_Token('name', match.group('name'), start))
+        elif match.lastgroup == 'op':
+            tokens.append(_Token('op', match.group('op'), start))
+        else:
+            tokens.append(_Token('name_call',
+                                 (match.group('name_call'), match.group('arg')), start))
+        pos = match.end()
+    return tokens
+
+
+def _literal(match: 're.Match[str]', dialect: Dialect) -> int:
+    digits = match.group('number')
+    if digits[:2] in ('0x', '0X'):
+        value = int(digits, 16)
+    elif dialect.octal and len(digits) > 1 and digits[0] == '0' and \
+            all(d in '01234567' for d in digits):
+        value = int(digits, 8)
+    else:
+        value = int(digits, 10)
+    suffix = match.group('suffix')
+    if suffix:
+        value *= SIZE_MULTIPLIERS[suffix.upper()]
+    return value
+
+
+class _Node(NamedTuple):
+    """A compiled subexpression; ``constant`` is set when it is literal."""
+    evaluate: Evaluate
+    constant: Optional[int] = None
+
+
+def _constant(value: int) -> _Node:
+    return _Node(lambda _context: value, value)
+
+
+class _Parser:
+    """Precedence-climbing parser turning tokens into closures."""
+
+    def __init__(self, text: str, dialect: Dialect):
+        self._text = text
+        self._tokens = _tokenize(text, dialect)
+        self._pos = 0
+        self._depth = 0
+        self._ternary_depth = 0
+        self.symbols: Set[str] = set()
+        precedence = dict(dialect.precedence)
+        self._levels = [
+            frozenset(op for op, level in precedence.items() if level == strength)
+            for strength in sorted(set(precedence.values()))]
+
+    def parse(self) -> _Node:
+        """Parse the whole token list."""
+        if not self._tokens:
+            raise ExpressionError("Empty expression")
+        node = self._ternary()
+        if self._pos < len(self._tokens):
+            token = self._tokens[self._pos]
+            raise ExpressionError(
+                f"Unexpected '{token.value}' at position {token.position} "
+                f"in '{self._text}'")
+        return node
+
+    def _peek_op(self) -> Optional[str]:
+        if self._pos < len(self._tokens) and self._tokens[self._pos].kind == 'op':
+            return self._tokens[self._pos].value
+        return None
+
+    def _expect(self, op: str) -> None:
+        if self._peek_op() != op:
+            raise ExpressionError(f"Expected '{op}' in '{self._text}'")
+        self._pos += 1
+
+    def _ternary(self) -> _Node:
+        condition = self._binary(0)
+        if self._peek_op() != '?':
+            return condition
+        self._ternary_depth += 1
+        if self._ternary_depth > MAX_TERNARY_DEPTH:
+            raise ExpressionError(
+                f"Ternary nesting depth exceeds limit ({MAX_TERNARY_DEPTH})")
+        self._pos += 1
+        when_true = self._ternary()
+        self._expect(':')
+        when_false = self._ternary()
+        self._ternary_depth -= 1
+
+        test = condition.evaluate
+        true_branch, false_branch = when_true.evaluate, when_false.evaluate
+        return _Node(lambda context: true_branch(context)
+                     if context.test_condition(test) else false_branch(context))
+
+    def _binary(self, level: int) -> _Node:
+        if level == len(self._levels):
+            return self._unary()
+        operators = self._levels[level]
+        first = self._binary(level + 1)
+        rest: List[Tuple[str, _Node]] = []
+        while self._peek_op() in operators:
+            op = self._peek_op()
+            self._pos += 1
+            rest.append((op, self._binary(level + 1)))
+        if not rest:
+            return first
+        if operators in _LOGICAL_LEVELS:
+            return self._logical('&&' in operators, [first] + [n for _, n in rest])
+        return self._chain(first, rest)
+
+    @staticmethod
+    def _logical(conjunction: bool, operands: List[_Node]) -> _Node:
+        functions = tuple(node.evaluate for node in operands)
+        if conjunction:
+            return _Node(lambda context: 1 if all(f(context) for f in functions) else 0)
+        return _Node(lambda context: 1 if any(f(context) for f in functions) else 0)
+
+    @staticmethod
+    def _chain(first: _Node, rest: List[Tuple[str, _Node]]) -> _Node:
+        # Fold the literal prefix of a left-associative chain
+        while rest and first.constant is not None and rest[0][1].constant is not None:
+            op, node = rest[0]
+            try:
+                first = _constant(_BINARY_OPERATORS[op](first.constant, node.constant))
+            except ExpressionError:
+                break  # e.g. division by zero: fail only when evaluated
+            rest = rest[1:]
+        if not rest:
+            return first
+        head = first.evaluate
+        steps = tuple((_BINARY_OPERATORS[op], node.evaluate) for op, node in rest)
+
+        def evaluate(context: EvaluationContext) -> int:
+            value = head(context)
+            for apply, operand in steps:
+                value = apply(value, operand(context))
+            return value
+        return _Node(evaluate)
+
+    def _unary(self) -> _Node:
+        op = self._peek_op()
+        if op not in _UNARY_OPERATORS:
+            return self._primary()
+        self._pos += 1
+        self._enter()
+        operand = self._unary()
+        self._depth -= 1
+        apply = _UNARY_OPERATORS[op]
+        if operand.constant is not None:
+            return _constant(apply(operand.constant))
+        inner = operand.evaluate
+        return _Node(lambda context: apply(inner(context)))
+
+    def _enter(self) -> None:
+        self._depth += 1
+        if self._depth > MAX_NESTING_DEPTH:
+            raise ExpressionError(
+                f"Expression nesting depth exceeds limit ({MAX_NESTING_DEPTH})")
+
+    def _primary(self) -> _Node:
+        if self._pos >= len(self._tokens):
+            raise ExpressionError(f"Unexpected end of expression '{self._text}'")
+        token = self._tokens[self._pos]
+        self._pos += 1
+        if token.kind == 'number':
+            return _constant(token.value)
+        if token.kind == 'name_call':
+            function, arg = token.value
+            return _Node(lambda context: context.call_name_function(function, arg))
+        if token.kind == 'name':
+            if self._peek_op() == '(':
+                return self._call(token.value)
+            name = token.value
+            self.symbols.add(name)
+            return _Node(lambda context: context.lookup_symbol(name))
+        if token.value == '(':
+            self._enter()
+            node = self._ternary()
+            self._depth -= 1
+            self._expect(')')
+            return node
+        raise ExpressionError(
+            f"Unexpected '{token.value}' at position {token.position} in '{self._text}'")
+
+    def _call(self, function: str) -> _Node:
+        self._pos += 1  # '('
+        self._enter()
+        args: List[_Node] = []
+        if self._peek_op() != ')':
+            args.append(self._ternary())
+            while self._peek_op() == ',':
+                self._pos += 1
+                args.append(self._ternary())
+        self._depth -= 1
+        self._expect(')')
+        functions = tuple(node.evaluate for node in args)
+        return _Node(lambda context: context.call_function(
+            function, tuple(f(context) for f in functions)))
+
+
+@lru_cache(maxsize=4096)
+def compile_expression(text: str, dialect: Dialect) -> CompiledExpression:
+    """Parse ``text`` once into a reusable :class:`CompiledExpression`.
+
+    Raises:
+        ExpressionError: If the text is not a valid expression
+    """
+    parser = _Parser(text, dialect)
+    try:
+        node = parser.parse()
+    except RecursionError as exc:
+        raise ExpressionError(f"Expression too deeply nested: '{text}'") from exc
+    return CompiledExpression(text, frozenset(parser.symbols), node.evaluate)
+
+
+def dependency_order(
+        dependencies: Mapping[str, Iterable[str]]
+) -> Tuple[List[str], List[List[str]]]:
+    """Order definitions so that each comes after the ones it reads.
+
+    Args:
+        dependencies: Names mapped to the names they reference; references
+            to names that are not keys are ignored
+
+    Returns:
+        (order, cycles): every name, dependencies first, and each circular
+        chain found, as a path that starts and ends with the same name
+    """
+    order: List[str] = []
+    cycles: List[List[str]] = []
+    state: Dict[str, int] = {}  # 1: on the current path, 2: done
+    for root in dependencies:
+        if root in state:
+            continue
+        path = [root]
+        pending = [iter(sorted(set(dependencies[root])))]
+        state[root] = 1
+        while pending:
+            name = next(pending[-1], None)
+            if name is None:
+                pending.pop()
+                done = path.pop()
+                state[done] = 2
+                order.append(done)
+            elif name not in dependencies or state.get(name) == 2:
+                continue
+            elif state.get(name) == 1:
+                cycles.append(path[path.index(name):] + [name])
+            else:
+                state[name] = 1
+                path.append(name)
+                pending.append(iter(sorted(set(dependencies[name]))))
+    return order, cycles
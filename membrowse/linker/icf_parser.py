@@ -27,6 +27,10 @@ from pathlib import Path
 from typing import Any, Dict, List, Optional, Set, Tuple
 
 from .base import LinkerScriptFormatParser, LinkerFormatDetector
+from .expression import (
+    CompiledExpression, Dialect, EvaluationContext, ExpressionError,
+    compile_expression, dependency_order,
+)
 from .parser import MemoryRegion, LinkerScriptError
 
 logger = logging.getLogger(__name__)
@@ -40,6 +44,20 @@ class ICFEvaluationError(LinkerScriptError):
     """Raised when an ICF expression cannot be evaluated."""
 
 
+# ICF expressions are C-like, but comparisons bind looser than the bitwise
+# operators, and there are no octal literals
+ICF_DIALECT = Dialect(
+    name_functions=frozenset({'isdefinedsymbol', 'isempty', 'start', 'end', 'size'}),
+    precedence=(
+        ('||', 1), ('&&', 2),
+        ('==', 3), ('!=', 3), ('<', 3), ('<=', 3), ('>', 3), ('>=', 3),
+        ('|', 4), ('^', 5), ('&', 6), ('<<', 7), ('>>', 7),
+        ('+', 8), ('-', 8), ('*', 9), ('/', 9), ('%', 9),
+    ),
+    octal=False,
+)
+
+
 # ---------------------------------------------------------------------------
 # Internal data structures
 # ---------------------------------------------------------------------------
@@ -107,17 +125,17 @@ class ICFRegionSpec:
 # ICFSymbolTable
 # ---------------------------------------------------------------------------
 
-class ICFSymbolTable:
+class ICFSymbolTable(EvaluationContext):
     """Stores and resolves IAR ICF symbol definitions.
 
-    Handles ``define symbol NAME = VALUE;`` directives with multi-pass
-    iterative resolution for forward references.
+    Handles ``define symbol NAME = VALUE;`` directives. Definitions are
+    resolved in dependency order, so forward references need no extra
+    passes and circular definitions are reported by name.
     """
 
-    _SIZE_MULTIPLIERS = {
-        "G": 1 << 30, "GB": 1 << 30,
-        "M": 1 << 20, "MB": 1 << 20,
-        "K": 1 << 10, "KB": 1 << 10,
+    # Region built-ins and the ICFRegionSpec attribute each returns
+    _REGION_FUNCTIONS = {
+        'start': 'address', 'end': 'end_address', 'size': 'limit_size',
     }
 
     def __init__(self) -> None:
@@ -156,306 +174,83 @@ class ICFSymbolTable:
         """Make a region available for start()/end()/size() built-ins."""
         self._regions[spec.name] = spec
 
-    def resolve_all(self, max_passes: int = 15) -> None:
-        """Iteratively resolve all symbols until convergence or stall."""
-        for _ in range(max_passes):
-            if not self._unresolved:
-                break
-            resolved_this_pass: Dict[str, int] = {}
-            still_unresolved: Dict[str, str] = {}
+    def resolve_all(self) -> None:
+        """Resolve all symbols, each after the symbols it references."""
+        dependencies = {}
+        for name, raw in self._unresolved.items():
+            try:
+                dependencies[name] = self._compile(raw).symbols
+            except ICFEvaluationError:
+                dependencies[name] = frozenset()
+        order, cycles = dependency_order(dependencies)
+        for cycle in cycles:
+            logger.warning("ICF: circular symbol definition: %s",
+                           " -> ".join(cycle))
+
+        for name in order:
+            try:
+                value = self.evaluate(self._unresolved[name])
+            except (ValueError, ICFEvaluationError):
+                continue
+            self._resolved[name] = value
+            del self._unresolved[name]
 
-            for name, raw in self._unresolved.items():
-                try:
-                    value = self.evaluate(raw)
-                    resolved_this_pass[name] = value
-                except (ValueError, ICFEvaluationError):
-                    still_unresolved[name] = raw
-
-            self._resolved.update(resolved_this_pass)
-            if not resolved_this_pass:
-                unresolved_names = ', '.join(sorted(still_unresolved))
-                logger.warning(
-                    "ICF: %d symbol(s) could not be resolved: %s. "
-                    "Use --def NAME=VALUE to supply values "
-                    "(e.g. --def %s=0x0).",
-                    len(still_unresolved),
-                    unresolved_names,
-                    next(iter(sorted(still_unresolved)))
-                )
-                break
-            self._unresolved = still_unresolved
+        if self._unresolved:
+            unresolved_names = sorted(self._unresolved)
+            logger.warning(
+                "ICF: %d symbol(s) could not be resolved: %s. "
+                "Use --def NAME=VALUE to supply values "
+                "(e.g. --def %s=0x0).",
+                len(unresolved_names),
+                ', '.join(unresolved_names),
+                unresolved_names[0]
+            )
 
     def is_defined(self, name: str) -> bool:
         """Check if a symbol is defined (resolved or raw)."""
         return name in self._resolved or name in self._unresolved
 
     def evaluate(self, expr: str) -> int:
-        """Evaluate an ICF expression to an integer."""
-        expr = expr.strip()
-        expr = self._expand_builtins(expr)
-        expr = self._substitute_symbols(expr)
-        expr = self._expand_size_suffixes(expr)
-        return self._arithmetic_eval(expr)
-
-    # ---- Built-in function expansion ----
-
-    def _expand_builtins(self, expr: str) -> str:
-        """Replace ICF built-in function calls with numeric values."""
-        expr = re.sub(
-            r'\bisdefinedsymbol\s*\(\s*([^)]+)\s*\)',
-            lambda m: '1' if self.is_defined(m.group(1).strip()) else '0',
-            expr
-        )
+        """Evaluate an ICF expression to an integer.
 
-        def _isempty_replacer(m):
-            rname = m.group(1).strip()
-            if rname in self._regions:
-                return '0' if self._regions[rname].spans else '1'
-            # Unknown region is treated as empty
-            return '1'
-
-        expr = re.sub(r'\bisempty\s*\(\s*([^)]+)\s*\)',
-                       _isempty_replacer, expr)
-
-        def _replace_region_fn(fn_name, attr):
-            def replacer(m):
-                rname = m.group(1).strip()
-                if rname in self._regions and self._regions[rname].spans:
-                    return str(getattr(self._regions[rname], attr))
-                raise ICFEvaluationError(
-                    f"{fn_name}(): unknown region '{rname}'")
-            return replacer
-
-        expr = re.sub(r'\bstart\s*\(\s*([^)]+)\s*\)',
-                       _replace_region_fn('start', 'address'), expr)
-        expr = re.sub(r'\bend\s*\(\s*([^)]+)\s*\)',
-                       _replace_region_fn('end', 'end_address'), expr)
-        expr = re.sub(r'\bsize\s*\(\s*([^)]+)\s*\)',
-                       _replace_region_fn('size', 'limit_size'), expr)
-        return expr
-
-    # ---- Symbol substitution ----
-
-    def _substitute_symbols(self, expr: str) -> str:
-        """Replace known symbol names with their numeric values."""
-        for sym in sorted(self._resolved, key=len, reverse=True):
-            if sym in expr:
-                pat = r'\b' + re.escape(sym) + r'\b'
-                expr = re.sub(pat, str(self._resolved[sym]), expr)
-
-        for sym in sorted(self._unresolved, key=len, reverse=True):
-            if sym in expr:
-                pat = r'\b' + re.escape(sym) + r'\b'
-                if re.search(pat, expr):
-                    raise ValueError(
-                        f"Unresolved symbol '{sym}' in expression: {expr}")
-        return expr
-
-    # ---- Size suffix expansion ----
-
-    def _expand_size_suffixes(self, expr: str) -> str:
-        """Expand K/M/G/KB/MB/GB size suffixes to numeric values."""
-        def replace_suffix(m):
-            num = int(m.group(1))
-            suffix = m.group(2).upper()
-            return str(num * self._SIZE_MULTIPLIERS[suffix])
-
-        return re.sub(
-            r'(\d+)\s*(GB?|MB?|KB?)\b',
-            replace_suffix,
-            expr,
-            flags=re.IGNORECASE
-        )
-
-    # ---- Arithmetic evaluator ----
-
-    def _arithmetic_eval(self, expr: str) -> int:  # pylint: disable=too-many-locals,too-many-statements
-        """Safe recursive-descent arithmetic evaluator.
-
-        Operator precedence (lowest to highest):
-          ternary     ? :
-          logical OR  ||
-          logical AND &&
-          comparison  == != > >= < <=
-          bitwise OR  |
-          bitwise AND &
-          shift       << >>
-          add/sub     + -
-          mul/div     * /
-          unary       ~ - + !
-          atom        literal | (expr)
+        Raises:
+            ValueError: If the expression reads a symbol not yet resolved
+            ICFEvaluationError: If the expression is malformed or uses an
+                unknown symbol or region
         """
-        expr = expr.replace(" ", "").replace("\t", "")
-
-        # Expand hex literals to decimal
-        expr = re.sub(
-            r'0[xX]([0-9a-fA-F]+)',
-            lambda m: str(int(m.group(1), 16)),
-            expr
-        )
+        try:
+            return self._compile(expr).evaluate(self)
+        except ExpressionError as exc:
+            raise ICFEvaluationError(str(exc)) from exc
 
-        if not expr:
-            raise ICFEvaluationError("Empty expression")
-
-        # Allow only safe characters (includes ? and : for ternary)
-        if not re.match(r'^[0-9+\-*/&|~<>=!()?:]+$', expr):
-            raise ICFEvaluationError(f"Unsafe characters in expression: {expr}")
-
-        idx = [0]
-
-        def peek():
-            return expr[idx[0]] if idx[0] < len(expr) else None
-
-        def peek2():
-            return expr[idx[0]:idx[0] + 2] if idx[0] + 1 < len(expr) else ''
-
-        def consume(n=1):
-            idx[0] += n
-
-        def parse_atom():
-            ch = peek()
-            if ch is None:
-                raise ICFEvaluationError("Unexpected end of expression")
-            if ch == '(':
-                consume()
-                val = parse_ternary()
-                if peek() != ')':
-                    raise ICFEvaluationError("Missing closing parenthesis")
-                consume()
-                return val
-            if ch == '!':
-                consume()
-                return 0 if parse_atom() else 1
-            if ch == '~':
-                consume()
-                return ~parse_atom()
-            if ch == '-':
-                consume()
-                return -parse_atom()
-            if ch == '+':
-                consume()
-                return parse_atom()
-            start = idx[0]
-            while idx[0] < len(expr) and expr[idx[0]].isdigit():
-                idx[0] += 1
-            if idx[0] == start:
-                raise ICFEvaluationError(
-                    f"Expected number at position {idx[0]} in '{expr}'")
-            return int(expr[start:idx[0]])
-
-        def parse_muldiv():
-            left = parse_atom()
-            while peek() in ('*', '/'):
-                op = peek()
-                consume()
-                right = parse_atom()
-                if op == '*':
-                    left *= right
-                else:
-                    if right == 0:
-                        raise ICFEvaluationError("Division by zero")
-                    left //= right
-            return left
-
-        def parse_addsub():
-            left = parse_muldiv()
-            while peek() in ('+', '-'):
-                op = peek()
-                consume()
-                right = parse_muldiv()
-                left = left + right if op == '+' else left - right
-            return left
-
-        def parse_shift():
-            left = parse_addsub()
-            while idx[0] < len(expr) - 1 and expr[idx[0]:idx[0] + 2] in ('<<', '>>'):
-                op = expr[idx[0]:idx[0] + 2]
-                consume(2)
-                right = parse_addsub()
-                left = left << right if op == '<<' else left >> right
-            return left
-
-        def parse_bitand():
-            left = parse_shift()
-            while peek() == '&' and peek2() != '&&':
-                consume()
-                left &= parse_shift()
-            return left
-
-        def parse_bitor():
-            left = parse_bitand()
-            while peek() == '|' and peek2() != '||':
-                consume()
-                left |= parse_bitand()
-            return left
-
-        def parse_comparison():
-            left = parse_bitor()
-            while idx[0] < len(expr):
-                two = peek2()
-                if two == '==':
-                    consume(2)
-                    left = 1 if left == parse_bitor() else 0
-                    continue
-                if two == '!=':
-                    consume(2)
-                    left = 1 if left != parse_bitor() else 0
-                    continue
-                if two == '>=':
-                    consume(2)
-                    left = 1 if left >= parse_bitor() else 0
-                    continue
-                if two == '<=':
-                    consume(2)
-                    left = 1 if left <= parse_bitor() else 0
-                    continue
-                ch = peek()
-                if ch == '>' and peek2() not in ('>>', '>='):
-                    consume()
-                    left = 1 if left > parse_bitor() else 0
-                    continue
-                if ch == '<' and peek2() not in ('<<', '<='):
-                    consume()
-                    left = 1 if left < parse_bitor() else 0
-                    continue
-                break
-            return left
-
-        def parse_logical_and():
-            left = parse_comparison()
-            while peek2() == '&&':
-                consume(2)
-                right = parse_comparison()
-                left = 1 if (left and right) else 0
-            return left
-
-        def parse_logical_or():
-            left = parse_logical_and()
-            while peek2() == '||':
-                consume(2)
-                right = parse_logical_and()
-                left = 1 if (left or right) else 0
-            return left
-
-        def parse_ternary():
-            cond = parse_logical_or()
-            if peek() == '?':
-                consume()
-                true_val = parse_ternary()
-                if peek() != ':':
-                    raise ICFEvaluationError(
-                        "Expected ':' in ternary expression")
-                consume()
-                false_val = parse_ternary()
-                return true_val if cond else false_val
-            return cond
-
-        result = parse_ternary()
-        if idx[0] < len(expr):
-            raise ICFEvaluationError(
-                f"Unexpected character at position {idx[0]}: "
-                f"'{expr[idx[0]]}' in '{expr}'")
-        return result
+    @staticmethod
+    def _compile(expr: str) -> CompiledExpression:
+        try:
+            return compile_expression(expr.strip(), ICF_DIALECT)
+        except ExpressionError as exc:
+            raise ICFEvaluationError(str(exc)) from exc
+
+    # ---- Evaluation hooks ----
+
+    def lookup_symbol(self, name: str) -> int:
+        """Value of a resolved symbol."""
+        if name in self._resolved:
+            return self._resolved[name]
+        if name in self._unresolved:
+            raise ValueError(f"Unresolved symbol '{name}'")
+        raise ICFEvaluationError(f"Unknown symbol '{name}'")
+
+    def call_name_function(self, name: str, arg: str) -> int:
+        """isdefinedsymbol(), isempty() and the region built-ins."""
+        if name == 'isdefinedsymbol':
+            return 1 if self.is_defined(arg) else 0
+        region = self._regions.get(arg)
+        if name == 'isempty':
+            # Unknown region is treated as empty
+            return 0 if region is not None and region.spans else 1
+        if region is None or not region.spans:
+            raise ICFEvaluationError(f"{name}(): unknown region '{arg}'")
+        return getattr(region, self._REGION_FUNCTIONS[name])
 
 
 # ---------------------------------------------------------------------------
@@ -706,7 +501,7 @@ class IARLinkerScriptParser(LinkerScriptFormatParser):
         Pipeline:
           1. Preprocess (strip comments, inline includes)
           2. Extract ``define symbol`` directives
-          3. Resolve symbols to integers (multi-pass)
+          3. Resolve symbols to integers (dependency order)
           4. Evaluate if/else conditionals
           5. Re-extract symbols from surviving branches
           6. Parse ``define region`` directives
@@ -14,23 +14,32 @@ to extract memory region information including:
 The module is split into focused classes with clear responsibilities:
 - LinkerScriptParser: Main parsing orchestrator
 - ScriptContentCleaner: Handles preprocessing and cleanup
-- ExpressionEvaluator: Evaluates linker script expressions
+- ScriptSources: Per-run cache of script text and inlined INCLUDEs
+- ExpressionEvaluator: Evaluates linker script expressions (compiled by
+  the expression module)
 - MemoryRegionBuilder: Constructs memory region objects
 """
 
 import os
 import re
 import logging
-from typing import Dict, List, Any, Optional, Set
+from typing import Any, Dict, Iterable, Iterator, List, NamedTuple, Optional, Set, Tuple
 from dataclasses import dataclass
 from pathlib import Path
 
 # Import ELF parser for architecture detection
-from .elf_info import get_architecture_info, get_linker_parsing_strategy
+from .elf_info import (
+    ELFContext, ELFParser, get_architecture_info, get_linker_parsing_strategy
+)
 
 # Import format detector for ICF support
 from .base import LinkerFormatDetector
 
+from .expression import (
+    C_PRECEDENCE, MAX_TERNARY_DEPTH, CompiledExpression, Dialect,
+    EvaluationContext, ExpressionError, compile_expression, dependency_order,
+)
+
 
 # Configure logging
 logger = logging.getLogger(__name__)
@@ -76,67 +85,107 @@ class VariableResolutionError(LinkerScriptError):
     """Exception raised when variable resolution fails"""
 
 
-class ScriptContentCleaner:  # pylint: disable=too-few-public-methods
-    """Handles preprocessing and cleanup of linker script content"""
+class CircularReferenceError(ExpressionEvaluationError, VariableResolutionError):
+    """Exception raised when variables are defined in terms of each other"""
+
+
+GNU_LD_DIALECT = Dialect(
+    name_functions=frozenset({'ORIGIN', 'LENGTH', 'ADDR', 'SIZEOF', 'DEFINED'}),
+    precedence=tuple(C_PRECEDENCE.items()),
+    octal=True,
+)
+
+
+class ScriptContentCleaner:
+    """Handles preprocessing and cleanup of linker script content
+
+    Cleaning is one streaming pass over the lines of a comment-free script:
+    preprocessor blocks and directives are dropped as each line is seen,
+    then ``SECTIONS`` bodies are skipped by tracking brace depth and
+    whitespace is collapsed.
+    """
 
     # GNU LD documents a nesting limit of 10 for INCLUDE.
     MAX_INCLUDE_DEPTH = 10
 
+    # C-style and C++-style comments, whichever starts first
+    COMMENT_PATTERN = re.compile(r"/\*.*?\*/|//[^\n]*", re.DOTALL)
+
+    # GNU LD syntax: `INCLUDE filename` with optional quoting.
+    INCLUDE_PATTERN = re.compile(
+        r'\bINCLUDE\s+"([^"]+)"|\bINCLUDE\s+(\S+?)\s*;?(?=\s|$)')
+
+    _DIRECTIVE_PATTERN = re.compile(r"#[a-zA-Z_][a-zA-Z0-9_]*\b")
+    _SECTIONS_PATTERN = re.compile(r"\bSECTIONS\b")
+    _BRACE_PATTERN = re.compile(r"[{}]")
+    _WHITESPACE_PATTERN = re.compile(r"\s+")
+
     @staticmethod
-    def resolve_includes(
-        content: str,
-        base_dir: str,
-        visited: Optional[Set[str]] = None,
-        depth: int = 0,
-    ) -> str:
-        """Inline GNU LD ``INCLUDE filename`` directives.
-
-        Paths are resolved relative to the including script's directory, then
-        the current working directory. Cycles are guarded via ``visited`` and
-        depth is capped at ``MAX_INCLUDE_DEPTH``. Unresolvable includes log a
-        warning and are dropped so parsing can continue.
-        """
-        if visited is None:
-            visited = set()
+    def strip_comments(content: str) -> str:
+        """Remove C-style /* ... */ and C++-style // ... comments"""
+        return ScriptContentCleaner.COMMENT_PATTERN.sub("", content)
 
-        if depth >= ScriptContentCleaner.MAX_INCLUDE_DEPTH:
-            logger.warning(
-                "INCLUDE nesting depth exceeds %d, skipping further includes",
-                ScriptContentCleaner.MAX_INCLUDE_DEPTH)
-            return content
+    @staticmethod
+    def clean_content(content: str, strip_sections: bool = False) -> str:
+        """Remove comments and normalize whitespace from linker script content
 
-        # Strip comments so INCLUDE directives inside comments aren't matched.
-        # clean_content re-runs these regexes; the operation is idempotent.
-        scan = re.sub(r"/\*.*?\*/", "", content, flags=re.DOTALL)
-        scan = re.sub(r"//.*", "", scan)
+        Args:
+            content: Linker script text
+            strip_sections: Also drop ``SECTIONS { ... }`` blocks
+        """
+        return ScriptContentCleaner.lex(
+            ScriptContentCleaner.strip_comments(content), strip_sections)
 
-        # GNU LD syntax: `INCLUDE filename` with optional quoting.
-        include_pattern = re.compile(
-            r'\bINCLUDE\s+"([^"]+)"|\bINCLUDE\s+(\S+?)\s*;?(?=\s|$)')
+    @staticmethod
+    def lex(content: str, strip_sections: bool = False) -> str:
+        """Clean comment-free script text in a single pass over its lines"""
+        lines = ScriptContentCleaner._preprocessed_lines(content.split("\n"))
+        content = "\n".join(lines)
+        if strip_sections:
+            content = ScriptContentCleaner.strip_sections_content(content)
+        return ScriptContentCleaner._WHITESPACE_PATTERN.sub(" ", content)
 
-        def replace_include(match: re.Match) -> str:
-            filename = (match.group(1) or match.group(2)).strip().rstrip(';')
-            resolved = ScriptContentCleaner._resolve_include_path(
-                filename, base_dir)
-            if resolved is None:
-                logger.warning(
-                    "INCLUDE '%s' not found (searched %s and cwd)",
-                    filename, base_dir)
-                return ""
-            if resolved in visited:
-                logger.debug("Skipping already-included file: %s", resolved)
-                return ""
-            visited.add(resolved)
-            try:
-                with open(resolved, "r", encoding="utf-8") as f:
-                    inner = f.read()
-            except OSError as exc:
-                logger.warning("Failed to read INCLUDE %s: %s", resolved, exc)
-                return ""
-            return ScriptContentCleaner.resolve_includes(
-                inner, os.path.dirname(resolved), visited, depth + 1)
+    @staticmethod
+    def _preprocessed_lines(lines: Iterable[str]) -> Iterator[str]:
+        """Drop preprocessor conditionals and directives line by line.
 
-        return include_pattern.sub(replace_include, scan)
+        A ``#if`` ... ``#endif`` block with nothing but ``#elif``/``#else``
+        in between is buffered and dropped entirely unless it holds a
+        variable assignment (``=`` and ``;``); the directive lines of the
+        blocks that are kept, and any other directive, are removed.
+        """
+        block: List[str] = []
+        for line in lines:
+            stripped = line.strip()
+            if block:
+                if "#" not in line or (stripped.startswith(("#elif", "#else"))
+                                       and line.count("#") == 1):
+                    block.append(line)
+                    continue
+                if stripped.startswith("#endif"):
+                    block.append(line)
+                    text = "\n".join(block)
+                    if "=" in text and ";" in text:
+                        yield from ScriptContentCleaner._without_directives(block)
+                    block = []
+                    continue
+                # A nested or unrelated directive: not a removable block
+                yield from ScriptContentCleaner._without_directives(block)
+                block = []
+            if stripped.startswith("#if") and line.count("#") == 1:
+                block.append(line)
+                continue
+            yield from ScriptContentCleaner._without_directives([line])
+        yield from ScriptContentCleaner._without_directives(block)
+
+    @staticmethod
+    def _without_directives(lines: Iterable[str]) -> Iterator[str]:
+        for line in lines:
+            stripped = line.strip()
+            if stripped.startswith(("#if", "#elif", "#else", "#endif", "#error")):
+                continue
+            directive = ScriptContentCleaner._DIRECTIVE_PATTERN.search(line)
+            yield line[:directive.start()] if directive else line
 
     @staticmethod
     def _resolve_include_path(filename: str, base_dir: str) -> Optional[str]:
@@ -153,72 +202,6 @@ class ScriptContentCleaner:  # pylint: disable=too-few-public-methods
 
         return None
 
-    @staticmethod
-    def clean_content(content: str) -> str:
-        """Remove comments and normalize whitespace from linker script content"""
-        # Remove C-style comments /* ... */
-        content = re.sub(r"/\*.*?\*/", "", content, flags=re.DOTALL)
-        # Remove C++-style comments // ...
-        content = re.sub(r"//.*", "", content)
-
-        # Handle preprocessor directives - remove them and their content
-        content = ScriptContentCleaner._remove_preprocessor_blocks(content)
-
-        # Remove remaining single-line preprocessor directives
-        content = re.sub(
-            r"#[a-zA-Z_][a-zA-Z0-9_]*\b.*$", "", content, flags=re.MULTILINE
-        )
-
-        # Normalize whitespace
-        content = re.sub(r"\s+", " ", content)
-        return content
-
-    @staticmethod
-    def _remove_preprocessor_blocks(content: str) -> str:
-        """Remove preprocessor conditional blocks"""
-        # Handle nested #if/#endif blocks more carefully
-        # Remove preprocessor directives but preserve variable definitions
-
-        # Handle #if blocks with only preprocessor directives
-        # Find blocks without variable assignments (no '=' followed by ';')
-        if_blocks_to_remove = []
-
-        # Find all #if...#endif blocks
-        if_pattern = r"#if[^#]*?(?:#(?:elif|else)[^#]*?)*?#endif"
-
-        for match in re.finditer(if_pattern, content, re.DOTALL):
-            block_content = match.group(0)
-            # If the block doesn't contain variable assignments, mark it for
-            # removal
-            if "=" not in block_content or ";" not in block_content:
-                if_blocks_to_remove.append(match.group(0))
-
-        # Remove the identified blocks
-        for block in if_blocks_to_remove:
-            content = content.replace(block, " ")
-
-        # For remaining #if blocks, remove preprocessor lines but keep content
-        # Remove #if, #elif, #else, #endif lines but preserve content
-        lines = content.split("\n")
-        filtered_lines = []
-
-        for line in lines:
-            stripped = line.strip()
-            if (
-                stripped.startswith("#if")
-                or stripped.startswith("#elif")
-                or stripped.startswith("#else")
-                or stripped.startswith("#endif")
-            ):
-                # Skip preprocessor directives
-                continue
-            if stripped.startswith("#error"):
-                # Skip error directives
-                continue
-            filtered_lines.append(line)
-
-        return "\n".join(filtered_lines)
-
     @staticmethod
     def strip_sections_content(content: str) -> str:
         """Remove SECTIONS { ... } block content from cleaned linker script text.
@@ -226,169 +209,213 @@ class ScriptContentCleaner:  # pylint: disable=too-few-public-methods
         Uses brace-depth counting to handle nested braces correctly.
         Config variables live outside SECTIONS blocks; linker symbols live inside.
         """
-        # Find all SECTIONS block starts using word boundary to avoid matching
-        # variable names that happen to contain "SECTIONS"
-        sections_starts = [
-            m.start() for m in re.finditer(r"\bSECTIONS\b", content)
-        ]
-
-        if not sections_starts:
-            return content
-
-        # Process in reverse order to preserve indices
-        result = content
-        for start in reversed(sections_starts):
-            # Find the opening brace after SECTIONS
-            brace_pos = result.find("{", start)
+        kept = []
+        copied_to = 0
+        search_from = 0
+        while True:
+            keyword = ScriptContentCleaner._SECTIONS_PATTERN.search(
+                content, search_from)
+            if keyword is None:
+                break
+            search_from = keyword.end()
+            brace_pos = content.find("{", keyword.end())
             if brace_pos == -1:
-                continue
-
-            # Count braces to find matching close
-            depth = 1
-            pos = brace_pos + 1
-            while pos < len(result) and depth > 0:
-                if result[pos] == "{":
-                    depth += 1
-                elif result[pos] == "}":
-                    depth -= 1
-                pos += 1
+                break
 
+            close, depth = ScriptContentCleaner._matching_brace(
+                content, brace_pos)
             if depth == 0:
                 # Remove from SECTIONS keyword through closing brace
-                result = result[:start] + result[pos:]
+                kept.append(content[copied_to:keyword.start()])
+                copied_to = search_from = close
             else:
                 logger.warning(
                     "Unclosed SECTIONS block at position %d "
                     "(brace depth %d) - linker symbols may be "
                     "incorrectly extracted as variables",
-                    start, depth
+                    keyword.start(), depth
                 )
 
-        return result
+        if not kept:
+            return content
+        kept.append(content[copied_to:])
+        return "".join(kept)
 
+    @staticmethod
+    def _matching_brace(content: str, brace_pos: int) -> Tuple[int, int]:
+        """Position after the brace closing the one at ``brace_pos``.
 
-class _ArithmeticParser:  # pylint: disable=too-few-public-methods
-    """Recursive descent parser for safe integer arithmetic expressions.
+        Returns (position, 0), or (len(content), remaining depth) when the
+        block is unclosed.
+        """
+        depth = 0
+        for brace in ScriptContentCleaner._BRACE_PATTERN.finditer(
+                content, brace_pos):
+            depth += 1 if brace.group() == "{" else -1
+            if depth == 0:
+                return brace.end(), 0
+        return len(content), depth
 
-    Operator precedence (lowest to highest, matching C):
-    1. | (bitwise OR)
-    2. ^ (bitwise XOR)
-    3. & (bitwise AND)
-    4. << >> (bitshift)
-    5. + - (addition, subtraction)
-    6. * / (multiplication, division)
-    7. unary +/-/~, parentheses
+
+# IAR ICF `include "file";` (see icf_parser.ICFContentPreprocessor)
+_ICF_INCLUDE_PATTERN = re.compile(r'\binclude\s+"([^"]+)"')
+
+
+class _Include(NamedTuple):
+    """An INCLUDE directive and the file it resolved to (None if missing)"""
+    filename: str
+    path: Optional[str]
+
+
+class ScriptSources:
+    """Linker script text shared by the parsers of one run.
+
+    Each file is read and split into comment-free text and ``INCLUDE``
+    directives once, however many scripts include it (e.g. a memory map
+    included by both the primary and the ``--limits`` script). The cleaned
+    text of each script, with its includes inlined, is memoized too.
     """
 
-    def __init__(self, expr: str):
-        self._expr = expr
-        self._pos = 0
-
-    def parse(self) -> int:
-        """Parse the full expression and ensure no trailing characters."""
-        result = self._parse_or()
-        if self._pos < len(self._expr):
-            raise ValueError(
-                f"Unexpected character at position {self._pos}: "
-                f"{self._expr[self._pos]}")
-        return result
-
-    def _peek(self, length: int = 1) -> str:
-        """Return up to ``length`` characters at the current position."""
-        return self._expr[self._pos:self._pos + length]
-
-    def _parse_number(self) -> int:
-        start = self._pos
-        while self._pos < len(self._expr) and self._expr[self._pos].isdigit():
-            self._pos += 1
-        if start == self._pos:
-            raise ValueError(f"Expected number at position {self._pos}")
-        return int(self._expr[start:self._pos])
-
-    def _parse_factor(self) -> int:
-        char = self._peek()
-        if char == "(":
-            self._pos += 1  # Skip '('
-            result = self._parse_or()
-            if self._peek() != ")":
-                raise ValueError("Missing closing parenthesis")
-            self._pos += 1  # Skip ')'
-            return result
-        if char == "-":
-            self._pos += 1  # Skip '-'
-            return -self._parse_factor()
-        if char == "+":
-            self._pos += 1  # Skip '+'
-            return self._parse_factor()
-        if char == "~":
-            self._pos += 1  # Skip '~'
-            return ~self._parse_factor()
-        return self._parse_number()
-
-    def _parse_term(self) -> int:
-        result = self._parse_factor()
-        while self._peek() in ("*", "/"):
-            op = self._peek()
-            self._pos += 1
-            right = self._parse_factor()
-            if op == "*":
-                result *= right
-            elif right == 0:
-                raise ArithmeticError("Division by zero")
+    def __init__(self) -> None:
+        self._text: Dict[str, str] = {}
+        self._parts: Dict[str, List[Any]] = {}
+        self._inlined: Dict[str, str] = {}
+        self._cleaned: Dict[Tuple[str, bool], str] = {}
+
+    def read(self, path: str) -> str:
+        """Raw text of a script."""
+        path = os.path.abspath(path)
+        if path not in self._text:
+            with open(path, "r", encoding="utf-8", errors="replace") as f:
+                self._text[path] = f.read()
+        return self._text[path]
+
+    def cleaned(self, path: str, strip_sections: bool = False) -> str:
+        """Cleaned text of a GNU LD script with its INCLUDEs inlined.
+
+        Args:
+            path: Script path
+            strip_sections: Also drop ``SECTIONS { ... }`` blocks, leaving
+                only configuration variables and MEMORY
+        """
+        path = os.path.abspath(path)
+        key = (path, strip_sections)
+        if key not in self._cleaned:
+            if path not in self._inlined:
+                pieces: List[str] = []
+                self._inline(path, {path}, 0, pieces)
+                self._inlined[path] = "".join(pieces)
+            self._cleaned[key] = ScriptContentCleaner.lex(
+                self._inlined[path], strip_sections)
+        return self._cleaned[key]
+
+    def dependencies(self, path: str) -> List[str]:
+        """``path`` and every file it includes, each listed once.
+
+        Follows GNU LD ``INCLUDE`` and IAR ICF ``include "..."``
+        directives, so the list covers every file a parse of ``path``
+        reads. Unreadable includes are left out.
+        """
+        path = os.path.abspath(path)
+        self.read(path)
+        order = [path]
+        pending = [path]
+        while pending:
+            current = pending.pop()
+            try:
+                parts = self._split(current)
+            except OSError:
+                continue
+            for target in self._include_targets(current, parts):
+                if target not in order:
+                    order.append(target)
+                    pending.append(target)
+        return order
+
+    @staticmethod
+    def _include_targets(path: str, parts: List[Any]) -> Iterator[str]:
+        base_dir = os.path.dirname(path)
+        for part in parts:
+            if isinstance(part, _Include):
+                if part.path is not None:
+                    yield part.path
+                continue
+            # IAR resolves includes against the including file only
+            for match in _ICF_INCLUDE_PATTERN.finditer(part):
+                target = os.path.realpath(os.path.join(base_dir, match.group(1)))
+                if os.path.isfile(target):
+                    yield target
+
+    def _split(self, path: str) -> List[Any]:
+        """Comment-free text pieces and _Include entries of one file."""
+        if path in self._parts:
+            return self._parts[path]
+        content = ScriptContentCleaner.strip_comments(self.read(path))
+        base_dir = os.path.dirname(path)
+        parts: List[Any] = []
+        position = 0
+        for match in ScriptContentCleaner.INCLUDE_PATTERN.finditer(content):
+            parts.append(content[position:match.start()])
+            position = match.end()
+            filename = (match.group(1) or match.group(2)).strip().rstrip(';')
+            resolved = ScriptContentCleaner._resolve_include_path(
+                filename, base_dir)
+            if resolved is None:
+                logger.warning(
+                    "INCLUDE '%s' not found (searched %s and cwd)",
+                    filename, base_dir)
+            parts.append(_Include(filename, resolved))
+        parts.append(content[position:])
+        self._parts[path] = parts
+        return parts
+
+    def _inline(self, path: str, visited: Set[str], depth: int,
+                pieces: List[str]) -> None:
+        """Append the text of ``path`` with includes expanded to ``pieces``."""
+        parts = self._split(path)
+        if depth >= ScriptContentCleaner.MAX_INCLUDE_DEPTH:
+            logger.warning(
+                "INCLUDE nesting depth exceeds %d, skipping further includes",
+                ScriptContentCleaner.MAX_INCLUDE_DEPTH)
+            pieces.extend(part for part in parts if isinstance(part, str))
+            return
+        for part in parts:
+            if isinstance(part, str):
+                pieces.append(part)
+            elif part.path is None:
+                continue
+            elif part.path in visited:
+                logger.debug("Skipping already-included file: %s", part.path)
             else:
-                result //= right  # Integer division
-        return result
-
-    def _parse_addition(self) -> int:
-        result = self._parse_term()
-        while self._peek() in ("+", "-"):
-            op = self._peek()
-            self._pos += 1
-            right = self._parse_term()
-            result = result + right if op == "+" else result - right
-        return result
-
-    def _parse_shift(self) -> int:
-        """Parse bitshift operators (<< and >>)."""
-        result = self._parse_addition()
-        while self._peek(2) in ("<<", ">>"):
-            op = self._peek(2)
-            self._pos += 2
-            right = self._parse_addition()
-            result = result << right if op == "<<" else result >> right
-        return result
-
-    def _parse_and(self) -> int:
-        """Parse bitwise AND (&), but not && which never appears here."""
-        result = self._parse_shift()
-        while self._peek() == "&" and self._peek(2) != "&&":
-            self._pos += 1  # Skip '&'
-            result &= self._parse_shift()
-        return result
-
-    def _parse_xor(self) -> int:
-        """Parse bitwise XOR (^)."""
-        result = self._parse_and()
-        while self._peek() == "^":
-            self._pos += 1  # Skip '^'
-            result ^= self._parse_and()
-        return result
-
-    def _parse_or(self) -> int:
-        """Parse bitwise OR (|), but not || which never appears here."""
-        result = self._parse_xor()
-        while self._peek() == "|" and self._peek(2) != "||":
-            self._pos += 1  # Skip '|'
-            result |= self._parse_xor()
-        return result
-
-
-class ExpressionEvaluator:
-    """Evaluates linker script expressions and variables"""
+                visited.add(part.path)
+                try:
+                    self._inline(part.path, visited, depth + 1, pieces)
+                except OSError as exc:
+                    logger.warning("Failed to read INCLUDE %s: %s", part.path, exc)
+
+
+class ExpressionEvaluator(EvaluationContext):
+    """Evaluates linker script expressions and variables
+
+    Expressions are compiled once (see :mod:`.expression`) and evaluated
+    against the current variables and memory regions. String variables are
+    resolved when first referenced and cached as integers.
+    """
+
+    # Maximum nesting depth for ternary expressions (security limit)
+    MAX_TERNARY_DEPTH = MAX_TERNARY_DEPTH
+
+    # Region functions and the MemoryRegion attribute each returns
+    _REGION_FUNCTIONS = {
+        'ORIGIN': 'address', 'ADDR': 'address',
+        'LENGTH': 'limit_size', 'SIZEOF': 'limit_size',
+    }
 
     def __init__(self):
         self.variables: Dict[str, Any] = {}
         self._memory_regions: Dict[str, MemoryRegion] = {}
+        # Variables being resolved, innermost last (cycle detection)
+        self._resolving: List[str] = []
 
     def set_variables(self, variables: Dict[str, Any]) -> None:
         """Set variables for expression evaluation"""
@@ -408,508 +435,102 @@ class ExpressionEvaluator:
         """Get copy of current memory regions"""
         return self._memory_regions.copy()
 
+    @staticmethod
+    def compile(expr: str) -> CompiledExpression:
+        """Compile a GNU LD expression (cached per expression text)"""
+        try:
+            return compile_expression(expr.strip(), GNU_LD_DIALECT)
+        except ExpressionError as exc:
+            raise ExpressionEvaluationError(str(exc)) from exc
+
     def evaluate_expression(
         self, expr: str, resolving_vars: Optional[Set[str]] = None
     ) -> int:
-        """Evaluate linker script expression with variables and arithmetic"""
-        expr = expr.strip()
-
-        # Initialize set to track variables being resolved (cycle detection)
-        if resolving_vars is None:
-            resolving_vars = set()
-
-        # Handle linker script functions first
-        expr = self._handle_linker_functions(expr)
-
-        # Replace variables with their values
-        expr = self._substitute_variables(expr, resolving_vars)
-
-        # Handle size suffixes before arithmetic evaluation
-        expr = self._resolve_size_suffixes(expr)
-
-        # Handle simple arithmetic expressions
-        return self._evaluate_arithmetic(expr)
-
-    def _substitute_variables(
-            self,
-            expr: str,
-            resolving_vars: Set[str]) -> str:
-        """Substitute variables in expression with their values"""
-        for var_name, var_value in self.variables.items():
-            # Quick substring check first (fast)
-            if var_name not in expr:
-                continue
-
-            # Use word boundary regex to check if variable is in expression
-            # This avoids matching _ram_start when looking for _app_ram_start
-            var_pattern = r'\b' + re.escape(var_name) + r'\b'
-            if not re.search(var_pattern, expr):
-                continue  # Variable not in expression (was substring), skip
-
-            if isinstance(var_value, (int, float)):
-                # Substitute numeric values
-                expr = re.sub(var_pattern, str(var_value), expr)
-            elif isinstance(var_value, str) and var_name not in resolving_vars:
-                # Try to recursively evaluate string variables with cycle
-                # detection
-                try:
-                    resolving_vars.add(var_name)
-                    resolved_value = self.evaluate_expression(
-                        var_value, resolving_vars
-                    )
-                    resolving_vars.remove(var_name)
-                    self.variables[var_name] = (
-                        resolved_value  # Cache the resolved value
-                    )
-                    expr = re.sub(var_pattern, str(resolved_value), expr)
-                except (ExpressionEvaluationError, VariableResolutionError):
-                    if var_name in resolving_vars:
-                        resolving_vars.remove(var_name)
-                    # Skip unresolvable variables - part of iterative
-                    # resolution
-        return expr
-
-    def _handle_linker_functions(self, expr: str) -> str:
-        """Handle linker script functions like DEFINED(), ORIGIN(), LENGTH(), etc."""
-        # Handle ABSOLUTE() function - simply extracts the inner expression
-        # ABSOLUTE() ensures a value is treated as an absolute address,
-        # but for our purposes it's a no-op that just returns the inner value
-        expr = self._replace_absolute(expr)
-
-        # Handle DEFINED() function
-        expr = re.sub(
-            r"DEFINED\s*\(\s*([^)]+)\s*\)",
-            self._replace_defined,
-            expr)
-
-        # Handle conditional expressions (ternary) with proper nesting support
-        expr = self._evaluate_ternary(expr)
-
-        # Handle ORIGIN() and LENGTH() functions
-        expr = re.sub(
-            r"ORIGIN\s*\(\s*([^)]+)\s*\)",
-            self._replace_origin,
-            expr)
-        expr = re.sub(
-            r"LENGTH\s*\(\s*([^)]+)\s*\)",
-            self._replace_length,
-            expr)
-
-        # Handle ADDR() and SIZEOF() functions (aliases for ORIGIN/LENGTH)
-        expr = re.sub(
-            r"ADDR\s*\(\s*([^)]+)\s*\)",
-            self._replace_addr,
-            expr)
-        expr = re.sub(
-            r"SIZEOF\s*\(\s*([^)]+)\s*\)",
-            self._replace_sizeof,
-            expr)
-
-        # Handle parenthesized expressions
-        expr = self._resolve_parenthesized_expressions(expr)
-
-        return expr
-
-    # Maximum nesting depth for ternary expressions (security limit)
-    MAX_TERNARY_DEPTH = 50
-
-    def _evaluate_ternary(self, expr: str, depth: int = 0) -> str:
-        """Evaluate ternary expressions with proper nesting support.
-
-        Handles patterns like:
-        - Simple: DEFINED(X) ? A : B
-        - Nested: DEFINED(X) ? A : DEFINED(Y) ? B : C
-        - Chained: !DEFINED(X) ? A : Y == 1 ? B : C
-
-        Ternary operators are right-associative, so:
-        a ? b : c ? d : e  is parsed as  a ? b : (c ? d : e)
-        """
-        if depth > self.MAX_TERNARY_DEPTH:
-            raise ExpressionEvaluationError(
-                f"Ternary nesting depth exceeds limit ({self.MAX_TERNARY_DEPTH})")
-
-        expr = expr.strip()
+        """Evaluate linker script expression with variables and arithmetic
 
-        # Find the first '?' that's not inside parentheses
-        question_pos = self._find_operator_outside_parens(expr, '?')
-        if question_pos == -1:
-            return expr  # No ternary operator
-
-        # Extract condition (everything before '?')
-        condition = expr[:question_pos].strip()
-
-        # Find the matching ':' for this '?'
-        # We need to count nested '?' and ':' pairs
-        rest = expr[question_pos + 1:]
-        colon_pos = self._find_matching_colon(rest)
-
-        if colon_pos == -1:
-            return expr  # Malformed ternary, return as-is
-
-        true_value = rest[:colon_pos].strip()
-        false_value = rest[colon_pos + 1:].strip()
-
-        # Recursively evaluate nested ternaries in the false branch
-        # (ternary is right-associative)
-        false_value = self._evaluate_ternary(false_value, depth + 1)
-
-        # Evaluate the condition
-        cond_result = self._evaluate_condition(condition)
-
-        # Return the appropriate branch
-        if cond_result:
-            return true_value
-        return false_value
-
-    def _find_operator_outside_parens(self, expr: str, op: str) -> int:
-        """Find the position of an operator that's not inside parentheses."""
-        paren_depth = 0
-        for i, char in enumerate(expr):
-            if char == '(':
-                paren_depth += 1
-            elif char == ')':
-                paren_depth -= 1
-            elif char == op and paren_depth == 0:
-                return i
-        return -1
-
-    def _find_matching_colon(self, expr: str) -> int:
-        """Find the colon that matches the current ternary level.
-
-        For nested ternaries like "A : B ? C : D", we need to find the first ':'
-        at depth 0 (not counting nested ternaries).
+        Args:
+            expr: Expression text
+            resolving_vars: Variables the caller is already resolving; a
+                reference back to one of them is reported as circular
         """
-        paren_depth = 0
-        ternary_depth = 0
-
-        for i, char in enumerate(expr):
-            if char == '(':
-                paren_depth += 1
-            elif char == ')':
-                paren_depth -= 1
-            elif char == '?' and paren_depth == 0:
-                ternary_depth += 1
-            elif char == ':' and paren_depth == 0:
-                if ternary_depth == 0:
-                    return i
-                ternary_depth -= 1
-
-        return -1
-
-    def _evaluate_condition(self, condition: str) -> bool:
-        """Evaluate a ternary condition to a boolean result."""
-        condition, negated = self._strip_negation(condition.strip())
-
-        handlers = [
-            self._eval_numeric_literal,
-            self._eval_defined,
-            self._eval_comparison,
-            self._eval_variable,
-        ]
-
-        for handler in handlers:
-            result = handler(condition)
-            if result is not None:
-                return not result if negated else result
-
-        return negated  # Unknown condition = false
-
-    def _strip_negation(self, condition: str) -> tuple:
-        """Strip leading ! and return (condition, is_negated)."""
-        if condition.startswith('!'):
-            return condition[1:].strip(), True
-        return condition, False
-
-    def _eval_numeric_literal(self, condition: str) -> Optional[bool]:
-        """Evaluate numeric literals 0 and 1."""
-        if condition in ["0", "1"]:
-            return int(condition) != 0
-        return None
-
-    def _eval_defined(self, condition: str) -> Optional[bool]:
-        """Evaluate DEFINED() function."""
-        if "DEFINED(" not in condition:
-            return None
-        match = re.search(r"DEFINED\s*\(\s*([^)]+)\s*\)", condition)
-        if match:
-            symbol = match.group(1).strip()
-            return symbol in self.variables
-        return None
-
-    def _eval_comparison(self, condition: str) -> Optional[bool]:
-        """Evaluate == and != comparisons."""
-        for op, func in [("==", lambda a, b: a == b), ("!=", lambda a, b: a != b)]:
-            if op in condition:
-                match = re.match(rf"(.+?)\s*{op}\s*(.+)", condition)
-                if match:
-                    try:
-                        left_val = self._get_value(match.group(1).strip())
-                        right_val = self._get_value(match.group(2).strip())
-                        return func(left_val, right_val)
-                    except (ValueError, ExpressionEvaluationError):
-                        pass
-        return None
-
-    def _eval_variable(self, condition: str) -> Optional[bool]:
-        """Evaluate variable lookup or numeric expression."""
-        # Direct variable lookup
-        if condition in self.variables:
-            var_val = self.variables[condition]
-            if isinstance(var_val, (int, float)):
-                return var_val != 0
-
-        # Try as numeric expression
+        compiled = self.compile(expr)
+        depth = len(self._resolving)
+        if resolving_vars:
+            self._resolving.extend(sorted(resolving_vars - set(self._resolving)))
         try:
-            return self._get_value(condition) != 0
-        except (ValueError, ExpressionEvaluationError):
-            return None
-
-    def _get_value(self, expr: str) -> int:
-        """Get numeric value from expression or variable."""
-        expr = expr.strip()
-
-        # Try as variable
-        if expr in self.variables:
-            val = self.variables[expr]
-            if isinstance(val, (int, float)):
-                return int(val)
-
-        # Try as hex literal
-        if expr.startswith('0x') or expr.startswith('0X'):
-            return int(expr, 16)
-
-        # Try as decimal literal
+            return compiled.evaluate(self)
+        except ExpressionError as exc:
+            raise ExpressionEvaluationError(str(exc)) from exc
+        finally:
+            del self._resolving[depth:]
+
+    def lookup_symbol(self, name: str) -> int:
+        """Value of a variable, resolving string definitions on first use"""
+        if name not in self.variables:
+            raise ExpressionEvaluationError(f"Undefined symbol '{name}'")
+        value = self.variables[name]
+        if isinstance(value, (int, float)):
+            return int(value)
+        if name in self._resolving:
+            chain = self._resolving[self._resolving.index(name):] + [name]
+            raise CircularReferenceError(
+                "Circular variable reference: " + " -> ".join(chain))
+        self._resolving.append(name)
         try:
-            return int(expr)
-        except ValueError:
-            pass
-
-        raise ValueError(f"Cannot evaluate: {expr}")
-
-    def _replace_defined(self, match: re.Match) -> str:
-        """Replace DEFINED() function with 1 or 0"""
-        symbol = match.group(1).strip()
-        return "1" if symbol in self.variables else "0"
-
-    def _replace_origin(self, match: re.Match) -> str:
-        """Replace ORIGIN() function with actual address"""
-        region_name = match.group(1).strip()
-        # Check if we have this region in our parsed data
-        if region_name in self._memory_regions:
-            return str(self._memory_regions[region_name].address)
-        # Cannot resolve - raise error
-        raise ExpressionEvaluationError(
-            f"ORIGIN({region_name}): region '{region_name}' not found")
-
-    def _replace_length(self, match: re.Match) -> str:
-        """Replace LENGTH() function with actual size"""
-        region_name = match.group(1).strip()
-        # Check if we have this region in our parsed data
-        if region_name in self._memory_regions:
-            return str(self._memory_regions[region_name].limit_size)
-        # Cannot resolve - raise error
-        raise ExpressionEvaluationError(
-            f"LENGTH({region_name}): region '{region_name}' not found")
-
-    def _replace_addr(self, match: re.Match) -> str:
-        """Replace ADDR() function with actual address (alias for ORIGIN)"""
-        region_name = match.group(1).strip()
-        # Check if we have this region in our parsed data
-        if region_name in self._memory_regions:
-            return str(self._memory_regions[region_name].address)
-        # Cannot resolve - raise error
-        raise ExpressionEvaluationError(
-            f"ADDR({region_name}): region '{region_name}' not found")
-
-    def _replace_sizeof(self, match: re.Match) -> str:
-        """Replace SIZEOF() function with actual size (alias for LENGTH)"""
-        region_name = match.group(1).strip()
-        # Check if we have this region in our parsed data
-        if region_name in self._memory_regions:
-            return str(self._memory_regions[region_name].limit_size)
-        # Cannot resolve - raise error
-        raise ExpressionEvaluationError(
-            f"SIZEOF({region_name}): region '{region_name}' not found")
-
-    def _replace_absolute(self, expr: str) -> str:
-        """Replace ABSOLUTE() function calls with their inner expressions.
-
-        ABSOLUTE() in linker scripts ensures a value is treated as an absolute
-        address rather than relative. For our parsing purposes, it's essentially
-        a no-op - we just extract and return the inner expression.
-
-        Handles nested ABSOLUTE() calls and complex inner expressions with
-        nested parentheses.
-        """
-        max_iterations = 10  # Prevent infinite loops
-
-        for _ in range(max_iterations):
-            # Find ABSOLUTE( and then match the balanced parentheses
-            match = re.search(r'ABSOLUTE\s*\(', expr)
-            if not match:
-                break
-
-            inner_start = match.end()
-
-            # Find matching closing parenthesis
-            paren_depth = 1
-            pos = inner_start
-            while pos < len(expr) and paren_depth > 0:
-                if expr[pos] == '(':
-                    paren_depth += 1
-                elif expr[pos] == ')':
-                    paren_depth -= 1
-                pos += 1
-
-            if paren_depth != 0:
-                # Unbalanced parentheses, stop processing
-                break
-
-            # Extract the inner expression (excluding the closing paren)
-            inner_expr = expr[inner_start:pos - 1].strip()
-
-            # Replace ABSOLUTE(...) with just the inner expression
-            expr = expr[:match.start()] + inner_expr + expr[pos:]
-
-        return expr
-
-    def _resolve_parenthesized_expressions(self, expr: str) -> str:
-        """Resolve parenthesized arithmetic expressions"""
-        max_iterations = 5
-
-        for _ in range(max_iterations):
-            # Find innermost parentheses (no nested parens inside)
-            paren_pattern = r"\(\s*([^()]+)\s*\)"
-
-            def resolve_paren_expr(match):
-                inner_expr = match.group(1).strip()
-                try:
-                    # Try to evaluate the inner expression
-                    result = self._evaluate_simple_arithmetic(inner_expr)
-                    return str(result)
-                except (ExpressionEvaluationError, ValueError, ArithmeticError):
-                    # If we can't evaluate, keep the original expression
-                    return match.group(0)
-
-            new_expr = re.sub(paren_pattern, resolve_paren_expr, expr)
-
-            # If no more changes, break
-            if new_expr == expr:
-                break
-            expr = new_expr
-
-        return expr
-
-    def _evaluate_simple_arithmetic(self, expr: str) -> int:
-        """Evaluate simple arithmetic expressions with variables"""
-        # Replace known variables with their values
-        for var_name, var_value in self.variables.items():
-            if var_name in expr and isinstance(var_value, (int, float)):
-                # Use word boundary regex to avoid substring matches
-                expr = re.sub(r'\b' + re.escape(var_name) + r'\b',
-                              str(var_value), expr)
-
-        # Handle hex and octal literals
-        expr = re.sub(r"0[xX]([0-9a-fA-F]+)",
-                      lambda m: str(int(m.group(1), 16)), expr)
-
-        # Handle octal literals
-        expr = re.sub(r"\b0([0-7]+)\b",
-                      lambda m: str(int(m.group(1), 8)), expr)
-
-        # Handle size suffixes
-        expr = self._resolve_size_suffixes(expr)
-
-        # Use safe arithmetic evaluation instead of eval
-        try:
-            return self._safe_arithmetic_eval(expr)
-        except (ValueError, ArithmeticError) as exc:
+            resolved = self.compile(str(value)).evaluate(self)
+        finally:
+            self._resolving.pop()
+        self.variables[name] = resolved  # Cache the resolved value
+        return resolved
+
+    def call_name_function(self, name: str, arg: str) -> int:
+        """DEFINED(symbol) and the ORIGIN/LENGTH/ADDR/SIZEOF region functions"""
+        if name == 'DEFINED':
+            return 1 if arg in self.variables else 0
+        region = self._memory_regions.get(arg)
+        if region is None:
             raise ExpressionEvaluationError(
-                f"Cannot evaluate expression: {expr}") from exc
-
-    def _evaluate_arithmetic(self, expr: str) -> int:
-        """Evaluate arithmetic expressions"""
-        # Replace hex and octal literals
-        expr = re.sub(r"0[xX]([0-9a-fA-F]+)",
-                      lambda m: str(int(m.group(1), 16)), expr)
-
-        # Replace octal literals (0 followed by digits, but not 0x)
-        expr = re.sub(r"\b0([0-7]+)\b",
-                      lambda m: str(int(m.group(1), 8)), expr)
+                f"{name}({arg}): region '{arg}' not found")
+        return getattr(region, self._REGION_FUNCTIONS[name])
+
+    def call_function(self, name: str, args: Tuple[int, ...]) -> int:
+        """ABSOLUTE(), MAX(), MIN() and two-argument ALIGN()"""
+        # ABSOLUTE() marks a value as an absolute address rather than a
+        # section-relative one; for our purposes it is a no-op
+        if name == 'ABSOLUTE' and len(args) == 1:
+            return args[0]
+        if name in ('MAX', 'MIN') and len(args) == 2:
+            return max(args) if name == 'MAX' else min(args)
+        if name == 'ALIGN' and len(args) == 2 and args[1] > 0:
+            return -(-args[0] // args[1]) * args[1]
+        # One-argument ALIGN() and friends depend on the location counter
+        raise ExpressionEvaluationError(
+            f"Unsupported function {name}() with {len(args)} argument(s)")
 
-        # Use safe arithmetic evaluation instead of eval
+    def test_condition(self, condition) -> bool:
+        """Conditions that cannot be evaluated count as false"""
         try:
-            return self._safe_arithmetic_eval(expr)
-        except (ValueError, ArithmeticError):
-            pass
-
-        # Try to parse as single number
-        if expr.startswith("0x") or expr.startswith("0X"):
-            return int(expr, 16)
-        if expr.startswith("0") and len(expr) > 1:
-            return int(expr, 8)
-        return int(expr, 10)
-
-    def _safe_arithmetic_eval(self, expr: str) -> int:
-        """Safely evaluate arithmetic expressions without using eval"""
-        # Only allow safe arithmetic characters (<< >> bitshift and & | ^ ~
-        # bitwise ops — ESP-IDF memory.ld sizes segments with the alignment
-        # idiom (x + 7) & ~7).
-        if not re.match(r"^[0-9+\-*/<>()&|^~ \t]+$", expr):
-            raise ValueError(f"Invalid characters in expression: {expr}")
-
-        # Use a simple recursive descent parser for arithmetic
-        return self._parse_expression(expr.replace(" ", "").replace("\t", ""))
-
-    def _parse_expression(self, expr: str) -> int:
-        """Parse arithmetic expression using recursive descent"""
-        return _ArithmeticParser(expr).parse()
-
-    def _resolve_size_suffixes(self, expr: str) -> str:
-        """Resolve size suffixes (K, M, G) in expressions"""
-        # Handle size multipliers in expressions
-        multipliers = {
-            "K": 1024,
-            "M": 1024 * 1024,
-            "G": 1024 * 1024 * 1024,
-            "KB": 1024,
-            "MB": 1024 * 1024,
-            "GB": 1024 * 1024 * 1024,
-        }
-
-        # Pattern to match numbers with suffixes: 256K, 1M, etc.
-        pattern = r"(\d+)\s*([KMG]B?)\b"
-
-        def replace_suffix(match):
-            number = int(match.group(1))
-            suffix = match.group(2).upper()
-            return str(number * multipliers[suffix])
-
-        return re.sub(pattern, replace_suffix, expr, flags=re.IGNORECASE)
+            return bool(condition(self))
+        except (ExpressionEvaluationError, ExpressionError):
+            return False
 
 
 class VariableExtractor:  # pylint: disable=too-few-public-methods
     """Extracts and manages variables from linker scripts"""
 
-    def __init__(self, evaluator: ExpressionEvaluator):
+    def __init__(self, evaluator: ExpressionEvaluator,
+                 sources: Optional["ScriptSources"] = None):
         self.evaluator = evaluator
+        self.sources = sources if sources is not None else ScriptSources()
         self.variables: Dict[str, Any] = {}
+        self._reported_cycles: Set[str] = set()
 
     def extract_from_script(self, script_path: str) -> None:
         """Extract variable definitions from a linker script"""
-        with open(script_path, "r", encoding="utf-8", errors="replace") as f:
-            content = f.read()
-
-        # Inline INCLUDE directives before any other preprocessing
-        content = ScriptContentCleaner.resolve_includes(
-            content, os.path.dirname(os.path.abspath(script_path)))
-
-        # Remove comments and preprocessor directives
-        content = ScriptContentCleaner.clean_content(content)
-
-        # Strip SECTIONS blocks so we only extract config variables
+        # INCLUDEs inlined, comments and preprocessor directives removed,
+        # and SECTIONS blocks stripped so we only extract config variables
         # (not linker symbols like __bss_start__ defined inside SECTIONS)
-        content = ScriptContentCleaner.strip_sections_content(content)
+        content = self.sources.cleaned(script_path, strip_sections=True)
 
         # Find variable assignments: var_name = value;
         var_pattern = r"([A-Za-z_][A-Za-z0-9_]*)\s*=\s*([^;]+);"
@@ -940,32 +561,41 @@ class VariableExtractor:  # pylint: disable=too-few-public-methods
         self.variables.update(simple_vars)
         self.evaluator.add_variables(self.variables)
 
-        # Multiple passes to resolve complex variables that depend on other
-        # variables
-        max_iterations = 10  # Increased for more complex dependencies
-        for _ in range(max_iterations):
-            resolved_any = False
-            unresolved_vars = {}
-
-            for var_name, var_value in complex_vars.items():
-                try:
-                    evaluated_value = self.evaluator.evaluate_expression(
-                        var_value, set()
-                    )
-                    self.variables[var_name] = evaluated_value
-                    self.evaluator.add_variables({var_name: evaluated_value})
-                    resolved_any = True
-                except (ExpressionEvaluationError, ValueError):
-                    unresolved_vars[var_name] = var_value
-
-            complex_vars = unresolved_vars
-
-            # If we didn't resolve any variables in this iteration, break
-            if not resolved_any:
-                break
+        # Resolve complex variables once each, after the variables they
+        # reference. Self references read the previous value, if any.
+        dependencies = {}
+        for var_name, var_value in complex_vars.items():
+            try:
+                symbols = self.evaluator.compile(var_value).symbols
+            except ExpressionEvaluationError:
+                symbols = frozenset()
+            dependencies[var_name] = symbols - {var_name}
+        order, cycles = dependency_order(dependencies)
+
+        in_cycle = set()
+        for cycle in cycles:
+            in_cycle.update(cycle)
+            chain = " -> ".join(cycle)
+            if chain not in self._reported_cycles:
+                self._reported_cycles.add(chain)
+                logger.warning("Circular variable reference in %s: %s",
+                               script_path, chain)
+
+        unresolved_vars = {}
+        for var_name in order:
+            var_value = complex_vars[var_name]
+            if var_name in in_cycle:
+                unresolved_vars[var_name] = var_value
+                continue
+            try:
+                evaluated_value = self.evaluator.evaluate_expression(var_value)
+                self.variables[var_name] = evaluated_value
+                self.evaluator.add_variables({var_name: evaluated_value})
+            except (ExpressionEvaluationError, ValueError):
+                unresolved_vars[var_name] = var_value
 
         # Store any remaining unresolved variables as strings
-        for var_name, var_value in complex_vars.items():
+        for var_name, var_value in unresolved_vars.items():
             if var_name not in self.variables:
                 self.variables[var_name] = var_value
 
@@ -1165,8 +795,10 @@ class MemoryRegionBuilder:  # pylint: disable=too-few-public-methods
 class LinkerScriptParser:  # pylint: disable=too-few-public-methods,too-many-instance-attributes
     """Main parser orchestrator for linker script files"""
 
-    def __init__(self, ld_scripts: List[str], elf_file: Optional[str] = None,
-                 user_variables: Optional[Dict[str, Any]] = None):
+    def __init__(self, ld_scripts: List[str], elf_file: Optional[str] = None,  # pylint: disable=too-many-arguments,too-many-positional-arguments
+                 user_variables: Optional[Dict[str, Any]] = None,
+                 elf_context: Optional[ELFContext] = None,
+                 script_sources: Optional[ScriptSources] = None):
         """Initialize the parser with linker script paths and optional ELF file
 
         Args:
@@ -1174,9 +806,15 @@ class LinkerScriptParser:  # pylint: disable=too-few-public-methods,too-many-ins
             elf_file: Optional path to ELF file for architecture detection
             user_variables: Optional dict of user-defined variables to use during parsing
                           (e.g., {'__micropy_flash_size__': '4096K', 'RAM_START': '0x20000000'})
+            elf_context: Optional already opened ELF to read the architecture
+                from instead of opening ``elf_file`` again
+            script_sources: Optional script cache shared with other parsers
+                of the same run, so common INCLUDEs are read only once
         """
         self.ld_scripts = [str(Path(script).resolve())
                            for script in ld_scripts]
+        if not elf_file and elf_context is not None:
+            elf_file = elf_context.elf_path
         self.elf_file = str(Path(elf_file).resolve()) if elf_file else None
         self._validate_scripts()
 
@@ -1184,7 +822,10 @@ class LinkerScriptParser:  # pylint: disable=too-few-public-methods,too-many-ins
         self.elf_info = None
         self.parsing_strategy = {}
         if self.elf_file:
-            self.elf_info = get_architecture_info(self.elf_file)
+            if elf_context is not None:
+                self.elf_info = ELFParser.parse_elffile(elf_context, self.elf_file)
+            else:
+                self.elf_info = get_architecture_info(self.elf_file)
             if self.elf_info:
                 self.parsing_strategy = get_linker_parsing_strategy(
                     self.elf_info)
@@ -1197,8 +838,9 @@ class LinkerScriptParser:  # pylint: disable=too-few-public-methods,too-many-ins
                     self.elf_file)
 
         # Initialize components
+        self.sources = script_sources if script_sources is not None else ScriptSources()
         self.evaluator = ExpressionEvaluator()
-        self.variable_extractor = VariableExtractor(self.evaluator)
+        self.variable_extractor = VariableExtractor(self.evaluator, self.sources)
         self.region_builder = MemoryRegionBuilder(self.evaluator)
 
         # Apply architecture-specific default variables
@@ -1247,8 +889,7 @@ class LinkerScriptParser:  # pylint: disable=too-few-public-methods,too-many-ins
         self._keil_scripts = set()
         gnu_scripts = []
         for script_path in self.ld_scripts:
-            with open(script_path, "r", encoding="utf-8", errors="replace") as f:
-                content = f.read()
+            content = self.sources.read(script_path)
             if LinkerFormatDetector.is_emproject(content):
                 self._emproject_scripts.add(script_path)
             elif LinkerFormatDetector.is_icf(content):
@@ -1356,8 +997,7 @@ class LinkerScriptParser:  # pylint: disable=too-few-public-methods,too-many-ins
             Tuple of (parsed_regions, failed_matches)
             ICF and .emProject files always return an empty failed_matches list.
         """
-        with open(script_path, "r", encoding="utf-8", errors="replace") as f:
-            content = f.read()
+        content = self.sources.read(script_path)
 
         # Auto-detect SEGGER ES .emProject XML and delegate
         if LinkerFormatDetector.is_emproject(content):
@@ -1371,13 +1011,9 @@ class LinkerScriptParser:  # pylint: disable=too-few-public-methods,too-many-ins
         if LinkerFormatDetector.is_keil(content):
             return self._parse_keil_script(script_path), []
 
-        # GNU LD path (existing logic)
-        # Inline INCLUDE directives before cleaning/scanning
-        content = ScriptContentCleaner.resolve_includes(
-            content, os.path.dirname(os.path.abspath(script_path)))
-
-        # Remove comments and normalize whitespace
-        content = ScriptContentCleaner.clean_content(content)
+        # GNU LD path: INCLUDEs inlined, comments removed, whitespace
+        # normalized
+        content = self.sources.cleaned(script_path)
 
         # Find all MEMORY blocks (case insensitive). Multiple blocks arise from
         # INCLUDE chains where an outer script overrides / augments an included
@@ -1,8 +1,12 @@
 """Utility modules for MemBrowse CLI."""
 
-from . import git
-from . import url
-from . import formatter
-from . import github_common
+from .lazy import lazy_exports
+
+__getattr__, __dir__ = lazy_exports(__name__, {
+    'git': '.git',
+    'url': '.url',
+    'formatter': '.formatter',
+    'github_common': '.github_common',
+})
 
 __all__ = ['git', 'url', 'formatter', 'github_common']
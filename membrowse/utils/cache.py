@@ -0,0 +1,178 @@
+"""On-disk content-addressed cache utilities.
+
+Entries are small JSON documents keyed by a SHA-256 of their inputs and
+stored under ``<cache_dir>/<namespace>/<key[:2]>/<key>.json``. The default
+cache directory is ``$XDG_CACHE_HOME/membrowse`` (``~/.cache/membrowse``).
+Writes are atomic, and unreadable or corrupt entries are treated as misses,
+so the cache directory can be deleted at any time.
+
+Long-running processes (``membrowse serve``) can additionally keep recently
+used entries in memory with :meth:`ContentCache.keep_in_memory`. A cache
+without a directory then lives in memory only.
+"""
+
+import hashlib
+import json
+import logging
+import os
+import tempfile
+import threading
+from collections import OrderedDict
+from pathlib import Path
+from typing import Any, Optional
+
+logger = logging.getLogger(__name__)
+
+
+def default_cache_dir() -> Path:
+    """Return ``$XDG_CACHE_HOME/membrowse``, falling back to ``~/.cache``."""
+    base = os.environ.get('XDG_CACHE_HOME') or os.path.join(
+        os.path.expanduser('~'), '.cache')
+    return Path(base) / 'membrowse'
+
+
+def cache_dir_from_args(args) -> Optional[str]:
+    """Resolve the ``--cache`` / ``--cache-dir`` CLI options.
+
+    Returns:
+        Cache directory path, or None when on-disk caching is disabled
+    """
+    cache_dir = getattr(args, 'cache_dir', None)
+    if cache_dir:
+        return cache_dir
+    if getattr(args, 'cache', False):
+        return str(default_cache_dir())
+    return None
+
+
+class ContentCache:
+    """JSON value store addressed by content hash."""
+
+    # Serialized entries shared by all instances, most recently used last;
+    # disabled until keep_in_memory() sets a budget. Entries are stored as
+    # JSON text so callers can modify the values they get.
+    _memory: 'OrderedDict[str, str]' = OrderedDict()
+    _memory_bytes = 0
+    _memory_limit = 0
+    _lock = threading.Lock()
+
+    def __init__(self, root: Optional[str], namespace: str):
+        """
+        Args:
+            root: Cache root directory (created on first write), or None to
+                use only the memory layer
+            namespace: Subdirectory separating independent caches
+        """
+        self.directory = Path(root) / namespace if root else None
+        self._namespace = namespace
+        self._write_failed = False
+
+    @classmethod
+    def enabled(cls, root: Optional[str]) -> bool:
+        """Whether a cache under ``root`` (None = memory only) can hold entries."""
+        return bool(root) or cls._memory_limit > 0
+
+    @staticmethod
+    def make_key(*parts: bytes) -> str:
+        """Hash ``parts`` into a cache key.
+
+        Each part is length-prefixed so that different splits of the same
+        bytes never collide.
+        """
+        digest = hashlib.sha256()
+        for part in parts:
+            digest.update(len(part).to_bytes(8, 'little'))
+            digest.update(part)
+        return digest.hexdigest()
+
+    def _path(self, key: str) -> Path:
+        return self.directory / key[:2] / f"{key}.json"
+
+    def _memory_key(self, key: str) -> str:
+        # Keys hash the content, so entries are shared by all roots
+        return f"{self._namespace}/{key}"
+
+    @classmethod
+    def keep_in_memory(cls, max_bytes: int) -> None:
+        """Keep up to ``max_bytes`` of serialized entries in memory.
+
+        Applies to every cache of the process; 0 disables the memory layer.
+        """
+        with cls._lock:
+            cls._memory_limit = max_bytes
+            cls._evict()
+
+    @classmethod
+    def clear_memory(cls) -> None:
+        """Drop the in-memory entries shared by all instances."""
+        with cls._lock:
+            cls._memory.clear()
+            cls._memory_bytes = 0
+
+    @classmethod
+    def _evict(cls) -> None:
+        while cls._memory and cls._memory_bytes > cls._memory_limit:
+            _, text = cls._memory.popitem(last=False)
+            cls._memory_bytes -= len(text)
+
+    @classmethod
+    def _remember(cls, memory_key: str, text: str) -> None:
+        if len(text) > cls._memory_limit:
+            return
+        with cls._lock:
+            previous = cls._memory.pop(memory_key, None)
+            if previous is not None:
+                cls._memory_bytes -= len(previous)
+            cls._memory[memory_key] = text
+            cls._memory_bytes += len(text)
+            cls._evict()
+
+    def get(self, key: str) -> Optional[Any]:
+        """Return the value stored under ``key``, or None on a miss."""
+        memory_key = self._memory_key(key)
+        text = None
+        if self._memory_limit:
+            with self._lock:
+                text = self._memory.get(memory_key)
+                if text is not None:
+                    self._memory.move_to_end(memory_key)
+        if text is None and self.directory is None:
+            return None
+        try:
+            if text is None:
+                with open(self._path(key), 'r', encoding='utf-8') as f:
+                    text = f.read()
+                if self._memory_limit:
+                    self._remember(memory_key, text)
+            value = json.loads(text)
+        except FileNotFoundError:
+            return None
+        except (OSError, ValueError) as e:
+            logger.debug("Ignoring unreadable cache entry %s: %s", key, e)
+            return None
+        return value
+
+    def put(self, key: str, value: Any) -> None:
+        """Store ``value`` under ``key``. Write failures are logged, not raised."""
+        text = json.dumps(value, separators=(',', ':'))
+        if self._memory_limit:
+            self._remember(self._memory_key(key), text)
+        if self.directory is None:
+            return
+        path = self._path(key)
+        try:
+            path.parent.mkdir(parents=True, exist_ok=True)
+            fd, tmp_path = tempfile.mkstemp(dir=path.parent, suffix='.tmp')
+            try:
+                with os.fdopen(fd, 'w', encoding='utf-8') as f:
+                    f.write(text)
+                os.replace(tmp_path, path)
+            except BaseException:
+                os.unlink(tmp_path)
+                raise
+        except OSError as e:
+            # Warn once per cache: a read-only or full disk would otherwise
+            # log for every entry.
+            if not self._write_failed:
+                logger.warning("Cannot write cache under %s: %s", self.directory, e)
+                self._write_failed = True
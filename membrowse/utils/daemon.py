@@ -0,0 +1,133 @@
+"""
+Client side of the ``membrowse serve`` report daemon.
+
+The daemon listens on a Unix domain socket (``serve.sock`` in the cache
+directory, or ``$MEMBROWSE_SOCKET``). Each connection carries one request
+and one response, both a single line of JSON:
+
+.. code-block:: json
+
+    {"command": "report", "version": "1.2.9", "cwd": "/src/fw",
+     "log_level": 20, "options": {"elf_path": "build/fw.elf"}}
+
+    {"ok": true, "report": {}, "logs": [["membrowse.commands.report", 20, "..."]]}
+
+A failed analysis answers ``{"ok": false, "error": "..."}``. Requests from
+a different membrowse version are refused, and the client then analyzes
+locally.
+"""
+
+import json
+import logging
+import os
+import socket
+from pathlib import Path
+from typing import Any, Dict, Optional
+
+from .cache import default_cache_dir
+
+logger = logging.getLogger(__name__)
+
+SOCKET_ENV = 'MEMBROWSE_SOCKET'
+
+# Seconds to wait for the daemon to accept a connection
+CONNECT_TIMEOUT = 1.0
+
+
+class DaemonUnavailable(Exception):
+    """No compatible daemon answered on the socket."""
+
+
+def daemon_supported() -> bool:
+    """Whether this platform has Unix domain sockets."""
+    return hasattr(socket, 'AF_UNIX')
+
+
+def socket_path() -> Path:
+    """Daemon socket: ``$MEMBROWSE_SOCKET`` or ``<cache dir>/serve.sock``."""
+    return Path(os.environ.get(SOCKET_ENV) or default_cache_dir() / 'serve.sock')
+
+
+def package_version() -> str:
+    """Installed membrowse version; client and daemon must agree on it."""
+    # pylint: disable-next=import-outside-toplevel
+    from importlib.metadata import version, PackageNotFoundError
+    try:
+        return version('membrowse')
+    except PackageNotFoundError:
+        return 'unknown'
+
+
+def send_request(request: Dict[str, Any], path: Optional[Path] = None,
+                 timeout: Optional[float] = None) -> Dict[str, Any]:
+    """Send one request to the daemon and return its response.
+
+    Args:
+        request: JSON-serializable request
+        path: Socket path (default: :func:`socket_path`)
+        timeout: Seconds to wait for the response (None waits for as long
+            as the analysis takes)
+
+    Raises:
+        DaemonUnavailable: If no daemon is listening or the exchange fails
+    """
+    path = path or socket_path()
+    if not daemon_supported() or not path.exists():
+        raise DaemonUnavailable(f"no daemon socket at {path}")
+    try:
+        with socket.socket(socket.AF_UNIX, socket.SOCK_STREAM) as sock:  # pylint: disable=no-member
+            sock.settimeout(CONNECT_TIMEOUT)
+            sock.connect(str(path))
+            sock.settimeout(timeout)
+            sock.sendall(json.dumps(request).encode('utf-8') + b'\n')
+            with sock.makefile('rb') as stream:
+                line = stream.readline()
+    except OSError as e:
+        raise DaemonUnavailable(f"cannot reach daemon at {path}: {e}") from e
+    try:
+        response = json.loads(line)
+    except ValueError as e:
+        raise DaemonUnavailable(f"invalid daemon response: {e}") from e
+    if not isinstance(response, dict):
+        raise DaemonUnavailable("invalid daemon response")
+    return response
+
+
+def request_report(options: Dict[str, Any]) -> Optional[Dict[str, Any]]:
+    """Generate a report in the running daemon.
+
+    Args:
+        options: Keyword arguments for ``generate_report()``; relative
+            paths are resolved against the current directory
+
+    Returns:
+        The report, or None when no compatible daemon is running (the
+        caller then analyzes locally)
+
+    Raises:
+        ValueError: If the daemon ran the analysis and it failed
+    """
+    request = {
+        'command': 'report',
+        'version': package_version(),
+        'cwd': os.getcwd(),
+        'log_level': logging.getLogger('membrowse').getEffectiveLevel(),
+        'options': options,
+    }
+    try:
+        response = send_request(request)
+    except DaemonUnavailable as e:
+        logger.debug("Not using membrowse serve: %s", e)
+        return None
+
+    # Messages the analysis logged in the daemon
+    for name, level, message in response.get('logs', []):
+        logging.getLogger(name).log(level, "%s", message)
+
+    if response.get('ok'):
+        logger.debug("Report generated by membrowse serve (pid %s)", response.get('pid'))
+        return response['report']
+    if response.get('incompatible'):
+        logger.info("Ignoring membrowse serve: %s", response.get('error'))
+        return None
+    raise ValueError(response.get('error', 'daemon request failed'))
@@ -2,8 +2,11 @@
 Human-readable formatting utilities for memory reports.
 """
 
+import heapq
 from typing import Dict, List, Any
 
+from .region_index import RegionIndex
+
 
 def _format_bytes(num_bytes: int) -> str:
     """Format bytes into human-readable format (KB, MB, etc.)."""
@@ -87,25 +90,11 @@ def _detect_parent_child_relationships(memory_layout: Dict[str, Any]) -> Dict[st
     Returns:
         Dictionary mapping parent region names to list of child region names
     """
-    regions = _extract_region_ranges(memory_layout)
-
-    # Find parent-child relationships
+    index = RegionIndex((name, address, end_address)
+                        for name, address, end_address, _ in
+                        _extract_region_ranges(memory_layout))
     # A region is a parent if another region is completely contained within it
-    parent_to_children = {}
-
-    for name1, addr1, end1, size1 in regions:
-        children = []
-        for name2, addr2, end2, size2 in regions:
-            if name1 == name2:
-                continue
-            # Check if region2 is completely contained in region1
-            if addr1 <= addr2 and end2 <= end1 and size2 < size1:
-                children.append(name2)
-
-        if children:
-            parent_to_children[name1] = children
-
-    return parent_to_children
+    return index.parent_to_children
 
 
 def _calculate_parent_used_size(
@@ -364,16 +353,14 @@ def _format_top_symbols(  # pylint: disable=too-many-locals,too-many-branches
     has_archive_info = any(s.get('archive', '') for s in symbols)
     has_object_info = any(s.get('object_file', '') for s in symbols)
 
-    # Sort by size descending
-    sorted_symbols = sorted(
-        symbols,
-        key=lambda x: x.get('size', 0),
-        reverse=True
-    )
+    # Largest first; only top_n are selected unless show_all is True
+    def size_of(symbol):
+        return symbol.get('size', 0)
 
-    # Limit to top_n unless show_all is True
-    if not show_all:
-        sorted_symbols = sorted_symbols[:top_n]
+    if show_all:
+        sorted_symbols = sorted(symbols, key=size_of, reverse=True)
+    else:
+        sorted_symbols = heapq.nlargest(top_n, symbols, key=size_of)
 
     # Header
     header = (
@@ -441,3 +428,96 @@ def format_report_human_readable(report: Dict[str, Any], show_all_symbols: bool
     ]
 
     return "\n".join(sections)
+
+
+def _format_delta(delta: int) -> str:
+    return f"{delta:+,}"
+
+
+def _format_diff_table(title: str, rows: List[List[str]], header: List[str],
+                       numeric: int) -> List[str]:
+    """Text table whose last ``numeric`` columns are right-aligned."""
+    lines = [title, "-" * len(title)]
+    if not rows:
+        return lines + ["No changes.", ""]
+    widths = [max(len(row[i]) for row in rows + [header]) for i in range(len(header))]
+    first_numeric = len(header) - numeric
+    for row in [header] + rows:
+        cells = [cell.rjust(width) if i >= first_numeric else cell.ljust(width)
+                 for i, (cell, width) in enumerate(zip(row, widths))]
+        lines.append("  ".join(cells).rstrip())
+    lines.append("")
+    return lines
+
+
+def format_diff_human_readable(  # pylint: disable=too-many-locals
+    diff: Dict[str, Any], top_n: int = 20, show_all: bool = False
+) -> str:
+    """Format a :func:`~membrowse.core.diff.diff_reports` result.
+
+    Args:
+        diff: Result of ``diff_reports``
+        top_n: Number of largest symbol changes to show (ignored if show_all)
+        show_all: If True, show every symbol change
+
+    Returns:
+        Region, section, archive and symbol tables, largest change first
+    """
+    changes = diff.get('changes', {})
+    title = f"Memory Changes: {diff.get('base')} -> {diff.get('head')}"
+    lines = [title, "=" * len(title), ""]
+
+    def entries(category, kinds=('modified', 'added', 'removed')):
+        data = changes.get(category, {})
+        return [(kind, entry) for kind in kinds for entry in data.get(kind, [])]
+
+    def old_value(kind, entry, field):
+        if kind == 'added':
+            return 0
+        return entry['old'][field] if kind in ('modified', 'moved') else entry.get(field, 0)
+
+    def new_value(kind, entry, field):
+        return 0 if kind == 'removed' else entry.get(field, 0)
+
+    region_rows = []
+    for kind, entry in entries('regions'):
+        limit = entry.get('limit_size', 0)
+        region_rows.append([
+            entry['name'], f"{old_value(kind, entry, 'used_size'):,}",
+            f"{new_value(kind, entry, 'used_size'):,}", _format_delta(entry['delta']),
+            f"{limit:,}" if limit else "-"])
+    lines += _format_diff_table("Regions", region_rows,
+                                ["Region", "Base", "Head", "Delta", "Limit"], 4)
+
+    section_rows = [[entry['region'], entry['name'], f"{old_value(kind, entry, 'size'):,}",
+                     f"{new_value(kind, entry, 'size'):,}", _format_delta(entry['delta'])]
+                    for kind, entry in entries('sections')]
+    lines += _format_diff_table("Sections", section_rows,
+                                ["Region", "Section", "Base", "Head", "Delta"], 3)
+
+    archive_rows = [[entry['name'], f"{old_value(kind, entry, 'size'):,}",
+                     f"{new_value(kind, entry, 'size'):,}", _format_delta(entry['delta'])]
+                    for kind, entry in entries('archives')]
+    if archive_rows:
+        lines += _format_diff_table("Archives", archive_rows,
+                                    ["Archive", "Base", "Head", "Delta"], 3)
+
+    symbols = sorted(entries('symbols', ('modified', 'moved', 'added', 'removed')),
+                     key=lambda item: (-abs(item[1]['delta']), item[1]['name']))
+    counts = ", ".join(f"{len(changes.get('symbols', {}).get(kind, []))} {kind}"
+                       for kind in ('added', 'removed', 'modified', 'moved'))
+    if not show_all:
+        symbols = symbols[:top_n]
+    symbol_rows = []
+    for kind, entry in symbols:
+        name = entry['name']
+        if kind == 'moved' and entry['old']['name'] != name:
+            name = f"{entry['old']['name']} -> {name}"
+        if len(name) > 58:
+            name = name[:55] + "..."
+        symbol_rows.append([name, kind, entry.get('section', ''),
+                            entry.get('source_file') or entry.get('object_file', ''),
+                            _format_delta(entry['delta'])])
+    lines += _format_diff_table(f"Symbols ({counts})", symbol_rows,
+                                ["Name", "Change", "Section", "Source", "Delta"], 1)
+    return "\n".join(lines)
@@ -4,9 +4,10 @@ import os
 import re
 import subprocess
 import json
+import threading
 from dataclasses import dataclass
 from datetime import datetime
-from typing import Optional, Dict, Any
+from typing import Optional, Dict, Any, Iterable, List
 
 # GitHub's sentinel 'before' SHA for branch creation / first push (not a commit).
 _ZERO_SHA = '0' * 40
@@ -14,6 +15,11 @@ _ZERO_SHA = '0' * 40
 # Matches a full 40-character hex git SHA-1.
 _FULL_SHA1_RE = re.compile(r'[0-9a-f]{40}')
 
+# One record per commit: fields separated by NUL, then the --name-only paths.
+# Merges are diffed against their first parent, like `git diff <sha>~1 <sha>`.
+_BATCH_LOG_FORMAT = '--format=%x1e%H%x00%P%x00%cI%x00%an%x00%ae%x00%B%x00'
+_RECORD_SEPARATOR = '\x1e'
+
 
 def _is_full_sha1(value: str) -> bool:
     """Return True if value is a 40-character hex git SHA-1."""
@@ -45,29 +51,78 @@ def run_git_command(command: list) -> Optional[str]:
         return None
 
 
-def git_checkout(ref: str) -> None:
+def git_checkout(ref: str, cwd: Optional[str] = None) -> None:
     """Checkout a git ref. Raises RuntimeError on failure."""
     result = subprocess.run(
         ['git', 'checkout', ref, '--quiet'],
         capture_output=True,
-        check=False
+        check=False,
+        cwd=cwd
     )
     if result.returncode != 0:
         raise RuntimeError(f"Failed to checkout {ref}")
 
 
-def git_submodule_update() -> None:
+def git_submodule_update(cwd: Optional[str] = None) -> None:
     """Update submodules to match the current checkout."""
     subprocess.run(
         ['git', 'submodule', 'update', '--init', '--recursive', '--quiet'],
-        capture_output=True, check=False
+        capture_output=True, check=False, cwd=cwd
     )
 
 
-def git_clean() -> None:
+def git_submodule_update_changed(cwd: Optional[str] = None) -> None:
+    """Update only submodules whose checkout differs from the commit's gitlink.
+
+    Uninitialized submodules are initialized. Submodules that are already at
+    the recorded commit, and their build output, are left alone.
+    """
+    status = subprocess.run(
+        ['git', 'submodule', 'status'],
+        capture_output=True, text=True, check=False, cwd=cwd
+    )
+    if status.returncode != 0:
+        git_submodule_update(cwd=cwd)
+        return
+    paths = []
+    for line in status.stdout.splitlines():
+        # "<flag><sha> <path>[ (<describe>)]", flag is ' ', '+', '-' or 'U'
+        if line[:1] not in ('+', '-', 'U') or ' ' not in line:
+            continue
+        path = line[1:].split(' ', 1)[1]
+        if path.endswith(')') and ' (' in path:
+            path = path.rsplit(' (', 1)[0]
+        paths.append(path)
+    if paths:
+        subprocess.run(
+            ['git', 'submodule', 'update', '--init', '--recursive', '--quiet', '--'] + paths,
+            capture_output=True, check=False, cwd=cwd
+        )
+
+
+def git_clean(cwd: Optional[str] = None) -> None:
     """Remove all untracked and gitignored files (full clean build)."""
     subprocess.run(
         ['git', 'clean', '-fdx'],
+        capture_output=True, check=False, cwd=cwd
+    )
+
+
+def git_worktree_add(path: str) -> None:
+    """Create a detached worktree of HEAD at path. Raises RuntimeError on failure."""
+    result = subprocess.run(
+        ['git', 'worktree', 'add', '--detach', '--quiet', path, 'HEAD'],
+        capture_output=True,
+        check=False
+    )
+    if result.returncode != 0:
+        raise RuntimeError(f"Failed to create worktree at {path}")
+
+
+def git_worktree_remove(path: str) -> None:
+    """Remove a worktree created by git_worktree_add (best effort)."""
+    subprocess.run(
+        ['git', 'worktree', 'remove', '--force', path],
         capture_output=True, check=False
     )
 
@@ -386,12 +441,19 @@ def get_commit_metadata(commit_sha: str) -> Dict[str, Any]:
     """
     Get metadata for a specific commit.
 
+    Commits loaded with :meth:`CommitMetadataCache.prefetch` are served
+    from memory; others cost one git call per field.
+
     Args:
         commit_sha: Git commit SHA
 
     Returns:
         Dictionary with commit metadata.
     """
+    cached = CommitMetadataCache.get(commit_sha)
+    if cached is not None:
+        return cached
+
     metadata = {
         'commit_sha': commit_sha,
         'parent_sha': None,
@@ -431,3 +493,116 @@ def get_commit_metadata(commit_sha: str) -> Dict[str, Any]:
     metadata['tags'] = get_commit_tags(commit_sha)
 
     return metadata
+
+
+class CommitMetadataCache:
+    """Metadata and changed paths of many commits, read in a few git calls.
+
+    Onboarding a long history would otherwise spawn several git processes
+    per commit (message, timestamp, author, tags, parent and a diff for
+    ``--build-dirs``). :meth:`prefetch` reads all of it for a commit list
+    with one ``git log --stdin`` and one ``git for-each-ref``; commits
+    that are not prefetched fall back to the per-commit queries. Entries are
+    keyed by full SHA, so they stay valid for the life of the process.
+    """
+
+    _entries: Dict[str, Dict[str, Any]] = {}
+    _lock = threading.Lock()
+
+    @classmethod
+    def prefetch(cls, commits: Iterable[str], cwd: Optional[str] = None) -> int:
+        """Load the metadata of ``commits`` (full SHAs) into memory.
+
+        Args:
+            commits: Commit SHAs, e.g. the onboard commit list
+            cwd: Repository directory (default: current directory)
+
+        Returns:
+            Number of commits loaded; 0 if git failed, in which case
+            lookups fall back to per-commit queries
+        """
+        with cls._lock:
+            wanted = list(dict.fromkeys(c for c in commits if c and c not in cls._entries))
+        if not wanted:
+            return 0
+        try:
+            result = subprocess.run(
+                ['git', 'log', '--no-walk=unsorted', '--stdin', '-m', '--first-parent',
+                 '--name-only', _BATCH_LOG_FORMAT],
+                input='\n'.join(wanted) + '\n', capture_output=True,
+                encoding='utf-8', errors='replace', check=False, cwd=cwd)
+        except OSError:
+            return 0
+        if result.returncode != 0:
+            return 0
+
+        tags = _tags_by_commit(cwd)
+        entries = {}
+        for record in result.stdout.split(_RECORD_SEPARATOR)[1:]:
+            fields = record.split('\0', 6)
+            if len(fields) != 7:
+                continue
+            sha, parents, timestamp, author_name, author_email, message, paths = fields
+            entries[sha] = {
+                'commit_sha': sha,
+                'parent_sha': parents.split()[0] if parents.split() else None,
+                'commit_message': message.strip() or 'Unknown commit message',
+                'commit_timestamp': (timestamp.strip() or
+                                     datetime.utcnow().strftime('%Y-%m-%dT%H:%M:%SZ')),
+                'author_name': author_name.strip() or 'Unknown',
+                'author_email': author_email.strip() or 'unknown@example.com',
+                'tags': tags.get(sha, []),
+                'changed_paths': [path.strip() for path in paths.splitlines()
+                                  if path.strip()],
+            }
+        with cls._lock:
+            cls._entries.update(entries)
+        return len(entries)
+
+    @classmethod
+    def get(cls, commit_sha: str) -> Optional[Dict[str, Any]]:
+        """Metadata of a prefetched commit (as :func:`get_commit_metadata`), or None."""
+        with cls._lock:
+            entry = cls._entries.get(commit_sha)
+        if entry is None:
+            return None
+        metadata = {key: value for key, value in entry.items() if key != 'changed_paths'}
+        metadata['tags'] = list(entry['tags'])
+        return metadata
+
+    @classmethod
+    def changed_paths(cls, commit_sha: str) -> Optional[List[str]]:
+        """Paths changed relative to the first parent, or None if not prefetched."""
+        with cls._lock:
+            entry = cls._entries.get(commit_sha)
+        return list(entry['changed_paths']) if entry is not None else None
+
+    @classmethod
+    def clear(cls) -> None:
+        """Drop every prefetched commit."""
+        with cls._lock:
+            cls._entries.clear()
+
+
+def _tags_by_commit(cwd: Optional[str] = None) -> Dict[str, List[str]]:
+    """Map commit SHAs to the tags pointing at them (``git tag --points-at``)."""
+    try:
+        result = subprocess.run(
+            ['git', 'for-each-ref', '--format=%(objectname) %(*objectname) %(refname)',
+             'refs/tags'],
+            capture_output=True, encoding='utf-8', errors='replace', check=False, cwd=cwd)
+    except OSError:
+        return {}
+    tags: Dict[str, List[str]] = {}
+    if result.returncode != 0:
+        return tags
+    for line in result.stdout.splitlines():
+        parts = line.split(' ', 2)
+        if len(parts) != 3:
+            continue
+        target, peeled, ref = parts
+        name = ref[len('refs/tags/'):]
+        # Annotated tags point at a tag object; the commit is the peeled object
+        for sha in {target, peeled} - {''}:
+            tags.setdefault(sha, []).append(name)
+    return tags
@@ -13,6 +13,7 @@ from jinja2 import TemplateError as Jinja2TemplateError
 from .summary_formatter import (
     build_summary_template_context,
     enrich_regions, enrich_sections, process_alerts, render_jinja2_template,
+    symbol_changes,
 )
 from .github_common import (
     is_gh_cli_available,
@@ -148,12 +149,7 @@ def _build_template_context(results: list[dict]) -> dict:  # pylint: disable=too
         regions = enrich_regions(changes_data.get('regions', {}))
         sections, sections_by_region = enrich_sections(changes_data.get('sections', {}))
 
-        symbols = {
-            'added': symbols_data.get('added', []),
-            'removed': symbols_data.get('removed', []),
-            'modified': symbols_data.get('modified', []),
-            'moved': symbols_data.get('moved', []),
-        } if symbols_data else {'added': [], 'removed': [], 'modified': [], 'moved': []}
+        symbols = symbol_changes(symbols_data)
 
         targets.append({
             'name': result.get('target_name', 'Unknown'),
@@ -282,7 +278,8 @@ def main():
     Supports three modes:
     - Summary mode: reads /summary API JSON, extracts PR number, renders and posts
     - Body mode: posts pre-rendered content (e.g., from 'membrowse summary')
-    - File mode: reads JSON result files from --output-raw-response
+    - File mode: reads JSON result files from --output-raw-response (a
+      single result, or the result list of ``report --manifest``)
     """
     parser = argparse.ArgumentParser(
         description='Post combined MemBrowse PR comment from multiple target results'
@@ -370,7 +367,11 @@ def _handle_file_mode(parser, args):
         try:
             with open(filepath, 'r', encoding='utf-8') as f:
                 data = json.load(f)
-                results.append(data)
+                # `report --manifest` writes all targets' results to one file
+                if isinstance(data, list):
+                    results.extend(data)
+                else:
+                    results.append(data)
                 logger.debug("Loaded result from %s", filepath)
         except (json.JSONDecodeError, IOError) as e:
             logger.warning("Failed to load %s: %s", filepath, e)
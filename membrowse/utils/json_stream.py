@@ -0,0 +1,42 @@
+"""Incremental JSON encoding for large reports.
+
+A report's symbol list can hold 100k entries, so encoding it with one
+``json.dumps`` call keeps the whole document in memory as a string (and
+again as bytes). :func:`iter_json` yields the same text in pieces instead,
+encoding long lists a batch at a time so that the C encoder still does the
+work.
+"""
+
+import json
+from typing import Any, Iterator
+
+# List items encoded per json.dumps call
+DEFAULT_BATCH_SIZE = 1000
+
+
+def iter_json(obj: Any, batch_size: int = DEFAULT_BATCH_SIZE) -> Iterator[str]:
+    """Yield the JSON text of ``obj`` in pieces.
+
+    The concatenated pieces are identical to ``json.dumps(obj)``.
+
+    Args:
+        obj: JSON-serializable value. Dicts are walked recursively and lists
+            longer than ``batch_size`` are encoded a batch at a time.
+        batch_size: Number of list items per encoded piece
+    """
+    if isinstance(obj, dict) and all(isinstance(key, str) for key in obj):
+        yield '{'
+        for index, (key, value) in enumerate(obj.items()):
+            yield (', ' if index else '') + json.dumps(key) + ': '
+            yield from iter_json(value, batch_size)
+        yield '}'
+    elif isinstance(obj, list) and len(obj) > batch_size:
+        yield '['
+        for start in range(0, len(obj), batch_size):
+            # Strip the brackets of each batch and join with the separator
+            # json.dumps would have used
+            batch = json.dumps(obj[start:start + batch_size])[1:-1]
+            yield (', ' if start else '') + batch
+        yield ']'
+    else:
+        yield json.dumps(obj)
@@ -0,0 +1,42 @@
+"""
+Lazy exports for package ``__init__`` modules.
+
+Importing any ``membrowse`` module runs the ``__init__`` of every package
+above it. If those imported their public names eagerly, ``membrowse
+summary`` and the comment action would load pyelftools, the demanglers
+and every linker parser without ever opening an ELF. Instead each package
+lists where its names live and the defining module is imported on first
+attribute access (PEP 562).
+"""
+
+import sys
+from importlib import import_module
+from typing import Any, Callable, Dict, List, Tuple
+
+
+def lazy_exports(package: str, exports: Dict[str, str]
+                 ) -> Tuple[Callable[[str], Any], Callable[[], List[str]]]:
+    """Module-level ``__getattr__`` and ``__dir__`` for ``package``.
+
+    Args:
+        package: ``__name__`` of the package
+        exports: Public name -> relative module defining it. A name whose
+            module is ``.<name>`` is the submodule itself.
+
+    Returns:
+        ``(__getattr__, __dir__)`` to assign in the package ``__init__``
+    """
+    def __getattr__(name: str) -> Any:
+        module_name = exports.get(name)
+        if module_name is None:
+            raise AttributeError(f"module {package!r} has no attribute {name!r}")
+        module = import_module(module_name, package)
+        value = module if module_name == f'.{name}' else getattr(module, name)
+        # Later lookups find the name without calling __getattr__
+        setattr(sys.modules[package], name, value)
+        return value
+
+    def __dir__() -> List[str]:
+        return sorted(set(vars(sys.modules[package])) | set(exports))
+
+    return __getattr__, __dir__
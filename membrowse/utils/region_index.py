@@ -0,0 +1,89 @@
+"""
+Nested-interval index over memory regions.
+
+Regions from linker scripts overlap and nest (``FLASH`` holding
+``FLASH_START`` and ``FLASH_FS``, ESP32 IRAM/DRAM aliases, i.MX RT
+FlexRAM banks). The index flattens them once into elementary address
+segments, each owning the smallest region covering it, so address lookups
+are a binary search. It also precomputes which regions contain which.
+"""
+
+import bisect
+from typing import Dict, Generic, Hashable, Iterable, List, Optional, Tuple, TypeVar
+
+K = TypeVar('K', bound=Hashable)
+
+
+class RegionIndex(Generic[K]):
+    """Smallest-region lookup and containment over ``[start, end)`` ranges.
+
+    Ties between equally sized regions go to the one with the lower start
+    address, then to the earlier one in input order.
+    """
+
+    def __init__(self, ranges: Iterable[Tuple[K, int, int]]):
+        """
+        Args:
+            ranges: (key, start, end) per region, in a stable order such as
+                the region dictionary's
+        """
+        self._ranges: List[Tuple[K, int, int]] = list(ranges)
+        self._parent_to_children: Optional[Dict[K, List[K]]] = None
+
+        by_start = sorted(self._ranges, key=lambda entry: entry[1])
+        bounds = sorted({bound for _, start, end in by_start if end > start
+                         for bound in (start, end)})
+        owners: List[Optional[K]] = [None] * max(len(bounds) - 1, 0)
+        sizes: List[int] = [0] * len(owners)
+        for key, start, end in by_start:
+            size = end - start
+            if size <= 0:
+                continue
+            first = bisect.bisect_left(bounds, start)
+            last = bisect.bisect_left(bounds, end)
+            for segment in range(first, last):
+                if owners[segment] is None or size < sizes[segment]:
+                    owners[segment] = key
+                    sizes[segment] = size
+        self._bounds = bounds
+        self._owners = owners
+
+    def smallest_containing(self, address: int) -> Optional[K]:
+        """Key of the smallest region containing ``address``, or None."""
+        segment = bisect.bisect_right(self._bounds, address) - 1
+        if 0 <= segment < len(self._owners):
+            return self._owners[segment]
+        return None
+
+    @property
+    def parent_to_children(self) -> Dict[K, List[K]]:
+        """Every region mapped to all smaller regions lying within it.
+
+        Parents and their children are listed in input order; regions
+        without children are omitted.
+        """
+        if self._parent_to_children is None:
+            self._parent_to_children = self._compute_containment()
+        return self._parent_to_children
+
+    def _compute_containment(self) -> Dict[K, List[K]]:
+        order = sorted(range(len(self._ranges)), key=lambda i: self._ranges[i][1])
+        starts = [self._ranges[i][1] for i in order]
+        parent_to_children = {}
+        for parent, (key, start, end) in enumerate(self._ranges):
+            size = end - start
+            children = []
+            # Candidates start within [start, end]; zero-size regions may sit
+            # right at the end
+            for pos in range(bisect.bisect_left(starts, start), len(order)):
+                child = order[pos]
+                _, child_start, child_end = self._ranges[child]
+                if child_start > end:
+                    break
+                if (child != parent and child_end <= end
+                        and child_end - child_start < size):
+                    children.append(child)
+            if children:
+                parent_to_children[key] = [self._ranges[child][0]
+                                           for child in sorted(children)]
+        return parent_to_children
@@ -7,8 +7,6 @@ this module (summary mode) and github_comment.py (file mode).
 from pathlib import Path
 from typing import Any
 
-from jinja2 import Environment, FileSystemLoader
-
 from .budget_alerts import iter_budget_alerts
 
 
@@ -61,6 +59,13 @@ def enrich_sections(sections_data: dict) -> tuple[list[dict], dict[str, list[dic
     return sections, sections_by_region
 
 
+def symbol_changes(symbols_data: dict | None) -> dict[str, list[dict]]:
+    """Symbol change lists, empty when the response has none."""
+    symbols_data = symbols_data or {}
+    return {kind: symbols_data.get(kind, [])
+            for kind in ('added', 'removed', 'modified', 'moved')}
+
+
 def process_alerts(alerts_data: dict | None) -> list[dict]:
     """Convert raw budget alert data to list of dicts."""
     budgets = alerts_data.get('budgets', []) if alerts_data else []
@@ -74,6 +79,9 @@ def render_jinja2_template(template_path: str, context: dict) -> str:
         FileNotFoundError: If template file doesn't exist
         jinja2.TemplateError: If template has syntax errors
     """
+    # Imported here so that `membrowse summary --json` does not load jinja2
+    from jinja2 import Environment, FileSystemLoader  # pylint: disable=import-outside-toplevel
+
     template_file = Path(template_path)
     if not template_file.exists():
         raise FileNotFoundError(f"Template file not found: {template_path}")
@@ -99,7 +107,8 @@ def build_summary_template_context(summary_response: dict[str, Any]) -> dict[str
 
     Returns:
         Dictionary with template variables:
-        - targets: List of target data with regions, sections, alerts
+        - targets: List of target data with regions, sections, symbols,
+          archives and alerts
         - has_alerts: True if any target has budget alerts
     """
     data = summary_response.get('data', {})
@@ -123,7 +132,8 @@ def build_summary_template_context(summary_response: dict[str, Any]) -> dict[str
             'regions': regions,
             'sections': sections,
             'sections_by_region': sections_by_region,
-            'symbols': {'added': [], 'removed': [], 'modified': [], 'moved': []},
+            'symbols': symbol_changes(changes.get('symbols', {})),
+            'archives': changes.get('archives', {}).get('modified', []),
             'alerts': alerts,
             'has_changes': bool(regions),
             'has_alerts': bool(alerts),
@@ -0,0 +1,305 @@
+"""Stage timing for benchmarks and profiles.
+
+Hot paths mark their work with :func:`stage` and tally work items with
+:func:`count`. Outside of :func:`recording` both cost one global lookup, so
+the markers stay in production code; inside it every stage is timed and
+recorded as an event. :func:`profiling` writes a recording as a Chrome
+trace-event file (``--profile``) that loads in Perfetto or
+``chrome://tracing``.
+
+Stages nest: each stage's *self* time excludes time spent in stages opened
+inside it, so the totals of all stages add up to the recorded wall time.
+Worker processes (``--jobs``) record on their own and send an
+:meth:`StageRecorder.export` back with their results, which the parent
+merges with :func:`merge_recording`; their stages then add to the totals
+while running in parallel, so the totals can exceed the wall time.
+"""
+
+import functools
+import json
+import os
+import threading
+import time
+from collections import defaultdict
+from contextlib import contextmanager
+from typing import Any, Dict, Iterator, List, NamedTuple, Optional
+
+# Stage names in pipeline order, shared by ``membrowse bench`` and profiles
+STAGES = (
+    'linker_parse',
+    'elf_open',
+    'dwarf_cu_index',
+    'line_programs',
+    'die_walk',
+    'symbol_extraction',
+    'source_resolution',
+    'region_mapping',
+    'serialization',
+)
+
+
+class StageEvent(NamedTuple):
+    """One timed stage, relative to the start of the recording."""
+    name: str
+    start: float
+    duration: float
+    thread_id: int
+    args: Optional[Dict[str, Any]] = None
+
+
+class CounterSample(NamedTuple):
+    """Counter totals at one point in time, relative to the recording."""
+    timestamp: float
+    values: Dict[str, int]
+
+
+class WorkerRecording(NamedTuple):
+    """A recording made in another process, to be merged into the parent's."""
+    origin: float
+    events: List[StageEvent]
+    self_times: Dict[str, float]
+    counts: Dict[str, int]
+    counters: Dict[str, int]
+
+
+class StageRecorder:
+    """Collects stage events, per-stage self times and counters."""
+
+    def __init__(self, keep_events: bool = True):
+        self.origin = time.perf_counter()
+        self.keep_events = keep_events
+        self.events: List[StageEvent] = []
+        self.self_times: Dict[str, float] = defaultdict(float)
+        self.counts: Dict[str, int] = defaultdict(int)
+        self.counters: Dict[str, int] = defaultdict(int)
+        self.counter_samples: List[CounterSample] = []
+        self._local = threading.local()
+        self._lock = threading.Lock()
+
+    def _stack(self) -> list:
+        stack = getattr(self._local, 'stack', None)
+        if stack is None:
+            stack = self._local.stack = []
+        return stack
+
+    def begin(self, name: str, args: Optional[Dict[str, Any]] = None) -> None:
+        """Open a stage on the calling thread."""
+        self._stack().append([name, time.perf_counter(), 0.0, args])
+
+    def end(self, keep_event: bool = True) -> None:
+        """Close the innermost stage opened by :meth:`begin`.
+
+        Args:
+            keep_event: Record an event as well as the time; per-item
+                stages (one per symbol) only add to the totals.
+        """
+        stack = self._stack()
+        name, start, child_time, args = stack.pop()
+        duration = time.perf_counter() - start
+        if stack:
+            stack[-1][2] += duration
+        with self._lock:
+            self.self_times[name] += duration - child_time
+            self.counts[name] += 1
+            if keep_event and self.keep_events:
+                self.events.append(StageEvent(
+                    name, start - self.origin, duration, threading.get_ident(), args))
+
+    def add_count(self, name: str, amount: int) -> None:
+        """Add ``amount`` to counter ``name``."""
+        with self._lock:
+            self.counters[name] += amount
+
+    def sample_counters(self) -> None:
+        """Record the current counter totals (a counter track point)."""
+        with self._lock:
+            self.counter_samples.append(CounterSample(
+                time.perf_counter() - self.origin, dict(self.counters)))
+
+    def export(self) -> WorkerRecording:
+        """The recording so far, picklable for a parent process.
+
+        Events are put on a track named after this process's pid, since
+        thread idents are only unique within one process.
+        """
+        pid = os.getpid()
+        with self._lock:
+            return WorkerRecording(
+                self.origin, [event._replace(thread_id=pid) for event in self.events],
+                dict(self.self_times), dict(self.counts), dict(self.counters))
+
+    def merge(self, worker: WorkerRecording) -> None:
+        """Add a worker's stages and counters to this recording.
+
+        ``time.perf_counter`` is system-wide, so worker events are only
+        shifted onto this recording's origin.
+        """
+        shift = worker.origin - self.origin
+        with self._lock:
+            if self.keep_events:
+                self.events.extend(event._replace(start=event.start + shift)
+                                   for event in worker.events)
+            for name, seconds in worker.self_times.items():
+                self.self_times[name] += seconds
+            for name, calls in worker.counts.items():
+                self.counts[name] += calls
+            for name, amount in worker.counters.items():
+                self.counters[name] += amount
+
+    def chrome_trace(self) -> Dict[str, Any]:
+        """The recording in Chrome trace-event format.
+
+        Stages become complete (``X``) events and counter samples become
+        counter (``C``) events, one track per counter. Times are in
+        microseconds.
+        """
+        pid = os.getpid()
+        events = []
+        for event in self.events:
+            entry = {
+                'name': event.name, 'cat': 'stage', 'ph': 'X', 'pid': pid,
+                'tid': event.thread_id, 'ts': event.start * 1e6,
+                'dur': event.duration * 1e6,
+            }
+            if event.args:
+                entry['args'] = event.args
+            events.append(entry)
+        samples = self.counter_samples + [CounterSample(
+            time.perf_counter() - self.origin, dict(self.counters))]
+        for sample in samples:
+            events.extend({
+                'name': name, 'cat': 'counter', 'ph': 'C', 'pid': pid,
+                'ts': sample.timestamp * 1e6, 'args': {name: value},
+            } for name, value in sorted(sample.values.items()))
+        return {
+            'traceEvents': events,
+            'displayTimeUnit': 'ms',
+            'otherData': {
+                'counters': dict(self.counters),
+                'stage_self_seconds': dict(self.self_times),
+            },
+        }
+
+
+_active: Optional[StageRecorder] = None
+
+
+def active_recorder() -> Optional[StageRecorder]:
+    """The recorder of the enclosing :func:`recording`, if any."""
+    return _active
+
+
+@contextmanager
+def recording(keep_events: bool = True) -> Iterator[StageRecorder]:
+    """Record every stage entered until the block exits."""
+    global _active  # pylint: disable=global-statement
+    previous = _active
+    recorder = _active = StageRecorder(keep_events)
+    try:
+        yield recorder
+    finally:
+        _active = previous
+
+
+@contextmanager
+def profiling(path: Optional[str]) -> Iterator[Optional[StageRecorder]]:
+    """Record the block and write a Chrome trace to ``path`` afterwards.
+
+    Does nothing when ``path`` is None. The trace is also written when the
+    block raises, so failed runs can be inspected.
+    """
+    if not path:
+        yield None
+        return
+    with recording() as recorder:
+        try:
+            yield recorder
+        finally:
+            with open(path, 'w', encoding='utf-8') as f:
+                json.dump(recorder.chrome_trace(), f)
+
+
+def merge_recording(worker: Optional[WorkerRecording]) -> None:
+    """Merge a worker process's recording into the active one, if any."""
+    recorder = _active
+    if recorder is not None and worker is not None:
+        recorder.merge(worker)
+
+
+def count(name: str, amount: int = 1) -> None:
+    """Add ``amount`` to counter ``name`` while recording."""
+    recorder = _active
+    if recorder is not None:
+        recorder.add_count(name, amount)
+
+
+def sample_counters() -> None:
+    """Add a point with the current counter totals to the profile."""
+    recorder = _active
+    if recorder is not None:
+        recorder.sample_counters()
+
+
+@contextmanager
+def stage(name: str, args: Optional[Dict[str, Any]] = None) -> Iterator[None]:
+    """Time the enclosed block as stage ``name`` while recording.
+
+    Args:
+        name: Stage name
+        args: Optional details shown with the event in a profile
+    """
+    recorder = _active
+    if recorder is None:
+        yield
+        return
+    recorder.begin(name, args)
+    try:
+        yield
+    finally:
+        recorder.end()
+
+
+def timed(name: str):
+    """Decorator timing every call of a function as stage ``name``."""
+    def decorator(func):
+        @functools.wraps(func)
+        def wrapper(*args, **kwargs):
+            with stage(name):
+                return func(*args, **kwargs)
+        return wrapper
+    return decorator
+
+
+class _TimedProxy:  # pylint: disable=too-few-public-methods
+    """Delegates to an object, timing some of its methods as one stage."""
+
+    def __init__(self, target, name: str, methods, recorder: StageRecorder):
+        self._target = target
+        for method_name in methods:
+            setattr(self, method_name,
+                    self._wrap(getattr(target, method_name), name, recorder))
+
+    @staticmethod
+    def _wrap(method, name, recorder):
+        def timed(*args, **kwargs):
+            recorder.begin(name)
+            try:
+                return method(*args, **kwargs)
+            finally:
+                recorder.end(keep_event=False)
+        return timed
+
+    def __getattr__(self, attr):
+        return getattr(self._target, attr)
+
+
+def timed_methods(target, name: str, *methods: str):
+    """Return ``target``, or a proxy timing ``methods`` as stage ``name``.
+
+    For per-item calls (one per symbol) where an event per call would be
+    too many; the calls only add to the stage's total.
+    """
+    recorder = _active
+    if recorder is None or target is None:
+        return target
+    return _TimedProxy(target, name, methods, recorder)
@@ -0,0 +1,8 @@
+extern const int crc_table[4];
+extern int *call_counter;
+
+int main(void)
+{
+    ++*call_counter;
+    return crc_table[1];
+}
@@ -0,0 +1,10 @@
+/* Only the data of this file survives --gc-sections */
+const int crc_table[4] = {0x00, 0x1d, 0x3a, 0x27};
+static int calls;
+int *call_counter = &calls;
+
+int unused_lookup(int index)
+{
+    calls++;
+    return crc_table[index & 3];
+}
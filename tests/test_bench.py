@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+"""
+Tests for stage timing and the ``membrowse bench`` subcommand.
+"""
+
+import argparse
+import json
+import sys
+import tempfile
+import time
+import unittest
+from pathlib import Path
+from unittest.mock import patch
+
+from membrowse.commands import bench
+from membrowse.commands.bench import find_regressions, run_bench
+from membrowse.utils.timing import recording, stage, timed_methods
+from tests.test_helpers import rmtree_robust
+
+TESTS_DIR = Path(__file__).parent
+
+
+def _bench_args(**overrides):
+    args = {
+        'fixtures_dir': str(TESTS_DIR),
+        'cases': ['gnu-ternary'],
+        'repeat': 1,
+        'output': None,
+        'baseline': None,
+        'max_regression': 20.0,
+    }
+    args.update(overrides)
+    return argparse.Namespace(**args)
+
+
+def _result(wall, stages):
+    return {'cases': [{'name': 'case', 'status': 'ok',
+                       'wall_seconds': {'median': wall},
+                       'stage_seconds': stages}]}
+
+
+class TestStageTiming(unittest.TestCase):
+    """Tests for the stage recorder"""
+
+    def test_stages_are_noops_without_recording(self):
+        """Stages outside a recording record nothing and proxies are bypassed"""
+        target = object()
+        with stage('die_walk'):
+            pass
+        self.assertIs(timed_methods(target, 'source_resolution'), target)
+
+    def test_nested_stages_record_self_time(self):
+        """A parent stage's self time excludes its children"""
+        with recording() as recorder:
+            with stage('symbol_extraction'):
+                with stage('source_resolution'):
+                    time.sleep(0.02)
+
+        self.assertGreaterEqual(recorder.self_times['source_resolution'], 0.02)
+        self.assertLess(recorder.self_times['symbol_extraction'], 0.02)
+        self.assertEqual([event.name for event in recorder.events],
+                         ['source_resolution', 'symbol_extraction'])
+
+    def test_timed_methods_accumulate_without_events(self):
+        """Proxied per-item calls add to the total but emit no events"""
+        class Resolver:  # pylint: disable=too-few-public-methods
+            """Stand-in source resolver"""
+            label = 'resolver'
+
+            def extract_source_file(self, name):
+                """Return a fake source file"""
+                return name + '.c'
+
+        with recording() as recorder:
+            resolver = timed_methods(Resolver(), 'source_resolution',
+                                     'extract_source_file')
+            self.assertEqual(resolver.extract_source_file('main'), 'main.c')
+            self.assertEqual(resolver.label, 'resolver')
+
+        self.assertEqual(recorder.counts['source_resolution'], 1)
+        self.assertEqual(recorder.events, [])
+
+
+class TestBenchCommand(unittest.TestCase):
+    """Tests for run_bench and baseline comparison"""
+
+    def setUp(self):
+        self.temp_dir = Path(tempfile.mkdtemp())
+
+    def tearDown(self):
+        rmtree_robust(self.temp_dir)
+
+    def test_writes_stage_results(self):
+        """A linker-only case reports its linker_parse time"""
+        output = self.temp_dir / 'bench.json'
+        self.assertEqual(run_bench(_bench_args(output=str(output))), 0)
+
+        results = json.loads(output.read_text(encoding='utf-8'))
+        case, = results['cases']
+        self.assertEqual(case['status'], 'ok')
+        self.assertIn('linker_parse', case['stage_seconds'])
+
+    def test_missing_elf_is_skipped(self):
+        """Cases whose ELF is missing or an LFS pointer are skipped"""
+        (self.temp_dir / 'fixtures' / 'micropython' / 'stm32' / 'linker').mkdir(parents=True)
+        (self.temp_dir / 'fixtures/micropython/stm32/linker/stm32f405.ld').write_text('')
+        (self.temp_dir / 'fixtures/micropython/stm32/firmware.elf').write_text(
+            'version https://git-lfs.github.com/spec/v1\n')
+        output = self.temp_dir / 'bench.json'
+
+        self.assertEqual(run_bench(_bench_args(
+            fixtures_dir=str(self.temp_dir), cases=['micropython-stm32'],
+            output=str(output))), 0)
+        case, = json.loads(output.read_text(encoding='utf-8'))['cases']
+        self.assertEqual(case['status'], 'skipped')
+
+    def test_regressions_against_baseline(self):
+        """Slower stages beyond the threshold are reported"""
+        baseline = _result(1.0, {'die_walk': 0.5, 'region_mapping': 0.001})
+        current = _result(1.1, {'die_walk': 0.8, 'region_mapping': 0.004})
+
+        regressions = find_regressions(current, baseline, 20.0)
+
+        self.assertEqual(len(regressions), 1)
+        self.assertIn('die_walk', regressions[0])
+        self.assertEqual(find_regressions(current, baseline, 100.0), [])
+
+    def test_baseline_comparison(self):
+        """run_bench passes against a slower baseline and fails on a bad file"""
+        baseline = self.temp_dir / 'baseline.json'
+        baseline.write_text(json.dumps({'cases': [{
+            'name': 'gnu-ternary', 'status': 'ok',
+            'wall_seconds': {'median': 60.0},
+            'stage_seconds': {'linker_parse': 60.0}}]}), encoding='utf-8')
+        output = str(self.temp_dir / 'out.json')
+        self.assertEqual(run_bench(_bench_args(baseline=str(baseline), output=output)), 0)
+
+        baseline.write_text('not json', encoding='utf-8')
+        self.assertEqual(run_bench(_bench_args(baseline=str(baseline), output=output)), 1)
+
+    def test_startup_commands(self):
+        """--startup times each command in a fresh interpreter and enforces --max-startup"""
+        output = self.temp_dir / 'startup.json'
+        with patch.object(bench.subprocess, 'run') as run:
+            self.assertEqual(run_bench(_bench_args(
+                startup=True, repeat=2, output=str(output), fixtures_dir='missing')), 0)
+            self.assertEqual(run_bench(_bench_args(
+                startup=True, repeat=1, output=str(output), max_startup=0.0)), 1)
+
+        self.assertEqual(run.call_count, 3 * len(bench.STARTUP_COMMANDS))
+        self.assertEqual(run.call_args.args[0][0], sys.executable)
+        case = json.loads(output.read_text(encoding='utf-8'))['cases'][1]
+        self.assertEqual(case['name'], 'startup-import')
+        self.assertEqual(case['command'], 'python -c import membrowse')
+        self.assertEqual(case['stage_seconds'], {})
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+"""
+Tests for batch commit metadata used by onboard.
+"""
+
+import os
+import shutil
+import subprocess
+import tempfile
+import unittest
+from pathlib import Path
+
+from membrowse.commands.onboard import _commit_has_changes_in_dirs
+from membrowse.utils.git import CommitMetadataCache, get_commit_metadata
+from tests.test_helpers import rmtree_robust
+
+
+class TestCommitMetadataCache(unittest.TestCase):
+    """Prefetched metadata matches the per-commit git queries"""
+
+    def setUp(self):
+        if shutil.which('git') is None:
+            self.skipTest("git is required")
+        self.repo = Path(tempfile.mkdtemp())
+        self.addCleanup(rmtree_robust, self.repo)
+        self.addCleanup(os.chdir, os.getcwd())
+        CommitMetadataCache.clear()
+        self.addCleanup(CommitMetadataCache.clear)
+        os.chdir(self.repo)
+
+        self._git('init', '-q')
+        self._git('config', 'user.name', 'Dev Eloper')
+        self._git('config', 'user.email', 'dev@example.com')
+        self._commit('README', 'Initial commit')
+        self._git('checkout', '-q', '-b', 'feature')
+        self._commit('src/main.c', 'Add sources\n\nWith a body.')
+        self._git('checkout', '-q', '-')
+        self._commit('docs/notes.txt', 'Update docs')
+        self._git('merge', '-q', '--no-ff', 'feature', '-m', 'Merge feature')
+        self._git('tag', 'v1.0')
+        self._git('tag', '-a', 'v0.9', '-m', 'annotated', 'HEAD~1')
+        self.commits = self._git('rev-list', '--first-parent', '--reverse', 'HEAD').split()
+
+    def _git(self, *args):
+        return subprocess.run(['git', *args], check=True, capture_output=True,
+                              text=True).stdout.strip()
+
+    def _commit(self, path, message):
+        (self.repo / path).parent.mkdir(parents=True, exist_ok=True)
+        (self.repo / path).write_text(message, encoding='utf-8')
+        self._git('add', path)
+        self._git('commit', '-q', '-m', message)
+
+    def test_prefetched_metadata_matches_git_queries(self):
+        """Message, author, timestamp, parent and tags come from one batch"""
+        expected = [get_commit_metadata(commit) for commit in self.commits]
+
+        self.assertEqual(CommitMetadataCache.prefetch(self.commits), len(self.commits))
+
+        self.assertEqual([CommitMetadataCache.get(commit) for commit in self.commits],
+                         expected)
+        self.assertEqual(expected[-1]['tags'], ['v1.0'])
+        self.assertEqual(expected[-2]['tags'], ['v0.9'])
+        self.assertEqual(expected[-1]['commit_message'], 'Merge feature')
+
+    def test_changed_paths_follow_first_parent(self):
+        """Merges report what they bring in; --build-dirs checks are unchanged"""
+        build_dirs = ['src/']
+        expected = [_commit_has_changes_in_dirs(commit, build_dirs) for commit in self.commits]
+
+        CommitMetadataCache.prefetch(self.commits)
+
+        self.assertEqual(CommitMetadataCache.changed_paths(self.commits[-1]), ['src/main.c'])
+        self.assertEqual([_commit_has_changes_in_dirs(commit, build_dirs)
+                          for commit in self.commits], expected)
+        self.assertEqual(expected, [True, False, True])
+
+    def test_unknown_commits_fall_back(self):
+        """A failing batch leaves lookups to the per-commit queries"""
+        self.assertEqual(CommitMetadataCache.prefetch(['0' * 40]), 0)
+        self.assertIsNone(CommitMetadataCache.get(self.commits[0]))
+        self.assertIsNone(CommitMetadataCache.changed_paths(self.commits[0]))
+
+
+if __name__ == '__main__':
+    unittest.main()
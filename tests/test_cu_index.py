@@ -0,0 +1,237 @@
+#!/usr/bin/env python3
+"""
+Tests for the CU address index (membrowse.analysis.cu_index).
+"""
+
+import platform
+import shutil
+import subprocess
+import tempfile
+import unittest
+from collections import namedtuple
+from pathlib import Path
+from types import SimpleNamespace
+from unittest.mock import patch
+
+from membrowse.analysis.cu_index import CUAddressIndex, read_aranges, read_die_ranges
+from membrowse.analysis.die_scan import declares_located_variable
+from membrowse.analysis.dwarf import DWARFProcessor
+from tests.test_helpers import rmtree_robust
+
+ARangeEntry = namedtuple('ARangeEntry', 'begin_addr length info_offset')
+RangeEntry = namedtuple('RangeEntry', 'entry_offset entry_length begin_offset '
+                                      'end_offset is_absolute')
+BaseAddressEntry = namedtuple('BaseAddressEntry', 'entry_offset base_address')
+Attribute = namedtuple('Attribute', 'form value')
+
+
+class _RangeLists:  # pylint: disable=too-few-public-methods
+    """Stand-in for pyelftools RangeLists"""
+
+    def __init__(self, lists):
+        self.lists = lists
+
+    def get_range_list_at_offset(self, offset, cu=None):  # pylint: disable=unused-argument
+        """Return the list at ``offset``"""
+        return self.lists[offset]
+
+
+def _dwarfinfo(aranges=None, range_lists=None):
+    return SimpleNamespace(
+        get_aranges=lambda: aranges,
+        range_lists=lambda: range_lists,
+        config=SimpleNamespace(little_endian=True))
+
+
+def _cu(offset, dwarf_format=32):
+    return SimpleNamespace(cu_offset=offset, dwarf_format=lambda: dwarf_format)
+
+
+class TestCUAddressIndex(unittest.TestCase):
+    """Tests for interval lookup"""
+
+    def test_multi_range_cus_are_pruned(self):
+        """Only CUs with a range covering a target address are selected"""
+        index = CUAddressIndex([
+            ('lto', [(0x1000, 0x1100), (0x3000, 0x3400)]),
+            ('main', [(0x2000, 0x2200)]),
+            ('unused', [(0x5000, 0x5100)]),
+        ])
+
+        self.assertEqual(index.relevant_cus({0x3010}), ['lto'])
+        self.assertEqual(index.relevant_cus({0x2000, 0x1050}), ['lto', 'main'])
+        self.assertEqual(index.relevant_cus({0x4000}), [])
+
+    def test_rangeless_cus_are_always_relevant(self):
+        """CUs without ranges are included without disabling the pruning"""
+        index = CUAddressIndex([
+            ('code', [(0x1000, 0x1100)]),
+            ('data_only', []),
+            ('other', [(0x2000, 0x2100)]),
+        ])
+
+        self.assertEqual(index.rangeless_count, 1)
+        self.assertEqual(index.relevant_cus({0x2050}), ['data_only', 'other'])
+
+    def test_nested_ranges(self):
+        """Addresses inside a range enclosing later-starting ranges are found"""
+        index = CUAddressIndex([
+            ('outer', [(0x1000, 0x9000)]),
+            ('inner', [(0x2000, 0x2100)]),
+            ('later', [(0x3000, 0x3100)]),
+        ])
+
+        self.assertEqual(index.relevant_cus({0x4000}), ['outer'])
+        self.assertEqual(index.relevant_cus({0x2050}), ['outer', 'inner'])
+        self.assertEqual(len(index), 3)
+
+    def test_segment_boundaries(self):
+        """Range ends are inclusive; overlapping ranges of one CU count once"""
+        index = CUAddressIndex([
+            ('wide', [(0x0, 0xffff), (0x100, 0x200)]),
+        ] + [(f'cu{i}', [(0x1000 + 0x10 * i, 0x1008 + 0x10 * i)]) for i in range(100)])
+
+        self.assertEqual(index._positions_at(0x150), (0,))  # pylint: disable=protected-access
+        self.assertEqual(index.relevant_cus({0x1008}), ['wide', 'cu0'])
+        self.assertEqual(index.relevant_cus({0x1009}), ['wide'])
+        self.assertEqual(index.relevant_cus({0x10000}), [])
+        self.assertEqual(index.relevant_cus(set(range(0x1000, 0x1640, 0x10))),
+                         list(index))
+
+    def test_include_selects_cus_outside_the_addresses(self):
+        """CUs accepted by ``include`` are added in index order"""
+        index = CUAddressIndex([
+            ('code', [(0x1000, 0x1100)]),
+            ('gc_data', [(0x0, 0x30)]),
+            ('other', [(0x2000, 0x2100)]),
+        ])
+
+        self.assertEqual(index.relevant_cus({0x2000}, lambda cu: cu == 'gc_data'),
+                         ['gc_data', 'other'])
+
+
+def _abbrev(code, tag, attributes, children=False):
+    """Raw abbreviation declaration (codes and forms below 0x80)"""
+    data = bytes([code, tag, int(children)])
+    for name, form in attributes:
+        data += bytes([name, form]) + (b'\x7f' if form == 0x21 else b'')
+    return data + b'\0\0'
+
+
+class TestDeclaresLocatedVariable(unittest.TestCase):
+    """Tests for spotting CUs that may define a variable"""
+
+    def test_variable_with_location(self):
+        """Only DW_TAG_variable with DW_AT_location counts"""
+        compile_unit = _abbrev(1, 0x11, [(0x03, 0x0e)], children=True)
+        declaration = _abbrev(2, 0x34, [(0x03, 0x0e), (0x3a, 0x21), (0x3c, 0x19)])
+        parameter = _abbrev(3, 0x05, [(0x02, 0x18)])
+        definition = _abbrev(4, 0x34, [(0x3a, 0x21), (0x02, 0x18)])
+
+        self.assertFalse(declares_located_variable(
+            compile_unit + declaration + parameter + b'\0', 0))
+        self.assertTrue(declares_located_variable(
+            compile_unit + declaration + definition + b'\0', 0))
+        table = b'\0' + compile_unit + definition + b'\0'
+        self.assertFalse(declares_located_variable(table, 0))
+        self.assertTrue(declares_located_variable(table, 1))
+
+    def test_truncated_table(self):
+        """A table running past the section cannot rule a CU out"""
+        self.assertTrue(declares_located_variable(_abbrev(1, 0x11, [])[:-1], 0))
+
+
+class TestPruningMatchesFullFixture(unittest.TestCase):
+    """Compile with --gc-sections and compare against processing every CU"""
+
+    def setUp(self):
+        if platform.system() == 'Windows' or shutil.which('gcc') is None:
+            self.skipTest("native gcc producing ELF is required")
+        self.temp_dir = Path(tempfile.mkdtemp())
+        self.addCleanup(rmtree_robust, self.temp_dir)
+        source_dir = Path(__file__).parent / "static_test" / "gc_sections_data"
+        sources = [str(p) for p in sorted(source_dir.glob("*.c"))]
+        self.elf_path = self.temp_dir / "a.out"
+        subprocess.run(
+            ["gcc", "-g", "-ffunction-sections", "-fdata-sections",
+             "-Wl,--gc-sections", "-o", str(self.elf_path)] + sources,
+            capture_output=True, text=True, check=True)
+
+    def _source_files(self):
+        # pylint: disable=import-outside-toplevel
+        from membrowse.core.analyzer import ELFAnalyzer
+        analyzer = ELFAnalyzer(str(self.elf_path))
+        return {(symbol.name, symbol.address): symbol.source_file
+                for symbol in analyzer.get_symbols()}
+
+    def test_source_files_match_unpruned(self):
+        """Data of a CU whose code was collected keeps its source file"""
+        pruned = self._source_files()
+        with patch.object(DWARFProcessor, '_find_relevant_cus',
+                          lambda self, cu_index, dwarfinfo: list(cu_index)):
+            unpruned = self._source_files()
+
+        self.assertEqual(pruned, unpruned)
+        sources = {name: source for (name, _), source in pruned.items()}
+        self.assertEqual(sources['crc_table'], 'table.c')
+        self.assertEqual(sources['calls'], 'table.c')
+
+
+class TestRangeSources(unittest.TestCase):
+    """Tests for reading CU ranges from .debug_aranges and DW_AT_ranges"""
+
+    def test_read_aranges(self):
+        """Entries are grouped per CU; empty entries are dropped"""
+        aranges = SimpleNamespace(entries=[
+            ARangeEntry(0x1000, 0x100, 0), ARangeEntry(0x3000, 0x40, 0),
+            ARangeEntry(0x2000, 0, 0x80), ARangeEntry(0x2000, 0x10, 0x80)])
+
+        self.assertEqual(read_aranges(_dwarfinfo(aranges)), {
+            0: [(0x1000, 0x1100), (0x3000, 0x3040)],
+            0x80: [(0x2000, 0x2010)],
+        })
+        self.assertEqual(read_aranges(_dwarfinfo(None)), {})
+
+    def test_range_list_bases(self):
+        """Offset pairs are relative to the CU low_pc or a base entry"""
+        range_lists = _RangeLists({0x40: [
+            RangeEntry(0, 0, 0x10, 0x20, False),
+            BaseAddressEntry(0, 0x8000),
+            RangeEntry(0, 0, 0x0, 0x8, False),
+            RangeEntry(0, 0, 0x9000, 0x9010, True),
+        ]})
+        top_die = SimpleNamespace(attributes={
+            'DW_AT_ranges': Attribute('DW_FORM_sec_offset', 0x40),
+            'DW_AT_low_pc': Attribute('DW_FORM_addr', 0x1000)})
+
+        ranges = read_die_ranges(_dwarfinfo(range_lists=range_lists), _cu(0),
+                                 top_die, b'')
+
+        self.assertEqual(ranges, [(0x1010, 0x1020), (0x8000, 0x8008), (0x9000, 0x9010)])
+
+    def test_rnglistx_uses_offset_table(self):
+        """DWARF 5 rnglistx indexes are resolved via DW_AT_rnglists_base"""
+        range_lists = _RangeLists({0x0c + 0x08: [RangeEntry(0, 0, 0x100, 0x180, True)]})
+        # Offset table at 0x0c; entry 1 holds 0x08 (relative to the base)
+        rnglists = bytes(0x0c) + (0).to_bytes(4, 'little') + (8).to_bytes(4, 'little')
+        top_die = SimpleNamespace(attributes={
+            'DW_AT_ranges': Attribute('DW_FORM_rnglistx', 1),
+            'DW_AT_rnglists_base': Attribute('DW_FORM_sec_offset', 0x0c)})
+
+        ranges = read_die_ranges(_dwarfinfo(range_lists=range_lists), _cu(0),
+                                 top_die, rnglists)
+
+        self.assertEqual(ranges, [(0x100, 0x180)])
+
+    def test_missing_ranges(self):
+        """CUs without DW_AT_ranges or with an unreadable list give None"""
+        top_die = SimpleNamespace(attributes={
+            'DW_AT_ranges': Attribute('DW_FORM_sec_offset', 0x99)})
+        self.assertIsNone(read_die_ranges(
+            _dwarfinfo(range_lists=_RangeLists({})), _cu(0), top_die, b''))
+        self.assertIsNone(read_die_ranges(
+            _dwarfinfo(), _cu(0), SimpleNamespace(attributes={}), b''))
+
+
+if __name__ == '__main__':
+    unittest.main()
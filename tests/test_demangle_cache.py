@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+"""
+Tests for demangling memoization and the batch native demangler
+(``--native-demangler``).
+"""
+# pylint: disable=protected-access
+
+import shutil
+import subprocess
+import threading
+import unittest
+from unittest.mock import MagicMock, patch
+
+from membrowse.analysis import symbols
+from membrowse.analysis._native_demangle import demangle_batch
+from membrowse.analysis.symbols import SymbolExtractor
+
+MANGLED = '_ZN3foo3barEv'
+
+
+def _completed(stdout):
+    return subprocess.CompletedProcess(args=[], returncode=0, stdout=stdout, stderr='')
+
+
+class TestDemangleMemo(unittest.TestCase):
+    """Results are computed once per process and shared between extractors"""
+
+    def setUp(self):
+        patcher = patch.dict(symbols._DEMANGLE_CACHES, clear=True)
+        patcher.start()
+        self.addCleanup(patcher.stop)
+
+    def test_memo_is_shared_between_extractors(self):
+        """A second extractor reuses the first one's results"""
+        first = SymbolExtractor(MagicMock())
+        expected = first._demangle_with_kind(MANGLED)
+
+        with patch.object(SymbolExtractor, '_demangle_uncached') as uncached:
+            second = SymbolExtractor(MagicMock())
+            self.assertEqual(second._demangle_with_kind(MANGLED), expected)
+            uncached.assert_not_called()
+
+    def test_native_and_builtin_results_are_kept_apart(self):
+        """Native output never leaks into the built-in demangler's cache"""
+        with patch('membrowse.analysis.symbols.find_native_demangler',
+                   return_value='/usr/bin/c++filt'), \
+                patch('membrowse.analysis._native_demangle.subprocess.run',
+                      return_value=_completed('native::bar()\n')):
+            native = SymbolExtractor(MagicMock(), native_demangler=True)
+            native.demangle_batch([MANGLED])
+
+        self.assertEqual(native._demangle_symbol_name(MANGLED), 'native::bar()')
+        builtin = SymbolExtractor(MagicMock())
+        self.assertNotEqual(builtin._demangle_symbol_name(MANGLED), 'native::bar()')
+
+    def test_least_recently_used_names_are_evicted(self):
+        """The memo holds at most MAX_DEMANGLE_CACHE_ENTRIES names"""
+        extractor = SymbolExtractor(MagicMock())
+        with patch.object(symbols, 'MAX_DEMANGLE_CACHE_ENTRIES', 2):
+            extractor._demangle_with_kind('_Z1av')
+            extractor._demangle_with_kind('_Z1bv')
+            extractor._demangle_with_kind('_Z1av')
+            extractor._demangle_with_kind('_Z1cv')
+
+        self.assertEqual(list(symbols._DEMANGLE_CACHES[None]), ['_Z1av', '_Z1cv'])
+
+    def test_threads_share_the_memo_safely(self):
+        """Concurrent lookups and evictions (batch --workers) do not fail"""
+        names = [f'_Z{len(tag)}{tag}v' for tag in ('a', 'bb', 'ccc', 'dddd', 'eeeee')]
+        errors = []
+
+        def work():
+            extractor = SymbolExtractor(MagicMock())
+            try:
+                for _ in range(2000):
+                    for name in names:
+                        extractor._demangle_with_kind(name)
+            except Exception as e:  # pylint: disable=broad-exception-caught
+                errors.append(e)
+
+        with patch.object(symbols, 'MAX_DEMANGLE_CACHE_ENTRIES', 2):
+            threads = [threading.Thread(target=work) for _ in range(8)]
+            for thread in threads:
+                thread.start()
+            for thread in threads:
+                thread.join()
+
+        self.assertEqual(errors, [])
+        self.assertLessEqual(len(symbols._DEMANGLE_CACHES[None]), 2)
+
+
+class TestNativeDemangler(unittest.TestCase):
+    """Tests for the batch subprocess call and its fallbacks"""
+
+    def setUp(self):
+        patcher = patch.dict(symbols._DEMANGLE_CACHES, clear=True)
+        patcher.start()
+        self.addCleanup(patcher.stop)
+
+    def _extractor(self):
+        with patch('membrowse.analysis.symbols.find_native_demangler',
+                   return_value='/usr/bin/c++filt'):
+            return SymbolExtractor(MagicMock(), native_demangler=True)
+
+    def test_one_call_for_all_cpp_names(self):
+        """C++ base names are demangled in one call, suffixes re-appended"""
+        extractor = self._extractor()
+        with patch('membrowse.analysis._native_demangle.subprocess.run',
+                   return_value=_completed('foo::bar()\n')) as run:
+            extractor.demangle_batch([MANGLED, MANGLED + '.part.0', 'main'])
+
+        run.assert_called_once()
+        self.assertEqual(run.call_args.kwargs['input'], MANGLED + '\n')
+        self.assertEqual(extractor._demangle_with_kind(MANGLED + '.part.0'),
+                         ('foo::bar().part.0', 'cpp'))
+        self.assertEqual(extractor._demangle_with_kind('main'), ('main', 'none'))
+
+    def test_tool_failure_falls_back_to_builtin(self):
+        """A failing tool leaves demangling to itanium_demangler"""
+        expected = SymbolExtractor(MagicMock())._demangle_uncached(MANGLED)
+        extractor = self._extractor()
+        with patch('membrowse.analysis._native_demangle.subprocess.run',
+                   side_effect=subprocess.CalledProcessError(1, 'c++filt')):
+            extractor.demangle_batch([MANGLED])
+
+        self.assertEqual(extractor._demangle_with_kind(MANGLED), expected)
+
+    def test_line_count_mismatch_is_ignored(self):
+        """Output that does not line up with the input is discarded"""
+        with patch('membrowse.analysis._native_demangle.subprocess.run',
+                   return_value=_completed('a()\n')):
+            self.assertEqual(demangle_batch('c++filt', ['_Z1av', '_Z1bv']), {})
+
+    def test_rejected_names_are_omitted(self):
+        """Names echoed back unchanged are left to the built-in demangler"""
+        with patch('membrowse.analysis._native_demangle.subprocess.run',
+                   return_value=_completed('a()\n_Zbogus\n')):
+            self.assertEqual(demangle_batch('c++filt', ['_Z1av', '_Zbogus']),
+                             {'_Z1av': 'a()'})
+
+    def test_real_cxxfilt(self):
+        """A real c++filt demangles a batch in order"""
+        tool = shutil.which('c++filt')
+        if tool is None:
+            self.skipTest("c++filt is required")
+        self.assertEqual(demangle_batch(tool, ['_Z3fooi', '_ZN1a1bEv']),
+                         {'_Z3fooi': 'foo(int)', '_ZN1a1bEv': 'a::b()'})
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,207 @@
+#!/usr/bin/env python3
+"""
+Tests for the abbreviation-driven DIE scanner (membrowse.analysis.die_scan).
+"""
+
+import platform
+import shutil
+import subprocess
+import tempfile
+import unittest
+from pathlib import Path
+
+from elftools.elf.elffile import ELFFile
+
+from membrowse.analysis.dwarf import DWARFProcessor
+from membrowse.analysis.die_scan import (
+    DIEScanner, ScanError, compile_abbrev, relevant_die_order)
+from tests.test_helpers import rmtree_robust
+
+COMPARED_TABLES = ('address_to_file', 'address_to_line', 'symbol_to_file',
+                   'address_to_cu_file', 'static_symbol_mappings')
+
+# code: (tag, has_children, attribute specs)
+ABBREVS = {
+    1: ('DW_TAG_compile_unit', True,
+        [('DW_AT_name', 'DW_FORM_string'), ('DW_AT_language', 'DW_FORM_data1')]),
+    2: ('DW_TAG_structure_type', True,
+        [('DW_AT_sibling', 'DW_FORM_ref4'), ('DW_AT_name', 'DW_FORM_string')]),
+    3: ('DW_TAG_member', False,
+        [('DW_AT_name', 'DW_FORM_string'),
+         ('DW_AT_data_member_location', 'DW_FORM_exprloc')]),
+    4: ('DW_TAG_subprogram', True,
+        [('DW_AT_name', 'DW_FORM_strp'), ('DW_AT_low_pc', 'DW_FORM_addr'),
+         ('DW_AT_high_pc', 'DW_FORM_udata')]),
+    5: ('DW_TAG_variable', False,
+        [('DW_AT_name', 'DW_FORM_string'), ('DW_AT_location', 'DW_FORM_exprloc')]),
+    6: ('DW_TAG_typedef', False,
+        [('DW_AT_name', 'DW_FORM_string'), ('DW_AT_type', 'DW_FORM_ref4')]),
+    7: ('DW_TAG_enumeration_type', True, [('DW_AT_name', 'DW_FORM_string')]),
+    8: ('DW_TAG_enumerator', False,
+        [('DW_AT_name', 'DW_FORM_string'), ('DW_AT_const_value', 'DW_FORM_sdata')]),
+}
+
+HEADER_SIZE = 11
+
+
+def _string(text):
+    return text.encode() + b'\0'
+
+
+class _CUBuilder:
+    """Builds the .debug_info bytes of one 32-bit DWARF 4 CU."""
+
+    def __init__(self):
+        self.data = bytearray(HEADER_SIZE)
+        self.offsets = {}
+
+    def die(self, label, code, payload=b''):
+        """Append a DIE and remember its offset under ``label``."""
+        self.offsets[label] = len(self.data)
+        self.data += bytes([code]) + payload
+
+    def end_children(self):
+        """Append the null entry closing the current children list."""
+        self.data += b'\0'
+
+
+def _build_cu():
+    """A CU with a struct (holding a static member), an enum, a typedef,
+    a function with a local and a global variable."""
+    cu = _CUBuilder()
+    cu.die('cu', 1, _string('main.c') + b'\x0c')
+    cu.die('struct', 2, b'\0\0\0\0' + _string('point'))
+    cu.die('member_x', 3, _string('x') + b'\x02\x23\x00')
+    cu.die('static_member', 5, _string('count') + b'\x05\x03\x00\x10\x00\x20')
+    cu.end_children()
+    # DW_AT_sibling of the struct points just past its children
+    sibling = len(cu.data)
+    struct_at = cu.offsets['struct'] + 1
+    cu.data[struct_at:struct_at + 4] = sibling.to_bytes(4, 'little')
+    cu.die('enum', 7, _string('color'))
+    cu.die('red', 8, _string('RED') + b'\x00')
+    cu.die('blue', 8, _string('BLUE') + b'\x7f')
+    cu.end_children()
+    cu.die('typedef', 6, _string('point_t') + b'\x0c\0\0\0')
+    cu.die('main', 4, b'\0\0\0\0' + b'\x00\x01\x00\x08' + b'\x80\x01')
+    cu.die('local', 5, _string('i') + b'\x02\x91\x70')
+    cu.end_children()
+    cu.die('global', 5, _string('g') + b'\x05\x03\x04\x00\x00\x20')
+    cu.end_children()
+    cu.data += b'\0\0'  # padding
+    return bytes(cu.data), cu.offsets
+
+
+def _lookup(address_size=4):
+    compiled = {code: compile_abbrev(tag, children, specs, address_size, 4, 4)
+                for code, (tag, children, specs) in ABBREVS.items()}
+    return compiled.__getitem__
+
+
+class TestDIEScanner(unittest.TestCase):
+    """Tests for scanning raw DIE bytes"""
+
+    def test_skips_type_subtrees(self):
+        """Typedefs, enums and their enumerators are stepped over"""
+        data, offsets = _build_cu()
+        tree = DIEScanner(data, _lookup()).scan(0, HEADER_SIZE, len(data))
+
+        kept = {label for label, offset in offsets.items() if offset in tree.tags}
+        self.assertEqual(kept, {'cu', 'struct', 'static_member', 'main', 'local',
+                                'global'})
+        self.assertEqual(tree.children[offsets['struct']], [offsets['static_member']])
+        self.assertEqual(tree.skipped, 5)
+
+    def test_c_aggregates_are_skipped_via_sibling(self):
+        """In C CUs whole struct subtrees are jumped over"""
+        data, offsets = _build_cu()
+        tree = DIEScanner(data, _lookup(), skip_c_aggregates=True).scan(
+            0, HEADER_SIZE, len(data))
+
+        self.assertNotIn(offsets['struct'], tree.tags)
+        self.assertNotIn(offsets['static_member'], tree.tags)
+        self.assertEqual(tree.children[offsets['cu']],
+                         [offsets['main'], offsets['global']])
+
+    def test_processing_order_matches_stack_walk(self):
+        """Relevant DIEs come out last child first, depth first"""
+        data, offsets = _build_cu()
+        tree = DIEScanner(data, _lookup()).scan(0, HEADER_SIZE, len(data))
+
+        order, visited = relevant_die_order(tree, offsets['cu'])
+
+        self.assertEqual(order, [offsets['global'], offsets['main'],
+                                 offsets['local'], offsets['static_member']])
+        self.assertEqual(visited, 6)
+
+    def test_unsupported_form_and_truncated_data(self):
+        """Indirect forms and truncated CUs raise ScanError"""
+        with self.assertRaises(ScanError):
+            compile_abbrev('DW_TAG_variable', False,
+                           [('DW_AT_name', 'DW_FORM_indirect')], 4, 4, 4)
+
+        data, _ = _build_cu()
+        truncated = data[:len(data) - 8]
+        with self.assertRaises(ScanError):
+            DIEScanner(truncated, _lookup()).scan(0, HEADER_SIZE, len(truncated))
+
+    def test_form_sizes(self):
+        """Address, offset and DWARF 2 ref_addr sizes follow the CU header"""
+        abbrev = compile_abbrev(
+            'DW_TAG_variable', False,
+            [('DW_AT_low_pc', 'DW_FORM_addr'), ('DW_AT_name', 'DW_FORM_strp'),
+             ('DW_AT_type', 'DW_FORM_ref_addr'), ('DW_AT_external', 'DW_FORM_flag_present')],
+            8, 4, 2)
+        self.assertEqual(abbrev.fixed_size, 20)
+        abbrev = compile_abbrev(
+            'DW_TAG_variable', False,
+            [('DW_AT_type', 'DW_FORM_ref_addr'), ('DW_AT_name', 'DW_FORM_string')],
+            4, 8, 4)
+        self.assertIsNone(abbrev.fixed_size)
+        self.assertEqual(abbrev.ops[0], 8)
+
+
+class TestFastScanParity(unittest.TestCase):
+    """Compile C and C++ programs and compare fast vs full DIE walks"""
+
+    def setUp(self):
+        if platform.system() == 'Windows' or shutil.which('g++') is None:
+            self.skipTest("native gcc producing ELF is required")
+        self.temp_dir = Path(tempfile.mkdtemp())
+
+    def tearDown(self):
+        if hasattr(self, 'temp_dir') and self.temp_dir.exists():
+            rmtree_robust(self.temp_dir)
+
+    def _compile(self, compiler, source):
+        elf_path = self.temp_dir / (Path(source).stem + '.elf')
+        subprocess.run(
+            [compiler, '-g', '-o', str(elf_path), str(Path(__file__).parent / source)],
+            capture_output=True, text=True, check=True)
+        return elf_path
+
+    @staticmethod
+    def _process(elf_path, fast_die_scan):
+        with open(elf_path, 'rb') as f:
+            elffile = ELFFile(f)
+            addresses = {sym['st_value']
+                         for sym in elffile.get_section_by_name('.symtab').iter_symbols()}
+            processor = DWARFProcessor(
+                elffile, addresses, machine=elffile.header['e_machine'],
+                fast_die_scan=fast_die_scan)
+            return processor.process_dwarf_info()
+
+    def test_fast_scan_matches_full_walk(self):
+        """Both walks produce identical mappings"""
+        for compiler, source in (('gcc', 'simple_program.c'),
+                                 ('g++', 'cpp_program.cpp')):
+            with self.subTest(source=source):
+                elf_path = self._compile(compiler, source)
+                full = self._process(elf_path, fast_die_scan=False)
+                fast = self._process(elf_path, fast_die_scan=True)
+                for table in COMPARED_TABLES:
+                    self.assertEqual(fast[table], full[table], table)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,254 @@
+#!/usr/bin/env python3
+"""
+Tests for the local report diff engine and ``membrowse diff``.
+"""
+
+import argparse
+import io
+import json
+import os
+import tempfile
+import unittest
+from contextlib import redirect_stdout
+from unittest.mock import patch
+
+from membrowse.commands import diff as diff_command
+from membrowse.core.diff import as_summary_response, base_name, diff_reports, diff_symbols
+from membrowse.utils.formatter import format_diff_human_readable
+from membrowse.utils.summary_formatter import build_summary_template_context
+from tests.test_helpers import rmtree_robust
+
+
+def _symbol(name, size, section='.text', source_file='main.c', address=0x08000000,
+            **fields):
+    return {'name': name, 'address': address, 'size': size, 'type': 'STT_FUNC',
+            'binding': 'STB_GLOBAL', 'section': section, 'source_file': source_file,
+            'source_line': 1, 'visibility': 'DEFAULT', 'archive': '', 'object_file': '',
+            **fields}
+
+
+def _report(path, flash_used, text_size, symbols):
+    return {
+        'file_path': path,
+        'symbols': symbols,
+        'memory_layout': {
+            'FLASH': {'address': 0x08000000, 'limit_size': 0x10000, 'type': 'UNKNOWN',
+                      'used_size': flash_used, 'free_size': 0x10000 - flash_used,
+                      'utilization_percent': flash_used / 0x10000 * 100,
+                      'sections': [{'name': '.text', 'address': 0x08000000,
+                                    'size': text_size, 'type': 'PROGBITS'},
+                                   {'name': '.data', 'address': 0x08004000,
+                                    'size': 0x20, 'type': 'PROGBITS'}],
+                      'symbol_used_size': 0},
+            'RAM': {'address': 0x20000000, 'limit_size': 0x5000, 'type': 'UNKNOWN',
+                    'used_size': 0x100, 'free_size': 0x4f00, 'utilization_percent': 1.25,
+                    'sections': [{'name': '.data', 'address': 0x20000000,
+                                  'size': 0x20, 'type': 'PROGBITS'}],
+                    'symbol_used_size': 0},
+        },
+    }
+
+
+def _base_report():
+    return _report('base.elf', 0x1000, 0x800, [
+        _symbol('main', 0x40),
+        _symbol('parse(char const*).constprop.0', 0x100, source_file='parse.cpp'),
+        _symbol('crc32', 0x80, source_file='crc.c'),
+        _symbol('old_name', 0x30, source_file='util.c'),
+        _symbol('gone', 0x10),
+        _symbol('memcpy', 0x60, source_file='', archive='libc.a', object_file='memcpy.o'),
+        _symbol('_etext', 0, section='.text', source_file=''),
+    ])
+
+
+def _head_report():
+    return _report('head.elf', 0x1100, 0x900, [
+        _symbol('main', 0x48),
+        _symbol('parse(char const*).part.1', 0x120, source_file='parse.cpp'),
+        _symbol('crc32', 0x80, source_file='checksum.c'),
+        _symbol('new_name', 0x30, source_file='util.c'),
+        _symbol('fresh', 0x200),
+        _symbol('memcpy', 0x60, source_file='', archive='libc.a', object_file='memcpy.o'),
+        _symbol('memset', 0x20, source_file='', archive='libc.a', object_file='memset.o'),
+        _symbol('_etext', 0, section='.text', source_file=''),
+    ])
+
+
+class TestDiffSymbols(unittest.TestCase):
+    """Hash join of symbols across two builds"""
+
+    def setUp(self):
+        self.changes = diff_symbols(_base_report()['symbols'], _head_report()['symbols'])
+
+    def _names(self, kind):
+        return [entry['name'] for entry in self.changes[kind]]
+
+    def test_suffixes_are_ignored_and_sizes_compared(self):
+        """Clones of one function match; modified entries keep the base in old"""
+        self.assertEqual(self._names('modified'),
+                         ['parse(char const*).part.1', 'main'])
+        parse = self.changes['modified'][0]
+        self.assertEqual(parse['delta'], 0x20)
+        self.assertEqual(parse['old']['name'], 'parse(char const*).constprop.0')
+        self.assertEqual(base_name('f.constprop.0.isra.1'), 'f')
+
+    def test_moves_and_renames(self):
+        """Unambiguous file moves and same-size renames are paired"""
+        moved = {entry['name']: entry for entry in self.changes['moved']}
+        self.assertEqual(set(moved), {'crc32', 'new_name'})
+        self.assertEqual(moved['crc32']['old']['source_file'], 'crc.c')
+        self.assertEqual(moved['new_name']['old']['name'], 'old_name')
+        self.assertEqual(moved['new_name']['delta'], 0)
+
+    def test_added_and_removed(self):
+        """Unmatched symbols remain; zero-size markers are ignored"""
+        self.assertEqual(self._names('added'), ['fresh', 'memset'])
+        self.assertEqual(self._names('removed'), ['gone'])
+        self.assertEqual(self.changes['removed'][0]['delta'], -0x10)
+        self.assertNotIn('old', self.changes['added'][0])
+
+    def test_ambiguous_candidates_stay_unpaired(self):
+        """Two same-size candidates are not guessed between"""
+        changes = diff_symbols([_symbol('a', 8)], [_symbol('b', 8), _symbol('c', 8)])
+        self.assertEqual(changes['moved'], [])
+        self.assertEqual(len(changes['added']), 2)
+
+    def test_clones_in_one_build_are_summed(self):
+        """Several clones of one function count as the function"""
+        changes = diff_symbols(
+            [_symbol('f', 0x40)],
+            [_symbol('f.constprop.0', 0x30), _symbol('f.part.0', 0x20, address=0x08000100)])
+        self.assertEqual(changes['modified'][0]['name'], 'f')
+        self.assertEqual(changes['modified'][0]['delta'], 0x10)
+
+
+class TestDiffReports(unittest.TestCase):
+    """Region, section and archive deltas in the changes_summary shape"""
+
+    def setUp(self):
+        self.diff = diff_reports(_base_report(), _head_report())
+        self.changes = self.diff['changes']
+
+    def test_regions_sections_archives(self):
+        """Only changed entries are modified; LMA copies are per region"""
+        [flash] = self.changes['regions']['modified']
+        self.assertEqual((flash['name'], flash['used_size'], flash['old']['used_size']),
+                         ('FLASH', 0x1100, 0x1000))
+        self.assertNotIn('sections', flash)
+        [text] = self.changes['sections']['modified']
+        self.assertEqual((text['region'], text['name'], text['delta']), ('FLASH', '.text', 0x100))
+        [libc] = self.changes['archives']['modified']
+        self.assertEqual((libc['name'], libc['delta']), ('libc.a', 0x20))
+        self.assertEqual((self.diff['base'], self.diff['head']), ('base.elf', 'head.elf'))
+
+    def test_summary_context_renders_diff(self):
+        """build_summary_template_context consumes the diff unchanged"""
+        context = build_summary_template_context(as_summary_response(self.diff, 'stm32'))
+        [target] = context['targets']
+        self.assertEqual(target['name'], 'stm32')
+        self.assertTrue(target['has_changes'])
+        self.assertEqual(target['regions'][0]['delta_str'], '+256')
+        self.assertEqual(target['regions'][0]['delta_pct_str'], '+6.2%')
+        self.assertEqual([s['name'] for s in target['sections_by_region']['FLASH']], ['.text'])
+        self.assertEqual(target['symbols'], self.changes['symbols'])
+        self.assertEqual(target['archives'][0]['name'], 'libc.a')
+
+    def test_identical_reports(self):
+        """Diffing a report against itself finds nothing"""
+        changes = diff_reports(_base_report(), _base_report())['changes']
+        for category in changes.values():
+            self.assertFalse(any(category.values()))
+
+    def test_human_readable(self):
+        """Text output lists every category, largest symbol change first"""
+        text = format_diff_human_readable(self.diff)
+        self.assertIn('Memory Changes: base.elf -> head.elf', text)
+        self.assertIn('Symbols (2 added, 1 removed, 2 modified, 2 moved)', text)
+        self.assertIn('old_name -> new_name', text)
+        symbol_rows = text.split('Symbols (')[1].splitlines()[3:]
+        self.assertTrue(symbol_rows[0].startswith('fresh'))
+        self.assertIn('+512', symbol_rows[0])
+        self.assertEqual(len(format_diff_human_readable(self.diff, top_n=2)
+                             .split('Symbols (')[1].splitlines()), 5)
+
+
+class TestDiffCommand(unittest.TestCase):
+    """membrowse diff on saved reports and on ELF files"""
+
+    def setUp(self):
+        self.temp_dir = tempfile.mkdtemp()
+        self.addCleanup(rmtree_robust, self.temp_dir)
+
+    def _args(self, base, head, **overrides):
+        values = {'base': base, 'head': head, 'ld_scripts': None, 'json': True}
+        values.update(overrides)
+        return argparse.Namespace(**values)
+
+    def _run(self, args):
+        output = io.StringIO()
+        with redirect_stdout(output):
+            exit_code = diff_command.run_diff(args)
+        return exit_code, output.getvalue()
+
+    def test_saved_reports(self):
+        """JSON reports are diffed without analysis"""
+        paths = []
+        for name, report in (('base.json', _base_report()), ('head.json', _head_report())):
+            paths.append(os.path.join(self.temp_dir, name))
+            with open(paths[-1], 'w', encoding='utf-8') as f:
+                json.dump(report, f)
+
+        with patch.object(diff_command, 'generate_report') as generate:
+            exit_code, output = self._run(self._args(*paths))
+        self.assertEqual(exit_code, 0)
+        generate.assert_not_called()
+        self.assertEqual(json.loads(output)['changes']['regions']['modified'][0]['name'],
+                         'FLASH')
+
+        exit_code, output = self._run(self._args(*paths, json=False))
+        self.assertEqual(exit_code, 0)
+        self.assertIn('Regions', output)
+
+    def test_elfs_share_the_cache(self):
+        """Both ELFs are analyzed with one cache and their own map file"""
+        reports = {'base.elf': _base_report(), 'head.elf': _head_report()}
+        args = self._args('base.elf', 'head.elf', cache_dir=self.temp_dir,
+                          map_files=['base.map', 'head.map'], no_daemon=True)
+        with patch.object(diff_command, 'generate_report',
+                          side_effect=lambda **options: reports[options['elf_path']]
+                          ) as generate, \
+                patch.object(diff_command, 'request_report') as request:
+            exit_code, _ = self._run(args)
+
+        self.assertEqual(exit_code, 0)
+        request.assert_not_called()
+        calls = [call.kwargs for call in generate.call_args_list]
+        self.assertEqual([call['map_file'] for call in calls], ['base.map', 'head.map'])
+        self.assertEqual({call['cache_dir'] for call in calls}, {self.temp_dir})
+
+    def test_cache_is_opt_in(self):
+        """Without --cache or --cache-dir nothing is cached on disk"""
+        reports = {'base.elf': _base_report(), 'head.elf': _head_report()}
+        with patch.object(diff_command, 'generate_report',
+                          side_effect=lambda **options: reports[options['elf_path']]
+                          ) as generate:
+            exit_code, _ = self._run(self._args('base.elf', 'head.elf', no_daemon=True))
+        self.assertEqual(exit_code, 0)
+        self.assertEqual([call.kwargs['cache_dir'] for call in generate.call_args_list],
+                         [None, None])
+
+    def test_errors(self):
+        """A failed analysis or an unreadable report exits with 1"""
+        with patch.object(diff_command, 'request_report', return_value=None), \
+                patch.object(diff_command, 'generate_report',
+                             side_effect=ValueError('ELF file not found')), \
+                self.assertLogs(diff_command.logger, 'ERROR') as logs:
+            self.assertEqual(self._run(self._args('a.elf', 'b.elf'))[0], 1)
+        self.assertIn('a.elf', logs.output[0])
+
+        with self.assertLogs(diff_command.logger, 'ERROR'):
+            self.assertEqual(self._run(self._args('missing.json', 'b.json'))[0], 1)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,191 @@
+#!/usr/bin/env python3
+"""
+Tests for the on-disk per-CU DWARF cache (``--cache`` / ``--cache-dir``).
+"""
+
+import json
+import os
+import platform
+import shutil
+import subprocess
+import tempfile
+import unittest
+from pathlib import Path
+from unittest.mock import patch
+
+from elftools.elf.elffile import ELFFile
+
+from membrowse.analysis.dwarf import DWARFProcessor, _line_header_strings
+from membrowse.utils.cache import ContentCache, cache_dir_from_args, default_cache_dir
+from tests.test_helpers import rmtree_robust
+
+COMPARED_TABLES = ('address_to_file', 'address_to_line', 'symbol_to_file',
+                   'address_to_cu_file', 'static_symbol_mappings')
+
+
+class TestContentCache(unittest.TestCase):
+    """Tests for the generic content-addressed store"""
+
+    def setUp(self):
+        self.temp_dir = tempfile.mkdtemp()
+
+    def tearDown(self):
+        rmtree_robust(Path(self.temp_dir))
+
+    def test_round_trip(self):
+        """Stored values are returned for the same key"""
+        cache = ContentCache(self.temp_dir, 'test')
+        key = ContentCache.make_key(b'a', b'b')
+        cache.put(key, {'lines': [[1, 'a.c', 2]]})
+
+        self.assertEqual(cache.get(key), {'lines': [[1, 'a.c', 2]]})
+
+    def test_missing_and_corrupt_entries_are_misses(self):
+        """Absent or unreadable entries return None instead of raising"""
+        cache = ContentCache(self.temp_dir, 'test')
+        key = ContentCache.make_key(b'x')
+        self.assertIsNone(cache.get(key))
+
+        path = Path(self.temp_dir) / 'test' / key[:2] / f"{key}.json"
+        path.parent.mkdir(parents=True)
+        path.write_text('{truncated', encoding='utf-8')
+        self.assertIsNone(cache.get(key))
+
+    def test_key_parts_are_length_prefixed(self):
+        """Different splits of the same bytes produce different keys"""
+        self.assertNotEqual(ContentCache.make_key(b'ab', b'c'),
+                            ContentCache.make_key(b'a', b'bc'))
+
+    def test_default_dir_honours_xdg_cache_home(self):
+        """$XDG_CACHE_HOME/membrowse is the default location"""
+        with patch.dict(os.environ, {'XDG_CACHE_HOME': self.temp_dir}):
+            self.assertEqual(default_cache_dir(), Path(self.temp_dir) / 'membrowse')
+
+    def test_cache_dir_from_args(self):
+        """--cache-dir wins over --cache; neither disables caching"""
+        class Args:  # pylint: disable=too-few-public-methods
+            """Minimal argparse namespace stand-in"""
+            cache = False
+            cache_dir = None
+
+        args = Args()
+        self.assertIsNone(cache_dir_from_args(args))
+        args.cache = True
+        with patch.dict(os.environ, {'XDG_CACHE_HOME': self.temp_dir}):
+            self.assertEqual(cache_dir_from_args(args),
+                             str(Path(self.temp_dir) / 'membrowse'))
+        args.cache_dir = '/explicit'
+        self.assertEqual(cache_dir_from_args(args), '/explicit')
+
+
+class TestLineHeaderStrings(unittest.TestCase):
+    """Cache key input for DWARF 5 line program headers"""
+
+    def test_names_and_directory_indices_are_keyed(self):
+        """Only this header's names count; moving a file changes the key"""
+        header = {'include_directory': [b'/src', b'inc'],
+                  'file_entry': [{'name': b'main.c', 'dir_index': 0},
+                                 {'name': b'util.h', 'dir_index': 1}]}
+        key = _line_header_strings(header)
+        self.assertEqual(key, b'/src\0inc\0\0main.c\x000\0util.h\x001')
+
+        header['file_entry'][1]['dir_index'] = 0
+        self.assertNotEqual(_line_header_strings(header), key)
+        self.assertEqual(_line_header_strings({}), b'')
+
+
+class TestDWARFCache(unittest.TestCase):
+    """Compile a multi-CU program and compare cached vs uncached output"""
+
+    def setUp(self):
+        if platform.system() == 'Windows' or shutil.which('gcc') is None:
+            self.skipTest("native gcc producing ELF is required")
+        self.temp_dir = Path(tempfile.mkdtemp())
+        self.cache_dir = str(self.temp_dir / 'cache')
+        source_dir = Path(__file__).parent / "static_test" / "header_static"
+        sources = [str(p) for p in sorted(source_dir.glob("*.c"))]
+        self.elf_path = self.temp_dir / "a.out"
+        subprocess.run(
+            ["gcc", "-g", "-I", str(source_dir), "-o", str(self.elf_path)] + sources,
+            capture_output=True, text=True, check=True)
+
+    def tearDown(self):
+        if hasattr(self, 'temp_dir') and self.temp_dir.exists():
+            rmtree_robust(self.temp_dir)
+
+    def _process(self, cache_dir=None):
+        with open(self.elf_path, 'rb') as f:
+            elffile = ELFFile(f)
+            addresses = {sym['st_value']
+                         for sym in elffile.get_section_by_name('.symtab').iter_symbols()}
+            processor = DWARFProcessor(
+                elffile, addresses, machine=elffile.header['e_machine'],
+                cache_dir=cache_dir)
+            return processor, processor.process_dwarf_info()
+
+    def _assert_same(self, expected, actual):
+        for table in COMPARED_TABLES:
+            self.assertEqual(actual[table], expected[table], table)
+
+    def test_cached_run_matches_uncached(self):
+        """A cold and a warm cached run both match an uncached run"""
+        _, uncached = self._process()
+        cold_processor, cold = self._process(self.cache_dir)
+        warm_processor, warm = self._process(self.cache_dir)
+
+        self.assertGreater(cold_processor.cache_misses, 0)
+        self.assertEqual(warm_processor.cache_misses, 0)
+        self.assertEqual(warm_processor.cache_hits, cold_processor.cache_misses)
+        self._assert_same(uncached, cold)
+        self._assert_same(uncached, warm)
+
+    def test_dwarf5_cus_survive_new_files_elsewhere(self):
+        """A file added to another CU keeps the other CUs' entries valid"""
+        source_dir = self.temp_dir / 'src'
+        source_dir.mkdir()
+        (source_dir / 'a.c').write_text('int a(void) { return 1; }\n', encoding='utf-8')
+        (source_dir / 'main.c').write_text(
+            '#include "extra.h"\nint a(void);\nint main(void) { return a(); }\n',
+            encoding='utf-8')
+
+        def build(new_header):
+            extra = ''
+            if new_header:
+                (source_dir / new_header).write_text(
+                    'static inline int b(void) { return 2; }\n', encoding='utf-8')
+                extra = f'#include "{new_header}"\n'
+            (source_dir / 'extra.h').write_text(extra, encoding='utf-8')
+            subprocess.run(
+                ["gcc", "-gdwarf-5", "-o", str(self.elf_path), "a.c", "main.c"],
+                capture_output=True, text=True, check=True, cwd=source_dir)
+
+        build(None)
+        self._process(self.cache_dir)
+        build('brand_new_header.h')
+        processor, result = self._process(self.cache_dir)
+        _, uncached = self._process()
+
+        self.assertGreater(processor.cache_hits, 0)  # a.c was not decoded again
+        self.assertGreater(processor.cache_misses, 0)  # main.c was
+        self._assert_same(uncached, result)
+
+    def test_changed_string_table_invalidates_entry(self):
+        """Entries whose recorded strings no longer match are re-decoded"""
+        _, uncached = self._process(self.cache_dir)
+        tampered = 0
+        for entry_path in Path(self.cache_dir).rglob('*.json'):
+            entry = json.loads(entry_path.read_text(encoding='utf-8'))
+            if entry['strings']:
+                entry['strings'][0][2] = 'renamed_' + entry['strings'][0][2]
+                entry_path.write_text(json.dumps(entry), encoding='utf-8')
+                tampered += 1
+
+        processor, result = self._process(self.cache_dir)
+
+        self.assertGreater(tampered, 0)
+        self.assertEqual(processor.cache_misses, tampered)
+        self._assert_same(uncached, result)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+"""
+Tests for parallel per-CU DWARF processing (``--jobs``).
+
+Parallel runs must produce exactly the same ``dwarf_data`` as a serial run,
+including the setdefault precedence used for ARM Thumb tolerance aliases.
+"""
+# pylint: disable=protected-access
+
+import platform
+import shutil
+import subprocess
+import tempfile
+import unittest
+from pathlib import Path
+from unittest.mock import patch
+
+from elftools.elf.elffile import ELFFile
+
+from membrowse.analysis import dwarf
+from membrowse.analysis.dwarf import DWARFProcessor, resolve_jobs
+from membrowse.analysis.line_table import LineTable
+from membrowse.utils.timing import count, recording, stage
+from tests.test_helpers import rmtree_robust
+
+
+def _partial(**tables):
+    """Build a worker result with empty defaults for unspecified tables."""
+    result = {
+        'address_to_file': LineTable(),
+        'symbol_to_file': {},
+        'address_to_cu_file': {},
+        'processed_cus': set(),
+        'static_symbol_mappings': [],
+        'found_symbols': set(),
+        'cache_hits': 0,
+        'cache_misses': 0,
+        'defaulted_keys': {'symbol_to_file': set(), 'address_to_cu_file': set()},
+        'profile': None,
+    }
+    result.update(tables)
+    return result
+
+
+class TestResolveJobs(unittest.TestCase):
+    """Tests for --jobs normalization"""
+
+    def test_positive_value_is_kept(self):
+        """Explicit worker counts are used as-is"""
+        self.assertEqual(resolve_jobs(4), 4)
+
+    def test_zero_means_cpu_count(self):
+        """0 selects one worker per CPU"""
+        with patch('membrowse.analysis.dwarf.os.cpu_count', return_value=16):
+            self.assertEqual(resolve_jobs(0), 16)
+
+    def test_none_is_serial(self):
+        """None falls back to serial processing"""
+        self.assertEqual(resolve_jobs(None), 1)
+
+
+class TestMergePartial(unittest.TestCase):
+    """Tests for deterministic merging of worker results"""
+
+    def test_exact_entry_overrides_earlier_alias(self):
+        """A later chunk's exact entry replaces an earlier tolerance alias"""
+        processor = DWARFProcessor(None, set())
+        key = ('foo', 0x1001)
+        processor._merge_partial(_partial(
+            symbol_to_file={key: 'alias.c'},
+            defaulted_keys={'symbol_to_file': {key}, 'address_to_cu_file': set()}))
+        processor._merge_partial(_partial(symbol_to_file={key: 'exact.c'}))
+
+        self.assertEqual(processor.dwarf_data['symbol_to_file'][key], 'exact.c')
+
+    def test_alias_does_not_override_earlier_entry(self):
+        """A later chunk's alias keeps the value written first"""
+        processor = DWARFProcessor(None, set())
+        processor._merge_partial(_partial(address_to_cu_file={0x1000: 'first.c'}))
+        processor._merge_partial(_partial(
+            address_to_cu_file={0x1000: 'second.c'},
+            defaulted_keys={'symbol_to_file': set(),
+                            'address_to_cu_file': {0x1000}}))
+
+        self.assertEqual(
+            processor.dwarf_data['address_to_cu_file'][0x1000], 'first.c')
+
+    def test_worker_profile_is_merged(self):
+        """A worker's stages and counters are added to the active profile"""
+        with recording() as worker:
+            with stage('die_walk'):
+                count('dies_visited', 5)
+        processor = DWARFProcessor(None, set())
+        with recording() as parent:
+            count('dies_visited', 2)
+            processor._merge_partial(_partial(profile=worker.export()))
+        # Without an active profile the recording is ignored
+        processor._merge_partial(_partial(profile=worker.export()))
+
+        self.assertEqual(parent.counters['dies_visited'], 7)
+        self.assertEqual(parent.counts['die_walk'], 1)
+        self.assertAlmostEqual(parent.self_times['die_walk'], worker.self_times['die_walk'])
+        event, = parent.events
+        self.assertEqual(event.name, 'die_walk')
+        self.assertAlmostEqual(parent.origin + event.start,
+                               worker.origin + worker.events[0].start)
+
+    def test_line_tables_and_statics_follow_chunk_order(self):
+        """Line entries are last-writer-wins and statics keep chunk order"""
+        processor = DWARFProcessor(None, set())
+        processor._merge_partial(_partial(
+            address_to_file=LineTable.from_mappings({0x10: 'a.c'}),
+            static_symbol_mappings=[('x', 'a.c', 'a.c')],
+            processed_cus={0}))
+        processor._merge_partial(_partial(
+            address_to_file=LineTable.from_mappings({0x10: 'b.c'}),
+            static_symbol_mappings=[('y', 'b.c', 'b.c')],
+            processed_cus={100}))
+        processor.build_line_table()
+
+        data = processor.dwarf_data
+        self.assertEqual(data['address_to_file'][0x10], 'b.c')
+        self.assertEqual(
+            [name for name, _, _ in data['static_symbol_mappings']], ['x', 'y'])
+        self.assertEqual(data['processed_cus'], {0, 100})
+
+
+class TestParallelMatchesSerial(unittest.TestCase):
+    """Compile a multi-CU program and compare serial vs parallel output"""
+
+    def setUp(self):
+        if platform.system() == 'Windows' or shutil.which('gcc') is None:
+            self.skipTest("native gcc producing ELF is required")
+        self.temp_dir = Path(tempfile.mkdtemp())
+        source_dir = Path(__file__).parent / "static_test" / "c_static_functions"
+        sources = [str(p) for p in sorted(source_dir.glob("*.c"))]
+        self.elf_path = self.temp_dir / "a.out"
+        subprocess.run(
+            ["gcc", "-g", "-o", str(self.elf_path)] + sources,
+            capture_output=True, text=True, check=True)
+
+    def tearDown(self):
+        if hasattr(self, 'temp_dir') and self.temp_dir.exists():
+            rmtree_robust(self.temp_dir)
+
+    def _process(self, jobs):
+        with open(self.elf_path, 'rb') as f:
+            elffile = ELFFile(f)
+            addresses = {sym['st_value']
+                         for sym in elffile.get_section_by_name('.symtab').iter_symbols()}
+            processor = DWARFProcessor(
+                elffile, addresses, machine=elffile.header['e_machine'],
+                jobs=jobs, elf_path=str(self.elf_path))
+            return processor.process_dwarf_info()
+
+    def test_parallel_output_identical(self):
+        """jobs=2 yields the same mappings as jobs=1"""
+        serial = self._process(jobs=1)
+        with patch.object(dwarf, 'MIN_CUS_PER_WORKER', 1):
+            parallel = self._process(jobs=2)
+
+        for table in ('address_to_file', 'address_to_line', 'symbol_to_file',
+                      'address_to_cu_file', 'static_symbol_mappings',
+                      'processed_cus'):
+            self.assertEqual(parallel[table], serial[table], table)
+        self.assertEqual(parallel['coverage_metrics']['cus_processed'],
+                         serial['coverage_metrics']['cus_processed'])
+
+
+if __name__ == '__main__':
+    unittest.main()
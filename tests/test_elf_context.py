@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+"""
+Tests for the shared, memory-mapped ELF context used by ``membrowse report``.
+"""
+# pylint: disable=protected-access
+
+import platform
+import shutil
+import subprocess
+import tempfile
+import unittest
+from pathlib import Path
+from unittest.mock import patch
+
+from elftools.elf.elffile import ELFFile
+
+from membrowse.core.analyzer import ELFAnalyzer
+from membrowse.linker.elf_info import ELFContext, get_architecture_info
+from membrowse.linker.parser import LinkerScriptParser
+from tests.test_helpers import rmtree_robust
+
+LINKER_SCRIPT = """
+MEMORY
+{
+    FLASH (rx) : ORIGIN = 0x08000000, LENGTH = 256K
+}
+"""
+
+
+class TestELFContext(unittest.TestCase):
+    """Compile a small program and compare the context against ELFFile"""
+
+    def setUp(self):
+        if platform.system() == 'Windows' or shutil.which('gcc') is None:
+            self.skipTest("native gcc producing ELF is required")
+        self.temp_dir = Path(tempfile.mkdtemp())
+        source_dir = Path(__file__).parent / "static_test" / "c_static_functions"
+        sources = [str(p) for p in sorted(source_dir.glob("*.c"))]
+        self.elf_path = str(self.temp_dir / "a.out")
+        subprocess.run(
+            ["gcc", "-g", "-o", self.elf_path] + sources,
+            capture_output=True, text=True, check=True)
+
+    def tearDown(self):
+        if hasattr(self, 'temp_dir') and self.temp_dir.exists():
+            rmtree_robust(self.temp_dir)
+
+    def test_tables_match_elffile(self):
+        """Sections, symbols and segments match a plain ELFFile"""
+        with open(self.elf_path, 'rb') as f:
+            elffile = ELFFile(f)
+            expected_sections = [s.name for s in elffile.iter_sections()]
+            expected_symbols = [
+                (s.name, s['st_value'])
+                for s in elffile.get_section_by_name('.symtab').iter_symbols()]
+            expected_segments = [s['p_vaddr'] for s in elffile.iter_segments()]
+
+        with ELFContext.open(self.elf_path) as elf:
+            self.assertEqual([s.name for s in elf.iter_sections()], expected_sections)
+            self.assertEqual(elf.num_sections(), len(expected_sections))
+            symtab = elf.get_section_by_name('.symtab')
+            self.assertEqual(
+                [(s.name, s['st_value']) for s in symtab.iter_symbols()],
+                expected_symbols)
+            self.assertEqual([s['p_vaddr'] for s in elf.iter_segments()],
+                             expected_segments)
+            self.assertIsNone(elf.get_section_by_name('.does_not_exist'))
+
+    def test_tables_are_decoded_once(self):
+        """Repeated lookups return the same cached objects"""
+        with ELFContext.open(self.elf_path) as elf:
+            symtab = elf.get_section_by_name('.symtab')
+            first = list(symtab.iter_symbols())
+            self.assertIs(elf.get_section_by_name('.symtab'), symtab)
+            self.assertTrue(all(
+                a is b for a, b in zip(first, symtab.iter_symbols())))
+            self.assertIs(elf.get_dwarf_info(), elf.get_dwarf_info())
+
+    def test_analyzer_with_shared_context_matches(self):
+        """ELFAnalyzer output is unchanged when given a shared context"""
+        expected = [s.__dict__ for s in ELFAnalyzer(self.elf_path).get_symbols()]
+        with ELFContext.open(self.elf_path) as elf:
+            analyzer = ELFAnalyzer(self.elf_path, elf_context=elf)
+            self.assertIs(analyzer.elffile, elf.elffile)
+            self.assertEqual([s.__dict__ for s in analyzer.get_symbols()], expected)
+
+    def test_linker_parser_does_not_reopen_elf(self):
+        """LinkerScriptParser reads the architecture from the shared context"""
+        script = self.temp_dir / "flash.ld"
+        script.write_text(LINKER_SCRIPT, encoding='utf-8')
+        expected = get_architecture_info(str(Path(self.elf_path).resolve()))
+
+        with ELFContext.open(self.elf_path) as elf, \
+                patch('membrowse.linker.parser.get_architecture_info') as reopen:
+            parser = LinkerScriptParser(
+                [str(script)], elf_file=self.elf_path, elf_context=elf)
+            reopen.assert_not_called()
+
+        self.assertEqual(parser.elf_info, expected)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+"""
+Tests for the shared keep-alive session and retry backoff of MemBrowseClient.
+"""
+
+import json
+import threading
+import unittest
+from email.utils import format_datetime
+from datetime import datetime, timedelta, timezone
+from unittest.mock import MagicMock, patch
+
+import requests
+
+from membrowse.api import client as client_module
+from membrowse.api.client import MemBrowseClient, retry_delay
+from membrowse.utils.timing import recording
+
+
+def _client(token='a'):
+    auth_context = MagicMock()
+    auth_context.build_headers.return_value = {'Authorization': f'Bearer {token}'}
+    return MemBrowseClient(auth_context, 'https://api.example.com')
+
+
+def _response(status_code, body=b'{"success": true}', headers=None):
+    response = MagicMock(status_code=status_code, content=body, headers=headers or {})
+    response.json.side_effect = lambda: json.loads(body)
+    if status_code >= 400:
+        response.raise_for_status.side_effect = requests.exceptions.HTTPError(
+            f"HTTP {status_code}", response=response)
+    return response
+
+
+class TestRetryDelay(unittest.TestCase):
+    """Tests for the backoff schedule"""
+
+    def test_exponential_backoff_with_jitter(self):
+        """Delays are drawn from the upper half of a doubling, capped bound"""
+        with patch.object(client_module.random, 'uniform',
+                          side_effect=lambda low, high: high) as uniform:
+            self.assertEqual([retry_delay(attempt) for attempt in range(1, 8)],
+                             [15, 30, 60, 120, 120, 120, 120])
+        self.assertTrue(all(call.args[0] == call.args[1] / 2
+                            for call in uniform.call_args_list))
+
+    def test_total_wait_rides_out_an_outage(self):
+        """All retries together wait minutes, even with the shortest draws"""
+        for pick in (lambda low, high: low, lambda low, high: high):
+            with patch.object(client_module.random, 'uniform', side_effect=pick):
+                total = sum(retry_delay(attempt)
+                            for attempt in range(1, client_module.MAX_ATTEMPTS))
+            self.assertGreaterEqual(total, 170)
+            self.assertLessEqual(total, 350)
+
+    def test_retry_after_is_honored(self):
+        """Retry-After in seconds or as an HTTP date wins on 429 and 503"""
+        later = format_datetime(datetime.now(timezone.utc) + timedelta(seconds=30),
+                                usegmt=True)
+        self.assertEqual(retry_delay(1, _response(429, headers={'Retry-After': '7'})), 7)
+        self.assertAlmostEqual(
+            retry_delay(1, _response(503, headers={'Retry-After': later})), 30, delta=2)
+        self.assertEqual(
+            retry_delay(1, _response(429, headers={'Retry-After': '86400'})), 300)
+        with patch.object(client_module.random, 'uniform', return_value=1.5):
+            self.assertEqual(retry_delay(1, _response(502, headers={'Retry-After': '7'})), 1.5)
+            self.assertEqual(retry_delay(1, _response(429, headers={'Retry-After': 'soon'})),
+                             1.5)
+
+
+class TestRequestWithRetry(unittest.TestCase):
+    """Tests for retries over the shared session"""
+
+    def test_session_is_shared_and_headers_are_per_client(self):
+        """Clients reuse one connection pool but send their own credentials"""
+        first, second = _client('a'), _client('b')
+        self.assertIs(first.session, second.session)
+        self.assertNotIn('Authorization', first.session.headers)
+
+        with patch.object(first.session, 'request', return_value=_response(200)) as request:
+            first.get_summary('abc')
+            second.get_summary('abc')
+        self.assertEqual([call.kwargs['headers']['Authorization']
+                          for call in request.call_args_list], ['Bearer a', 'Bearer b'])
+
+    def test_threads_get_their_own_session(self):
+        """requests.Session is not thread-safe; upload threads do not share one"""
+        client = _client()
+        sessions = []
+        thread = threading.Thread(target=lambda: sessions.append(client.session))
+        thread.start()
+        thread.join()
+        self.assertIsNot(sessions[0], client.session)
+        self.assertIs(client.session, client.session)
+
+    def test_gateway_errors_wait_minutes_before_giving_up(self):
+        """Persistent 502s are retried for the whole backoff budget"""
+        client = _client()
+        with patch.object(client.session, 'request',
+                          side_effect=lambda *_a, **_k: _response(502, b'{}')), \
+                patch.object(client_module.time, 'sleep') as sleep, \
+                self.assertRaises(requests.exceptions.HTTPError):
+            client.get_summary('abc')
+        self.assertGreaterEqual(sum(call.args[0] for call in sleep.call_args_list), 170)
+
+    def test_retries_wait_for_retry_after_and_are_counted(self):
+        """A 429 with Retry-After is retried after exactly that delay"""
+        client = _client()
+        responses = [_response(429, b'{}', {'Retry-After': '3'}), _response(200)]
+
+        with patch.object(client.session, 'request', side_effect=responses), \
+                patch.object(client_module.time, 'sleep') as sleep, \
+                recording() as recorder:
+            self.assertEqual(client.get_summary('abc'), {'success': True})
+
+        sleep.assert_called_once_with(3.0)
+        self.assertEqual(recorder.counters['http_requests'], 2)
+        self.assertEqual(recorder.counters['http_retries'], 1)
+        self.assertEqual(recorder.counters['http_retry_wait_ms'], 3000)
+        self.assertEqual(recorder.counters['http_response_bytes'], 2 + 17)
+
+    def test_gives_up_after_max_attempts(self):
+        """Persistent 503s raise after MAX_ATTEMPTS requests"""
+        client = _client()
+        with patch.object(client.session, 'request',
+                          side_effect=lambda *_a, **_k: _response(503, b'{}')) as request, \
+                patch.object(client_module.time, 'sleep'), \
+                self.assertRaises(requests.exceptions.HTTPError):
+            client.get_summary('abc')
+        self.assertEqual(request.call_count, client_module.MAX_ATTEMPTS)
+
+
+if __name__ == '__main__':
+    unittest.main()
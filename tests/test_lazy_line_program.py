@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+"""
+Tests for lazy line program decoding (``--lazy-line-program``).
+
+The DIE pass runs first; line programs are then decoded only for the CUs
+containing functions the DIE mappings could not attribute.
+"""
+# pylint: disable=protected-access
+
+import platform
+import shutil
+import subprocess
+import tempfile
+import unittest
+from pathlib import Path
+from types import SimpleNamespace
+from unittest.mock import Mock, patch
+
+from membrowse.analysis.cu_index import CUAddressIndex
+from membrowse.analysis.dwarf import DWARFProcessor
+from membrowse.analysis.sources import SourceFileResolver
+from tests.test_helpers import rmtree_robust
+
+
+class TestUnresolvedFunctions(unittest.TestCase):
+    """Tests for selecting the functions that need line programs"""
+
+    def test_die_mapped_functions_are_resolved(self):
+        """Exact and suffix-stripped DIE keys count as resolved"""
+        resolver = SourceFileResolver({
+            'symbol_to_file': {('main', 0x100): 'main.c', ('helper', 0x200): 'util.c'},
+            'address_to_cu_file': {},
+        }, system_header_cache={})
+
+        self.assertEqual(resolver.unresolved_function_addresses([
+            ('main', 0x100), ('helper.part.0', 0x200), ('ns::f(int)', 0x300),
+            ('main', 0x400), ('undefined', 0), ('ns::f(int)', 0x300)]),
+            [0x300, 0x400])
+
+
+class TestDecodeLinePrograms(unittest.TestCase):
+    """Tests for the second, on-demand line program pass"""
+
+    def _processor(self, lazy=True):
+        cus = [SimpleNamespace(cu_offset=offset) for offset in (0, 100, 200)]
+        processor = DWARFProcessor(Mock(), set(), lazy_line_program=lazy)
+        processor._cu_index = CUAddressIndex([
+            (cus[0], [(0x1000, 0x2000)]), (cus[1], [(0x2000, 0x3000)]),
+            (cus[2], [(0x3000, 0x4000)])])
+
+        def decode(cu, _dwarfinfo):
+            processor._line_rows.add(0x1000 * (cu.cu_offset // 100 + 1), f'cu{cu.cu_offset}.c', 7)
+        return processor, decode
+
+    def test_only_covering_cus_are_decoded(self):
+        """CUs without unresolved addresses keep their line program undecoded"""
+        processor, decode = self._processor()
+        self.assertTrue(processor.skip_line_program)
+
+        with patch.object(processor, '_extract_line_program_data',
+                          side_effect=decode) as extract:
+            decoded = processor.decode_line_programs([0x1004, 0x3010, 0x3020])
+
+        self.assertEqual(decoded, 2)
+        self.assertEqual([call.args[0].cu_offset for call in extract.call_args_list], [0, 200])
+        self.assertEqual(dict(processor.dwarf_data['address_to_file']),
+                         {0x1000: 'cu0.c', 0x3000: 'cu200.c'})
+        self.assertEqual(processor.dwarf_data['address_to_line'][0x3000], 7)
+
+    def test_noop_without_lazy_mode_or_addresses(self):
+        """Nothing is decoded for eager processors or an empty address set"""
+        for lazy, addresses in ((False, [0x1004]), (True, [])):
+            processor, decode = self._processor(lazy)
+            with self.subTest(lazy=lazy), patch.object(
+                    processor, '_extract_line_program_data', side_effect=decode) as extract:
+                self.assertEqual(processor.decode_line_programs(addresses), 0)
+                extract.assert_not_called()
+
+
+class TestLazyMatchesFull(unittest.TestCase):
+    """Compile a multi-CU program and compare lazy and full source files"""
+
+    def setUp(self):
+        if platform.system() == 'Windows' or shutil.which('gcc') is None:
+            self.skipTest("native gcc producing ELF is required")
+        self.temp_dir = Path(tempfile.mkdtemp())
+        self.addCleanup(rmtree_robust, self.temp_dir)
+        source_dir = Path(__file__).parent / "static_test" / "c_static_functions"
+        sources = [str(p) for p in sorted(source_dir.glob("*.c"))]
+        self.elf_path = self.temp_dir / "a.out"
+        subprocess.run(
+            ["gcc", "-g", "-o", str(self.elf_path)] + sources,
+            capture_output=True, text=True, check=True)
+
+    def _source_files(self, **options):
+        # pylint: disable=import-outside-toplevel
+        from membrowse.core.analyzer import ELFAnalyzer
+        analyzer = ELFAnalyzer(str(self.elf_path), **options)
+        return {(symbol.name, symbol.address): symbol.source_file
+                for symbol in analyzer.get_symbols()}
+
+    def test_source_files_match_full_decoding(self):
+        """Lazy decoding attributes the same files as decoding every CU"""
+        full = self._source_files()
+        lazy = self._source_files(lazy_line_program=True)
+        self.assertEqual(lazy, full)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+"""
+Tests for the compact sorted line table that backs ``address_to_file`` and
+``address_to_line`` in ``dwarf_data``.
+"""
+
+import pickle
+import unittest
+from array import array
+
+from membrowse.analysis.line_table import LineTable, LineTableBuilder, sorted_indices
+from membrowse.analysis.sources import SourceFileResolver
+
+
+def _build(rows):
+    builder = LineTableBuilder()
+    for address, filename, line in rows:
+        builder.add(address, filename, line)
+    return builder.build()
+
+
+class TestLineTable(unittest.TestCase):
+    """Tests for LineTable construction and lookups"""
+
+    def test_matches_dict_semantics(self):
+        """Out-of-order and repeated rows behave like sequential dict writes"""
+        rows = [(0x30, 'c.c', 3), (0x10, 'a.c', 1), (0x20, 'b.c', 2),
+                (0x10, 'a2.c', 0), (0x20, 'b2.c', 7)]
+        expected_files, expected_lines = {}, {}
+        for address, filename, line in rows:
+            expected_files[address] = filename
+            if line:
+                expected_lines[address] = line
+
+        table = _build(rows)
+
+        self.assertEqual(dict(table), expected_files)
+        self.assertEqual(dict(table.lines), expected_lines)
+        self.assertEqual(list(table), [0x10, 0x20, 0x30])
+        self.assertEqual(table.lines[0x10], 1)
+        self.assertNotIn(0x11, table)
+        self.assertIsNone(table.get(0x11))
+        with self.assertRaises(KeyError):
+            _ = table[0x11]
+
+    def test_file_names_are_interned(self):
+        """Rows sharing a file name share one string"""
+        table = _build([(0x10, 'a.c', 1), (0x20, 'a.c', 2), (0x30, 'b.c', 3)])
+        self.assertIs(table[0x10], table[0x20])
+
+    def test_nearest_prefers_closest_then_lower(self):
+        """nearest() picks the closest row within range, lower address on ties"""
+        table = _build([(0x100, 'a.c', 1), (0x110, 'b.c', 2)])
+
+        self.assertEqual(table.nearest(0x100, 100), 0x100)
+        self.assertEqual(table.nearest(0x10e, 100), 0x110)
+        self.assertEqual(table.nearest(0x108, 100), 0x100)
+        self.assertIsNone(table.nearest(0x200, 100))
+        self.assertIsNone(LineTable().nearest(0x100, 100))
+
+    def test_sweep_matches_lookups(self):
+        """sweep() gives the exact and nearest rows of ascending addresses"""
+        table = _build([(0x100, 'a.c', 1), (0x110, 'b.c', 2), (0x400, 'c.c', 3)])
+        addresses = [0x0, 0x100, 0x108, 0x10e, 0x200, 0x3f0, 0x400, 0x500]
+
+        for address, (exact, near) in zip(addresses, table.sweep(addresses, 100)):
+            with self.subTest(address=hex(address)):
+                self.assertEqual(table.row(exact)[0] if exact >= 0 else None,
+                                 address if address in table else None)
+                self.assertEqual(table.row(near)[0] if near >= 0 else None,
+                                 table.nearest(address, 100))
+
+    def test_64bit_addresses_and_pickling(self):
+        """Addresses above 4 GiB are kept and tables survive pickling"""
+        table = _build([(0x1_0000_0000, 'hi.c', 5), (0x10, 'lo.c', 1)])
+        restored = pickle.loads(pickle.dumps(table))
+
+        self.assertEqual(restored, {0x10: 'lo.c', 0x1_0000_0000: 'hi.c'})
+        self.assertEqual(restored.lines[0x1_0000_0000], 5)
+
+    def test_extend_keeps_later_rows(self):
+        """Merging built tables keeps last-writer-wins per address"""
+        builder = LineTableBuilder()
+        builder.extend(_build([(0x10, 'a.c', 1), (0x20, 'a.c', 2)]))
+        builder.extend(_build([(0x10, 'b.c', 0)]))
+        table = builder.build()
+
+        self.assertEqual(dict(table), {0x10: 'b.c', 0x20: 'a.c'})
+        self.assertEqual(dict(table.lines), {0x10: 1, 0x20: 2})
+
+
+    def test_sorted_indices_merges_runs(self):
+        """Ascending runs are merged stably, ties in arrival order"""
+        keys = array('Q', [0x30, 0x40, 0x10, 0x30, 0x50, 0x20, 0x20, 0x05])
+        self.assertEqual(list(sorted_indices(keys)),
+                         sorted(range(len(keys)), key=keys.__getitem__))
+        self.assertEqual(list(sorted_indices(array('Q'))), [])
+
+
+class TestResolverWithLineTable(unittest.TestCase):
+    """SourceFileResolver must give the same answers for LineTable and dicts"""
+
+    def _resolvers(self, address_to_file, address_to_line, symbol_addresses=()):
+        table = LineTable.from_mappings(address_to_file, address_to_line)
+        for kind, files, lines in (('dict', address_to_file, address_to_line),
+                                   ('line_table', table, table.lines),
+                                   ('swept', table, table.lines)):
+            dwarf_data = {
+                'address_to_file': files,
+                'address_to_line': lines,
+                'symbol_to_file': {},
+                'address_to_cu_file': {},
+            }
+            resolver = SourceFileResolver(dwarf_data, system_header_cache={})
+            if kind == 'swept':
+                resolver.resolve_addresses(sorted(symbol_addresses))
+            yield kind, resolver
+
+    def test_address_fallback(self):
+        """Exact and nearby address lookups agree across representations"""
+        files = {0x1000: '/src/main.c', 0x1040: '/src/util.c'}
+        lines = {0x1000: 10, 0x1040: 42}
+        for kind, resolver in self._resolvers(files, lines, (0x1000, 0x1004, 0x1042, 0x9000)):
+            with self.subTest(kind=kind):
+                self.assertEqual(resolver.extract_source_file('f', 'FUNC', 0x1000), 'main.c')
+                self.assertEqual(resolver.extract_source_file('g', 'FUNC', 0x1042), 'util.c')
+                self.assertEqual(resolver.extract_source_file('h', 'FUNC', 0x9000), '')
+                self.assertEqual(resolver.extract_source_line(0x1004), 10)
+                self.assertEqual(resolver.extract_source_line(0x9000), 0)
+
+
+if __name__ == '__main__':
+    unittest.main()
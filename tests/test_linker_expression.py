@@ -0,0 +1,188 @@
+#!/usr/bin/env python3
+"""
+Tests for compiled linker script expressions (membrowse.linker.expression)
+and the dependency-ordered variable resolution built on them.
+"""
+# pylint: disable=protected-access
+
+import tempfile
+import unittest
+from pathlib import Path
+
+from membrowse.linker.expression import (
+    EvaluationContext, ExpressionError, compile_expression, dependency_order)
+from membrowse.linker.icf_parser import ICF_DIALECT, ICFSymbolTable
+from membrowse.linker.parser import (
+    GNU_LD_DIALECT, CircularReferenceError, ExpressionEvaluator, VariableExtractor)
+from tests.test_helpers import rmtree_robust
+
+
+class _Symbols(EvaluationContext):
+    """Context with a fixed symbol table"""
+
+    def __init__(self, **symbols):
+        self.symbols = symbols
+        self.lookups = []
+
+    def lookup_symbol(self, name):
+        self.lookups.append(name)
+        return self.symbols[name]
+
+
+class TestCompiledExpression(unittest.TestCase):
+    """Tests for tokenizing, parsing and evaluating expressions"""
+
+    def test_compiled_once_and_reusable(self):
+        """The same text compiles to one object usable with any context"""
+        compiled = compile_expression('BASE + 4K', GNU_LD_DIALECT)
+
+        self.assertIs(compile_expression('BASE + 4K', GNU_LD_DIALECT), compiled)
+        self.assertEqual(compiled.symbols, {'BASE'})
+        self.assertEqual(compiled.evaluate(_Symbols(BASE=0x1000)), 0x2000)
+        self.assertEqual(compiled.evaluate(_Symbols(BASE=0)), 0x1000)
+
+    def test_literals(self):
+        """Hex, octal and suffixed literals; ICF has no octal"""
+        cases = {'0x10': 16, '010': 8, '08': 8, '256 k': 256 << 10,
+                 '2MB': 2 << 20, '1G': 1 << 30, '0x2K': 2 << 10}
+        for text, expected in cases.items():
+            self.assertEqual(
+                compile_expression(text, GNU_LD_DIALECT).evaluate(_Symbols()),
+                expected, text)
+        self.assertEqual(
+            compile_expression('010', ICF_DIALECT).evaluate(_Symbols()), 10)
+
+    def test_c_precedence(self):
+        """Comparisons bind tighter than bitwise operators in GNU LD, looser in ICF"""
+        gnu = compile_expression('3 & 1 == 1', GNU_LD_DIALECT).evaluate(_Symbols())
+        icf = compile_expression('3 & 1 == 1', ICF_DIALECT).evaluate(_Symbols())
+
+        self.assertEqual(gnu, 3 & (1 == 1))
+        self.assertEqual(icf, 1)
+        self.assertEqual(compile_expression(
+            '1 + 2 * 3 << 1 | 1', GNU_LD_DIALECT).evaluate(_Symbols()), 15)
+        self.assertEqual(compile_expression(
+            '-7 / 2 + 7 % 4', GNU_LD_DIALECT).evaluate(_Symbols()), -1)
+
+    def test_only_taken_branch_is_evaluated(self):
+        """?: and the logical operators short-circuit"""
+        context = _Symbols(A=1, B=2)
+
+        value = compile_expression('A ? B : C || D', GNU_LD_DIALECT).evaluate(context)
+        self.assertEqual(value, 2)
+        self.assertEqual(compile_expression(
+            '0 && C || A', GNU_LD_DIALECT).evaluate(context), 1)
+        self.assertNotIn('C', context.lookups)
+
+    def test_syntax_errors(self):
+        """Malformed text, nesting and runtime faults raise ExpressionError"""
+        for text in ('', '1 +', '(1', '1 2', '4 @ 2', '1 ? 2', 'x = 1',
+                     '(' * 40 + '1' + ')' * 40, '1 << 65'):
+            with self.subTest(text=text), self.assertRaises(ExpressionError):
+                compile_expression(text, GNU_LD_DIALECT).evaluate(_Symbols())
+        with self.assertRaises(ExpressionError):
+            compile_expression('1 / 0', GNU_LD_DIALECT).evaluate(_Symbols())
+
+
+class TestDependencyOrder(unittest.TestCase):
+    """Tests for ordering definitions by the symbols they read"""
+
+    def test_dependencies_come_first(self):
+        """Each name follows the names it references; outside names are ignored"""
+        order, cycles = dependency_order({
+            'END': {'START', 'SIZE'}, 'START': {'BASE'}, 'SIZE': {'EXTERNAL'},
+            'BASE': set()})
+
+        self.assertEqual(cycles, [])
+        self.assertEqual(sorted(order), ['BASE', 'END', 'SIZE', 'START'])
+        self.assertLess(order.index('BASE'), order.index('START'))
+        self.assertLess(order.index('START'), order.index('END'))
+        self.assertLess(order.index('SIZE'), order.index('END'))
+
+    def test_cycles_are_reported_as_paths(self):
+        """A cycle is returned as the exact chain of references"""
+        order, cycles = dependency_order({
+            'A': {'B'}, 'B': {'C'}, 'C': {'A'}, 'D': {'A'}, 'SELF': {'SELF'}})
+
+        self.assertEqual(cycles, [['A', 'B', 'C', 'A'], ['SELF', 'SELF']])
+        self.assertEqual(sorted(order), ['A', 'B', 'C', 'D', 'SELF'])
+
+    def test_long_chain(self):
+        """Deep dependency chains do not recurse"""
+        chain = {f'V{i}': {f'V{i + 1}'} for i in range(5000)}
+
+        order, _ = dependency_order(chain)
+
+        self.assertEqual(order[0], 'V4999')
+        self.assertEqual(order[-1], 'V0')
+
+
+class TestVariableResolution(unittest.TestCase):
+    """Tests for resolving GNU LD variables and ICF symbols"""
+
+    def setUp(self):
+        self.temp_dir = Path(tempfile.mkdtemp())
+
+    def tearDown(self):
+        rmtree_robust(self.temp_dir)
+
+    def test_gnu_forward_references(self):
+        """Variables resolve regardless of definition order"""
+        script = self.temp_dir / 'vars.ld'
+        script.write_text(
+            '_stack_end = _ram_end - 16;\n'
+            '_ram_end = _ram_start + _ram_size;\n'
+            '_ram_size = 64K;\n'
+            '_ram_start = 0x20000000;\n', encoding='utf-8')
+        evaluator = ExpressionEvaluator()
+
+        VariableExtractor(evaluator).extract_from_script(str(script))
+
+        self.assertEqual(evaluator.variables['_ram_end'], 0x20010000)
+        self.assertEqual(evaluator.variables['_stack_end'], 0x20010000 - 16)
+
+    def test_gnu_cycle_is_reported(self):
+        """Circular definitions stay unresolved and are named in a warning"""
+        script = self.temp_dir / 'cycle.ld'
+        script.write_text('A = B + 1;\nB = A + 1;\nC = 4;\n', encoding='utf-8')
+        extractor = VariableExtractor(ExpressionEvaluator())
+
+        with self.assertLogs('membrowse.linker.parser', level='WARNING') as logs:
+            extractor.extract_from_script(str(script))
+
+        self.assertIn('A -> B -> A', '\n'.join(logs.output))
+        self.assertEqual(extractor.variables['A'], 'B + 1')
+        self.assertEqual(extractor.variables['C'], 4)
+
+    def test_gnu_lazy_string_variables(self):
+        """String variables are resolved on use; cycles among them raise"""
+        evaluator = ExpressionEvaluator()
+        evaluator.set_variables({'BASE': '0x1000', 'TOP': 'BASE + 0x100',
+                                 'X': 'Y', 'Y': 'X'})
+
+        self.assertEqual(evaluator.evaluate_expression('TOP'), 0x1100)
+        self.assertEqual(evaluator.variables['BASE'], 0x1000)
+        with self.assertRaises(CircularReferenceError) as ctx:
+            evaluator.evaluate_expression('X + 1')
+        self.assertIn('X -> Y -> X', str(ctx.exception))
+
+    def test_icf_single_pass_and_cycles(self):
+        """ICF symbols resolve in dependency order; the cycle is named"""
+        symbols = ICFSymbolTable()
+        symbols.define_raw('END', 'START + SIZE - 1')
+        symbols.define_raw('START', '0x08000000')
+        symbols.define_raw('SIZE', '512K')
+        symbols.define_raw('P', 'Q')
+        symbols.define_raw('Q', 'P')
+
+        with self.assertLogs('membrowse.linker.icf_parser', level='WARNING') as logs:
+            symbols.resolve_all()
+
+        self.assertEqual(symbols.evaluate('END'), 0x0807FFFF)
+        self.assertIn('P -> Q -> P', '\n'.join(logs.output))
+        with self.assertRaises(ValueError):
+            symbols.evaluate('P')
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -419,6 +419,59 @@ Linker script and memory map
         self.assertTrue(obj.endswith('.o'),
                         f"Expected .o file, got {obj!r}")
 
+    def test_from_file_skips_discarded_sections_and_cref(self):
+        """Streaming parse ignores discarded sections and stops at --cref."""
+        content = (
+            "Discarded input sections\r\n"
+            "\r\n"
+            " .text.unused   0x0000000008000200       0x10 unused.o\r\n"
+            "\r\n"
+            "Linker script and memory map\r\n"
+            "\r\n"
+            " .text.main     0x0000000008000000       0x40 libapp.a(main.o)\r\n"
+            " .text.very_long_function_name\r\n"
+            "                0x0000000008000040       0x20 util.o\r\n"
+            "\r\n"
+            "Cross Reference Table\r\n"
+            "\r\n"
+            " .text.bogus    0x0000000008000100       0x10 bogus.o\r\n"
+        )
+        with tempfile.TemporaryDirectory() as tmpdir:
+            map_path = Path(tmpdir) / 'cref.map'
+            map_path.write_bytes(content.encode('utf-8'))
+            resolver = MapFileResolver.from_file(str(map_path))
+            (Path(tmpdir) / 'empty.map').write_bytes(b'')
+            empty = MapFileResolver.from_file(str(Path(tmpdir) / 'empty.map'))
+        self.assertEqual(resolver.resolve(0x08000010), ('libapp.a', 'main.o'))
+        self.assertEqual(resolver.resolve(0x08000050), ('', 'util.o'))
+        self.assertEqual(resolver.resolve(0x08000100), ('', ''))
+        self.assertEqual(resolver.resolve(0x08000200), ('', ''))
+        self.assertEqual(empty.resolve(0x08000010), ('', ''))
+
+    def test_unsorted_ranges_are_sorted(self):
+        """Ranges passed out of order are sorted before lookup."""
+        resolver = MapFileResolver(ranges=[
+            (0x300, 0x310, 'libfoo.a', 'foo.o'),
+            (0x100, 0x180, '', 'main.o'),
+            (0x200, 0x210, 'libfoo.a', 'bar.o'),
+        ])
+        self.assertEqual(resolver.resolve(0x17f), ('', 'main.o'))
+        self.assertEqual(resolver.resolve(0x180), ('', ''))
+        self.assertEqual(resolver.resolve(0x208), ('libfoo.a', 'bar.o'))
+        self.assertEqual(resolver.resolve(0x30f), ('libfoo.a', 'foo.o'))
+
+    def test_resolve_sorted_matches_resolve(self):
+        """Batch lookups of ascending addresses equal per-address lookups."""
+        addresses = [0x0ff, 0x100, 0x17f, 0x180, 0x208, 0x30f, 0x310]
+        for resolver in (
+                MapFileResolver(ranges=[(0x100, 0x180, '', 'main.o'),
+                                        (0x200, 0x210, 'libfoo.a', 'bar.o'),
+                                        (0x300, 0x310, 'libfoo.a', 'foo.o')]),
+                MapFileResolver({0x100: ('', 'main.o')}),
+                MapFileResolver.null()):
+            self.assertEqual(list(resolver.resolve_sorted(addresses)),
+                             [resolver.resolve(address) for address in addresses])
+
 
 # ============================================================
 # IAR map file test fixtures and tests
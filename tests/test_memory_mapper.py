@@ -5,7 +5,8 @@ Unit tests for memory mapper logic, especially overlapping region handling.
 
 import unittest
 from membrowse.analysis.mapper import MemoryMapper
-from membrowse.core.models import MemoryRegion, MemorySection
+from membrowse.core.models import MemoryRegion, MemorySection, Symbol
+from membrowse.utils.region_index import RegionIndex
 
 
 class TestMemoryMapper(unittest.TestCase):
@@ -537,5 +538,83 @@ class TestMemoryMapper(unittest.TestCase):
         self.assertIn('Flash (inferred @0x10000000)', inferred)
 
 
+class TestRegionIndex(unittest.TestCase):
+    """Tests for the nested-interval region index"""
+
+    def test_matches_linear_smallest_region_scan(self):
+        """Lookups agree with a linear scan over overlapping ESP32-style regions"""
+        ranges = [
+            ('iram0_0_seg', 0x40080000, 0x400A0000),
+            ('iram0_2_seg', 0x400D0020, 0x40400000),
+            ('dram0_0_seg', 0x3FFB0000, 0x40000000),
+            ('drom0_0_seg', 0x3F400020, 0x3F800000),
+            ('rtc_iram_seg', 0x400C0000, 0x400C2000),
+            ('ALL_IRAM', 0x40080000, 0x40400000),
+            ('ALIAS', 0x40080000, 0x400A0000),
+            ('empty', 0x40090000, 0x40090000),
+        ]
+        index = RegionIndex(ranges)
+
+        def linear(address):
+            matches = [(end - start, pos, key)
+                       for pos, (key, start, end) in enumerate(
+                           sorted(ranges, key=lambda r: r[1]))
+                       if start <= address < end]
+            return min(matches)[2] if matches else None
+
+        for address in (0x3F400000, 0x3F400020, 0x3FFB1234, 0x40080000,
+                        0x4009FFFF, 0x400A0000, 0x400C1000, 0x400D0020,
+                        0x403FFFFF, 0x40400000, 0x50000000):
+            self.assertEqual(index.smallest_containing(address), linear(address),
+                             hex(address))
+
+    def test_parent_to_children(self):
+        """Containment lists all nested regions, in input order"""
+        index = RegionIndex([
+            ('FLASH', 0x08000000, 0x08100000),
+            ('FLASH_FS', 0x08004000, 0x08020000),
+            ('FLASH_START', 0x08000000, 0x08004000),
+            ('FLASH_ISR', 0x08000000, 0x08000200),
+            ('RAM', 0x20000000, 0x20020000),
+        ])
+
+        self.assertEqual(index.parent_to_children, {
+            'FLASH': ['FLASH_FS', 'FLASH_START', 'FLASH_ISR'],
+            'FLASH_START': ['FLASH_ISR'],
+        })
+
+
+class TestSymbolAttribution(unittest.TestCase):
+    """Tests for per-symbol region attribution"""
+
+    def test_symbols_credit_vma_and_lma_regions(self):
+        """Symbols count in their region; .data symbols also at their LMA"""
+        regions = {
+            'FLASH': MemoryRegion(address=0x08000000, limit_size=0x100000),
+            'FLASH_START': MemoryRegion(address=0x08000000, limit_size=0x4000),
+            'RAM': MemoryRegion(address=0x20000000, limit_size=0x20000),
+            'CCM': MemoryRegion(address=0x10000000, limit_size=0x10000),
+        }
+        sections = [
+            MemorySection('.text', 0x08004000, 0x2000, 'code'),
+            MemorySection('.data', 0x20000000, 0x100, 'data', lma=0x08006000),
+        ]
+        symbols = [
+            Symbol('vectors', 0x08000000, 0x188, 'STT_OBJECT', 'STB_GLOBAL', '.isr'),
+            Symbol('main', 0x08004001, 0x40, 'STT_FUNC', 'STB_GLOBAL', '.text'),
+            Symbol('counter', 0x20000010, 4, 'STT_OBJECT', 'STB_GLOBAL', '.data'),
+            Symbol('marker', 0x20000014, 0, 'STT_NOTYPE', 'STB_GLOBAL', '.data'),
+        ]
+
+        lma_offsets = MemoryMapper.section_lma_offsets(sections)
+        MemoryMapper.map_sections_to_regions(sections, regions)
+        MemoryMapper.attribute_symbols_to_regions(symbols, lma_offsets, regions)
+
+        self.assertEqual(
+            {name: region.symbol_used_size for name, region in regions.items()},
+            {'FLASH': 0x40 + 4, 'FLASH_START': 0x188, 'RAM': 4, 'CCM': 0})
+        self.assertEqual(regions['RAM'].to_dict()['symbol_used_size'], 4)
+
+
 if __name__ == '__main__':
     unittest.main()
@@ -18,7 +18,7 @@ import tempfile
 import unittest
 from pathlib import Path
 
-from membrowse.linker.parser import parse_linker_scripts, LinkerScriptParser
+from membrowse.linker.parser import parse_linker_scripts, LinkerScriptParser, ScriptSources
 from tests.test_utils import validate_memory_regions
 
 # Add shared directory to path so we can import our modules
@@ -1015,6 +1015,24 @@ class TestIncludeDirective(unittest.TestCase):
         regions = parse_linker_scripts([str(outer)])
         self.assertIn('FLASH', regions)
 
+    def test_shared_include_is_read_once(self):
+        """Parsers sharing ScriptSources read a common INCLUDE only once."""
+        base = self.create_test_file(
+            'MEMORY { FLASH (rx) : ORIGIN = 0x08000000, LENGTH = 512K }\n', 'base.ld')
+        primary = self.create_test_file('INCLUDE "base.ld"\nFLASH_SIZE = 1K;\n',
+                                        'primary.ld')
+        limits = self.create_test_file('INCLUDE base.ld\n', 'limits.ld')
+        sources = ScriptSources()
+
+        LinkerScriptParser([str(primary)], script_sources=sources).parse_memory_regions()
+        # The limits parse must be served from the cache
+        base.write_text('MEMORY { FLASH (rx) : ORIGIN = 0, LENGTH = 1K }', encoding='utf-8')
+        regions = LinkerScriptParser(
+            [str(limits)], script_sources=sources).parse_memory_regions()
+
+        self.assertEqual(regions['FLASH']['address'], 0x08000000)
+        self.assertEqual(regions['FLASH']['limit_size'], 512 * 1024)
+
 
 if __name__ == '__main__':
     print("Memory Regions Test Suite")
@@ -1581,6 +1581,33 @@ class TestStripSectionsContent(unittest.TestCase):
         self.assertIn("__VAR2 = 2;", result)
 
 
+class TestCleanContent(unittest.TestCase):
+    """Direct unit tests for ScriptContentCleaner.clean_content()"""
+
+    def test_comments_removed(self):
+        """Block and line comments are removed, whichever opens first"""
+        content = "A = 1; /* B = 2; // */ C = 3; // D = 4; /* */\nE = 5;"
+        self.assertEqual(ScriptContentCleaner.clean_content(content),
+                         "A = 1; C = 3; E = 5;")
+
+    def test_preprocessor_blocks(self):
+        """Blocks without assignments are dropped; directive lines always are"""
+        content = (
+            "#if defined(FOO)\nINCLUDE_ME\n#endif\n"
+            "#ifdef BIG\nSIZE = 2M;\n#else\nSIZE = 1M;\n#endif\n"
+            "#define X 1\nKEEP = 1; #pragma once\n"
+        )
+        self.assertEqual(ScriptContentCleaner.clean_content(content).strip(),
+                         "SIZE = 2M; SIZE = 1M; KEEP = 1;")
+
+    def test_sections_stripped_in_same_pass(self):
+        """strip_sections drops SECTIONS bodies from the cleaned text"""
+        content = "A = 1;\nSECTIONS\n{\n .text : { *(.text) } /* } */\n}\nB = 2;"
+        self.assertEqual(
+            ScriptContentCleaner.clean_content(content, strip_sections=True),
+            "A = 1; B = 2;")
+
+
 if __name__ == '__main__':
     # Configure test output
     import logging
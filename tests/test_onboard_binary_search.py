@@ -7,6 +7,8 @@ from membrowse.commands.onboard import (
     _extract_fingerprint,
     _binary_search_range,
     _run_binary_search_onboard,
+    _split_points,
+    _WorktreePool,
     run_onboard,
 )
 
@@ -591,8 +593,116 @@ class TestDryRun:
         mock_upload.assert_not_called()
 
 
-class TestMutualExclusivity:  # pylint: disable=too-few-public-methods
-    """Test --binary-search and --build-dirs mutual exclusivity."""
+class _FakeWorktreePool:
+    """Stand-in for _WorktreePool that never touches git."""
+
+    def __init__(self, count):
+        self.count = count
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc_info):
+        return False
+
+    def acquire(self):
+        """Return a fake worktree path."""
+        return '/wt'
+
+    def release(self, path):
+        """Accept a released worktree."""
+
+    def build_dir(self, worktree):
+        """Build in the worktree root."""
+        return worktree
+
+    def worktree_args(self, args, _worktree):
+        """Leave paths unchanged."""
+        return args
+
+
+def _upload_sequence(mock_upload):
+    """(commit, build_failed, identical) for each upload, in order."""
+    return [
+        (call.kwargs['commit_info']['commit_hash'],
+         call.kwargs.get('build_failed'), call.kwargs.get('identical'))
+        for call in mock_upload.call_args_list
+    ]
+
+
+class TestParallelBinarySearch:
+    """Tests for --workers (parallel builds in git worktrees)."""
+
+    def test_split_points(self):
+        """Split points are evenly spaced and strictly inside the range."""
+        assert _split_points(0, 10, 1) == [5]
+        assert _split_points(0, 10, 3) == [2, 5, 7]
+        assert _split_points(3, 5, 4) == [4]
+
+    def _run(self, workers, build):
+        with patch('membrowse.commands.onboard._build_and_generate_report',
+                   side_effect=build) as mock_build, \
+                patch('membrowse.commands.onboard.upload_report',
+                      return_value=({"status": "success"}, "")) as mock_upload, \
+                patch('membrowse.commands.onboard.get_commit_metadata',
+                      side_effect=_make_commit_metadata), \
+                patch('membrowse.commands.onboard._WorktreePool', _FakeWorktreePool):
+            result = _run_binary_search_onboard(
+                _make_args(workers=workers), [f'c{i}' for i in range(20)],
+                'main', 'repo', {})
+        return result, _upload_sequence(mock_upload), mock_build
+
+    def test_uploads_match_serial_run(self):
+        """Parallel builds upload the same results, in the same order."""
+        def build(commit, *_args, **_kwargs):
+            index = int(commit[1:])
+            if index >= 15:
+                return _make_report(), True
+            flash = 1000 if index < 7 else 2000
+            return _make_report(_make_layout(flash_used=flash)), False
+
+        serial_result, serial_uploads, _ = self._run(1, build)
+        parallel_result, parallel_uploads, mock_build = self._run(4, build)
+
+        assert serial_result == parallel_result == (20, 0)
+        assert parallel_uploads == serial_uploads
+        assert all(call.kwargs['cwd'] == '/wt'
+                   for call in mock_build.call_args_list)
+
+    def test_report_error_aborts(self):
+        """A configuration error stops the search like a serial run."""
+        def build(commit, *_args, **_kwargs):
+            if commit == 'c19':
+                raise ValueError("bad linker script")
+            return _make_report(_make_layout()), False
+
+        (success, failed), uploads, _ = self._run(4, build)
+
+        assert failed == 1
+        assert success == 1
+        assert [commit for commit, _, _ in uploads] == ['c0']
+
+    @patch('membrowse.commands.onboard.run_git_command')
+    def test_paths_are_mapped_into_worktree(self, mock_git):
+        """Relative and in-repo paths move into the worktree; others stay."""
+        mock_git.side_effect = lambda cmd: {
+            '--show-toplevel': '/repo', '--show-prefix': 'app/'}.get(cmd[-1])
+        pool = _WorktreePool(2)
+        args = _make_args(elf_path='build/fw.elf',
+                          ld_scripts='/repo/ld/a.ld /opt/sdk/b.ld',
+                          map_file=None, limits='/repo/app/limits.ld')
+
+        mapped = pool.worktree_args(args, '/wt')
+
+        assert mapped.elf_path == '/wt/app/build/fw.elf'
+        assert mapped.ld_scripts == '/wt/ld/a.ld /opt/sdk/b.ld'
+        assert mapped.limits == '/wt/app/limits.ld'
+        assert mapped.map_file is None
+        assert args.elf_path == 'build/fw.elf'
+
+
+class TestMutualExclusivity:
+    """Test mutually exclusive onboard options."""
 
     @patch('membrowse.commands.onboard._get_repository_info')
     def test_binary_search_and_build_dirs_rejected(self, mock_repo):
@@ -602,3 +712,10 @@ class TestMutualExclusivity:  # pylint: disable=too-few-public-methods
         assert result == 1
         # _get_repository_info should not be called
         mock_repo.assert_not_called()
+
+    @patch('membrowse.commands.onboard._get_repository_info')
+    def test_workers_requires_binary_search(self, mock_repo):
+        """--workers > 1 without --binary-search returns error."""
+        result = run_onboard(_make_args(workers=4))
+        assert result == 1
+        mock_repo.assert_not_called()
@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+"""
+Tests for incremental onboard builds (``--incremental``).
+"""
+
+import argparse
+import os
+import platform
+import shutil
+import subprocess
+import tempfile
+import unittest
+from pathlib import Path
+from unittest.mock import MagicMock, patch
+
+from membrowse.commands import onboard
+from membrowse.utils import git
+from tests.test_helpers import rmtree_robust
+
+
+class TestSubmoduleUpdate(unittest.TestCase):
+    """Only submodules that are not at their recorded commit are updated"""
+
+    def test_changed_and_missing_submodules_are_updated(self):
+        """'+' and '-' entries are updated, up-to-date ones are skipped"""
+        status = MagicMock(returncode=0, stdout=(
+            " 1111111 lib/up-to-date (v1.0)\n"
+            "+2222222 lib/moved (v1.1-3-g2222222)\n"
+            "-3333333 lib/new\n"
+            "+4444444 lib/with space (heads/main)\n"))
+
+        with patch.object(git.subprocess, 'run', return_value=status) as run:
+            git.git_submodule_update_changed(cwd='repo')
+
+        self.assertEqual(run.call_args_list[-1].args[0][-4:],
+                         ['--', 'lib/moved', 'lib/new', 'lib/with space'])
+        self.assertEqual(run.call_count, 2)
+
+    def test_nothing_to_update(self):
+        """No update runs when every submodule is at its gitlink"""
+        status = MagicMock(returncode=0, stdout=" 1111111 lib/a (v1.0)\n")
+        with patch.object(git.subprocess, 'run', return_value=status) as run:
+            git.git_submodule_update_changed()
+        run.assert_called_once()
+
+
+class TestIncrementalBuild(unittest.TestCase):
+    """Incremental builds skip git clean; scheduled builds are verified"""
+
+    def setUp(self):
+        if platform.system() == 'Windows':
+            self.skipTest("build scripts use POSIX shell syntax")
+        self.temp_dir = Path(tempfile.mkdtemp())
+        self.addCleanup(rmtree_robust, self.temp_dir)
+        for target in ('git_checkout', 'git_submodule_update', 'git_submodule_update_changed',
+                       'git_clean', 'sample_counters'):
+            patcher = patch.object(onboard, target)
+            setattr(self, target, patcher.start())
+            self.addCleanup(patcher.stop)
+        patcher = patch.object(onboard, 'generate_report',
+                               return_value={'memory_layout': {'FLASH': {'used_size': 1}}})
+        self.generate_report = patcher.start()
+        self.addCleanup(patcher.stop)
+
+    def _args(self, build_script, verify_every=0):
+        elf_path = str(self.temp_dir / 'fw.elf')
+        return argparse.Namespace(
+            build_script=build_script.format(elf=elf_path, dir=self.temp_dir),
+            elf_path=elf_path, ld_scripts=None, incremental=True,
+            clean_build_schedule=onboard._CleanBuildSchedule(  # pylint: disable=protected-access
+                verify_every))
+
+    def test_incremental_build_keeps_output(self):
+        """No clean and only changed submodules are updated"""
+        args = self._args('echo elf > {elf}')
+
+        report, build_failed = onboard._build_and_generate_report(  # pylint: disable=protected-access
+            'abc', args, {})
+
+        self.assertFalse(build_failed)
+        self.assertIn('FLASH', report['memory_layout'])
+        self.git_clean.assert_not_called()
+        self.git_submodule_update.assert_not_called()
+        self.git_submodule_update_changed.assert_called_once_with(cwd=None)
+
+    def test_verification_rebuilds_clean_and_warns_on_mismatch(self):
+        """Every Nth build is redone from a clean tree and compared"""
+        args = self._args('echo $(cat {dir}/count 2>/dev/null) >> {dir}/count; '
+                          'cp {dir}/count {elf}', verify_every=2)
+
+        onboard._build_and_generate_report('c1', args, {})  # pylint: disable=protected-access
+        self.git_clean.assert_not_called()
+        with self.assertLogs(onboard.logger, 'WARNING') as logs:
+            onboard._build_and_generate_report('c2', args, {})  # pylint: disable=protected-access
+
+        self.git_clean.assert_called_once()
+        self.assertIn('differs from a clean build', logs.output[0])
+        self.assertEqual(self.generate_report.call_count, 2)
+
+    def test_matching_verification_is_silent(self):
+        """A reproducible build passes verification without warnings"""
+        args = self._args('echo elf > {elf}', verify_every=1)
+        with self.assertNoLogs(onboard.logger, 'WARNING'):
+            onboard._build_and_generate_report('c1', args, {})  # pylint: disable=protected-access
+        self.git_clean.assert_called_once()
+
+
+class TestPersistentWorktrees(unittest.TestCase):
+    """Incremental worktrees survive between runs"""
+
+    def setUp(self):
+        if shutil.which('git') is None:
+            self.skipTest("git is required")
+        self.repo = Path(tempfile.mkdtemp())
+        self.addCleanup(rmtree_robust, self.repo)
+        self.addCleanup(os.chdir, os.getcwd())
+        os.chdir(self.repo)
+        for command in (['init', '-q'], ['config', 'user.name', 'Dev'],
+                        ['config', 'user.email', 'dev@example.com'],
+                        ['commit', '-q', '--allow-empty', '-m', 'init']):
+            subprocess.run(['git', *command], check=True, capture_output=True)
+
+    def test_worktrees_and_build_output_are_reused(self):
+        """A second pool finds the first pool's worktree and its files"""
+        with onboard._WorktreePool(1, persistent=True) as pool:  # pylint: disable=protected-access
+            worktree = pool.acquire()
+            Path(worktree, 'build.o').write_text('cached', encoding='utf-8')
+
+        with onboard._WorktreePool(1, persistent=True) as pool:  # pylint: disable=protected-access
+            self.assertEqual(pool.acquire(), worktree)
+        self.assertEqual(Path(worktree, 'build.o').read_text(encoding='utf-8'), 'cached')
+        self.assertEqual(Path(worktree).parent.name, 'membrowse-worktrees')
+
+    def _worktree_list(self):
+        return subprocess.run(['git', 'worktree', 'list', '--porcelain'], check=True,
+                              capture_output=True, text=True).stdout
+
+    def test_surplus_worktrees_are_removed(self):
+        """A pool with fewer workers removes the extra kept worktrees"""
+        with onboard._WorktreePool(2, persistent=True) as pool:  # pylint: disable=protected-access
+            second = max(pool.acquire(), pool.acquire())
+
+        with onboard._WorktreePool(1, persistent=True):  # pylint: disable=protected-access
+            self.assertFalse(os.path.exists(second))
+        self.assertNotIn(second, self._worktree_list())
+
+    def test_clean_removes_kept_worktrees(self):
+        """--clean-worktrees removes the worktrees and their directory"""
+        with onboard._WorktreePool(1, persistent=True):  # pylint: disable=protected-access
+            pass
+        # pylint: disable=protected-access
+        with onboard._WorktreePool(1, persistent=True, clean=True) as pool:
+            root = Path(pool.acquire()).parent
+
+        self.assertFalse(root.exists())
+        self.assertNotIn('membrowse-worktrees', self._worktree_list())
+
+
+if __name__ == '__main__':
+    unittest.main()
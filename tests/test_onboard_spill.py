@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+"""
+Tests for the on-disk queue of binary search results awaiting upload.
+"""
+
+import os
+import unittest
+
+from membrowse.commands.onboard import (
+    _SpilledResults, _create_metadata_only_report, _extract_fingerprint)
+
+
+def _report(used):
+    return {
+        'memory_layout': {'FLASH': {'used_size': used}},
+        'symbols': [{'name': f'sym_{i}', 'size': i, 'source_file': 'main.c'}
+                    for i in range(100)],
+    }
+
+
+class TestSpilledResults(unittest.TestCase):
+    """Reports with symbols live on disk until they are popped"""
+
+    def setUp(self):
+        self.results = _SpilledResults()
+        self.addCleanup(self.results.close)
+
+    def _spilled_files(self):
+        directory = self.results._dir  # pylint: disable=protected-access
+        return sorted(os.listdir(directory)) if directory else []
+
+    def test_reports_round_trip_through_disk(self):
+        """Popped results equal what was stored and their file is removed"""
+        self.results[3] = (_report(10), False, False)
+        self.results[1] = (_report(20), True, False)
+
+        self.assertEqual(self._spilled_files(), ['1.json.gz', '3.json.gz'])
+        self.assertIn(3, self.results)
+        self.assertEqual(self.results.pop(3), (_report(10), False, False))
+        self.assertNotIn(3, self.results)
+        self.assertEqual(self._spilled_files(), ['1.json.gz'])
+        self.assertEqual(_extract_fingerprint(self.results[1][0]), (('FLASH', 20),))
+
+    def test_small_reports_stay_in_memory(self):
+        """Metadata-only reports are not written to disk"""
+        report = _create_metadata_only_report('fw.elf')
+        self.results[0] = (report, False, True)
+        self.assertEqual(self._spilled_files(), [])
+        self.assertIs(self.results.pop(0)[0], report)
+
+    def test_overwrite_and_close_remove_files(self):
+        """Replacing an entry drops its old file; close deletes the directory"""
+        self.results[0] = (_report(1), False, False)
+        self.results[0] = (_create_metadata_only_report('fw.elf'), False, True)
+        self.assertEqual(self._spilled_files(), [])
+        self.assertEqual(len(self.results), 1)
+
+        self.results[2] = (_report(1), False, False)
+        directory = self.results._dir  # pylint: disable=protected-access
+        self.results.close()
+        self.assertFalse(os.path.exists(directory))
+        self.assertEqual(len(self.results), 0)
+
+
+if __name__ == '__main__':
+    unittest.main()
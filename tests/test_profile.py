@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+"""
+Tests for ``--profile`` Chrome trace output of report and onboard.
+"""
+
+import io
+import json
+import tempfile
+import unittest
+from pathlib import Path
+from unittest.mock import patch
+
+from membrowse.cli import create_parser
+from membrowse.commands import onboard as onboard_command
+from membrowse.commands import report as report_command
+from membrowse.utils.timing import count, recording, stage
+from tests.test_helpers import rmtree_robust
+
+
+def _fake_generate_report(elf_path, **_kwargs):
+    with stage('dwarf'):
+        with stage('die_walk'):
+            count('dies_visited', 42)
+    return {'file_path': elf_path, 'architecture': None, 'toolchain': None,
+            'entry_point': 0, 'file_type': 'ET_EXEC', 'machine': 'EM_ARM',
+            'symbols': [], 'program_headers': [], 'memory_layout': {}}
+
+
+class TestChromeTrace(unittest.TestCase):
+    """Tests for the trace-event conversion"""
+
+    def test_events_and_counters(self):
+        """Stages become X events, counters become C events"""
+        with recording() as recorder:
+            with stage('commit', {'commit': 'abc123'}):
+                count('line_program_rows', 7)
+            recorder.sample_counters()
+            count('line_program_rows', 3)
+
+        trace = recorder.chrome_trace()
+        events = trace['traceEvents']
+        complete, = [e for e in events if e['ph'] == 'X']
+        self.assertEqual(complete['name'], 'commit')
+        self.assertEqual(complete['args'], {'commit': 'abc123'})
+        self.assertGreaterEqual(complete['dur'], 0)
+        samples = [e['args']['line_program_rows'] for e in events if e['ph'] == 'C']
+        self.assertEqual(samples, [7, 10])
+        self.assertEqual(trace['otherData']['counters'], {'line_program_rows': 10})
+
+
+class TestProfileOption(unittest.TestCase):
+    """--profile on the report and onboard subcommands"""
+
+    def setUp(self):
+        self.temp_dir = Path(tempfile.mkdtemp())
+        self.elf_path = self.temp_dir / 'firmware.elf'
+        self.elf_path.write_bytes(b'\x7fELF')
+
+    def tearDown(self):
+        rmtree_robust(self.temp_dir)
+
+    def test_report_writes_trace(self):
+        """membrowse report --profile writes nested spans and counters"""
+        profile = self.temp_dir / 'profile.json'
+        args = create_parser().parse_args(
+            ['report', str(self.elf_path), '--json', '--profile', str(profile)])
+
+        with patch.object(report_command, 'generate_report',
+                          side_effect=_fake_generate_report), \
+                patch('sys.stdout', new_callable=io.StringIO):
+            self.assertEqual(report_command.run_report(args), 0)
+
+        trace = json.loads(profile.read_text(encoding='utf-8'))
+        names = [e['name'] for e in trace['traceEvents'] if e['ph'] == 'X']
+        self.assertEqual(names, ['die_walk', 'dwarf'])
+        self.assertEqual(trace['otherData']['counters']['dies_visited'], 42)
+
+    def test_report_rejects_missing_directory(self):
+        """A --profile path in a missing directory is a usage error"""
+        args = create_parser().parse_args(
+            ['report', str(self.elf_path), '--profile',
+             str(self.temp_dir / 'missing' / 'profile.json')])
+        self.assertEqual(report_command.run_report(args), 1)
+
+    def test_onboard_commit_span(self):
+        """Each onboard commit is one span, followed by a counter sample"""
+        with patch.object(onboard_command, '_checkout_build_and_analyze',
+                          return_value=({}, False)):
+            with recording() as recorder:
+                count('symbols_demangled', 5)
+                result = onboard_command._build_and_generate_report(  # pylint: disable=protected-access
+                    'abc123', None, None)
+
+        self.assertEqual(result, ({}, False))
+        event, = recorder.events
+        self.assertEqual((event.name, event.args), ('commit', {'commit': 'abc123'}))
+        self.assertEqual(recorder.counter_samples[0].values, {'symbols_demangled': 5})
+
+
+if __name__ == '__main__':
+    unittest.main()
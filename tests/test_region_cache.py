@@ -0,0 +1,98 @@
+#!/usr/bin/env python3
+"""
+Tests for the parsed memory region cache keyed by linker script content.
+"""
+
+import shutil
+import tempfile
+import unittest
+from pathlib import Path
+from unittest.mock import patch
+
+from membrowse.commands.report import _parse_linker_inputs
+from membrowse.core.region_cache import RegionCache
+from membrowse.linker.parser import LinkerScriptParser, ScriptSources
+from tests.test_helpers import rmtree_robust
+
+MEMORY_MAP = 'MEMORY { FLASH (rx) : ORIGIN = 0x08000000, LENGTH = FLASH_SIZE }\n'
+
+
+class TestRegionCache(unittest.TestCase):
+    """Tests for region cache keys and storage"""
+
+    def setUp(self):
+        self.temp_dir = Path(tempfile.mkdtemp())
+        self.addCleanup(rmtree_robust, self.temp_dir)
+        RegionCache.clear_memory()
+        self.addCleanup(RegionCache.clear_memory)
+
+    def _write_tree(self, root, flash_size='512K'):
+        root.mkdir(parents=True, exist_ok=True)
+        (root / 'memory.ld').write_text(MEMORY_MAP, encoding='utf-8')
+        (root / 'main.ld').write_text(
+            f'FLASH_SIZE = {flash_size};\nINCLUDE memory.ld\n', encoding='utf-8')
+        return str(root / 'main.ld')
+
+    @staticmethod
+    def _key(script, linker_variables=None, strategy=None):
+        return RegionCache.make_key([script], None, linker_variables,
+                                    strategy or {}, ScriptSources())
+
+    def test_key_covers_includes_variables_and_strategy(self):
+        """Any input of the parse changes the key; checkout location does not"""
+        script = self._write_tree(self.temp_dir / 'a')
+        key = self._key(script)
+
+        self.assertEqual(self._key(self._write_tree(self.temp_dir / 'b')), key)
+        self.assertNotEqual(self._key(script, {'FLASH_SIZE': '1M'}), key)
+        self.assertNotEqual(
+            self._key(script, strategy={'default_variables': {'X': 1}}), key)
+        (self.temp_dir / 'a' / 'memory.ld').write_text(
+            MEMORY_MAP + 'MEMORY { RAM : ORIGIN = 0, LENGTH = 1K }\n', encoding='utf-8')
+        self.assertNotEqual(self._key(script), key)
+        self.assertIsNone(self._key(str(self.temp_dir / 'missing.ld')))
+
+    def test_icf_includes_are_dependencies(self):
+        """ICF include targets are part of the hashed inputs"""
+        (self.temp_dir / 'regions.icf').write_text(
+            'define symbol __ROM_start__ = 0x0;\n', encoding='utf-8')
+        main = self.temp_dir / 'main.icf'
+        main.write_text('include "regions.icf";\n', encoding='utf-8')
+
+        self.assertEqual(ScriptSources().dependencies(str(main)),
+                         [str(main), str((self.temp_dir / 'regions.icf').resolve())])
+
+    def test_parse_is_reused_in_memory(self):
+        """A second report with unchanged scripts skips the linker parse"""
+        script = self._write_tree(self.temp_dir / 'a')
+        parse = LinkerScriptParser.parse_memory_regions
+
+        with patch.object(LinkerScriptParser, 'parse_memory_regions',
+                          autospec=True, side_effect=parse) as parse_mock:
+            first, _ = _parse_linker_inputs(script, None, None, None)
+            first['FLASH']['limit_size'] = 0
+            second, limits = _parse_linker_inputs(script, None, None, None)
+            self._write_tree(self.temp_dir / 'a', flash_size='256K')
+            third, _ = _parse_linker_inputs(script, None, None, None)
+
+        self.assertEqual(parse_mock.call_count, 2)
+        self.assertEqual(second['FLASH']['limit_size'], 512 * 1024)
+        self.assertIsNone(limits)
+        self.assertEqual(third['FLASH']['limit_size'], 256 * 1024)
+
+    def test_entries_persist_on_disk(self):
+        """With a cache directory, entries survive the process-wide memory"""
+        cache_dir = self.temp_dir / 'cache'
+        cache = RegionCache(str(cache_dir))
+        cache.put('ab' * 32, {'memory_regions': {'FLASH': {}}, 'real_limits': None})
+        RegionCache.clear_memory()
+
+        self.assertEqual(RegionCache(str(cache_dir)).get('ab' * 32),
+                         {'memory_regions': {'FLASH': {}}, 'real_limits': None})
+        self.assertIsNone(RegionCache().get('cd' * 32))
+        shutil.rmtree(cache_dir)
+        self.assertIsNotNone(RegionCache().get('ab' * 32))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+"""
+Tests for the whole-report cache keyed by the ELF content fingerprint.
+"""
+
+import io
+import platform
+import shutil
+import subprocess
+import tempfile
+import unittest
+from pathlib import Path
+from unittest.mock import patch
+
+from membrowse.commands import report as report_command
+from membrowse.commands.report import generate_report
+from membrowse.core.report_cache import ReportCache, elf_fingerprint
+from tests.test_helpers import rmtree_robust
+
+
+class _FakeSection(dict):
+    """Section header dict with a name, like pyelftools sections."""
+
+    def __init__(self, name, **header):
+        super().__init__(header)
+        self.name = name
+
+
+class _FakeELF:
+    """Minimal ELF stand-in: a byte stream plus header and section table."""
+
+    def __init__(self, sections, data):
+        self.stream = io.BytesIO(data)
+        self.header = {'e_ehsize': 4, 'e_shoff': 4, 'e_shentsize': 4, 'e_shnum': 1,
+                       'e_phoff': 0, 'e_phentsize': 0, 'e_phnum': 0}
+        self._sections = sections
+
+    def iter_sections(self):
+        """Iterate the fake sections."""
+        return iter(self._sections)
+
+
+def _fake_elf(text=b'CODE', note=b'NOTE'):
+    data = b'ELF!' + b'SHDR' + text + note
+    sections = [
+        _FakeSection('.text', sh_type='SHT_PROGBITS', sh_flags=0x6,
+                     sh_offset=8, sh_size=4, sh_link=0),
+        _FakeSection('.note.build', sh_type='SHT_NOTE', sh_flags=0,
+                     sh_offset=12, sh_size=4, sh_link=0),
+        _FakeSection('.bss', sh_type='SHT_NOBITS', sh_flags=0x3,
+                     sh_offset=16, sh_size=64, sh_link=0),
+    ]
+    return _FakeELF(sections, data)
+
+
+class TestFingerprint(unittest.TestCase):
+    """Tests for elf_fingerprint and cache keys"""
+
+    def test_alloc_contents_change_fingerprint(self):
+        """Code changes alter the fingerprint, unused sections do not"""
+        base = elf_fingerprint(_fake_elf())
+        self.assertEqual(elf_fingerprint(_fake_elf()), base)
+        self.assertNotEqual(elf_fingerprint(_fake_elf(text=b'EDOC')), base)
+        self.assertEqual(elf_fingerprint(_fake_elf(note=b'ETON')), base)
+
+    def test_key_covers_options(self):
+        """Report options are part of the key"""
+        options = {'memory_regions': {'FLASH': {'limit_size': 1024}},
+                   'skip_sections': []}
+        key = ReportCache.make_key(_fake_elf(), options)
+        self.assertEqual(ReportCache.make_key(_fake_elf(), dict(options)), key)
+        changed = dict(options, memory_regions={'FLASH': {'limit_size': 2048}})
+        self.assertNotEqual(ReportCache.make_key(_fake_elf(), changed), key)
+
+    def test_round_trip(self):
+        """Stored reports are returned on a later lookup"""
+        temp_dir = tempfile.mkdtemp()
+        self.addCleanup(rmtree_robust, Path(temp_dir))
+        cache = ReportCache(temp_dir)
+        key = ReportCache.make_key(_fake_elf(), {})
+
+        self.assertIsNone(cache.get(key))
+        cache.put(key, {'symbols': [], 'memory_layout': {}})
+        self.assertEqual(cache.get(key), {'symbols': [], 'memory_layout': {}})
+
+
+class TestGenerateReportCache(unittest.TestCase):
+    """generate_report reuses the report of a byte-identical ELF"""
+
+    def setUp(self):
+        if platform.system() == 'Windows' or shutil.which('gcc') is None:
+            self.skipTest("native gcc producing ELF is required")
+        self.temp_dir = Path(tempfile.mkdtemp())
+        self.cache_dir = str(self.temp_dir / "cache")
+        source_dir = Path(__file__).parent / "static_test" / "c_static_functions"
+        sources = [str(p) for p in sorted(source_dir.glob("*.c"))]
+        self.elf_path = str(self.temp_dir / "a.out")
+        subprocess.run(
+            ["gcc", "-g", "-o", self.elf_path] + sources,
+            capture_output=True, text=True, check=True)
+
+    def tearDown(self):
+        if hasattr(self, 'temp_dir') and self.temp_dir.exists():
+            rmtree_robust(self.temp_dir)
+
+    def test_second_run_skips_analysis(self):
+        """The cached report equals a fresh one and skips ReportGenerator"""
+        fresh = generate_report(self.elf_path, cache_dir=self.cache_dir)
+
+        with patch.object(report_command, 'ReportGenerator') as generator:
+            cached = generate_report(self.elf_path, cache_dir=self.cache_dir)
+            generator.assert_not_called()
+
+        self.assertEqual(cached, fresh)
+
+    def test_options_miss_the_cache(self):
+        """A different --skip-section generates a new report"""
+        generate_report(self.elf_path, cache_dir=self.cache_dir)
+        with patch.object(report_command, 'ReportGenerator',
+                          wraps=report_command.ReportGenerator) as generator:
+            generate_report(self.elf_path, cache_dir=self.cache_dir,
+                            skip_sections=['.data'])
+            generator.assert_called_once()
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,167 @@
+#!/usr/bin/env python3
+"""
+Tests for the multi-target ``report --manifest`` mode.
+"""
+
+import argparse
+import contextlib
+import io
+import json
+import tempfile
+import unittest
+from concurrent.futures import ThreadPoolExecutor
+from pathlib import Path
+from unittest.mock import patch
+
+from membrowse.commands import batch
+from membrowse.commands.report import add_report_parser, run_report
+from tests.test_helpers import rmtree_robust
+
+
+def _parse_args(*argv):
+    parser = argparse.ArgumentParser()
+    add_report_parser(parser.add_subparsers(dest='subcommand'))
+    return parser.parse_args(['report', *argv])
+
+
+class TestManifest(unittest.TestCase):
+    """Tests for loading manifests and running every target"""
+
+    def setUp(self):
+        self.temp_dir = Path(tempfile.mkdtemp())
+        self.addCleanup(rmtree_robust, self.temp_dir)
+        for name in ('a.elf', 'b.elf', 'c.elf', 'mem.ld', 'sections.ld', 'limits.ld'):
+            (self.temp_dir / name).write_text('', encoding='utf-8')
+
+    def _manifest(self, targets):
+        path = self.temp_dir / 'targets.json'
+        path.write_text(json.dumps(targets), encoding='utf-8')
+        return str(path)
+
+    def test_paths_are_relative_to_manifest(self):
+        """Targets resolve paths, split scripts and merge --def variables"""
+        path = self._manifest({'targets': [
+            {'target_name': 'board-a', 'elf_path': 'a.elf',
+             'ld_scripts': 'mem.ld sections.ld', 'limits': 'limits.ld',
+             'defs': {'FLASH_SIZE': '1M'}},
+            {'target_name': 'board-b', 'elf_path': 'b.elf', 'ld_scripts': ['mem.ld'],
+             'skip_sections': ['.noinit']},
+        ]})
+
+        first, second = batch.load_manifest(path, {'FLASH_SIZE': '512K', 'RAM': '64K'})
+
+        self.assertEqual(first.elf_path, str(self.temp_dir / 'a.elf'))
+        self.assertEqual(first.ld_scripts.split(),
+                         [str(self.temp_dir / 'mem.ld'), str(self.temp_dir / 'sections.ld')])
+        self.assertEqual(first.limits, str(self.temp_dir / 'limits.ld'))
+        self.assertEqual(first.linker_variables, {'FLASH_SIZE': '1M', 'RAM': '64K'})
+        self.assertEqual(second.skip_sections, ['.noinit'])
+        self.assertIsNone(second.map_file)
+
+    def test_invalid_manifests(self):
+        """Missing files, unknown fields and duplicate names are rejected"""
+        cases = {
+            'not found': [{'target_name': 'x', 'elf_path': 'missing.elf'}],
+            'Unknown manifest field': [{'target_name': 'x', 'elf_path': 'a.elf', 'elf': 1}],
+            'no target_name': [{'elf_path': 'a.elf'}],
+            'Duplicate': [{'target_name': 'x', 'elf_path': 'a.elf'},
+                          {'target_name': 'x', 'elf_path': 'b.elf'}],
+            'no targets': [],
+        }
+        for message, targets in cases.items():
+            with self.subTest(message=message), self.assertRaises(ValueError) as ctx:
+                batch.load_manifest(self._manifest(targets))
+            self.assertIn(message, str(ctx.exception))
+
+    def test_single_target_arguments_are_rejected(self):
+        """elf_path and --target-name belong in the manifest"""
+        path = self._manifest([{'target_name': 'x', 'elf_path': 'a.elf'}])
+
+        self.assertIsNone(batch.validate_manifest_args(_parse_args('--manifest', path)))
+        self.assertIn('replaces', batch.validate_manifest_args(
+            _parse_args('x.elf', '--manifest', path)))
+        self.assertIn('--target-name', batch.validate_manifest_args(
+            _parse_args('--manifest', path, '--target-name', 'x')))
+
+    def test_uploads_are_combined(self):
+        """Every report is uploaded and the result list is printed once"""
+        path = self._manifest([
+            {'target_name': 'board-b', 'elf_path': 'b.elf'},
+            {'target_name': 'board-a', 'elf_path': 'a.elf'},
+            {'target_name': 'broken', 'elf_path': 'c.elf'},
+        ])
+        args = _parse_args('--manifest', path, '--upload', '--api-key', 'k',
+                           '--no-git', '--pr-number', '7', '--output-raw-response')
+
+        def fake_report(elf_path, **_):
+            if elf_path.endswith('c.elf'):
+                raise ValueError('bad ELF')
+            return {'file_path': elf_path}
+
+        def fake_upload(report, _args, commit_info, target_name):
+            return 0, {'target_name': target_name, 'pr_number': commit_info['pr_number'],
+                       'api_response': {'file': report['file_path']}, 'comparison_url': ''}
+
+        stdout = io.StringIO()
+        with patch.object(batch, 'generate_report', side_effect=fake_report), \
+                patch.object(batch, '_upload_and_check_alerts', side_effect=fake_upload), \
+                contextlib.redirect_stdout(stdout), \
+                self.assertLogs('membrowse.commands.batch', level='ERROR') as logs:
+            exit_code = run_report(args)
+
+        results = json.loads(stdout.getvalue())
+        self.assertEqual(exit_code, 1)
+        self.assertIn('broken: Failed to generate report: bad ELF', logs.output[0])
+        self.assertEqual([result['target_name'] for result in results],
+                         ['board-a', 'board-b'])
+        self.assertEqual(results[0]['pr_number'], '7')
+
+    def test_unreadable_target_does_not_restart_the_pool(self):
+        """An OSError from one target fails only that target"""
+        path = self._manifest([
+            {'target_name': 'board-a', 'elf_path': 'a.elf'},
+            {'target_name': 'board-b', 'elf_path': 'b.elf'},
+        ])
+        calls = []
+
+        def fake_report(elf_path, **_):
+            calls.append(elf_path)
+            if elf_path.endswith('b.elf'):
+                raise OSError('Permission denied')
+            return {'file_path': elf_path}
+
+        stdout = io.StringIO()
+        # Threads stand in for worker processes so generate_report stays patched
+        with patch.object(batch, 'ProcessPoolExecutor', ThreadPoolExecutor), \
+                patch.object(batch, 'generate_report', side_effect=fake_report), \
+                contextlib.redirect_stdout(stdout), \
+                self.assertLogs('membrowse.commands.batch', level='WARNING') as logs:
+            exit_code = run_report(_parse_args('--manifest', path, '--json', '--jobs', '2'))
+
+        self.assertEqual(exit_code, 1)
+        self.assertEqual(sorted(calls), sorted(set(calls)))
+        self.assertEqual(len(logs.output), 1)
+        self.assertIn('board-b: Failed to generate report: Permission denied', logs.output[0])
+        self.assertEqual([entry['target_name'] for entry in json.loads(stdout.getvalue())],
+                         ['board-a'])
+
+    def test_local_json_output(self):
+        """Without --upload, reports are printed in manifest order"""
+        path = self._manifest([
+            {'target_name': 'board-b', 'elf_path': 'b.elf'},
+            {'target_name': 'board-a', 'elf_path': 'a.elf'},
+        ])
+
+        stdout = io.StringIO()
+        with patch.object(batch, 'generate_report',
+                          side_effect=lambda elf_path, **_: {'file_path': elf_path}), \
+                contextlib.redirect_stdout(stdout):
+            exit_code = run_report(_parse_args('--manifest', path, '--json'))
+
+        self.assertEqual(exit_code, 0)
+        self.assertEqual([entry['target_name'] for entry in json.loads(stdout.getvalue())],
+                         ['board-b', 'board-a'])
+
+
+if __name__ == '__main__':
+    unittest.main()
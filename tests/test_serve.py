@@ -0,0 +1,209 @@
+#!/usr/bin/env python3
+"""
+Tests for the ``membrowse serve`` daemon and its use by ``membrowse report``.
+"""
+
+import argparse
+import logging
+import os
+import tempfile
+import threading
+import time
+import unittest
+from pathlib import Path
+from unittest.mock import patch
+
+from membrowse.commands import report as report_command
+from membrowse.commands import serve
+from membrowse.utils import daemon
+from membrowse.utils.cache import ContentCache
+from tests.test_helpers import rmtree_robust
+
+
+class TestMemoryLayer(unittest.TestCase):
+    """ContentCache keeps serialized entries in memory when enabled"""
+
+    def setUp(self):
+        self.temp_dir = Path(tempfile.mkdtemp())
+        self.addCleanup(rmtree_robust, self.temp_dir)
+        self.addCleanup(ContentCache.keep_in_memory, 0)
+        self.addCleanup(ContentCache.clear_memory)
+        ContentCache.clear_memory()
+
+    def test_entries_survive_deleted_files_and_are_copies(self):
+        """Hits come from memory and callers cannot change the stored value"""
+        ContentCache.keep_in_memory(1024)
+        cache = ContentCache(str(self.temp_dir), 'dwarf')
+        cache.put('ab12', {'files': ['main.c']})
+        rmtree_robust(self.temp_dir / 'dwarf')
+
+        value = cache.get('ab12')
+        self.assertEqual(value, {'files': ['main.c']})
+        value['files'].append('other.c')
+        self.assertEqual(cache.get('ab12'), {'files': ['main.c']})
+
+    def test_budget_evicts_least_recently_used(self):
+        """Entries beyond the byte budget are dropped oldest first"""
+        ContentCache.keep_in_memory(80)
+        cache = ContentCache(str(self.temp_dir), 'report')
+        for key in ('aa01', 'bb02', 'cc03'):
+            cache.put(key, {'payload': 'x' * 10})  # 24 bytes serialized
+        cache.get('aa01')
+        cache.put('dd04', {'payload': 'x' * 10})
+        rmtree_robust(self.temp_dir / 'report')
+
+        self.assertIsNotNone(cache.get('aa01'))
+        self.assertIsNone(cache.get('bb02'))
+        self.assertIsNotNone(cache.get('dd04'))
+
+    def test_memory_only_cache(self):
+        """Without a directory entries live in memory and nothing is written"""
+        self.assertFalse(ContentCache.enabled(None))
+        ContentCache.keep_in_memory(1024)
+        self.assertTrue(ContentCache.enabled(None))
+        cache = ContentCache(None, 'dwarf')
+        self.assertIsNone(cache.get('ab12'))
+        cache.put('ab12', [1])
+
+        self.assertEqual(cache.get('ab12'), [1])
+        self.assertEqual(ContentCache(str(self.temp_dir), 'dwarf').get('ab12'), [1])
+        self.assertEqual(os.listdir(self.temp_dir), [])
+
+    def test_disabled_by_default(self):
+        """Without a budget every get reads the file"""
+        cache = ContentCache(str(self.temp_dir), 'dwarf')
+        cache.put('ab12', [1])
+        rmtree_robust(self.temp_dir / 'dwarf')
+        self.assertIsNone(cache.get('ab12'))
+
+
+class TestReportDaemon(unittest.TestCase):
+    """Request handling without a socket"""
+
+    def setUp(self):
+        self.daemon = serve.ReportDaemon(cache_dir='cache')
+        self.temp_dir = tempfile.mkdtemp()
+        self.addCleanup(rmtree_robust, self.temp_dir)
+
+    def _request(self, **options):
+        return {'command': 'report', 'version': self.daemon.version,
+                'cwd': self.temp_dir, 'log_level': logging.INFO,
+                'options': {'elf_path': 'fw.elf', **options}}
+
+    def test_report_runs_in_client_directory_and_returns_logs(self):
+        """Options reach generate_report; cwd and the daemon's cache apply"""
+        def fake_generate_report(**options):
+            serve.logger.warning("analyzed in %s", os.path.basename(os.getcwd()))
+            serve.logger.debug("hidden")
+            return {'options': options}
+
+        before = os.getcwd()
+        with patch.object(serve, 'generate_report', side_effect=fake_generate_report):
+            response = self.daemon.handle(self._request(jobs=2))
+
+        self.assertTrue(response['ok'])
+        self.assertEqual(response['report']['options'],
+                         {'elf_path': 'fw.elf', 'jobs': 2, 'cache_dir': 'cache'})
+        self.assertEqual(response['logs'], [
+            ['membrowse.commands.serve', logging.WARNING,
+             f'analyzed in {os.path.basename(self.temp_dir)}']])
+        self.assertEqual(os.getcwd(), before)
+        self.assertEqual(self.daemon.requests, 1)
+
+    def test_disk_cache_only_when_asked_for(self):
+        """Without --cache-dir the daemon leaves a request's cache_dir alone"""
+        self.daemon = serve.ReportDaemon()
+        with patch.object(serve, 'generate_report',
+                          side_effect=lambda **options: options) as generate:
+            self.daemon.handle(self._request(cache_dir=None))
+            self.daemon.handle(self._request(cache_dir='mine'))
+
+        self.assertEqual([call.kwargs['cache_dir'] for call in generate.call_args_list],
+                         [None, 'mine'])
+
+    def test_errors_and_incompatible_requests(self):
+        """Failures are reported; other versions and options are refused"""
+        with patch.object(serve, 'generate_report', side_effect=ValueError('no ELF')):
+            self.assertEqual(self.daemon.handle(self._request())['error'], 'no ELF')
+
+        request = self._request()
+        request['version'] = '0.0.1'
+        self.assertTrue(self.daemon.handle(request)['incompatible'])
+        self.assertTrue(self.daemon.handle(self._request(colour=True))['incompatible'])
+        self.assertFalse(self.daemon.handle({'command': 'reboot'})['ok'])
+        self.assertTrue(self.daemon.handle({'command': 'ping'})['ok'])
+
+
+@unittest.skipUnless(daemon.daemon_supported(), "needs Unix domain sockets")
+class TestServeSocket(unittest.TestCase):
+    """A running daemon answers report requests over its socket"""
+
+    def setUp(self):
+        self.temp_dir = Path(tempfile.mkdtemp())
+        self.addCleanup(rmtree_robust, self.temp_dir)
+        self.socket = self.temp_dir / 'serve.sock'
+        patcher = patch.dict(os.environ, {daemon.SOCKET_ENV: str(self.socket)})
+        patcher.start()
+        self.addCleanup(patcher.stop)
+
+    def _start(self):
+        args = argparse.Namespace(socket=None, cache_dir=str(self.temp_dir / 'cache'),
+                                  memory_mb=16, idle_timeout=10, stop=False)
+        thread = threading.Thread(target=serve.run_serve, args=(args,))
+        thread.start()
+        self.addCleanup(thread.join, 10)
+        self.addCleanup(daemon.send_request, {'command': 'stop'})
+        for _ in range(100):
+            if self.socket.exists():
+                return
+            time.sleep(0.05)
+        self.fail("daemon did not start")
+
+    def test_request_report_round_trip(self):
+        """request_report returns the daemon's report and replays its logs"""
+        self.assertIsNone(daemon.request_report({'elf_path': 'fw.elf'}))
+
+        with patch.object(serve, 'generate_report',
+                          side_effect=lambda **options: {'file_path': options['elf_path']}):
+            self._start()
+            with self.assertLogs('membrowse', 'DEBUG') as logs:
+                report = daemon.request_report({'elf_path': 'fw.elf'})
+
+        self.assertEqual(report, {'file_path': 'fw.elf'})
+        self.assertIn('Report generated by membrowse serve', logs.output[-1])
+        with self.assertLogs(serve.logger, 'ERROR'):
+            self.assertEqual(serve.run_serve(argparse.Namespace(
+                socket=str(self.socket), memory_mb=16, stop=False)), 1)
+
+
+class TestReportUsesDaemon(unittest.TestCase):
+    """membrowse report prefers a running daemon"""
+
+    def _run(self, **overrides):
+        values = {'elf_path': 'fw.elf', 'ld_scripts': None, 'json': True}
+        values.update(overrides)
+        with patch.object(report_command, 'request_report',
+                          return_value={'memory_layout': {}}) as request, \
+                patch.object(report_command, 'generate_report',
+                             return_value={'memory_layout': {}}) as generate, \
+                patch('sys.stdout'):
+            self.assertEqual(report_command._run_report(  # pylint: disable=protected-access
+                argparse.Namespace(**values)), 0)
+        return request, generate
+
+    def test_daemon_report_is_used(self):
+        """A daemon answer skips the local analysis"""
+        request, generate = self._run()
+        self.assertEqual(request.call_args.args[0]['elf_path'], 'fw.elf')
+        generate.assert_not_called()
+
+    def test_no_daemon_and_profile_analyze_locally(self):
+        """--no-daemon and --profile never contact the daemon"""
+        for overrides in ({'no_daemon': True}, {'profile': 'trace.json'}):
+            request, generate = self._run(**overrides)
+            request.assert_not_called()
+            generate.assert_called_once()
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -7,6 +7,7 @@ Tests the new address-priority mapping structure for handling duplicate symbol n
 
 import sys
 import unittest
+from collections.abc import Mapping
 from pathlib import Path
 from unittest.mock import patch, mock_open
 
@@ -39,7 +40,7 @@ class TestSourceFileMapping(unittest.TestCase):
         self.assertIn('address_to_file', analyzer._dwarf_data)
         self.assertIn('symbol_to_file', analyzer._dwarf_data)
         self.assertIsInstance(
-            analyzer._dwarf_data['address_to_file'], dict)
+            analyzer._dwarf_data['address_to_file'], Mapping)
         self.assertIsInstance(
             analyzer._dwarf_data['symbol_to_file'], dict)
 
@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+"""
+Tests that short commands do not import the ELF analysis stack.
+"""
+
+import json
+import os
+import subprocess
+import sys
+import unittest
+from pathlib import Path
+from unittest.mock import patch
+
+import membrowse
+from membrowse import cli
+from membrowse.core.generator import ReportGenerator
+
+REPO_ROOT = Path(__file__).parent.parent
+
+# Modules only ELF analysis, uploads and template rendering need
+HEAVY_MODULES = ('elftools', 'itanium_demangler', 'rust_demangler', 'jinja2', 'requests',
+                 'importlib.metadata', 'membrowse.linker.parser', 'membrowse.core.generator')
+
+
+def _imported_heavy_modules(code):
+    """Heavy modules loaded after running ``code`` in a fresh interpreter."""
+    env = dict(os.environ)
+    env['PYTHONPATH'] = os.pathsep.join(
+        filter(None, [str(REPO_ROOT), env.get('PYTHONPATH')]))
+    script = (f"import sys\n{code}\n"
+              f"print(__import__('json').dumps([m for m in {HEAVY_MODULES!r} "
+              "if m in sys.modules]))")
+    result = subprocess.run([sys.executable, '-c', script], check=True, env=env,
+                            capture_output=True, text=True, cwd=REPO_ROOT)
+    return json.loads(result.stdout.splitlines()[-1])
+
+
+class TestLazyImports(unittest.TestCase):
+    """The package and the CLI load subsystems on first use"""
+
+    def test_import_membrowse_is_light(self):
+        """import membrowse defers the public API until it is accessed"""
+        self.assertEqual(_imported_heavy_modules('import membrowse'), [])
+        self.assertEqual(
+            _imported_heavy_modules('import membrowse.utils.github_common'), [])
+
+    def test_summary_parser_is_light(self):
+        """Parsing a summary command line imports only the summary module"""
+        code = ("from membrowse.cli import create_parser\n"
+                "argv = ['summary', 'abc', '--api-key', 'KEY', '--json']\n"
+                "args = create_parser(argv).parse_args(argv)\n"
+                "assert args.json and 'membrowse.commands.report' not in sys.modules")
+        self.assertEqual(_imported_heavy_modules(code), [])
+
+    def test_public_api_resolves(self):
+        """Lazy names resolve to the defining objects and are listed by dir()"""
+        self.assertIs(membrowse.ReportGenerator, ReportGenerator)
+        self.assertIn('parse_linker_scripts', dir(membrowse))
+        self.assertIsInstance(membrowse.__version__, str)
+        with self.assertRaises(AttributeError):
+            _ = membrowse.not_an_export
+
+    def test_selected_subcommand_gets_full_parser(self):
+        """Only the subcommand on the command line is fully built"""
+        self.assertEqual(cli.selected_subcommand(['-v', 'DEBUG', 'summary', 'abc']),
+                         'summary')
+        self.assertIsNone(cli.selected_subcommand(['--help']))
+        self.assertEqual(cli.selected_subcommand(['--verbose=DEBUG', 'diff', 'report']),
+                         'diff')
+        self.assertEqual(cli.selected_subcommand(['-v', 'INFO', 'report', 'serve']),
+                         'report')
+        self.assertIsNone(cli.selected_subcommand(['fw.elf', 'report']))
+        argv = ['report', 'fw.elf', '--json']
+        self.assertTrue(cli.create_parser(argv).parse_args(argv).json)
+        with self.assertRaises(SystemExit), \
+                open(os.devnull, 'w', encoding='utf-8') as devnull, \
+                patch('sys.stderr', devnull):
+            cli.create_parser(['summary']).parse_args(['report', 'fw.elf'])
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+"""
+Tests for the columnar symbol table behind reports and the formatter.
+"""
+
+import unittest
+
+from membrowse.core.models import Symbol
+from membrowse.core.symbol_table import SymbolTable
+from membrowse.utils.formatter import _format_top_symbols
+
+
+def _symbols():
+    return [
+        Symbol('main', 0x08000100, 0x40, 'STT_FUNC', 'STB_GLOBAL', '.text', 'main.c', 12),
+        Symbol('buf', 0x20000000, 0x400, 'STT_OBJECT', 'STB_LOCAL', '.bss',
+               archive='libc.a', object_file='buf.o'),
+        Symbol('init', 0x08000200, 0x40, 'STT_FUNC', 'STB_GLOBAL', '.text', 'init.c', 3),
+        Symbol('marker', 0x20000400, 0, 'STT_NOTYPE', 'STB_GLOBAL', '.bss'),
+        Symbol('dbg', 0, 0x10, 'STT_OBJECT', 'STB_LOCAL', '.debug_info'),
+    ]
+
+
+class TestSymbolTable(unittest.TestCase):
+    """Columnar operations agree with the list-of-symbols equivalents"""
+
+    def setUp(self):
+        self.symbols = _symbols()
+        self.table = SymbolTable.from_symbols(self.symbols)
+
+    def test_round_trip_keeps_report_shape(self):
+        """to_dicts matches Symbol.__dict__, including key order"""
+        dicts = self.table.to_dicts()
+        self.assertEqual(dicts, [symbol.__dict__ for symbol in self.symbols])
+        self.assertEqual([list(d) for d in dicts],
+                         [list(symbol.__dict__) for symbol in self.symbols])
+        self.assertEqual(SymbolTable.from_dicts(dicts).to_dicts(), dicts)
+        self.assertEqual(self.table.strings.count('.text'), 1)
+
+    def test_filter_and_counts(self):
+        """Excluded sections drop their symbols; unknown names are ignored"""
+        kept = self.table.filter('section', {'.debug_info', '.missing'}, exclude=True)
+        self.assertEqual(kept.values('name'), ['main', 'buf', 'init', 'marker'])
+        self.assertEqual(self.table.filter('section', {'.nope'}, exclude=True), self.table)
+        self.assertEqual(self.table.rows_where('section', ['.bss']), [1, 3])
+        self.assertEqual(self.table.count_nonempty('source_file'), 2)
+        self.assertEqual(len(SymbolTable()), 0)
+
+    def test_group_sizes(self):
+        """Sizes are summed per section, archive and looked-up region"""
+        self.assertEqual(self.table.group_sizes('section'),
+                         {'.text': 0x80, '.bss': 0x400, '.debug_info': 0x10})
+        self.assertEqual(self.table.group_sizes('archive'), {'': 0x90, 'libc.a': 0x400})
+
+        def region(address):
+            if 0x08000000 <= address < 0x08100000:
+                return 'FLASH'
+            return 'RAM' if address >= 0x20000000 else None
+        self.assertEqual(self.table.group_sizes_by_address(region, {'.bss': -0x17ff0000}),
+                         {'FLASH': 0x80 + 0x400, 'RAM': 0x400})
+
+    def test_aliases_are_counted_once(self):
+        """Names sharing an address and size occupy the region once"""
+        table = SymbolTable.from_symbols(self.symbols + [
+            Symbol('memcpy', 0x08000300, 0x20, 'STT_FUNC', 'STB_GLOBAL', '.text'),
+            Symbol('__aeabi_memcpy', 0x08000300, 0x20, 'STT_FUNC', 'STB_GLOBAL', '.text'),
+            Symbol('__aeabi_memcpy4', 0x08000300, 0x20, 'STT_FUNC', 'STB_GLOBAL', '.text'),
+            Symbol('buf_alias', 0x20000000, 0x400, 'STT_OBJECT', 'STB_GLOBAL', '.bss'),
+        ])
+
+        self.assertEqual(table.group_sizes_by_address(
+            lambda address: 'FLASH' if address < 0x20000000 else 'RAM', {'.bss': -0x17ff0000}),
+            {'FLASH': 0x10 + 0x80 + 0x20 + 0x400, 'RAM': 0x400})
+
+    def test_top_k_matches_stable_sort(self):
+        """Top-k orders like a stable descending sort by size"""
+        expected = sorted(range(len(self.symbols)),
+                          key=lambda row: self.symbols[row].size, reverse=True)
+        self.assertEqual(self.table.top_k(), expected)
+        self.assertEqual(self.table.top_k(2), expected[:2])
+        self.assertEqual(self.table.values('name')[self.table.top_k(2)[1]], 'main')
+
+    def test_formatter_top_symbols(self):
+        """The formatter shows the largest symbols and map file columns"""
+        report = {'symbols': self.table.to_dicts()}
+        text = _format_top_symbols(report, top_n=2)
+        rows = text.splitlines()[5:7]
+        self.assertTrue(rows[0].startswith('buf'))
+        self.assertTrue(rows[1].startswith('main'))
+        self.assertIn('Archive', text)
+        self.assertIn('Object', text)
+        self.assertNotIn('init', text)
+
+
+if __name__ == '__main__':
+    unittest.main()
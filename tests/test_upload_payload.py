@@ -0,0 +1,201 @@
+#!/usr/bin/env python3
+"""
+Tests for incremental JSON encoding, the streaming upload body, encoding
+fallback and the compact (version 2) report format.
+"""
+
+import gzip
+import json
+import unittest
+from unittest.mock import MagicMock, patch
+
+import requests
+
+from membrowse.api.client import JSONBody, MemBrowseClient
+from membrowse.core.compact import compact_report, expand_report
+from membrowse.utils.json_stream import iter_json
+
+
+def _report(symbol_count=2500):
+    return {
+        'metadata': {'git': {'commit_hash': 'abc123'}, 'identical': False},
+        'memory_analysis': {
+            'symbols': [{'name': f'sym_{i}', 'size': i, 'source_file': 'main.c'}
+                        for i in range(symbol_count)],
+            'memory_layout': {},
+            'program_headers': [],
+            'toolchain': 'gcc-12 é',
+        },
+    }
+
+
+class TestIterJson(unittest.TestCase):
+    """iter_json must produce exactly what json.dumps produces"""
+
+    def test_matches_json_dumps(self):
+        """Nested dicts and long lists are encoded identically"""
+        report = _report()
+        for batch_size in (1, 7, 1000, 10000):
+            with self.subTest(batch_size=batch_size):
+                self.assertEqual(''.join(iter_json(report, batch_size)),
+                                 json.dumps(report))
+
+    def test_non_string_keys_fall_back(self):
+        """Dicts with non-string keys are encoded by json.dumps as a whole"""
+        value = {'regions': {1: 'a', 2: 'b'}}
+        self.assertEqual(''.join(iter_json(value)), json.dumps(value))
+
+    def test_long_lists_are_split(self):
+        """Long lists are yielded in several pieces"""
+        pieces = list(iter_json(list(range(10)), batch_size=3))
+        self.assertGreater(len(pieces), 3)
+
+
+def _client():
+    auth_context = MagicMock()
+    auth_context.build_headers.return_value = {}
+    auth_context.get_metadata_additions.return_value = {'github_context': {'x': 1}}
+    return MemBrowseClient(auth_context, 'https://api.example.com')
+
+
+def _http_error(status_code):
+    response = MagicMock(status_code=status_code)
+    return requests.exceptions.HTTPError(f"HTTP {status_code}", response=response)
+
+
+class TestJSONBody(unittest.TestCase):
+    """Tests for the streaming request body"""
+
+    def test_identity_body_is_plain_json(self):
+        """Without compression the body is the JSON text"""
+        report = _report()
+        self.assertEqual(b''.join(JSONBody(report, 'identity')),
+                         json.dumps(report).encode('utf-8'))
+
+    def test_decompresses_to_json(self):
+        """The body is the gzip-compressed JSON and can be sent twice"""
+        report = _report()
+        body = JSONBody(report, 'gzip')
+        first = b''.join(body)
+        self.assertEqual(gzip.decompress(first), json.dumps(report).encode('utf-8'))
+        self.assertEqual(b''.join(body), first)
+        self.assertLess(len(first), len(json.dumps(report)) / 5)
+
+    def test_upload_streams_without_mutating_input(self):
+        """upload_report sends a gzip body and leaves the input untouched"""
+        report = _report(10)
+        expected = json.loads(json.dumps(report))
+
+        client = _client()
+        with patch.object(client, '_request_with_retry',
+                          return_value={'success': True}) as request:
+            client.upload_report(report)
+
+        kwargs = request.call_args.kwargs
+        self.assertEqual(kwargs['headers']['Content-Encoding'], 'gzip')
+        sent = json.loads(gzip.decompress(b''.join(kwargs['data'])))
+        self.assertEqual(sent['metadata']['github_context'], {'x': 1})
+        self.assertEqual(sent['memory_analysis'], expected['memory_analysis'])
+        self.assertEqual(report, expected)
+
+
+class TestEncodingFallback(unittest.TestCase):
+    """The client downgrades the upload body when the server rejects it"""
+
+    def test_unsupported_encoding_falls_back_to_identity(self):
+        """HTTP 415 resends without Content-Encoding and remembers it"""
+        client = _client()
+        with patch.object(client, '_request_with_retry',
+                          side_effect=[_http_error(415), {'success': True},
+                                       {'success': True}]) as request:
+            client.upload_report(_report(10))
+            client.upload_report(_report(10))
+
+        headers = [call.kwargs['headers'] for call in request.call_args_list]
+        self.assertEqual(headers[0].get('Content-Encoding'), 'gzip')
+        self.assertNotIn('Content-Encoding', headers[1])
+        self.assertNotIn('Content-Encoding', headers[2])
+        self.assertEqual(client.content_encoding, 'identity')
+
+    def test_length_required_sends_bytes(self):
+        """HTTP 411 resends the same encoding with a bytes body"""
+        client = _client()
+        with patch.object(client, '_request_with_retry',
+                          side_effect=[_http_error(411), {'success': True}]) as request:
+            client.upload_report(_report(10))
+
+        retry = request.call_args_list[1].kwargs
+        self.assertIsInstance(retry['data'], bytes)
+        self.assertEqual(retry['headers']['Content-Encoding'], 'gzip')
+
+    def test_bad_request_falls_back_to_plain_body(self):
+        """HTTP 400 resends once, uncompressed and with Content-Length"""
+        client = _client()
+        with patch.object(client, '_request_with_retry',
+                          side_effect=[_http_error(400), {'success': True}]) as request:
+            client.upload_report(_report(10))
+
+        retry = request.call_args_list[1].kwargs
+        self.assertNotIn('Content-Encoding', retry['headers'])
+        self.assertIsInstance(retry['data'], bytes)
+        self.assertEqual(json.loads(retry['data'])['metadata']['git']['commit_hash'], 'abc123')
+        self.assertEqual((client.content_encoding, client.chunked_upload), ('identity', False))
+
+    def test_genuine_bad_request_is_raised(self):
+        """A 400 to the plain body too raises the first 400 and keeps the settings"""
+        client = _client()
+        settings = (client.content_encoding, client.chunked_upload)
+        first = _http_error(400)
+        with patch.object(client, '_request_with_retry',
+                          side_effect=[first, _http_error(400)]) as request:
+            with self.assertRaises(requests.exceptions.HTTPError) as raised:
+                client.upload_report(_report(10))
+
+        self.assertIs(raised.exception, first)
+        self.assertEqual(request.call_count, 2)
+        self.assertEqual((client.content_encoding, client.chunked_upload), settings)
+
+        with patch.object(client, '_request_with_retry',
+                          side_effect=_http_error(400)) as request:
+            with self.assertRaises(requests.exceptions.HTTPError):
+                client.upload_report(_report(10))
+        self.assertIn('Content-Encoding', request.call_args_list[-2].kwargs['headers'])
+
+    def test_other_errors_are_raised(self):
+        """Validation errors are not retried with another encoding"""
+        client = _client()
+        with patch.object(client, '_request_with_retry',
+                          side_effect=_http_error(422)) as request:
+            with self.assertRaises(requests.exceptions.HTTPError):
+                client.upload_report(_report(10))
+        request.assert_called_once()
+
+
+class TestCompactFormat(unittest.TestCase):
+    """Tests for the interned (version 2) report format"""
+
+    def test_round_trip(self):
+        """Expanding a compact report restores the original symbols"""
+        report = {'symbols': [
+            {'name': 'a', 'section': '.text', 'source_file': 'main.c',
+             'archive': '', 'object_file': 'main.o'},
+            {'name': 'b', 'section': '.bss', 'source_file': 'main.c',
+             'archive': 'libc.a', 'object_file': 'x.o'},
+        ], 'memory_layout': {}}
+
+        compact = compact_report(report)
+
+        self.assertEqual(compact['format_version'], 2)
+        self.assertEqual(compact['string_tables']['source_file'], ['main.c'])
+        self.assertEqual([s['source_file'] for s in compact['symbols']], [0, 0])
+        self.assertEqual(expand_report(compact), report)
+        self.assertIsInstance(report['symbols'][0]['section'], str)
+
+    def test_plain_reports_expand_unchanged(self):
+        """Version 1 reports pass through expand_report"""
+        report = {'symbols': [{'name': 'a', 'section': '.text'}]}
+        self.assertIs(expand_report(report), report)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+"""
+Tests for the background upload queue of the onboard subcommand.
+"""
+
+import argparse
+import threading
+import unittest
+from unittest.mock import patch
+
+from membrowse.commands import onboard
+from membrowse.commands.onboard import _UploadQueue
+
+
+def _args(**overrides):
+    defaults = {
+        'num_commits': 3, 'build_script': 'make', 'elf_path': 'fw.elf',
+        'target_name': 'stm32', 'api_key': 'KEY', 'api_url': 'https://api.membrowse.com',
+        'api_url_flag': None, 'ld_scripts': None, 'linker_defs': None, 'build_dirs': None,
+        'dry_run': True,
+    }
+    defaults.update(overrides)
+    return argparse.Namespace(**defaults)
+
+
+class TestUploadQueue(unittest.TestCase):
+    """Tests for ordering, backpressure and failure handling"""
+
+    def test_uploads_run_in_order(self):
+        """A single sender keeps submission order"""
+        sent = []
+        with _UploadQueue(2) as uploads:
+            for index in range(20):
+                self.assertTrue(uploads.submit(lambda index=index: sent.append(index) or True))
+        self.assertEqual(sent, list(range(20)))
+        self.assertEqual((uploads.successful, uploads.failures), (20, 0))
+
+    def test_full_queue_blocks_submit(self):
+        """At most max_pending uploads wait behind the one being sent"""
+        release = threading.Event()
+        uploads = _UploadQueue(1)
+        self.addCleanup(uploads.close)
+        self.addCleanup(release.set)
+        uploads.submit(release.wait)
+        uploads.submit(lambda: True)
+
+        third = threading.Thread(target=uploads.submit, args=(lambda: True,))
+        third.start()
+        third.join(0.2)
+        self.assertTrue(third.is_alive())
+
+        release.set()
+        third.join(5)
+        self.assertFalse(third.is_alive())
+
+    def test_failure_drops_remaining_uploads(self):
+        """After a failed upload nothing else is sent"""
+        sent = []
+        for max_pending in (0, 4):
+            sent.clear()
+            with self.subTest(max_pending=max_pending), _UploadQueue(max_pending) as uploads:
+                uploads.submit(lambda: sent.append('a') or True)
+                uploads.submit(lambda: False)
+                uploads.close()
+                self.assertFalse(uploads.submit(lambda: sent.append('c') or True))
+                self.assertTrue(uploads.failed)
+                self.assertEqual((uploads.successful, uploads.failures), (1, 1))
+                self.assertEqual(sent, ['a'])
+
+    def test_exceptions_count_as_failures(self):
+        """An exception in an upload stops the queue instead of the sender thread"""
+        def broken():
+            raise KeyError('boom')
+        with self.assertLogs(onboard.logger, 'ERROR'), _UploadQueue(2) as uploads:
+            uploads.submit(broken)
+        self.assertTrue(uploads.failed)
+
+
+class TestOnboardOverlap(unittest.TestCase):
+    """Builds continue while earlier reports are uploaded"""
+
+    def _run(self, upload, built=None, **overrides):
+        builds = []
+
+        def build(commit, *_args, **_kwargs):
+            builds.append(commit)
+            if built is not None and commit == 'c3':
+                built.set()
+            return {'memory_layout': {}}, False
+
+        with patch.object(onboard, '_get_repository_info', return_value=('main', 'head', 'r')), \
+                patch.object(onboard, '_get_commit_list', return_value=['c1', 'c2', 'c3']), \
+                patch.object(onboard.CommitMetadataCache, 'prefetch'), \
+                patch.object(onboard, 'git_checkout'), \
+                patch.object(onboard, '_build_and_generate_report', side_effect=build), \
+                patch.object(onboard, '_upload_commit', side_effect=upload) as upload_mock:
+            exit_code = onboard.run_onboard(_args(**overrides))
+        return exit_code, builds, [call.args[1] for call in upload_mock.call_args_list]
+
+    def test_next_build_runs_during_upload(self):
+        """The first upload only finishes once the last commit has been built"""
+        built_last = threading.Event()
+
+        def upload(_report, commit, *_args, **_kwargs):
+            if commit == 'c1':
+                return built_last.wait(5)
+            return True
+
+        exit_code, builds, uploaded = self._run(upload, built_last)
+
+        self.assertEqual(exit_code, 0)
+        self.assertEqual(builds, ['c1', 'c2', 'c3'])
+        self.assertEqual(uploaded, ['c1', 'c2', 'c3'])
+
+    def test_upload_failure_stops_onboard(self):
+        """A failed upload fails the run and later builds are not uploaded"""
+        exit_code, builds, uploaded = self._run(
+            lambda _report, commit, *_args, **_kwargs: commit != 'c1', upload_queue=0)
+
+        self.assertEqual(exit_code, 1)
+        self.assertEqual(builds, ['c1'])
+        self.assertEqual(uploaded, ['c1'])
+
+
+if __name__ == '__main__':
+    unittest.main()